@@ -84,6 +84,9 @@ from _bascenev1 import (
     get_game_port,
     get_game_roster,
     get_local_active_input_devices_count,
+    get_nearest_nodes,
+    get_nodes_in_box,
+    get_nodes_in_radius,
     get_public_party_enabled,
     get_public_party_max_size,
     get_random_names,
@@ -326,6 +329,9 @@ __all__ = [
     'get_local_active_input_devices_count',
     'get_map_class',
     'get_map_display_string',
+    'get_nearest_nodes',
+    'get_nodes_in_box',
+    'get_nodes_in_radius',
     'get_player_colors',
     'get_player_profile_colors',
     'get_player_profile_icon',
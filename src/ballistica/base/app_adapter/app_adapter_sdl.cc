@@ -10,6 +10,7 @@
 #include "ballistica/base/graphics/gl/renderer_gl.h"
 #include "ballistica/base/graphics/graphics.h"
 #include "ballistica/base/graphics/graphics_server.h"
+#include "ballistica/base/graphics/null/renderer_null.h"
 #include "ballistica/base/input/device/joystick_input.h"
 #include "ballistica/base/input/input.h"
 #include "ballistica/base/logic/logic.h"
@@ -48,6 +49,12 @@ AppAdapterSDL::AppAdapterSDL() {
   if (val && *val == "1") {
     debug_log_sdl_frame_timing_ = true;
   }
+
+  // Allow swapping in the null renderer via env var.
+  auto renderer_val = g_core->platform->GetEnv("BA_RENDERER");
+  if (renderer_val && *renderer_val == "null") {
+    null_renderer_ = true;
+  }
 }
 
 void AppAdapterSDL::OnMainThreadStartApp() {
@@ -77,6 +84,17 @@ void AppAdapterSDL::OnMainThreadStartApp() {
     FatalError(std::string("SDL_Init failed: ") + SDL_GetError());
   }
 
+  // SDL's dummy video driver can't give us a GL context, so go with the
+  // null renderer there.
+  if (const char* driver = SDL_GetCurrentVideoDriver()) {
+    if (!strcmp(driver, "dummy")) {
+      null_renderer_ = true;
+    }
+  }
+  if (null_renderer_) {
+    Log(LogLevel::kInfo, "AppAdapterSDL using null renderer.");
+  }
+
   // Register events we can send ourself.
   sdl_runnable_event_id_ = SDL_RegisterEvents(1);
   assert(sdl_runnable_event_id_ != (uint32_t)-1);
@@ -167,7 +185,7 @@ void AppAdapterSDL::ApplyGraphicsSettings(
       vsync = VSync::kNever;
       break;
   }
-  if (vsync != vsync_) {
+  if (vsync != vsync_ && !null_renderer_) {
     switch (vsync) {
       case VSync::kUnset:
       case VSync::kNever: {
@@ -221,7 +239,7 @@ void AppAdapterSDL::RunMainThreadEventLoopToCompletion() {
     }
 
     // Draw.
-    if (!hidden_ && TryRender()) {
+    if (!hidden_ && TryRender() && !null_renderer_) {
       SDL_GL_SwapWindow(sdl_window_);
     }
 
@@ -648,8 +666,11 @@ void AppAdapterSDL::ReloadRenderer_(const GraphicsSettings_* settings) {
     auto width = static_cast<int>(kBaseVirtualResX * 0.8f);
     auto height = static_cast<int>(kBaseVirtualResY * 0.8f);
 
-    uint32_t flags = SDL_WINDOW_OPENGL | SDL_WINDOW_SHOWN
-                     | SDL_WINDOW_ALLOW_HIGHDPI | SDL_WINDOW_RESIZABLE;
+    uint32_t flags =
+        SDL_WINDOW_SHOWN | SDL_WINDOW_ALLOW_HIGHDPI | SDL_WINDOW_RESIZABLE;
+    if (!null_renderer_) {
+      flags |= SDL_WINDOW_OPENGL;
+    }
     if (settings->fullscreen) {
       flags |= SDL_WINDOW_FULLSCREEN_DESKTOP;
     }
@@ -691,19 +712,25 @@ void AppAdapterSDL::ReloadRenderer_(const GraphicsSettings_* settings) {
       FatalError("Unable to create SDL Window of size " + std::to_string(width)
                  + " by " + std::to_string(height));
     }
-    sdl_gl_context_ = SDL_GL_CreateContext(sdl_window_);
-    if (!sdl_gl_context_) {
-      FatalError("Unable to create SDL GL Context");
+    if (!null_renderer_) {
+      sdl_gl_context_ = SDL_GL_CreateContext(sdl_window_);
+      if (!sdl_gl_context_) {
+        FatalError("Unable to create SDL GL Context");
+      }
     }
 
     SDL_SetWindowTitle(sdl_window_, "BallisticaKit");
 
     UpdateScreenSizes_();
 
-    // Now assign a GL renderer to the graphics-server to do its work.
+    // Now assign a renderer to the graphics-server to do its work.
     assert(!gs->renderer());
     if (!gs->renderer()) {
-      gs->set_renderer(new RendererGL());
+      if (null_renderer_) {
+        gs->set_renderer(new RendererNull());
+      } else {
+        gs->set_renderer(new RendererGL());
+      }
     }
   }
 
@@ -727,7 +754,12 @@ void AppAdapterSDL::UpdateScreenSizes_() {
   // Also grab the new size of the drawable; this is our physical (pixel)
   // dimensions.
   int pixels_x, pixels_y;
-  SDL_GL_GetDrawableSize(sdl_window_, &pixels_x, &pixels_y);
+  if (null_renderer_) {
+    pixels_x = win_size_x;
+    pixels_y = win_size_y;
+  } else {
+    SDL_GL_GetDrawableSize(sdl_window_, &pixels_x, &pixels_y);
+  }
 
   // Push this over to the logic thread which owns the canonical value
   // for this.
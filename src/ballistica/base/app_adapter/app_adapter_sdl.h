@@ -91,6 +91,11 @@ class AppAdapterSDL : public AppAdapter {
   /// that require such a setup.
   bool strict_graphics_context_{};
   bool strict_graphics_allowed_{};
+
+  /// Render with RendererNull instead of GL; no GL context is created and
+  /// nothing gets drawn to the window. Enabled with BA_RENDERER=null or
+  /// when running under SDL's dummy video driver.
+  bool null_renderer_{};
   VSync vsync_{VSync::kUnset};
   uint32_t sdl_runnable_event_id_{};
   std::mutex strict_graphics_calls_mutex_;
@@ -13,6 +13,7 @@
 #include "ballistica/base/audio/audio_server.h"
 #include "ballistica/base/graphics/graphics.h"
 #include "ballistica/base/graphics/graphics_server.h"
+#include "ballistica/base/graphics/support/frame_def.h"
 #include "ballistica/base/graphics/text/text_packer.h"
 #include "ballistica/base/logic/logic.h"
 #include "ballistica/base/python/base_python.h"
@@ -36,6 +37,9 @@ static const bool kShowPruningInfo = false;
 
 #define QR_TEXTURE_PRUNE_TIME 10000
 
+// Compiled Lstr templates we keep before starting over.
+static const size_t kMaxLstrTemplates{512};
+
 // How long we should spend loading assets in each runPendingLoads() call.
 #define PENDING_LOAD_PROCESS_TIME 5
 
@@ -1341,6 +1345,7 @@ void Assets::SetLanguageKeys(
   // receiving callbacks can see if they're out of date if they become
   // active again.
   language_state_++;
+  lstr_templates_.clear();
 
   // Let some subsystems know that language has changed.
   g_base->app_mode()->LanguageChanged();
@@ -1348,7 +1353,9 @@ void Assets::SetLanguageKeys(
   g_base->graphics->LanguageChanged();
 }
 
-auto DoCompileResourceString(cJSON* obj) -> std::string {
+// Return the base text for a json Lstr object (its resource, translation,
+// or value), before subs are applied.
+static auto GetLstrBase_(cJSON* obj) -> std::string {
   // NOTE: We currently talk to Python here so need to be sure
   // we're holding the GIL. Perhaps in the future we could handle this
   // stuff completely in C++ and be free of this limitation.
@@ -1469,10 +1476,12 @@ auto DoCompileResourceString(cJSON* obj) -> std::string {
       }
     }
   }
+  return result;
+}
 
-  // Ok; now no matter what it was, see if it contains any subs and replace
-  // them.
-  // ("subs" or "s")
+// Return the subs array for a json Lstr object if it has one ("subs" or
+// "s").
+static auto GetLstrSubs_(cJSON* obj) -> cJSON* {
   cJSON* subs = cJSON_GetObjectItem(obj, "s");
   if (subs == nullptr) {
     subs = cJSON_GetObjectItem(obj, "subs");
@@ -1490,6 +1499,15 @@ auto DoCompileResourceString(cJSON* obj) -> std::string {
       }
     }
   }
+  return subs;
+}
+
+auto DoCompileResourceString(cJSON* obj) -> std::string {
+  std::string result = GetLstrBase_(obj);
+
+  // Ok; now no matter what it was, see if it contains any subs and replace
+  // them.
+  cJSON* subs = GetLstrSubs_(obj);
   if (subs != nullptr) {
     if (subs->type != cJSON_Array) {
       throw Exception("expected an array for 'subs'");
@@ -1538,6 +1556,228 @@ auto DoCompileResourceString(cJSON* obj) -> std::string {
   return result;
 }
 
+auto Assets::ScanLstr_(const std::string& s, std::string* shape,
+                       std::vector<std::string>* values) -> bool {
+  // We track just enough json structure to find literal sub values (the
+  // second member of each pair in a "subs"/"s" array). Everything else is
+  // copied into shape verbatim and each value is swapped for a \x01 (raw
+  // control chars can't appear in valid json so that's unambiguous).
+  struct Frame {
+    bool object;
+    bool in_value;  // Object: past the ':' of the current member.
+    bool subs_key;  // Object: current member is "subs" or "s".
+    bool subs;      // Array: a subs list.
+    bool pair;      // Array: an entry in a subs list.
+    int index;      // Array: current element index.
+  };
+  constexpr int kMaxDepth{32};
+  Frame stack[kMaxDepth];
+  int depth{};
+  auto is_subs_key = [](const char* key, size_t len) {
+    // cJSON matches keys case-insensitively, so we do too.
+    return (len == 1 && tolower(key[0]) == 's')
+           || (len == 4 && tolower(key[0]) == 's' && tolower(key[1]) == 'u'
+               && tolower(key[2]) == 'b' && tolower(key[3]) == 's');
+  };
+
+  shape->clear();
+  values->clear();
+  size_t size = s.size();
+  size_t i{};
+  while (i < size) {
+    char c = s[i];
+    Frame* top = depth > 0 ? &stack[depth - 1] : nullptr;
+    if (c == '"') {
+      size_t end = i + 1;
+      bool escaped{};
+      while (end < size && s[end] != '"') {
+        if (static_cast<unsigned char>(s[end]) < 0x20) {
+          return false;
+        }
+        if (s[end] == '\\') {
+          escaped = true;
+          end++;
+        }
+        end++;
+      }
+      if (end >= size) {
+        return false;
+      }
+      if (top && top->object && !top->in_value) {
+        top->subs_key = !escaped && is_subs_key(&s[i + 1], end - i - 1);
+        shape->append(s, i, end + 1 - i);
+      } else if (top && top->pair && top->index == 1) {
+        if (!escaped) {
+          values->emplace_back(s, i + 1, end - i - 1);
+        } else {
+          // Let cJSON deal with escapes.
+          cJSON* str = cJSON_Parse(s.substr(i, end + 1 - i).c_str());
+          if (str == nullptr || str->type != cJSON_String) {
+            cJSON_Delete(str);
+            return false;
+          }
+          values->emplace_back(str->valuestring);
+          cJSON_Delete(str);
+        }
+        shape->push_back('\x01');
+      } else {
+        shape->append(s, i, end + 1 - i);
+      }
+      i = end + 1;
+      continue;
+    }
+    switch (c) {
+      case '{':
+      case '[':
+        if (depth >= kMaxDepth) {
+          return false;
+        }
+        stack[depth] = {};
+        stack[depth].object = (c == '{');
+        if (c == '[' && top) {
+          stack[depth].subs = top->object && top->in_value && top->subs_key;
+          stack[depth].pair = !top->object && top->subs;
+        }
+        depth++;
+        break;
+      case '}':
+      case ']':
+        if (depth == 0 || top->object != (c == '}')) {
+          return false;
+        }
+        depth--;
+        break;
+      case ':':
+        if (top && top->object) {
+          top->in_value = true;
+        }
+        break;
+      case ',':
+        if (top && top->object) {
+          top->in_value = top->subs_key = false;
+        } else if (top) {
+          top->index++;
+        }
+        break;
+      case ' ':
+      case '\t':
+      case '\n':
+      case '\r':
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          return false;
+        }
+        break;
+    }
+    shape->push_back(c);
+    i++;
+  }
+  return depth == 0;
+}
+
+auto Assets::CompileLstrTemplate_(cJSON* obj, int* slot_count)
+    -> std::unique_ptr<LstrTemplate_> {
+  // This mirrors DoCompileResourceString() (including its errors), except
+  // that literal sub values become slots.
+  auto lstr = std::make_unique<LstrTemplate_>();
+  lstr->pieces.push_back({GetLstrBase_(obj)});
+  cJSON* subs = GetLstrSubs_(obj);
+  if (subs == nullptr) {
+    return lstr;
+  }
+  if (subs->type != cJSON_Array) {
+    throw Exception("expected an array for 'subs'");
+  }
+  int subs_count = cJSON_GetArraySize(subs);
+  for (int i = 0; i < subs_count; i++) {
+    cJSON* sub = cJSON_GetArrayItem(subs, i);
+    if (sub->type != cJSON_Array || cJSON_GetArraySize(sub) != 2) {
+      throw Exception(
+          "Invalid subs entry; expected length 2 list of sub/replacement.");
+    }
+    cJSON* key = cJSON_GetArrayItem(sub, 0);
+    if (key->type != cJSON_String) {
+      throw Exception("Sub keys must be strings.");
+    }
+    LstrTemplate_::Sub entry;
+    entry.key = key->valuestring;
+
+    // Any value 'contains' an empty key.
+    if (entry.key.empty()) {
+      throw Exception("Subs replace string cannot contain search string.");
+    }
+    cJSON* value = cJSON_GetArrayItem(sub, 1);
+    if (value->type == cJSON_String) {
+      entry.slot = (*slot_count)++;
+    } else if (value->type == cJSON_Object) {
+      entry.nested = CompileLstrTemplate_(value, slot_count);
+    } else {
+      throw Exception("Sub values must be strings or dicts.");
+    }
+
+    // Split remaining literal text at each occurrence of our key.
+    std::vector<LstrTemplate_::Piece> pieces;
+    for (auto&& piece : lstr->pieces) {
+      if (piece.sub != -1) {
+        pieces.push_back(std::move(piece));
+        continue;
+      }
+      size_t start{};
+      size_t pos;
+      while ((pos = piece.text.find(entry.key, start)) != std::string::npos) {
+        if (pos > start) {
+          pieces.push_back({piece.text.substr(start, pos - start)});
+        }
+        pieces.push_back({"", i});
+        start = pos + entry.key.size();
+      }
+      if (start < piece.text.size()) {
+        pieces.push_back({piece.text.substr(start)});
+      }
+    }
+    lstr->pieces.swap(pieces);
+    lstr->subs.push_back(std::move(entry));
+  }
+  return lstr;
+}
+
+auto Assets::RenderLstrTemplate_(const LstrTemplate_& lstr,
+                                 const std::vector<std::string>& values,
+                                 std::string* out) -> bool {
+  // DoCompileResourceString() applies subs one at a time to the whole
+  // string, so a value can wind up forming part of a later key (or of its
+  // own key; an error). Splicing values in place only gives the same
+  // result when that can't happen, so we bail if it might and let the
+  // caller take the slow path.
+  std::vector<std::string> sub_values(lstr.subs.size());
+  for (size_t i = 0; i < lstr.subs.size(); ++i) {
+    auto& sub{lstr.subs[i]};
+    auto& value{sub_values[i]};
+    if (sub.nested) {
+      if (!RenderLstrTemplate_(*sub.nested, values, &value)) {
+        return false;
+      }
+    } else {
+      assert(sub.slot >= 0 && sub.slot < static_cast<int>(values.size()));
+      value = values[sub.slot];
+    }
+    for (size_t j = i; j < lstr.subs.size(); ++j) {
+      auto& key{lstr.subs[j].key};
+      if (value.find(key.front()) != std::string::npos
+          || value.find(key.back()) != std::string::npos
+          || key.find(value) != std::string::npos) {
+        return false;
+      }
+    }
+  }
+  out->clear();
+  for (auto&& piece : lstr.pieces) {
+    out->append(piece.sub == -1 ? piece.text : sub_values[piece.sub]);
+  }
+  return true;
+}
+
 auto Assets::CompileResourceString(const std::string& s, const std::string& loc,
                                    bool* valid) -> std::string {
   bool dummyvalid;
@@ -1552,6 +1792,42 @@ auto Assets::CompileResourceString(const std::string& s, const std::string& loc,
     return s;
   }
 
+  // Json Lstrs tend to come in a limited number of shapes with just their
+  // literal sub values changing (scores, timers, etc.), so in the logic
+  // thread we keep compiled templates per shape; repeats then skip json
+  // parsing and Python resource lookups entirely.
+  if (g_base->InLogicThread()) {
+    std::string shape;
+    std::vector<std::string> values;
+    if (ScanLstr_(s, &shape, &values)) {
+      auto i = lstr_templates_.find(shape);
+      if (i == lstr_templates_.end()) {
+        if (cJSON* root = cJSON_Parse(s.c_str())) {
+          std::unique_ptr<LstrTemplate_> lstr;
+          int slot_count{};
+          try {
+            lstr = CompileLstrTemplate_(root, &slot_count);
+          } catch (const std::exception&) {
+            // The regular path below will report this.
+          }
+          cJSON_Delete(root);
+          if (lstr && slot_count == static_cast<int>(values.size())) {
+            if (lstr_templates_.size() >= kMaxLstrTemplates) {
+              lstr_templates_.clear();
+            }
+            i = lstr_templates_.emplace(shape, std::move(lstr)).first;
+          }
+        }
+      }
+      std::string result;
+      if (i != lstr_templates_.end()
+          && RenderLstrTemplate_(*i->second, values, &result)) {
+        *valid = true;
+        return result;
+      }
+    }
+  }
+
   cJSON* root = cJSON_Parse(s.c_str());
   if (root == nullptr) {
     Log(LogLevel::kError, "CompileResourceString failed (loc " + loc
@@ -1615,14 +1891,14 @@ Assets::AssetListLock::~AssetListLock() {
 
 auto Assets::SysTexture(SysTextureID id) -> TextureAsset* {
   assert(asset_loads_allowed_ && sys_assets_loaded_);
-  assert(g_base->InLogicThread());
+  assert(FrameDef::InDrawThread());
   assert(static_cast<size_t>(id) < system_textures_.size());
   return system_textures_[static_cast<int>(id)].Get();
 }
 
 auto Assets::SysCubeMapTexture(SysCubeMapTextureID id) -> TextureAsset* {
   assert(asset_loads_allowed_ && sys_assets_loaded_);
-  assert(g_base->InLogicThread());
+  assert(FrameDef::InDrawThread());
   assert(static_cast<size_t>(id) < system_cube_map_textures_.size());
   return system_cube_map_textures_[static_cast<int>(id)].Get();
 }
@@ -1640,7 +1916,7 @@ auto Assets::SysSound(SysSoundID id) -> SoundAsset* {
 
 auto Assets::SysMesh(SysMeshID id) -> MeshAsset* {
   assert(asset_loads_allowed_ && sys_assets_loaded_);
-  assert(g_base->InLogicThread());
+  assert(FrameDef::InDrawThread());
   assert(static_cast<size_t>(id) < system_meshes_.size());
   return system_meshes_[static_cast<int>(id)].Get();
 }
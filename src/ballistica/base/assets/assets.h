@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_BASE_ASSETS_ASSETS_H_
 #define BALLISTICA_BASE_ASSETS_ASSETS_H_
 
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -121,6 +122,33 @@ class Assets {
   auto asset_loads_allowed() const { return asset_loads_allowed_; }
 
  private:
+  /// A json Lstr with its resources/translations resolved and its literal
+  /// sub values pulled out into numbered slots, so it can be re-rendered
+  /// with new values without touching json or Python.
+  struct LstrTemplate_ {
+    struct Sub {
+      std::string key;
+      /// Slot providing this sub's value, or -1 if it is nested.
+      int slot{-1};
+      std::unique_ptr<LstrTemplate_> nested;
+    };
+    /// Base text split at sub keys: literal text when sub is -1 and
+    /// otherwise the index of a sub.
+    struct Piece {
+      std::string text;
+      int sub{-1};
+    };
+    std::vector<Piece> pieces;
+    std::vector<Sub> subs;
+  };
+  static auto ScanLstr_(const std::string& s, std::string* shape,
+                        std::vector<std::string>* values) -> bool;
+  static auto CompileLstrTemplate_(cJSON* obj, int* slot_count)
+      -> std::unique_ptr<LstrTemplate_>;
+  static auto RenderLstrTemplate_(const LstrTemplate_& lstr,
+                                  const std::vector<std::string>& values,
+                                  std::string* out) -> bool;
+
   static void MarkAssetForLoad(Asset* c);
   void LoadSystemTexture(SysTextureID id, const char* name);
   void LoadSystemCubeMapTexture(SysCubeMapTextureID id, const char* name);
@@ -181,6 +209,11 @@ class Assets {
   // Text & Language (need to mold this into more asset-like concepts).
   std::mutex language_mutex_;
   std::unordered_map<std::string, std::string> language_;
+
+  // Compiled json Lstrs keyed by their text with literal sub values
+  // removed; cleared whenever language changes. Logic thread only.
+  std::unordered_map<std::string, std::unique_ptr<LstrTemplate_> >
+      lstr_templates_;
   std::mutex special_char_mutex_;
   std::unordered_map<SpecialChar, std::string> special_char_strings_;
 };
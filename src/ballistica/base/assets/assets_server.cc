@@ -2,14 +2,26 @@
 
 #include "ballistica/base/assets/assets_server.h"
 
+#include <algorithm>
+
 #include "ballistica/base/assets/asset.h"
 #include "ballistica/base/assets/assets.h"
 #include "ballistica/base/graphics/graphics.h"
-#include "ballistica/base/support/huffman.h"
 #include "ballistica/shared/foundation/event_loop.h"
+#include "ballistica/shared/generic/worker_pool.h"
 
 namespace ballistica::base {
 
+// Most sound preloads we run per Process() call.
+static const size_t kAudioPreloadBatchSize{16};
+
+static auto GetAudioDecodePool_() -> WorkerPool* {
+  // We use our own pool (sized like the shared one) so that long decodes
+  // never hold up its other users such as physics and drawing.
+  static auto* pool = new WorkerPool(WorkerPool::Shared()->thread_count());
+  return pool;
+}
+
 AssetsServer::AssetsServer() = default;
 
 void AssetsServer::OnMainThreadStartApp() {
@@ -54,11 +66,7 @@ void AssetsServer::PushBeginWriteReplayCall(uint16_t protocol_version) {
     if (writing_replay_) {
       Log(LogLevel::kError,
           "AssetsServer got BeginWriteReplayCall while already writing");
-      WriteReplayMessages();
-      if (replay_out_file_) {
-        fclose(replay_out_file_);
-      }
-      replay_out_file_ = nullptr;
+      replay_writer_.End();
       replays_broken_ = true;
       return;
     }
@@ -68,26 +76,9 @@ void AssetsServer::PushBeginWriteReplayCall(uint16_t protocol_version) {
     assert(g_core);
     std::string file_path =
         g_core->platform->GetReplaysDir() + BA_DIRSLASH + f_name + ".brp";
-    replay_out_file_ = g_core->platform->FOpen(file_path.c_str(), "wb");
-    replay_bytes_written_ = 0;
-
-    if (!replay_out_file_) {
+    if (!replay_writer_.Begin(file_path, protocol_version)) {
       Log(LogLevel::kError,
-          "unable to open output-stream file: '" + file_path + "'");
-    } else {
-      // Write file id and protocol-version.
-      // NOTE: We always write replays in our host protocol version
-      // no matter what the client stream is.
-      uint32_t file_id = kBrpFileID;
-      uint16_t version = protocol_version;
-      if ((fwrite(&file_id, sizeof(file_id), 1, replay_out_file_) != 1)
-          || (fwrite(&version, sizeof(version), 1, replay_out_file_) != 1)) {
-        fclose(replay_out_file_);
-        replay_out_file_ = nullptr;
-        Log(LogLevel::kError, "error writing replay file header: "
-                                  + g_core->platform->GetErrnoString());
-      }
-      replay_bytes_written_ = 5;
+          "unable to start output-stream file: '" + file_path + "'");
     }
 
     // Trigger our process timer to go off immediately
@@ -111,22 +102,9 @@ void AssetsServer::PushAddMessageToReplayCall(
       return;
     }
 
-    // Just add it to our list.
-    if (replay_out_file_) {
-      // If we've got too much data built up (lets go with 10 megs for now),
-      // abort.
-      if (replay_message_bytes_ > 10000000) {
-        Log(LogLevel::kError,
-            "replay output buffer exceeded 10 megs; aborting replay");
-        fclose(replay_out_file_);
-        replay_out_file_ = nullptr;
-        replay_message_bytes_ = 0;
-        replay_messages_.clear();
-        return;
-      }
-      replay_message_bytes_ += data.size();
-      replay_messages_.push_back(data);
-    }
+    // This fails quietly once the writer has given up on the replay
+    // (it logs why when that happens).
+    replay_writer_.Add(data);
   });
 }
 
@@ -142,82 +120,14 @@ void AssetsServer::PushEndWriteReplayCall() {
       replays_broken_ = true;
       return;
     }
-    WriteReplayMessages();
+    replay_writer_.End();
 
     // Whether or not we actually have a file has no impact on our
     // writing_replay_ status.
-    if (replay_out_file_) {
-      fclose(replay_out_file_);
-      replay_out_file_ = nullptr;
-    }
     writing_replay_ = false;
   });
 }
 
-void AssetsServer::WriteReplayMessages() {
-  if (replay_out_file_) {
-    for (auto&& i : replay_messages_) {
-      std::vector<uint8_t> data_compressed = g_base->huffman->compress(i);
-
-      // If message length is < 254, write length as one byte.
-      // If its between 254 and 65535, write 254 and then 2 length bytes
-      // otherwise write 255 and then 4 length bytes.
-      auto len32 = static_cast<uint32_t>(data_compressed.size());
-      {
-        uint8_t len8;
-        if (len32 < 254) {
-          len8 = static_cast_check_fit<uint8_t>(len32);
-        } else if (len32 < 65535) {
-          len8 = 254;
-        } else {
-          len8 = 255;
-        }
-        if (fwrite(&len8, 1, 1, replay_out_file_) != 1) {
-          fclose(replay_out_file_);
-          replay_out_file_ = nullptr;
-          Log(LogLevel::kError, "error writing replay file: "
-                                    + g_core->platform->GetErrnoString());
-          return;
-        }
-      }
-      // write 16 bit val if need be..
-      if (len32 >= 254) {
-        if (len32 <= 65535) {
-          auto len16 = static_cast_check_fit<uint16_t>(len32);
-          if (fwrite(&len16, 2, 1, replay_out_file_) != 1) {
-            fclose(replay_out_file_);
-            replay_out_file_ = nullptr;
-            Log(LogLevel::kError, "error writing replay file: "
-                                      + g_core->platform->GetErrnoString());
-            return;
-          }
-        } else {
-          if (fwrite(&len32, 4, 1, replay_out_file_) != 1) {
-            fclose(replay_out_file_);
-            replay_out_file_ = nullptr;
-            Log(LogLevel::kError, "error writing replay file: "
-                                      + g_core->platform->GetErrnoString());
-            return;
-          }
-        }
-      }
-      // Write buffer.
-      size_t result = fwrite(&(data_compressed[0]), data_compressed.size(), 1,
-                             replay_out_file_);
-      if (result != 1) {
-        fclose(replay_out_file_);
-        replay_out_file_ = nullptr;
-        Log(LogLevel::kError,
-            "error writing replay file: " + g_core->platform->GetErrnoString());
-        return;
-      }
-      replay_bytes_written_ += data_compressed.size() + 2;
-    }
-    replay_messages_.clear();
-    replay_message_bytes_ = 0;
-  }
-}
-
 void AssetsServer::Process() {
   // Make sure we don't do any loading until we know what kind/quality of
   // textures we'll be loading.
@@ -243,15 +153,28 @@ void AssetsServer::Process() {
     g_base->assets->AddPendingLoad(pending_preloads_.back());
     pending_preloads_.pop_back();
   } else if (!pending_preloads_audio_.empty()) {
-    (**pending_preloads_audio_.back()).Preload();
-    // Pass the ref-pointer along to the load queue.
-    g_base->assets->AddPendingLoad(pending_preloads_audio_.back());
-    pending_preloads_audio_.pop_back();
+    // Sounds are mostly decode time and independent of each other, so we
+    // preload a batch at once across our decode pool.
+    size_t count =
+        std::min(pending_preloads_audio_.size(), kAudioPreloadBatchSize);
+    auto batch_begin = pending_preloads_audio_.end() - count;
+    GetAudioDecodePool_()->ParallelFor(
+        count, 1, [batch_begin](size_t begin, size_t end, int slot) {
+          for (size_t i = begin; i < end; ++i) {
+            (**batch_begin[i]).Preload();
+          }
+        });
+    // Pass the ref-pointers along to the load queue.
+    for (auto i = batch_begin; i != pending_preloads_audio_.end(); ++i) {
+      g_base->assets->AddPendingLoad(*i);
+    }
+    pending_preloads_audio_.erase(batch_begin, pending_preloads_audio_.end());
   }
 
-  // If we're writing a replay, dump anything we've got built up.
+  // If we're writing a replay, push out any partial block so we never
+  // have more than a second or so of it only in memory.
   if (writing_replay_) {
-    WriteReplayMessages();
+    replay_writer_.Flush();
   }
 
   // If we've got nothing left, set our timer to go off every now and then if
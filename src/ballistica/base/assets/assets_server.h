@@ -3,9 +3,9 @@
 #ifndef BALLISTICA_BASE_ASSETS_ASSETS_SERVER_H_
 #define BALLISTICA_BASE_ASSETS_ASSETS_SERVER_H_
 
-#include <list>
 #include <vector>
 
+#include "ballistica/base/assets/replay_writer.h"
 #include "ballistica/base/base.h"
 #include "ballistica/shared/foundation/object.h"
 
@@ -20,18 +20,15 @@ class AssetsServer {
   void PushAddMessageToReplayCall(const std::vector<uint8_t>& data);
   void PushPendingPreload(Object::Ref<Asset>* asset_ref_ptr);
   auto event_loop() const -> EventLoop* { return event_loop_; }
+  auto replay_writer() -> ReplayWriter* { return &replay_writer_; }
 
  private:
   void OnAppStartInThread();
   void Process();
-  void WriteReplayMessages();
   EventLoop* event_loop_{};
-  FILE* replay_out_file_{};
-  size_t replay_bytes_written_{};
+  ReplayWriter replay_writer_;
   bool writing_replay_{};
   bool replays_broken_{};
-  std::list<std::vector<uint8_t> > replay_messages_;
-  size_t replay_message_bytes_{};
   Timer* process_timer_{};
   std::vector<Object::Ref<Asset>*> pending_preloads_;
   std::vector<Object::Ref<Asset>*> pending_preloads_audio_;
@@ -0,0 +1,254 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/assets/audio_cache_archive.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if BA_OSTYPE_WINDOWS
+#include <io.h>
+#include <sys/locking.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "ballistica/base/base.h"
+#include "ballistica/core/platform/core_platform.h"
+
+namespace ballistica::base {
+
+// File layout: kArchiveMagic, then records, each being a RecordHeader_
+// followed by its data padded out to a multiple of 8 bytes. Values are
+// written in host byte order; caches are never shared between machines.
+static const char kArchiveMagic[8] = {'B', 'A', 'A', 'U', 'D', 'C', '0', '2'};
+static const uint32_t kRecordMagic{0x44435541};  // "AUCD"
+
+// Once we hit this we stop adding to the archive and start over next launch
+// (it accumulates dead entries as sounds change between versions).
+static const size_t kMaxArchiveSize{256 * 1024 * 1024};
+
+struct RecordHeader_ {
+  uint32_t magic;
+  uint32_t size;
+  uint64_t hash;
+  uint64_t source_size;
+  int32_t format;
+  int32_t freq;
+  uint64_t checksum;  // Hash() of the record's data.
+};
+static_assert(sizeof(RecordHeader_) == 40);
+
+static auto PaddedSize_(size_t size) -> size_t { return (size + 7) & ~7ull; }
+
+// Take an exclusive, non-blocking lock on an open file; held until the
+// process exits.
+static auto LockFile_(FILE* file) -> bool {
+#if BA_OSTYPE_WINDOWS
+  fseek(file, 0, SEEK_SET);
+  return _locking(_fileno(file), _LK_NBLCK, 1) == 0;
+#else
+  return flock(fileno(file), LOCK_EX | LOCK_NB) == 0;
+#endif
+}
+
+auto AudioCacheArchive::Get() -> AudioCacheArchive* {
+  // Intentionally leaked; handed out data may be in use until exit.
+  static auto* archive = new AudioCacheArchive();
+  return archive;
+}
+
+auto AudioCacheArchive::Hash(const void* data, size_t size) -> uint64_t {
+  // FNV-1a, taking a word at a time.
+  auto* bytes = static_cast<const uint8_t*>(data);
+  uint64_t hash = 14695981039346656037ull;
+  size_t i{};
+  for (; i + 8 <= size; i += 8) {
+    uint64_t word;
+    memcpy(&word, bytes + i, sizeof(word));
+    hash = (hash ^ word) * 1099511628211ull;
+  }
+  for (; i < size; ++i) {
+    hash = (hash ^ bytes[i]) * 1099511628211ull;
+  }
+  return hash;
+}
+
+AudioCacheArchive::AudioCacheArchive() {
+  std::string dir =
+      g_core->platform->GetVolatileDataDirectory() + BA_DIRSLASH + "audiocache";
+  g_core->platform->MakeDir(dir);
+  path_ = dir + BA_DIRSLASH + "decoded.bacache";
+
+  // Only one process at a time gets the archive; another one appending or
+  // starting over underneath us would corrupt it. Any others simply go
+  // without. The lock lives in a file of its own since the archive itself
+  // gets replaced when we start over.
+  lock_file_ = g_core->platform->FOpen((path_ + ".lock").c_str(), "a+b");
+  if (lock_file_ == nullptr || !LockFile_(lock_file_)) {
+    return;
+  }
+
+  // We only ever append, but read from anywhere.
+  file_ = g_core->platform->FOpen(path_.c_str(), "a+b");
+  if (file_ == nullptr) {
+    Log(LogLevel::kWarning,
+        "Unable to open audio cache archive '" + path_ + "'.");
+    return;
+  }
+  fseek(file_, 0, SEEK_END);
+  auto file_size = static_cast<size_t>(ftell(file_));
+  if (file_size < kMaxArchiveSize && ReadIndex_(file_size)) {
+    MapFile_(file_size);
+    return;
+  }
+
+  // Empty, broken (a crash mid-write, most likely), or too big; start over.
+  index_.clear();
+  if (file_size > 0) {
+    fclose(file_);
+    g_core->platform->Unlink(path_.c_str());
+    file_ = g_core->platform->FOpen(path_.c_str(), "a+b");
+    if (file_ == nullptr) {
+      return;
+    }
+  }
+  if (fwrite(kArchiveMagic, sizeof(kArchiveMagic), 1, file_) != 1
+      || fflush(file_) != 0) {
+    fclose(file_);
+    file_ = nullptr;
+  }
+}
+
+auto AudioCacheArchive::ReadIndex_(size_t file_size) -> bool {
+  char magic[sizeof(kArchiveMagic)];
+  fseek(file_, 0, SEEK_SET);
+  if (fread(magic, sizeof(magic), 1, file_) != 1
+      || memcmp(magic, kArchiveMagic, sizeof(magic)) != 0) {
+    return false;
+  }
+  size_t offset = sizeof(kArchiveMagic);
+  while (offset < file_size) {
+    RecordHeader_ header{};
+    if (offset + sizeof(header) > file_size
+        || fseek(file_, static_cast<long>(offset), SEEK_SET) != 0  // NOLINT
+        || fread(&header, sizeof(header), 1, file_) != 1
+        || header.magic != kRecordMagic) {
+      return false;
+    }
+    size_t data_offset = offset + sizeof(header);
+    if (data_offset + header.size > file_size) {
+      return false;
+    }
+    index_[header.hash] = {header.source_size, data_offset, header.checksum,
+                           header.size, header.format, header.freq};
+    offset = data_offset + PaddedSize_(header.size);
+  }
+  return true;
+}
+
+void AudioCacheArchive::MapFile_(size_t size) {
+#if !BA_OSTYPE_WINDOWS
+  int fd = open(path_.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return;
+  }
+  void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map != MAP_FAILED) {
+    map_ = static_cast<const char*>(map);
+    map_size_ = size;
+  }
+#endif
+  // Otherwise everything gets read through our file.
+}
+
+auto AudioCacheArchive::Find(uint64_t hash, uint64_t source_size,
+                             Entry* entry, std::vector<char>* storage)
+    -> bool {
+  std::scoped_lock lock(mutex_);
+  auto i = index_.find(hash);
+  if (i == index_.end() || i->second.source_size != source_size) {
+    return false;
+  }
+  auto& record{i->second};
+  if (record.offset + record.size <= map_size_) {
+    entry->data = map_ + record.offset;
+  } else {
+    if (file_ == nullptr) {
+      return false;
+    }
+    storage->resize(record.size);
+    if (fseek(file_, static_cast<long>(record.offset), SEEK_SET)  // NOLINT
+            != 0
+        || fread(storage->data(), record.size, 1, file_) != 1) {
+      return false;
+    }
+    entry->data = storage->data();
+  }
+
+  // Catch records that got damaged on disk after they were written.
+  if (Hash(entry->data, record.size) != record.checksum) {
+    index_.erase(i);
+    return false;
+  }
+  entry->size = record.size;
+  entry->format = record.format;
+  entry->freq = record.freq;
+  return true;
+}
+
+void AudioCacheArchive::Add(uint64_t hash, uint64_t source_size,
+                            const Entry& entry) {
+  std::scoped_lock lock(mutex_);
+  if (file_ == nullptr || index_.find(hash) != index_.end()) {
+    return;
+  }
+  if (entry.size > UINT32_MAX) {
+    return;
+  }
+
+  // Find() may have just read from the stream; a positioning call is
+  // required between a read and a write on the same stream. Take our
+  // offset from the actual end of the file too.
+  long end{-1};  // NOLINT
+  if (fseek(file_, 0, SEEK_END) == 0) {
+    end = ftell(file_);
+  }
+  if (end < 0) {
+    return;
+  }
+  auto record_offset = static_cast<size_t>(end);
+  size_t padded_size = PaddedSize_(entry.size);
+  if (record_offset + sizeof(RecordHeader_) + padded_size > kMaxArchiveSize) {
+    return;
+  }
+  RecordHeader_ header{kRecordMagic,
+                       static_cast<uint32_t>(entry.size),
+                       hash,
+                       source_size,
+                       entry.format,
+                       entry.freq,
+                       Hash(entry.data, entry.size)};
+  static const char kPadding[8]{};
+
+  if (fwrite(&header, sizeof(header), 1, file_) != 1
+      || fwrite(entry.data, entry.size, 1, file_) != 1
+      || (padded_size > entry.size
+          && fwrite(kPadding, padded_size - entry.size, 1, file_) != 1)
+      || fflush(file_) != 0) {
+    // We've likely left a partial record; it'll get caught next launch
+    // and we'll start over then.
+    Log(LogLevel::kWarning, "Error writing audio cache archive: "
+                                + g_core->platform->GetErrnoString());
+    fclose(file_);
+    file_ = nullptr;
+    return;
+  }
+  index_[hash] = {source_size, record_offset + sizeof(header), header.checksum,
+                  header.size, entry.format, entry.freq};
+}
+
+}  // namespace ballistica::base
@@ -0,0 +1,73 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_ASSETS_AUDIO_CACHE_ARCHIVE_H_
+#define BALLISTICA_BASE_ASSETS_AUDIO_CACHE_ARCHIVE_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ballistica::base {
+
+/// A single-file archive of decoded sound data.
+///
+/// Entries are keyed by a hash of the source ogg's contents (and its size)
+/// instead of its name and mod time, so they can never go stale and
+/// survive reinstalls and renames. The archive is indexed once on first use
+/// and memory-mapped where possible, so hits hand out pointers straight
+/// into the mapping with no file reads or copies. Newly decoded sounds get
+/// appended to the end. Each record carries a checksum of its data that is
+/// verified on lookup. Only one process uses the archive at a time. Safe to
+/// use from any thread.
+class AudioCacheArchive {
+ public:
+  struct Entry {
+    const char* data{};
+    size_t size{};
+    int32_t format{};
+    int32_t freq{};
+  };
+
+  /// Return the shared archive, opening it if need be.
+  static auto Get() -> AudioCacheArchive*;
+
+  /// Hash used to key source data.
+  static auto Hash(const void* data, size_t size) -> uint64_t;
+
+  /// Look up decoded data for a source. Data for entries added since the
+  /// archive was opened is read into the provided storage; otherwise it
+  /// points into our mapping, which lives for the life of the process.
+  auto Find(uint64_t hash, uint64_t source_size, Entry* entry,
+            std::vector<char>* storage) -> bool;
+
+  /// Add decoded data for a source.
+  void Add(uint64_t hash, uint64_t source_size, const Entry& entry);
+
+ private:
+  struct Record_ {
+    uint64_t source_size;
+    uint64_t offset;
+    uint64_t checksum;
+    uint32_t size;
+    int32_t format;
+    int32_t freq;
+  };
+  AudioCacheArchive();
+  auto ReadIndex_(size_t file_size) -> bool;
+  void MapFile_(size_t size);
+
+  std::mutex mutex_;
+  std::string path_;
+  FILE* lock_file_{};
+  FILE* file_{};
+  const char* map_{};
+  size_t map_size_{};
+  std::unordered_map<uint64_t, Record_> index_;
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_ASSETS_AUDIO_CACHE_ARCHIVE_H_
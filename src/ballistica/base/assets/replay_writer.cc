@@ -0,0 +1,342 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/assets/replay_writer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#if BA_OSTYPE_WINDOWS
+#include <io.h>
+#else
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+#include "ballistica/base/base.h"
+#include "ballistica/base/support/huffman.h"
+#include "ballistica/core/platform/core_platform.h"
+
+namespace ballistica::base {
+
+// Hard cap on block memory (64 blocks of 64k; 4 megs).
+static const size_t kMaxReplayBlocks{64};
+
+// How long Add() will wait on the disk for a free block before giving up
+// on the replay.
+static const int kMaxReplayStallMillisecs{500};
+
+// Sync to disk after this many block writes (and at close).
+static const uint64_t kReplayBlocksPerSync{16};
+
+ReplayWriter::ReplayWriter() = default;
+
+ReplayWriter::~ReplayWriter() {
+  if (thread_) {
+    {
+      std::scoped_lock lock(mutex_);
+      shutting_down_ = true;
+    }
+    jobs_cv_.notify_one();
+    thread_->join();
+  }
+  for (auto* block : free_blocks_) {
+    delete block;
+  }
+}
+
+auto ReplayWriter::Begin(const std::string& path, uint16_t protocol_version)
+    -> bool {
+  assert(file_ == nullptr);
+  if (!thread_) {
+    thread_ = std::make_unique<std::thread>([this] { RunThread_(); });
+  }
+
+  // Secure a block before creating the file so we never leave an empty,
+  // header-less replay behind.
+  if (!AcquireBlocks_(1, true)) {
+    Log(LogLevel::kError, "Replay writer has no free blocks; skipping replay.");
+    return false;
+  }
+  FILE* file = g_core->platform->FOpen(path.c_str(), "wb");
+  if (file == nullptr) {
+    ReleaseReservedBlocks_();
+    return false;
+  }
+  file_ = new File_();
+  file_->file = file;
+  block_ = reserved_blocks_.back();
+  reserved_blocks_.pop_back();
+
+  // File id and protocol-version. NOTE: We always write replays in our
+  // host protocol version no matter what the client stream is.
+  uint32_t file_id = kBrpFileID;
+  uint8_t header[sizeof(file_id) + sizeof(protocol_version)];
+  memcpy(header, &file_id, sizeof(file_id));
+  memcpy(header + sizeof(file_id), &protocol_version,
+         sizeof(protocol_version));
+  {
+    std::scoped_lock lock(mutex_);
+    stats_.backlog_bytes += sizeof(header);
+  }
+  Append_(header, sizeof(header));
+  return true;
+}
+
+auto ReplayWriter::Add(const std::vector<uint8_t>& message) -> bool {
+  if (file_ == nullptr) {
+    return false;
+  }
+  if (file_->failed) {
+    // The disk thread has already complained; just wind things down.
+    Close_();
+    return false;
+  }
+  std::vector<uint8_t> data_compressed = g_base->huffman->compress(message);
+
+  // If message length is < 254, write length as one byte. If its between
+  // 254 and 65535, write 254 and then 2 length bytes; otherwise write 255
+  // and then 4 length bytes.
+  auto len32 = static_cast<uint32_t>(data_compressed.size());
+  uint8_t prefix[5];
+  size_t prefix_size;
+  if (len32 < 254) {
+    prefix[0] = static_cast_check_fit<uint8_t>(len32);
+    prefix_size = 1;
+  } else if (len32 <= 65535) {
+    auto len16 = static_cast_check_fit<uint16_t>(len32);
+    prefix[0] = 254;
+    memcpy(prefix + 1, &len16, sizeof(len16));
+    prefix_size = 3;
+  } else {
+    prefix[0] = 255;
+    memcpy(prefix + 1, &len32, sizeof(len32));
+    prefix_size = 5;
+  }
+  size_t record_size = prefix_size + data_compressed.size();
+
+  // Line up a fresh block for each one this record will fill before
+  // writing any of it, so a cut-off replay always ends on a whole message.
+  size_t blocks_filled = (block_->size + record_size) / kBlockSize;
+  if (blocks_filled > 0 && !AcquireBlocks_(blocks_filled, true)) {
+    Log(LogLevel::kError,
+        "Replay output fell too far behind the disk; cutting off replay.");
+    {
+      std::scoped_lock lock(mutex_);
+      stats_.replays_cut_off++;
+    }
+    Close_();
+    return false;
+  }
+  {
+    std::scoped_lock lock(mutex_);
+    stats_.backlog_bytes += record_size;
+    stats_.peak_backlog_bytes =
+        std::max(stats_.peak_backlog_bytes, stats_.backlog_bytes);
+  }
+  Append_(prefix, prefix_size);
+  Append_(data_compressed.data(), data_compressed.size());
+  return true;
+}
+
+void ReplayWriter::Flush() {
+  if (file_ == nullptr || block_->size == 0) {
+    return;
+  }
+  // Never wait here; if nothing is free the disk is behind anyway.
+  if (AcquireBlocks_(1, false)) {
+    SubmitBlock_();
+  }
+}
+
+void ReplayWriter::End() {
+  if (file_ != nullptr) {
+    Close_();
+  }
+}
+
+auto ReplayWriter::stats() -> Stats {
+  std::scoped_lock lock(mutex_);
+  return stats_;
+}
+
+void ReplayWriter::Append_(const uint8_t* data, size_t size) {
+  while (size > 0) {
+    size_t amount = std::min(size, kBlockSize - block_->size);
+    memcpy(block_->data + block_->size, data, amount);
+    block_->size += amount;
+    data += amount;
+    size -= amount;
+    if (block_->size == kBlockSize) {
+      SubmitBlock_();
+    }
+  }
+}
+
+auto ReplayWriter::AcquireBlocks_(size_t count, bool wait) -> bool {
+  if (count > kMaxReplayBlocks) {
+    return false;
+  }
+  std::unique_lock lock(mutex_);
+  auto deadline = std::chrono::steady_clock::now()
+                  + std::chrono::milliseconds(kMaxReplayStallMillisecs);
+  bool stalled{};
+  while (reserved_blocks_.size() < count) {
+    if (!free_blocks_.empty()) {
+      reserved_blocks_.push_back(free_blocks_.back());
+      free_blocks_.pop_back();
+    } else if (block_count_ < kMaxReplayBlocks) {
+      reserved_blocks_.push_back(new Block_);
+      block_count_++;
+      stats_.pool_bytes += sizeof(Block_);
+    } else if (wait) {
+      if (!stalled) {
+        stalled = true;
+        stats_.stalls++;
+      }
+      if (!free_cv_.wait_until(lock, deadline,
+                               [this] { return !free_blocks_.empty(); })) {
+        return false;
+      }
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ReplayWriter::ReleaseReservedBlocks_() {
+  {
+    std::scoped_lock lock(mutex_);
+    for (auto* block : reserved_blocks_) {
+      free_blocks_.push_back(block);
+    }
+  }
+  reserved_blocks_.clear();
+  free_cv_.notify_all();
+}
+
+void ReplayWriter::SubmitBlock_() {
+  assert(!reserved_blocks_.empty());
+  {
+    std::scoped_lock lock(mutex_);
+    jobs_.push_back({file_, block_, false});
+  }
+  jobs_cv_.notify_one();
+  block_ = reserved_blocks_.back();
+  reserved_blocks_.pop_back();
+}
+
+void ReplayWriter::Close_() {
+  assert(file_);
+  {
+    std::scoped_lock lock(mutex_);
+    if (block_ != nullptr && block_->size > 0) {
+      jobs_.push_back({file_, block_, false});
+    } else if (block_ != nullptr) {
+      free_blocks_.push_back(block_);
+    }
+    for (auto* block : reserved_blocks_) {
+      free_blocks_.push_back(block);
+    }
+    reserved_blocks_.clear();
+    jobs_.push_back({file_, nullptr, true});
+  }
+  jobs_cv_.notify_one();
+  free_cv_.notify_all();
+  file_ = nullptr;
+  block_ = nullptr;
+}
+
+void ReplayWriter::RunThread_() {
+  g_core->platform->SetCurrentThreadName("ballistica replay writer");
+  std::unique_lock lock(mutex_);
+  while (true) {
+    jobs_cv_.wait(lock, [this] { return !jobs_.empty() || shutting_down_; });
+    if (jobs_.empty()) {
+      break;
+    }
+    Job_ job = jobs_.front();
+    jobs_.pop_front();
+    lock.unlock();
+    if (job.block != nullptr) {
+      if (!job.file->failed) {
+        WriteBlock_(job.file, job.block);
+      }
+    } else if (job.close) {
+      if (!job.file->failed) {
+        Sync_(job.file);
+      }
+      fclose(job.file->file);
+      delete job.file;
+    }
+    lock.lock();
+    if (job.block != nullptr) {
+      stats_.backlog_bytes -= job.block->size;
+      job.block->size = 0;
+      free_blocks_.push_back(job.block);
+      free_cv_.notify_all();
+    }
+  }
+}
+
+void ReplayWriter::WriteBlock_(File_* file, Block_* block) {
+  microsecs_t start_time = core::CorePlatform::GetCurrentMicrosecs();
+  bool success{true};
+#if BA_OSTYPE_WINDOWS
+  success = fwrite(block->data, block->size, 1, file->file) == 1
+            && fflush(file->file) == 0;
+#else
+  // One write per block; we only loop on the rare short write.
+  int fd = fileno(file->file);
+  size_t offset{};
+  while (offset < block->size) {
+    ssize_t result = write(fd, block->data + offset, block->size - offset);
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      success = false;
+      break;
+    }
+    offset += static_cast<size_t>(result);
+  }
+#endif
+  microsecs_t write_time =
+      core::CorePlatform::GetCurrentMicrosecs() - start_time;
+  if (!success) {
+    Log(LogLevel::kError,
+        "error writing replay file: " + g_core->platform->GetErrnoString());
+    file->failed = true;
+    return;
+  }
+  {
+    std::scoped_lock lock(mutex_);
+    stats_.bytes_written += block->size;
+    stats_.blocks_written++;
+    stats_.last_write_time = write_time;
+    stats_.max_write_time = std::max(stats_.max_write_time, write_time);
+    stats_.total_write_time += write_time;
+  }
+  if (++file->blocks_since_sync >= kReplayBlocksPerSync) {
+    Sync_(file);
+  }
+}
+
+void ReplayWriter::Sync_(File_* file) {
+  microsecs_t start_time = core::CorePlatform::GetCurrentMicrosecs();
+#if BA_OSTYPE_WINDOWS
+  _commit(_fileno(file->file));
+#else
+  fsync(fileno(file->file));
+#endif
+  microsecs_t sync_time =
+      core::CorePlatform::GetCurrentMicrosecs() - start_time;
+  file->blocks_since_sync = 0;
+  std::scoped_lock lock(mutex_);
+  stats_.syncs++;
+  stats_.max_sync_time = std::max(stats_.max_sync_time, sync_time);
+}
+
+}  // namespace ballistica::base
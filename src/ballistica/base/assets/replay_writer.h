@@ -0,0 +1,114 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_ASSETS_REPLAY_WRITER_H_
+#define BALLISTICA_BASE_ASSETS_REPLAY_WRITER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ballistica/shared/foundation/types.h"
+
+namespace ballistica::base {
+
+/// Streams replay messages to disk with bounded memory.
+///
+/// Messages are compressed and length-prefixed as they arrive, straight
+/// into fixed-size blocks drawn from a pool. Full blocks go to a disk
+/// thread which writes each with a single call and syncs the file
+/// periodically, so the caller never waits on the disk. The pool is
+/// capped; if the disk falls so far behind that no block frees up within
+/// a short grace period, the replay is cut off at the last whole message
+/// (dropping individual messages would corrupt the stream). Begin(), Add()
+/// and End() must all be called from one thread; stats() from any.
+class ReplayWriter {
+ public:
+  struct Stats {
+    /// Bytes accepted but not yet written.
+    size_t backlog_bytes{};
+    size_t peak_backlog_bytes{};
+    /// Memory held by the block pool.
+    size_t pool_bytes{};
+    uint64_t bytes_written{};
+    uint64_t blocks_written{};
+    microsecs_t last_write_time{};
+    microsecs_t max_write_time{};
+    microsecs_t total_write_time{};
+    uint64_t syncs{};
+    microsecs_t max_sync_time{};
+    /// Times Add() had to wait on the disk for a free block.
+    uint64_t stalls{};
+    uint64_t replays_cut_off{};
+  };
+
+  ReplayWriter();
+  ~ReplayWriter();
+
+  /// Start a new replay file; returns false if it can't be opened or no
+  /// block memory frees up in time.
+  auto Begin(const std::string& path, uint16_t protocol_version) -> bool;
+
+  /// Add a message to the replay. Returns false if the replay has been cut
+  /// off or failed; further adds are ignored in that case.
+  auto Add(const std::vector<uint8_t>& message) -> bool;
+
+  /// Hand off any partially filled block so it reaches the disk soon.
+  void Flush();
+
+  /// Finish the replay. The file is written out and closed in the
+  /// background.
+  void End();
+
+  auto stats() -> Stats;
+
+ private:
+  static constexpr size_t kBlockSize{64 * 1024};
+  struct Block_ {
+    uint8_t data[kBlockSize];
+    size_t size{};
+  };
+  struct File_ {
+    FILE* file{};
+    std::atomic<bool> failed{};
+    uint64_t blocks_since_sync{};
+  };
+  struct Job_ {
+    File_* file{};
+    Block_* block{};
+    bool close{};
+  };
+  void Append_(const uint8_t* data, size_t size);
+  auto AcquireBlocks_(size_t count, bool wait) -> bool;
+  void ReleaseReservedBlocks_();
+  void SubmitBlock_();
+  void Close_();
+  void RunThread_();
+  void WriteBlock_(File_* file, Block_* block);
+  void Sync_(File_* file);
+
+  std::mutex mutex_;
+  std::condition_variable jobs_cv_;
+  std::condition_variable free_cv_;
+  std::unique_ptr<std::thread> thread_;
+  std::deque<Job_> jobs_;
+  std::vector<Block_*> free_blocks_;
+  size_t block_count_{};
+  Stats stats_;
+  bool shutting_down_{};
+
+  // Only touched by the calling thread.
+  File_* file_{};
+  Block_* block_{};
+  std::vector<Block_*> reserved_blocks_;
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_ASSETS_REPLAY_WRITER_H_
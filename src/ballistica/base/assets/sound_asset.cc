@@ -2,7 +2,11 @@
 
 #include "ballistica/base/assets/sound_asset.h"
 
+#include <algorithm>
+#include <cstdio>
 #include <cstring>
+#include <mutex>
+#include <string>
 
 #if BA_ENABLE_AUDIO
 #if BA_USE_TREMOR_VORBIS
@@ -13,6 +17,7 @@
 #endif  // BA_ENABLE_AUDIO
 
 #include "ballistica/base/assets/assets.h"
+#include "ballistica/base/assets/audio_cache_archive.h"
 #include "ballistica/base/audio/audio_server.h"
 #include "ballistica/base/python/base_python.h"
 #include "ballistica/core/core.h"
@@ -25,6 +30,35 @@
 
 namespace ballistica::base {
 
+// Times for non-streamed sound loads, split by whether they came from our
+// cache archive.
+struct SoundLoadStats {
+  std::mutex mutex;
+  int64_t cached_loads{};
+  int64_t decoded_loads{};
+  microsecs_t cached_time{};
+  microsecs_t decoded_time{};
+};
+
+static auto GetSoundLoadStats() -> SoundLoadStats& {
+  static auto* stats = new SoundLoadStats();
+  return *stats;
+}
+
+[[maybe_unused]] static void RecordSoundLoad(bool cached,
+                                             microsecs_t start_time) {
+  auto duration = g_core->GetAppTimeMicrosecs() - start_time;
+  auto& stats{GetSoundLoadStats()};
+  std::scoped_lock lock(stats.mutex);
+  if (cached) {
+    stats.cached_loads++;
+    stats.cached_time += duration;
+  } else {
+    stats.decoded_loads++;
+    stats.decoded_time += duration;
+  }
+}
+
 #if BA_ENABLE_AUDIO
 
 const int kReadBufferSize = 32768;  // 32 KB buffers
@@ -45,14 +79,119 @@ static long CallbackTell(void* data_source) {  // NOLINT (vorbis uses long)
   return ftell(static_cast<FILE*>(data_source));
 }
 
+// Memory data source for decoding.
+struct OggMemSource {
+  const char* data;
+  size_t size;
+  size_t pos;
+};
+
+static auto MemCallbackRead(void* ptr, size_t size, size_t nmemb,
+                            void* data_source) -> size_t {
+  auto* source = static_cast<OggMemSource*>(data_source);
+  if (size == 0) {
+    return 0;
+  }
+  size_t count = std::min(nmemb, (source->size - source->pos) / size);
+  memcpy(ptr, source->data + source->pos, count * size);
+  source->pos += count * size;
+  return count;
+}
+static auto MemCallbackSeek(void* data_source, ogg_int64_t offset,
+                            int whence) -> int {
+  auto* source = static_cast<OggMemSource*>(data_source);
+  ogg_int64_t base;
+  switch (whence) {
+    case SEEK_SET:
+      base = 0;
+      break;
+    case SEEK_CUR:
+      base = static_cast<ogg_int64_t>(source->pos);
+      break;
+    case SEEK_END:
+      base = static_cast<ogg_int64_t>(source->size);
+      break;
+    default:
+      return -1;
+  }
+  if (base + offset < 0
+      || base + offset > static_cast<ogg_int64_t>(source->size)) {
+    return -1;
+  }
+  source->pos = static_cast<size_t>(base + offset);
+  return 0;
+}
+static auto MemCallbackClose(void* data_source) -> int { return 0; }
+static long MemCallbackTell(void* data_source) {  // NOLINT (vorbis uses long)
+  return static_cast<long>(  // NOLINT
+      static_cast<OggMemSource*>(data_source)->pos);
+}
+
+// Decode an opened ogg file in its entirety (and clear it). Returns false
+// if the data turned out to be corrupt.
+static auto DecodeOgg(OggVorbis_File* ogg_file, std::vector<char>* buffer,
+                      ALenum* format, ALsizei* freq) -> bool {
+  int bit_stream;
+  int bytes;
+  char array[kReadBufferSize];  // Local fixed size array
+
+  // Get some information about the OGG file.
+  vorbis_info* p_info = ov_info(ogg_file, -1);
+
+  // Check the number of channels. Always use 16-bit samples.
+  if (p_info->channels == 1) {
+    (*format) = AL_FORMAT_MONO16;
+  } else {
+    (*format) = AL_FORMAT_STEREO16;
+  }
+
+  // The frequency of the sampling rate.
+  (*freq) = static_cast<ALsizei>(p_info->rate);
+
+  bool corrupt = false;
+
+  // Keep reading until all is read.
+  do {
+    // Read up to a buffer's worth of decoded sound data.
+#if BA_USE_TREMOR_VORBIS
+    bytes = static_cast<int>(
+        ov_read(ogg_file, array, kReadBufferSize, &bit_stream));
+#else
+    bytes = static_cast<int>(
+        ov_read(ogg_file, array, kReadBufferSize, 0, 2, 1, &bit_stream));
+#endif
+
+    // If something went wrong in the decode, just spit out an empty sound and
+    // an error message that the user should re-install.
+    if (bytes < 0) {
+      corrupt = true;
+      break;
+    }
+
+    // Append to end of buffer
+    buffer->insert(buffer->end(), array, array + bytes);
+  } while (bytes > 0);
+
+  // Clean up!
+  ov_clear(ogg_file);
+
+  if (corrupt) {
+    static bool reported_corrupt = false;
+    if (!reported_corrupt) {
+      reported_corrupt = true;
+      g_base->python->objs().PushCall(
+          BasePython::ObjID::kPrintCorruptFileErrorCall);
+    }
+    (*buffer) = std::vector<char>(32 * 100, 0);
+  }
+  return !corrupt;
+}
+
 // This function loads a .ogg file into a memory buffer and returns
 // the format and frequency.  return value is true on success or false if a
 // fallback was used
 static auto LoadOgg(const char* file_name, std::vector<char>* buffer,
                     ALenum* format, ALsizei* freq) -> bool {
-  int bit_stream;
-  int bytes;
-  char array[kReadBufferSize];  // Local fixed size array
   FILE* f;
   bool fallback = false;
 
@@ -71,7 +210,6 @@ static auto LoadOgg(const char* file_name, std::vector<char>* buffer,
                       + file_name + "' for reading...");
   }
 
-  vorbis_info* p_info;
   OggVorbis_File ogg_file;
   ov_callbacks callbacks;
   callbacks.read_func = CallbackRead;
@@ -99,56 +237,7 @@ static auto LoadOgg(const char* file_name, std::vector<char>* buffer,
                       + file_name + "'");
   }
 
-  // Get some information about the OGG file.
-  p_info = ov_info(&ogg_file, -1);
-
-  // Check the number of channels. Always use 16-bit samples.
-  if (p_info->channels == 1) {
-    (*format) = AL_FORMAT_MONO16;
-  } else {
-    (*format) = AL_FORMAT_STEREO16;
-  }
-
-  // The frequency of the sampling rate.
-  (*freq) = static_cast<ALsizei>(p_info->rate);
-
-  bool corrupt = false;
-
-  // Keep reading until all is read.
-  do {
-    // Read up to a buffer's worth of decoded sound data.
-#if BA_USE_TREMOR_VORBIS
-    bytes = static_cast<int>(
-        ov_read(&ogg_file, array, kReadBufferSize, &bit_stream));
-#else
-    bytes = static_cast<int>(
-        ov_read(&ogg_file, array, kReadBufferSize, 0, 2, 1, &bit_stream));
-#endif
-
-    // If something went wrong in the decode, just spit out an empty sound and
-    // an error message that the user should re-install.
-    if (bytes < 0) {
-      corrupt = true;
-      ov_clear(&ogg_file);
-      break;
-    }
-
-    // Append to end of buffer
-    buffer->insert(buffer->end(), array, array + bytes);
-  } while (bytes > 0);
-
-  // Clean up!
-  ov_clear(&ogg_file);
-
-  if (corrupt) {
-    static bool reported_corrupt = false;
-    if (!reported_corrupt) {
-      reported_corrupt = true;
-      g_base->python->objs().PushCall(
-          BasePython::ObjID::kPrintCorruptFileErrorCall);
-    }
-    (*buffer) = std::vector<char>(32 * 100, 0);
-  }
+  DecodeOgg(&ogg_file, buffer, format, freq);
 
   if ((*buffer).empty()) {
     throw Exception(std::string("Error: got zero-length buffer from ogg-file '")
@@ -157,92 +246,87 @@ static auto LoadOgg(const char* file_name, std::vector<char>* buffer,
   return !fallback;
 }
 
-static void LoadCachedOgg(const char* file_name, std::vector<char>* buffer,
-                          ALenum* format, ALsizei* freq) {
-  std::string sound_cache_dir =
-      g_core->platform->GetVolatileDataDirectory() + BA_DIRSLASH + "audiocache";
-  static bool made_sound_cache_dir = false;
-  if (!made_sound_cache_dir) {
-    g_core->platform->MakeDir(sound_cache_dir);
-    made_sound_cache_dir = true;
-  }
-  std::vector<char> b(strlen(file_name) + 1);
-  memcpy(b.data(), file_name, b.size());
-  for (char* c = &b[0]; *c != 0; c++) {
-    if ((*c) == '/') *c = '_';
-  }
-  std::string cache_file_name = sound_cache_dir + "/" + &b[0] + ".cache";
-
-  // If we have a cache file and it matches the mod time on the ogg, attempt to
-  // load it.
-  struct BA_STAT stat_ogg {};
-  time_t ogg_mod_time = 0;
-  if (g_core->platform->Stat(file_name, &stat_ogg) == 0) {
-    ogg_mod_time = stat_ogg.st_mtime;
+static auto ReadFileData(const char* file_name, std::vector<char>* data)
+    -> bool {
+  FILE* f = g_core->platform->FOpen(file_name, "rb");
+  if (f == nullptr) {
+    return false;
   }
-  FILE* f_cache = g_core->platform->FOpen(cache_file_name.c_str(), "rb");
-  if (f_cache && ogg_mod_time != 0) {
-    bool got_cache = false;
-    time_t cache_mod_time;
-    if (fread(&cache_mod_time, sizeof(cache_mod_time), 1, f_cache) == 1) {
-      if (cache_mod_time == ogg_mod_time) {
-        if (fread(&(*format), sizeof((*format)), 1, f_cache) == 1) {
-          if (fread(&(*freq), sizeof((*freq)), 1, f_cache) == 1) {
-            uint32_t buffer_size;
-            if (fread(&buffer_size, sizeof(buffer_size), 1, f_cache) == 1) {
-              (*buffer).resize(buffer_size);
-              if (fread(&(*buffer)[0], buffer_size, 1, f_cache) == 1) {
-                got_cache = true;
-              }
-            }
-          }
-        }
-      }
+  bool success = false;
+  if (fseek(f, 0, SEEK_END) == 0) {
+    long size = ftell(f);  // NOLINT
+    if (size > 0 && fseek(f, 0, SEEK_SET) == 0) {
+      data->resize(static_cast<size_t>(size));
+      success = (fread(data->data(), data->size(), 1, f) == 1);
     }
-    fclose(f_cache);
-    if (got_cache) {
+  }
+  fclose(f);
+  return success;
+}
+
+// Load decoded data for an ogg file, going through our cache archive. On
+// return, data/size point at the decoded data, which lives either in the
+// archive's memory-mapping or in buffer.
+static void LoadCachedOgg(const char* file_name, std::vector<char>* buffer,
+                          const char** data, size_t* size, ALenum* format,
+                          ALsizei* freq) {
+  auto start_time = g_core->GetAppTimeMicrosecs();
+  auto* archive = AudioCacheArchive::Get();
+
+  std::vector<char> ogg;
+  if (ReadFileData(file_name, &ogg)) {
+    uint64_t hash = AudioCacheArchive::Hash(ogg.data(), ogg.size());
+    AudioCacheArchive::Entry entry;
+    if (archive->Find(hash, ogg.size(), &entry, buffer)) {
       // At a loss for how this happened, but wound up loading cache files
       // with invalid formats of 0 once. Report and ignore if we see
       // something like that.
-      if (*format != AL_FORMAT_MONO16 && *format != AL_FORMAT_STEREO16) {
+      if (entry.format != AL_FORMAT_MONO16
+          && entry.format != AL_FORMAT_STEREO16) {
         Log(LogLevel::kError, std::string("Ignoring invalid audio cache of ")
                                   + file_name + " with format "
-                                  + std::to_string(*format));
+                                  + std::to_string(entry.format));
       } else {
-        return;  // SUCCESS!!!!
+        *data = entry.data;
+        *size = entry.size;
+        *format = entry.format;
+        *freq = entry.freq;
+        RecordSoundLoad(true, start_time);
+        return;
       }
     }
-  }
 
-  // Ok that didn't work. Load the actual ogg.
-  (*buffer).clear();
-  bool success = LoadOgg(file_name, buffer, format, freq);
-
-  // If the load went cleanly, attempt to write a cache file.
-  if (success) {
-    FILE* f = g_core->platform->FOpen(cache_file_name.c_str(), "wb");
-    bool success2 = false;
-    if (f) {
-      if (fwrite(&ogg_mod_time, sizeof(ogg_mod_time), 1, f) == 1) {
-        if (fwrite(&(*format), sizeof((*format)), 1, f) == 1) {
-          if (fwrite(&(*freq), sizeof((*freq)), 1, f) == 1) {
-            auto buffer_size = static_cast<uint32_t>((*buffer).size());
-            if (fwrite(&buffer_size, sizeof(buffer_size), 1, f) == 1) {
-              if (fwrite(&(*buffer)[0], buffer_size, 1, f) == 1) {
-                success2 = true;
-              }
-            }
-          }
-        }
+    // Decode straight from the data we already read.
+    OggMemSource source{ogg.data(), ogg.size(), 0};
+    OggVorbis_File ogg_file;
+    ov_callbacks callbacks;
+    callbacks.read_func = MemCallbackRead;
+    callbacks.seek_func = MemCallbackSeek;
+    callbacks.close_func = MemCallbackClose;
+    callbacks.tell_func = MemCallbackTell;
+    buffer->clear();
+    if (ov_open_callbacks(&source, &ogg_file, nullptr, 0, callbacks) == 0) {
+      // Only cache clean decodes.
+      if (DecodeOgg(&ogg_file, buffer, format, freq) && !buffer->empty()) {
+        archive->Add(hash, ogg.size(),
+                     {buffer->data(), buffer->size(), *format, *freq});
       }
-      fclose(f);
-
-      // Attempt to clean up if it looks like something went wrong.
-      if (!success2) {
-        g_core->platform->Unlink(cache_file_name.c_str());
+      if (!buffer->empty()) {
+        *data = buffer->data();
+        *size = buffer->size();
+        RecordSoundLoad(false, start_time);
+        return;
       }
     }
   }
+
+  // Ok that didn't work; go the long way (this handles errors and
+  // fallbacks).
+  buffer->clear();
+  LoadOgg(file_name, buffer, format, freq);
+  *data = buffer->data();
+  *size = buffer->size();
+  RecordSoundLoad(false, start_time);
 }
 
 #endif  // BA_ENABLE_AUDIO
@@ -274,7 +358,8 @@ void SoundAsset::DoPreload() {
     is_streamed_ = true;
   } else if (strstr(file_name_full_.c_str(), ".ogg")) {
     is_streamed_ = false;
-    LoadCachedOgg(file_name_full_.c_str(), &load_buffer_, &format_, &freq_);
+    LoadCachedOgg(file_name_full_.c_str(), &load_buffer_, &load_data_,
+                  &load_data_size_, &format_, &freq_);
   } else {
     throw Exception("Unsupported sound file (needs to end in .ogg): '"
                     + file_name_full_ + "'");
@@ -296,14 +381,17 @@ void SoundAsset::DoLoad() {
     alGenBuffers(1, &buffer_);
     CHECK_AL_ERROR;
 
-    // Preload pulled data into our load-buffer, and send that along to openal.
-    alBufferData(buffer_, format_, &load_buffer_[0],
-                 static_cast<ALsizei>(load_buffer_.size()), freq_);
+    // Preload pulled data into our load-buffer (or found it in the cache
+    // archive); send that along to openal.
+    alBufferData(buffer_, format_, load_data_,
+                 static_cast<ALsizei>(load_data_size_), freq_);
 
     CHECK_AL_ERROR;
 
     // Done with load buffer; clear its used memory.
     std::vector<char>().swap(load_buffer_);
+    load_data_ = nullptr;
+    load_data_size_ = 0;
   }
 
   CHECK_AL_ERROR;
@@ -323,6 +411,31 @@ void SoundAsset::DoUnload() {
 #endif  // BA_ENABLE_AUDIO
 }
 
+auto SoundAsset::GetLoadStatsString(bool reset) -> std::string {
+  auto& stats{GetSoundLoadStats()};
+  std::scoped_lock lock(stats.mutex);
+  auto average = [](microsecs_t time, int64_t count) {
+    return count > 0 ? static_cast<double>(time) / 1000.0
+                           / static_cast<double>(count)
+                     : 0.0;
+  };
+  char buffer[256];
+  snprintf(buffer, sizeof(buffer),
+           "Sound loads: %lld decoded (cold) in %.1fms (%.2fms avg),"
+           " %lld from cache (warm) in %.1fms (%.2fms avg).",
+           static_cast<long long>(stats.decoded_loads),  // NOLINT
+           static_cast<double>(stats.decoded_time) / 1000.0,
+           average(stats.decoded_time, stats.decoded_loads),
+           static_cast<long long>(stats.cached_loads),  // NOLINT
+           static_cast<double>(stats.cached_time) / 1000.0,
+           average(stats.cached_time, stats.cached_loads));
+  if (reset) {
+    stats.cached_loads = stats.decoded_loads = 0;
+    stats.cached_time = stats.decoded_time = 0;
+  }
+  return buffer;
+}
+
 void SoundAsset::UpdatePlayTime() {
   last_play_time_ = g_core->GetAppTimeMillisecs();
 }
@@ -33,6 +33,11 @@ class SoundAsset : public Asset {
   const auto& file_name() const { return file_name_; }
   const auto& file_name_full() const { return file_name_full_; }
   void UpdatePlayTime();
+
+  /// Return a summary of how long sound loads have taken, split by loads
+  /// that had to decode and ones served from the cache. Can be called from
+  /// any thread.
+  static auto GetLoadStatsString(bool reset) -> std::string;
   auto last_play_time() const { return last_play_time_; }
 
  private:
@@ -45,6 +50,9 @@ class SoundAsset : public Asset {
   ALsizei freq_{};
 #endif  // BA_ENABLE_AUDIO
   std::vector<char> load_buffer_;
+  // Decoded data to upload; in either load_buffer_ or the cache archive.
+  const char* load_data_{};
+  size_t load_data_size_{};
   millisecs_t last_play_time_{};
 };
 
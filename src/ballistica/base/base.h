@@ -122,6 +122,7 @@ class TextureAssetRendererData;
 class TouchInput;
 class UI;
 class UIDelegateInterface;
+class ViewFrustum;
 class AppAdapterVR;
 class GraphicsVR;
 
@@ -145,7 +145,11 @@ void BGDynamics::Step(const Vector3f& cam_pos, int step_millisecs) {
 
 void BGDynamics::SetDrawSnapshot(BGDynamicsDrawSnapshot* s) {
   // We were passed a raw pointer; assign it to our unique_ptr which will
-  // take ownership of it and handle disposing it when we get the next one.
+  // take ownership of it. Anything it replaces goes back to the server to
+  // be reused (its matrices have already been copied into frame defs).
+  if (draw_snapshot_) {
+    g_base->bg_dynamics_server->RecycleDrawSnapshot(draw_snapshot_.release());
+  }
   draw_snapshot_ = std::unique_ptr<BGDynamicsDrawSnapshot>(s);
 }
 
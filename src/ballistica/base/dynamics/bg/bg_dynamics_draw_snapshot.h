@@ -42,6 +42,26 @@ class BGDynamicsDrawSnapshot {
     }
   }
 
+  // Prep a recycled snapshot for reuse. Vectors keep their capacity; mesh
+  // buffers are released since the graphics side may still be using them.
+  void Reset() {
+    for (auto* matrices : {&rocks, &ice, &slime, &metal, &sparks, &splinters,
+                           &sweats, &flag_stands}) {
+      matrices->clear();
+    }
+    tendril_shadows.clear();
+    tendril_indices.Clear();
+    tendril_vertices.Clear();
+    fuse_indices.Clear();
+    fuse_vertices.Clear();
+    shadow_indices.Clear();
+    shadow_vertices.Clear();
+    light_indices.Clear();
+    light_vertices.Clear();
+    spark_indices.Clear();
+    spark_vertices.Clear();
+  }
+
   // Particles.
   std::vector<Matrix44f> rocks;
   std::vector<Matrix44f> ice;
@@ -972,17 +972,15 @@ void BGDynamicsServer::UpdateTendrils() {
 
 void BGDynamicsServer::Clear() {
   // Clear chunks.
-  {
-    auto i = chunks_.begin();
-    while (i != chunks_.end()) {
-      delete *i;
-      chunks_.erase(i);
+  for (auto& chunks : chunks_) {
+    for (auto* chunk : chunks) {
+      delete chunk;
       chunk_count_--;
-      i = chunks_.begin();
       assert(chunk_count_ >= 0);
     }
-    assert(chunk_count_ == 0);
+    chunks.clear();
   }
+  assert(chunk_count_ == 0);
 
   // ..and tendrils.
   {
@@ -1204,8 +1202,7 @@ void BGDynamicsServer::Emit(const BGDynamicsEmission& def) {
             chunk->UpdateTendril();
           }
         }
-        chunks_.push_back(chunk);
-        chunk_count_++;
+        AddChunk(chunk);
       }
       break;
     }
@@ -1224,8 +1221,7 @@ void BGDynamicsServer::Emit(const BGDynamicsEmission& def) {
           if (dCollide(ray, t_geom, 1, &contact[0].geom, sizeof(dContact))) {
             // Create a static chunk at this hit point.
             edef.position = Vector3f(contact[0].geom.pos);
-            chunks_.push_back(new Chunk(this, edef, false));
-            chunk_count_++;
+            AddChunk(new Chunk(this, edef, false));
           }
         }
       }
@@ -1343,8 +1339,7 @@ void BGDynamicsServer::Emit(const BGDynamicsEmission& def) {
           BGDynamicsEmission edef = def;
           edef.chunk_type = BGDynamicsChunkType::kFlagStand;
           edef.position = Vector3f(contact[0].geom.pos);
-          chunks_.push_back(new Chunk(this, edef, false, false));
-          chunk_count_++;
+          AddChunk(new Chunk(this, edef, false, false));
           break;
         }
       }
@@ -1494,110 +1489,93 @@ void BGDynamicsServer::PushSetDebrisKillHeightCall(float height) {
   event_loop()->PushCall([this, height] { debris_kill_height_ = height; });
 }
 
+void BGDynamicsServer::AddChunk(Chunk* chunk) {
+  chunks_[static_cast<int>(chunk->type())].push_back(chunk);
+  chunk_count_++;
+}
+
+// Only a few snapshots are ever in flight at once.
+static const size_t kMaxPooledDrawSnapshots{4};
+
+auto BGDynamicsServer::AcquireDrawSnapshot() -> BGDynamicsDrawSnapshot* {
+  {
+    std::scoped_lock lock(draw_snapshot_pool_mutex_);
+    if (!draw_snapshot_pool_.empty()) {
+      auto* ss = draw_snapshot_pool_.back();
+      draw_snapshot_pool_.pop_back();
+      return ss;
+    }
+  }
+  return new BGDynamicsDrawSnapshot();
+}
+
+void BGDynamicsServer::RecycleDrawSnapshot(BGDynamicsDrawSnapshot* snapshot) {
+  assert(snapshot);
+
+  // Drop our mesh-buffer refs here in the calling thread, which owns them.
+  snapshot->Reset();
+  {
+    std::scoped_lock lock(draw_snapshot_pool_mutex_);
+    if (draw_snapshot_pool_.size() < kMaxPooledDrawSnapshots) {
+      draw_snapshot_pool_.push_back(snapshot);
+      return;
+    }
+  }
+  delete snapshot;
+}
+
+static auto ChunkMatrices_(BGDynamicsDrawSnapshot* ss,
+                           BGDynamicsChunkType type)
+    -> std::vector<Matrix44f>* {
+  switch (type) {
+    case BGDynamicsChunkType::kRock:
+      return &ss->rocks;
+    case BGDynamicsChunkType::kIce:
+      return &ss->ice;
+    case BGDynamicsChunkType::kSlime:
+      return &ss->slime;
+    case BGDynamicsChunkType::kMetal:
+      return &ss->metal;
+    case BGDynamicsChunkType::kSpark:
+      return &ss->sparks;
+    case BGDynamicsChunkType::kSplinter:
+      return &ss->splinters;
+    case BGDynamicsChunkType::kSweat:
+      return &ss->sweats;
+    case BGDynamicsChunkType::kFlagStand:
+      return &ss->flag_stands;
+  }
+  FatalError("Invalid chunk type.");
+  return nullptr;
+}
+
 auto BGDynamicsServer::CreateDrawSnapshot() -> BGDynamicsDrawSnapshot* {
   assert(g_base->InBGDynamicsThread());
 
-  auto* ss = new BGDynamicsDrawSnapshot();
-
-  uint32_t rock_count = 0;
-  uint32_t ice_count = 0;
-  uint32_t slime_count = 0;
-  uint32_t metal_count = 0;
-  uint32_t spark_count = 0;
-  uint32_t splinter_count = 0;
-  uint32_t sweat_count = 0;
-  uint32_t flag_stand_count = 0;
+  auto* ss = AcquireDrawSnapshot();
 
   uint32_t shadow_max_count = 0;
   uint32_t light_max_count = 0;
   uint32_t shadow_drawn_count = 0;
   uint32_t light_drawn_count = 0;
 
-  for (auto&& i : chunks_) {
-    BGDynamicsChunkType t = i->type();
-    switch (t) {
-      case BGDynamicsChunkType::kRock:
-        rock_count++;
-        break;
-      case BGDynamicsChunkType::kIce:
-        ice_count++;
-        break;
-      case BGDynamicsChunkType::kSlime:
-        slime_count++;
-        break;
-      case BGDynamicsChunkType::kMetal:
-        metal_count++;
-        break;
-      case BGDynamicsChunkType::kSpark:
-        spark_count++;
-        break;
-      case BGDynamicsChunkType::kSplinter:
-        splinter_count++;
-        break;
-      case BGDynamicsChunkType::kSweat:
-        sweat_count++;
-        break;
-      case BGDynamicsChunkType::kFlagStand:
-        flag_stand_count++;
-        break;
-    }
-    // tally shadow/lights
-    switch (t) {
+  // Chunks are stored by type so we know all our counts up front.
+  for (int t = 0; t < kChunkTypeCount; ++t) {
+    auto count = static_cast<uint32_t>(chunks_[t].size());
+    switch (static_cast<BGDynamicsChunkType>(t)) {
       case BGDynamicsChunkType::kFlagStand:
       case BGDynamicsChunkType::kSweat:
         break;  //  these have no shadows
       case BGDynamicsChunkType::kIce:
       case BGDynamicsChunkType::kSpark:
-        light_max_count++;
+        light_max_count += count;
         break;
       default:
-        shadow_max_count++;
+        shadow_max_count += count;
         break;
     }
   }
 
-  Matrix44f* c_rock = nullptr;
-  Matrix44f* c_ice = nullptr;
-  Matrix44f* c_slime = nullptr;
-  Matrix44f* c_metal = nullptr;
-  Matrix44f* c_spark = nullptr;
-  Matrix44f* c_splinter = nullptr;
-  Matrix44f* c_sweat = nullptr;
-  Matrix44f* c_flag_stand = nullptr;
-
-  if (rock_count > 0) {
-    ss->rocks.resize(rock_count);
-    c_rock = ss->rocks.data();
-  }
-  if (ice_count > 0) {
-    ss->ice.resize(ice_count);
-    c_ice = ss->ice.data();
-  }
-  if (slime_count > 0) {
-    ss->slime.resize(slime_count);
-    c_slime = ss->slime.data();
-  }
-  if (metal_count > 0) {
-    ss->metal.resize(metal_count);
-    c_metal = ss->metal.data();
-  }
-  if (spark_count > 0) {
-    ss->sparks.resize(spark_count);
-    c_spark = ss->sparks.data();
-  }
-  if (splinter_count > 0) {
-    ss->splinters.resize(splinter_count);
-    c_splinter = ss->splinters.data();
-  }
-  if (sweat_count > 0) {
-    ss->sweats.resize(sweat_count);
-    c_sweat = ss->sweats.data();
-  }
-  if (flag_stand_count > 0) {
-    ss->flag_stands.resize(flag_stand_count);
-    c_flag_stand = ss->flag_stands.data();
-  }
-
   // Allocate buffers as if we're drawing *all* lights/shadows for chunks.
   // We may prune this down.
   uint16_t *s_index = nullptr, *l_index = nullptr;
@@ -1640,284 +1618,236 @@ auto BGDynamicsServer::CreateDrawSnapshot() -> BGDynamicsDrawSnapshot* {
     l_vertex_index = 0;
   }
 
-  Matrix44f* c{};
-
-  for (auto&& i : chunks_) {
-    BGDynamicsChunkType type = i->type();
-    switch (type) {
-      case BGDynamicsChunkType::kRock:
-        c = c_rock;
-        break;
-      case BGDynamicsChunkType::kIce:
-        c = c_ice;
-        break;
-      case BGDynamicsChunkType::kSlime:
-        c = c_slime;
-        break;
-      case BGDynamicsChunkType::kMetal:
-        c = c_metal;
-        break;
-      case BGDynamicsChunkType::kSpark:
-        c = c_spark;
-        break;
-      case BGDynamicsChunkType::kSplinter:
-        c = c_splinter;
-        break;
-      case BGDynamicsChunkType::kSweat:
-        c = c_sweat;
-        break;
-      case BGDynamicsChunkType::kFlagStand:
-        c = c_flag_stand;
-        break;
-    }
-
-    const float* s = i->size();
-    if (i->dynamic()) {
-      dBodyID b = i->body();
-      const dReal* p = dBodyGetPosition(b);
-      const dReal* r = dBodyGetRotation(b);
-      (*c).m[0] = r[0] * s[0];  // NOLINT: clang-tidy says possible null
-      (*c).m[1] = r[4] * s[0];
-      (*c).m[2] = r[8] * s[0];
-      (*c).m[3] = 0;
-      (*c).m[4] = r[1] * s[1];
-      (*c).m[5] = r[5] * s[1];
-      (*c).m[6] = r[9] * s[1];
-      (*c).m[7] = 0;
-      (*c).m[8] = r[2] * s[2];
-      (*c).m[9] = r[6] * s[2];
-      (*c).m[10] = r[10] * s[2];
-      (*c).m[11] = 0;
-      (*c).m[12] = p[0];
-      (*c).m[13] = p[1];
-      (*c).m[14] = p[2];
-      (*c).m[15] = 1;
-    } else {
-      // NOLINTNEXTLINE: clang-tidy complaining of possible null here.
-      memcpy((*c).m, i->static_transform(), sizeof((*c)));
-    }
-
-    // Shadow size is just average of our dimensions.
-    float shadow_size = (s[0] + s[1] + s[2]) * 0.3333f;
-
-    // These are elongated so shadows are a bit big by default.
-    if (type == BGDynamicsChunkType::kSplinter) shadow_size *= 0.65f;
-    float flicker = i->flicker_;
-    float shadow_dist = i->shadow_dist_;
-    float life = std::min(1.0f, (static_cast<float>(time_ms_)
-                                 - static_cast<float>(i->birth_time_))
-                                    / i->lifespan_);
-
-    // Shrink our matrix down over time.
-    switch (type) {
-      case BGDynamicsChunkType::kSpark:
-      case BGDynamicsChunkType::kSweat: {
-        float shrink_scale = (1.0f - life) * flicker;
-        Matrix44f* m = &(*c);
-        (*m) = Matrix44fScale(shrink_scale) * (*m);
-        break;
+  for (int t = 0; t < kChunkTypeCount; ++t) {
+    auto type = static_cast<BGDynamicsChunkType>(t);
+    auto& chunks{chunks_[t]};
+    std::vector<Matrix44f>* matrices{ChunkMatrices_(ss, type)};
+    matrices->resize(chunks.size());
+    Matrix44f* c{matrices->data()};
+    for (auto&& i : chunks) {
+      const float* s = i->size();
+      if (i->dynamic()) {
+        dBodyID b = i->body();
+        const dReal* p = dBodyGetPosition(b);
+        const dReal* r = dBodyGetRotation(b);
+        (*c).m[0] = r[0] * s[0];  // NOLINT: clang-tidy says possible null
+        (*c).m[1] = r[4] * s[0];
+        (*c).m[2] = r[8] * s[0];
+        (*c).m[3] = 0;
+        (*c).m[4] = r[1] * s[1];
+        (*c).m[5] = r[5] * s[1];
+        (*c).m[6] = r[9] * s[1];
+        (*c).m[7] = 0;
+        (*c).m[8] = r[2] * s[2];
+        (*c).m[9] = r[6] * s[2];
+        (*c).m[10] = r[10] * s[2];
+        (*c).m[11] = 0;
+        (*c).m[12] = p[0];
+        (*c).m[13] = p[1];
+        (*c).m[14] = p[2];
+        (*c).m[15] = 1;
+      } else {
+        // NOLINTNEXTLINE: clang-tidy complaining of possible null here.
+        memcpy((*c).m, i->static_transform(), sizeof((*c)));
       }
-      default: {
-        // Regular chunks shrink only when on the ground.
-        float sd = shadow_dist;
-        Matrix44f* m = &(*c);
-        if (sd < 1.0f && sd >= 0) {
-          float sink = -sd * life;
-          (*m) = (*m) * Matrix44fTranslate(0, sink, 0);
+
+      // Shadow size is just average of our dimensions.
+      float shadow_size = (s[0] + s[1] + s[2]) * 0.3333f;
+
+      // These are elongated so shadows are a bit big by default.
+      if (type == BGDynamicsChunkType::kSplinter) shadow_size *= 0.65f;
+      float flicker = i->flicker_;
+      float shadow_dist = i->shadow_dist_;
+      float life = std::min(1.0f, (static_cast<float>(time_ms_)
+                                   - static_cast<float>(i->birth_time_))
+                                      / i->lifespan_);
+
+      // Shrink our matrix down over time.
+      switch (type) {
+        case BGDynamicsChunkType::kSpark:
+        case BGDynamicsChunkType::kSweat: {
+          float shrink_scale = (1.0f - life) * flicker;
+          Matrix44f* m = &(*c);
+          (*m) = Matrix44fScale(shrink_scale) * (*m);
+          break;
+        }
+        default: {
+          // Regular chunks shrink only when on the ground.
+          float sd = shadow_dist;
+          Matrix44f* m = &(*c);
+          if (sd < 1.0f && sd >= 0) {
+            float sink = -sd * life;
+            (*m) = (*m) * Matrix44fTranslate(0, sink, 0);
+          }
+          float shrink_scale = 1.0f - life;
+          (*m) = Matrix44fScale(shrink_scale) * (*m);
+          break;
         }
-        float shrink_scale = 1.0f - life;
-        (*m) = Matrix44fScale(shrink_scale) * (*m);
-        break;
       }
-    }
 
-    // Go ahead and build a buffer for our lights/shadows so when it comes
-    // time to draw we just have to upload it.
-    float shadow_scale_mult = 1.0f;
-    float max_shadow_scale = 2.3f;
-    float max_shadow_grow_dist = 2.0f;
-    float max_shadow_dist = 1.0f;
-    bool draw_shadow{};
-    bool draw_light{};
-    switch (type) {
-      case BGDynamicsChunkType::kIce:
-      case BGDynamicsChunkType::kSpark: {
-        draw_shadow = false;
-        draw_light = true;
-        shadow_scale_mult *= 8.0f;
-        break;
-      }
-      case BGDynamicsChunkType::kFlagStand:
-      case BGDynamicsChunkType::kSweat:
-        draw_shadow = false;
-        draw_light = false;
-        break;  // These have no shadows.
-      default: {
-        draw_shadow = true;
-        draw_light = false;
+      // Go ahead and build a buffer for our lights/shadows so when it comes
+      // time to draw we just have to upload it.
+      float shadow_scale_mult = 1.0f;
+      float max_shadow_scale = 2.3f;
+      float max_shadow_grow_dist = 2.0f;
+      float max_shadow_dist = 1.0f;
+      bool draw_shadow{};
+      bool draw_light{};
+      switch (type) {
+        case BGDynamicsChunkType::kIce:
+        case BGDynamicsChunkType::kSpark: {
+          draw_shadow = false;
+          draw_light = true;
+          shadow_scale_mult *= 8.0f;
+          break;
+        }
+        case BGDynamicsChunkType::kFlagStand:
+        case BGDynamicsChunkType::kSweat:
+          draw_shadow = false;
+          draw_light = false;
+          break;  // These have no shadows.
+        default: {
+          draw_shadow = true;
+          draw_light = false;
+        }
       }
-    }
 
-    if (draw_shadow || draw_light) {
-      // Only draw light/shadow if we're within our max/min distances
-      // from the ground.
-      if (shadow_dist > -kShadowOccludeDistance
-          && shadow_dist < max_shadow_dist) {
-        float sd = shadow_dist;
-
-        // Ok we'll draw this fella.
-        uint16_t* this_i{};
-        VertexSprite* this_v{};
-        uint32_t this_v_index{};
-        if (draw_shadow) {
-          shadow_drawn_count++;
-          this_i = s_index;
-          this_v = s_vertex;
-          this_v_index = s_vertex_index;
-          s_index += 6;
-          s_vertex += 4;
-          s_vertex_index += 4;
-        } else {
-          light_drawn_count++;
-          assert(draw_light);
-          this_i = l_index;
-          this_v = l_vertex;
-          this_v_index = l_vertex_index;
-          l_index += 6;
-          l_vertex += 4;
-          l_vertex_index += 4;
-        }
+      if (draw_shadow || draw_light) {
+        // Only draw light/shadow if we're within our max/min distances
+        // from the ground.
+        if (shadow_dist > -kShadowOccludeDistance
+            && shadow_dist < max_shadow_dist) {
+          float sd = shadow_dist;
+
+          // Ok we'll draw this fella.
+          uint16_t* this_i{};
+          VertexSprite* this_v{};
+          uint32_t this_v_index{};
+          if (draw_shadow) {
+            shadow_drawn_count++;
+            this_i = s_index;
+            this_v = s_vertex;
+            this_v_index = s_vertex_index;
+            s_index += 6;
+            s_vertex += 4;
+            s_vertex_index += 4;
+          } else {
+            light_drawn_count++;
+            assert(draw_light);
+            this_i = l_index;
+            this_v = l_vertex;
+            this_v_index = l_vertex_index;
+            l_index += 6;
+            l_vertex += 4;
+            l_vertex_index += 4;
+          }
 
-        float* m = c->m;
+          float* m = c->m;
 
-        // As we get farther from the ground, our shadow gets bigger and
-        // softer.
-        float shadow_scale{};
-        float density{};
+          // As we get farther from the ground, our shadow gets bigger and
+          // softer.
+          float shadow_scale{};
+          float density{};
 
-        // Negative shadow_dist means some object is in front of our
-        // shadow-caster. In this case lets keep our scale the same
-        // as it would have been at zero dist but fade our density
-        // out gradually as we become more deeply submerged.
-        if (sd <= 0.0f) {
-          shadow_scale = 1.0f;
-          density = 1.0f - std::min(1.0f, -sd / kShadowOccludeDistance);
-        } else {
-          // Normal non-submerged shadow.
-          shadow_scale =
-              1.0f
-              + std::max(0.0f, std::min(1.0f, (sd / max_shadow_grow_dist))
-                                   * (max_shadow_scale - 1.0f));
-          density = 0.5f
-                    * g_base->graphics->GetShadowDensity(m[12], m[13], m[14])
-                    * (1.0f - (sd / max_shadow_dist));
-        }
+          // Negative shadow_dist means some object is in front of our
+          // shadow-caster. In this case lets keep our scale the same
+          // as it would have been at zero dist but fade our density
+          // out gradually as we become more deeply submerged.
+          if (sd <= 0.0f) {
+            shadow_scale = 1.0f;
+            density = 1.0f - std::min(1.0f, -sd / kShadowOccludeDistance);
+          } else {
+            // Normal non-submerged shadow.
+            shadow_scale =
+                1.0f
+                + std::max(0.0f, std::min(1.0f, (sd / max_shadow_grow_dist))
+                                     * (max_shadow_scale - 1.0f));
+            density = 0.5f
+                      * g_base->graphics->GetShadowDensity(m[12], m[13], m[14])
+                      * (1.0f - (sd / max_shadow_dist));
+          }
 
-        // Sink down over the course of our lifespan if we
-        // know where the ground is.
-        float sink = 0.0f;
-        if (sd < 1.0f && sd >= 0.0f) {
-          sink = -sd * life;
-        }
-        shadow_scale *= (1.0f - life);
-        assert(shadow_scale >= 0.0f);
+          // Sink down over the course of our lifespan if we
+          // know where the ground is.
+          float sink = 0.0f;
+          if (sd < 1.0f && sd >= 0.0f) {
+            sink = -sd * life;
+          }
+          shadow_scale *= (1.0f - life);
+          assert(shadow_scale >= 0.0f);
 
-        // Drop our density as our shadow scale grows.
-        // Do this *after* this is used to modulate density.
-        shadow_scale *= shadow_scale_mult;
+          // Drop our density as our shadow scale grows.
+          // Do this *after* this is used to modulate density.
+          shadow_scale *= shadow_scale_mult;
 
-        // Add our 6 indices.
-        {
-          this_i[0] = static_cast<uint16_t>(this_v_index);
-          this_i[1] = static_cast<uint16_t>(this_v_index + 1);
-          this_i[2] = static_cast<uint16_t>(this_v_index + 2);
-          this_i[3] = static_cast<uint16_t>(this_v_index + 1);
-          this_i[4] = static_cast<uint16_t>(this_v_index + 3);
-          this_i[5] = static_cast<uint16_t>(this_v_index + 2);
-        }
-
-        // Add our 4 verts.
-        this_v[0].uv[0] = 0;
-        this_v[0].uv[1] = 0;
-        this_v[1].uv[0] = 0;
-        this_v[1].uv[1] = 65535;
-        this_v[2].uv[0] = 65535;
-        this_v[2].uv[1] = 0;
-        this_v[3].uv[0] = 65535;
-        this_v[3].uv[1] = 65535;
-
-        switch (type) {
-          case BGDynamicsChunkType::kIce: {
-            this_v[0].color[0] = this_v[1].color[0] = this_v[2].color[0] =
-                this_v[3].color[0] = 0.1f * density;
-            this_v[0].color[1] = this_v[1].color[1] = this_v[2].color[1] =
-                this_v[3].color[1] = 0.1f * density;
-            this_v[0].color[2] = this_v[1].color[2] = this_v[2].color[2] =
-                this_v[3].color[2] = 0.2f * density;
-            this_v[0].color[3] = this_v[1].color[3] = this_v[2].color[3] =
-                this_v[3].color[3] = 0.2f * density;
-            break;
-          }
-          case BGDynamicsChunkType::kSpark: {
-            this_v[0].color[0] = this_v[1].color[0] = this_v[2].color[0] =
-                this_v[3].color[0] = 0.3f * density;
-            this_v[0].color[1] = this_v[1].color[1] = this_v[2].color[1] =
-                this_v[3].color[1] = 0.12f * density;
-            this_v[0].color[2] = this_v[1].color[2] = this_v[2].color[2] =
-                this_v[3].color[2] = 0.10f * density;
-            this_v[0].color[3] = this_v[1].color[3] = this_v[2].color[3] =
-                this_v[3].color[3] = 0.1f * density;
-            break;
+          // Add our 6 indices.
+          {
+            this_i[0] = static_cast<uint16_t>(this_v_index);
+            this_i[1] = static_cast<uint16_t>(this_v_index + 1);
+            this_i[2] = static_cast<uint16_t>(this_v_index + 2);
+            this_i[3] = static_cast<uint16_t>(this_v_index + 1);
+            this_i[4] = static_cast<uint16_t>(this_v_index + 3);
+            this_i[5] = static_cast<uint16_t>(this_v_index + 2);
           }
-          default: {
-            this_v[0].color[0] = this_v[1].color[0] = this_v[2].color[0] =
-                this_v[3].color[0] = 0.0f;
-            this_v[0].color[1] = this_v[1].color[1] = this_v[2].color[1] =
-                this_v[3].color[1] = 0.0f;
-            this_v[0].color[2] = this_v[1].color[2] = this_v[2].color[2] =
-                this_v[3].color[2] = 0.0f;
-            this_v[0].color[3] = this_v[1].color[3] = this_v[2].color[3] =
-                this_v[3].color[3] = 0.4f * density;
-            break;
+
+          // Add our 4 verts.
+          this_v[0].uv[0] = 0;
+          this_v[0].uv[1] = 0;
+          this_v[1].uv[0] = 0;
+          this_v[1].uv[1] = 65535;
+          this_v[2].uv[0] = 65535;
+          this_v[2].uv[1] = 0;
+          this_v[3].uv[0] = 65535;
+          this_v[3].uv[1] = 65535;
+
+          switch (type) {
+            case BGDynamicsChunkType::kIce: {
+              this_v[0].color[0] = this_v[1].color[0] = this_v[2].color[0] =
+                  this_v[3].color[0] = 0.1f * density;
+              this_v[0].color[1] = this_v[1].color[1] = this_v[2].color[1] =
+                  this_v[3].color[1] = 0.1f * density;
+              this_v[0].color[2] = this_v[1].color[2] = this_v[2].color[2] =
+                  this_v[3].color[2] = 0.2f * density;
+              this_v[0].color[3] = this_v[1].color[3] = this_v[2].color[3] =
+                  this_v[3].color[3] = 0.2f * density;
+              break;
+            }
+            case BGDynamicsChunkType::kSpark: {
+              this_v[0].color[0] = this_v[1].color[0] = this_v[2].color[0] =
+                  this_v[3].color[0] = 0.3f * density;
+              this_v[0].color[1] = this_v[1].color[1] = this_v[2].color[1] =
+                  this_v[3].color[1] = 0.12f * density;
+              this_v[0].color[2] = this_v[1].color[2] = this_v[2].color[2] =
+                  this_v[3].color[2] = 0.10f * density;
+              this_v[0].color[3] = this_v[1].color[3] = this_v[2].color[3] =
+                  this_v[3].color[3] = 0.1f * density;
+              break;
+            }
+            default: {
+              this_v[0].color[0] = this_v[1].color[0] = this_v[2].color[0] =
+                  this_v[3].color[0] = 0.0f;
+              this_v[0].color[1] = this_v[1].color[1] = this_v[2].color[1] =
+                  this_v[3].color[1] = 0.0f;
+              this_v[0].color[2] = this_v[1].color[2] = this_v[2].color[2] =
+                  this_v[3].color[2] = 0.0f;
+              this_v[0].color[3] = this_v[1].color[3] = this_v[2].color[3] =
+                  this_v[3].color[3] = 0.4f * density;
+              break;
+            }
           }
+          this_v[0].position[0] = this_v[1].position[0] =
+              this_v[2].position[0] = this_v[3].position[0] = m[12];
+          this_v[0].position[1] = this_v[1].position[1] =
+              this_v[2].position[1] = this_v[3].position[1] = m[13] + sink;
+          this_v[0].position[2] = this_v[1].position[2] =
+              this_v[2].position[2] = this_v[3].position[2] = m[14];
+          this_v[0].size = this_v[1].size = this_v[2].size = this_v[3].size =
+              2.8f * shadow_size * shadow_scale;
         }
-        this_v[0].position[0] = this_v[1].position[0] = this_v[2].position[0] =
-            this_v[3].position[0] = m[12];
-        this_v[0].position[1] = this_v[1].position[1] = this_v[2].position[1] =
-            this_v[3].position[1] = m[13] + sink;
-        this_v[0].position[2] = this_v[1].position[2] = this_v[2].position[2] =
-            this_v[3].position[2] = m[14];
-        this_v[0].size = this_v[1].size = this_v[2].size = this_v[3].size =
-            2.8f * shadow_size * shadow_scale;
       }
+      c++;
     }
-    c++;
-    switch (type) {
-      case BGDynamicsChunkType::kRock:
-        c_rock = c;
-        break;
-      case BGDynamicsChunkType::kIce:
-        c_ice = c;
-        break;
-      case BGDynamicsChunkType::kSlime:
-        c_slime = c;
-        break;
-      case BGDynamicsChunkType::kMetal:
-        c_metal = c;
-        break;
-      case BGDynamicsChunkType::kSpark:
-        c_spark = c;
-        break;
-      case BGDynamicsChunkType::kSplinter:
-        c_splinter = c;
-        break;
-      case BGDynamicsChunkType::kSweat:
-        c_sweat = c;
-        break;
-      case BGDynamicsChunkType::kFlagStand:
-        c_flag_stand = c;
-        break;
-    }
+    assert(c == matrices->data() + matrices->size());
   }
   if (shadow_max_count > 0) {
     if (shadow_drawn_count == 0) {
@@ -2237,27 +2167,28 @@ void BGDynamicsServer::PushTooSlowCall() {
   event_loop()->PushCall([this] {
     if (chunk_count_ > 0 || tendril_count_thick_ > 0
         || tendril_count_thin_ > 0) {
-      // Ok lets kill a small percentage of our oldest chunks.
-      int killcount =
-          static_cast<int>(0.1f * static_cast<float>(chunks_.size()));
-      int killed = 0;
-      auto i = chunks_.begin();
-      while (i != chunks_.end()) {
-        if (killed >= killcount) break;
-        auto i_next = i;
-        i_next++;
-
-        // Kill it if its killable; otherwise move to next.
-        if ((**i).can_die()) {
-          delete (*i);
-          chunks_.erase(i);
-          chunk_count_--;
-          killed++;
+      // Ok lets kill a small percentage of our oldest chunks (of each
+      // type; each list is in order of creation).
+      for (auto& chunks : chunks_) {
+        int killcount =
+            static_cast<int>(0.1f * static_cast<float>(chunks.size()));
+        int killed = 0;
+        size_t live = 0;
+        for (auto* chunk : chunks) {
+          // Kill it if its killable; otherwise keep it.
+          if (killed < killcount && chunk->can_die()) {
+            delete chunk;
+            chunk_count_--;
+            killed++;
+            continue;
+          }
+          chunks[live++] = chunk;
         }
-        i = i_next;
+        chunks.resize(live);
       }
       // ...and tendrils.
-      killcount = static_cast<int>(0.2f * static_cast<float>(tendrils_.size()));
+      int killcount =
+          static_cast<int>(0.2f * static_cast<float>(tendrils_.size()));
       for (int j = 0; j < killcount; j++) {
         Tendril* t = *tendrils_.begin();
         if (t->type_ == BGDynamicsTendrilType::kThinSmoke) {
@@ -2526,125 +2457,129 @@ void BGDynamicsServer::UpdateChunks() {
   // rather we explicitly test everything against our terrain objects;
   // this keeps things simple.
 
-  for (auto i = chunks_.begin(); i != chunks_.end();) {
-    Chunk& c(**i);
-
-    // first off, kill this chunk if its time has come
-    {
-      bool kill = false;
-      if (time_ms_ - c.birth_time_ > c.lifespan_) {
-        kill = true;
-      }
-
-      // If we've fallen off the level.
-      if (c.dynamic()) {
-        const dReal* pos = dGeomGetPosition(c.geom_);
-        if (pos[1] < debris_kill_height_) kill = true;
-      }
-      if (kill) {
-        auto i_next = i;
-        i_next++;
-        delete *i;
-        chunks_.erase(i);
-        chunk_count_--;
-        assert(chunk_count_ >= 0);
-        i = i_next;
-        continue;
-      }
-    }
-    BGDynamicsChunkType type = c.type();
+  for (auto& chunks : chunks_) {
+    // Compact each list as we go, keeping creation order.
+    size_t live = 0;
+    for (auto* chunk : chunks) {
+      Chunk& c(*chunk);
+
+      // first off, kill this chunk if its time has come
+      {
+        bool kill = false;
+        if (time_ms_ - c.birth_time_ > c.lifespan_) {
+          kill = true;
+        }
 
-    // Some spark-specific stuff.
-    if (type == BGDynamicsChunkType::kSpark) {
-      if (RandomFloat() < 0.1f) {
-        float fs = c.flicker_scale_;
-        c.flicker_ = fs * RandomFloat() + (1.0f - fs) * 0.8f;
-      }
-    } else if (type == BGDynamicsChunkType::kSweat) {
-      // Some sweat-specific stuff.
-      if (RandomFloat() < 0.25f) {
-        c.flicker_ = RandomFloat();
+        // If we've fallen off the level.
+        if (c.dynamic()) {
+          const dReal* pos = dGeomGetPosition(c.geom_);
+          if (pos[1] < debris_kill_height_) kill = true;
+        }
+        if (kill) {
+          delete &c;
+          chunk_count_--;
+          assert(chunk_count_ >= 0);
+          continue;
+        }
       }
-    }
+      chunks[live++] = &c;
+      BGDynamicsChunkType type = c.type();
 
-    // Most stuff only applies to dynamic chunks.
-    if (c.dynamic()) {
-      dGeomID geom = c.geom();
-      dBodyID body = c.body();
-      if (type == BGDynamicsChunkType::kSlime) {
-        // add some drag on slime chunks
-        const dReal* vel = dBodyGetLinearVel(body);
-        dBodySetLinearVel(body, vel[0] * 0.99f, vel[1] * 0.99f, vel[2] * 0.99f);
-      }
+      // Some spark-specific stuff.
       if (type == BGDynamicsChunkType::kSpark) {
-        // Add some drag on spark.
-        const dReal* vel = dBodyGetLinearVel(body);
-
-        // Also add a bit of upward to counteract gravity.
-        float vel_squared = vel[0] * vel[0] + vel[1] * vel[1] + vel[2] * vel[2];
-
-        // Slow down fast if we're going fast.
-        // Otherwise, slow down more gradually.
-        if (vel_squared > 14) {
-          dBodySetLinearVel(body, vel[0] * 0.94f, 0.13f + vel[1] * 0.94f,
-                            vel[2] * 0.94f);
-        } else {
-          dBodySetLinearVel(body, vel[0] * 0.99f, 0.07f + vel[1] * 0.99f,
-                            vel[2] * 0.99f);
+        if (RandomFloat() < 0.1f) {
+          float fs = c.flicker_scale_;
+          c.flicker_ = fs * RandomFloat() + (1.0f - fs) * 0.8f;
         }
       } else if (type == BGDynamicsChunkType::kSweat) {
-        // Add some drag on sweat.
-        const dReal* vel = dBodyGetLinearVel(body);
-
-        // Also add a bit of upward to counteract gravity.
-        float vel_squared = vel[0] * vel[0] + vel[1] * vel[1] + vel[2] * vel[2];
+        // Some sweat-specific stuff.
+        if (RandomFloat() < 0.25f) {
+          c.flicker_ = RandomFloat();
+        }
+      }
 
-        // Slow down fast if we're going fast.
-        // Otherwise, slow down more gradually.
-        if (vel_squared > 14) {
-          dBodySetLinearVel(body, vel[0] * 0.93f, 0.13f + vel[1] * 0.93f,
-                            vel[2] * 0.93f);
-        } else {
-          dBodySetLinearVel(body, vel[0] * 0.97f, 0.11f + vel[1] * 0.97f,
-                            vel[2] * 0.97f);
+      // Most stuff only applies to dynamic chunks.
+      if (c.dynamic()) {
+        dGeomID geom = c.geom();
+        dBodyID body = c.body();
+        if (type == BGDynamicsChunkType::kSlime) {
+          // add some drag on slime chunks
+          const dReal* vel = dBodyGetLinearVel(body);
+          dBodySetLinearVel(body, vel[0] * 0.99f, vel[1] * 0.99f,
+                            vel[2] * 0.99f);
         }
-      } else if (type == BGDynamicsChunkType::kSplinter) {
-        // Add some drag on slime chunks.
-        const dReal* vel = dBodyGetLinearVel(body);
-        dBodySetLinearVel(body, vel[0] * 0.995f, vel[1] * 0.995f,
-                          vel[2] * 0.995f);
-        vel = dBodyGetAngularVel(body);
-        dBodySetAngularVel(body, vel[0] * 0.995f, vel[1] * 0.995f,
-                           vel[2] * 0.995f);
-      } else {
-        const dReal* vel = dBodyGetAngularVel(body);
-        if (vel[0] * vel[0] + vel[1] * vel[1] + vel[2] * vel[2] > 500) {
-          // Drastic slowdown for super-fast stuff.
-          dBodySetAngularVel(body, vel[0] * 0.75f, vel[1] * 0.75f,
-                             vel[2] * 0.75f);
-        } else {
+        if (type == BGDynamicsChunkType::kSpark) {
+          // Add some drag on spark.
+          const dReal* vel = dBodyGetLinearVel(body);
+
+          // Also add a bit of upward to counteract gravity.
+          float vel_squared =
+              vel[0] * vel[0] + vel[1] * vel[1] + vel[2] * vel[2];
+
+          // Slow down fast if we're going fast.
+          // Otherwise, slow down more gradually.
+          if (vel_squared > 14) {
+            dBodySetLinearVel(body, vel[0] * 0.94f, 0.13f + vel[1] * 0.94f,
+                              vel[2] * 0.94f);
+          } else {
+            dBodySetLinearVel(body, vel[0] * 0.99f, 0.07f + vel[1] * 0.99f,
+                              vel[2] * 0.99f);
+          }
+        } else if (type == BGDynamicsChunkType::kSweat) {
+          // Add some drag on sweat.
+          const dReal* vel = dBodyGetLinearVel(body);
+
+          // Also add a bit of upward to counteract gravity.
+          float vel_squared =
+              vel[0] * vel[0] + vel[1] * vel[1] + vel[2] * vel[2];
+
+          // Slow down fast if we're going fast.
+          // Otherwise, slow down more gradually.
+          if (vel_squared > 14) {
+            dBodySetLinearVel(body, vel[0] * 0.93f, 0.13f + vel[1] * 0.93f,
+                              vel[2] * 0.93f);
+          } else {
+            dBodySetLinearVel(body, vel[0] * 0.97f, 0.11f + vel[1] * 0.97f,
+                              vel[2] * 0.97f);
+          }
+        } else if (type == BGDynamicsChunkType::kSplinter) {
+          // Add some drag on slime chunks.
+          const dReal* vel = dBodyGetLinearVel(body);
+          dBodySetLinearVel(body, vel[0] * 0.995f, vel[1] * 0.995f,
+                            vel[2] * 0.995f);
+          vel = dBodyGetAngularVel(body);
           dBodySetAngularVel(body, vel[0] * 0.995f, vel[1] * 0.995f,
                              vel[2] * 0.995f);
+        } else {
+          const dReal* vel = dBodyGetAngularVel(body);
+          if (vel[0] * vel[0] + vel[1] * vel[1] + vel[2] * vel[2] > 500) {
+            // Drastic slowdown for super-fast stuff.
+            dBodySetAngularVel(body, vel[0] * 0.75f, vel[1] * 0.75f,
+                               vel[2] * 0.75f);
+          } else {
+            dBodySetAngularVel(body, vel[0] * 0.995f, vel[1] * 0.995f,
+                               vel[2] * 0.995f);
+          }
         }
-      }
 
-      // If this chunk is disabled, we don't need to do anything
-      // (since no terrain ever moves to wake us back up).
-      // Also, we skip sweat since that neither casts shadows nor collides.
-      if (dBodyIsEnabled(body) && type != BGDynamicsChunkType::kSweat) {
-        // Move our shadow ray to where we are and reset our shadow length.
-        const dReal* pos = dGeomGetPosition(geom);
-        // Update shadow dist.
-        c.shadow_dist_ = pos[1] - height_cache_->Sample(Vector3f(pos));
-        cb_type_ = type;
-        cb_body_ = body;
-        collision_cache_->CollideAgainstGeom(geom, this,
-                                             TerrainCollideCallback);
-        // Tell it to update any tendril it might have.
-        c.UpdateTendril();
+        // If this chunk is disabled, we don't need to do anything
+        // (since no terrain ever moves to wake us back up).
+        // Also, we skip sweat since that neither casts shadows nor collides.
+        if (dBodyIsEnabled(body) && type != BGDynamicsChunkType::kSweat) {
+          // Move our shadow ray to where we are and reset our shadow length.
+          const dReal* pos = dGeomGetPosition(geom);
+          // Update shadow dist.
+          c.shadow_dist_ = pos[1] - height_cache_->Sample(Vector3f(pos));
+          cb_type_ = type;
+          cb_body_ = body;
+          collision_cache_->CollideAgainstGeom(geom, this,
+                                               TerrainCollideCallback);
+          // Tell it to update any tendril it might have.
+          c.UpdateTendril();
+        }
       }
     }
-    i++;
+    chunks.resize(live);
   }
 }
 
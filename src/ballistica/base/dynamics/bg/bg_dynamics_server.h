@@ -121,10 +121,18 @@ class BGDynamicsServer {
   void PushSetDebrisFrictionCall(float friction);
   void PushSetDebrisKillHeightCall(float height);
 
+  /// Hand a draw snapshot back once the logic thread is done with it so
+  /// its storage can be reused for a future one. Can be called from any
+  /// thread.
+  void RecycleDrawSnapshot(BGDynamicsDrawSnapshot* snapshot);
+
   auto step_seconds() const { return step_seconds_; }
   auto step_milliseconds() const { return step_milliseconds_; }
 
  private:
+  static constexpr int kChunkTypeCount{
+      static_cast<int>(BGDynamicsChunkType::kFlagStand) + 1};
+
   class Terrain;
   class Chunk;
   class Field;
@@ -141,6 +149,8 @@ class BGDynamicsServer {
   void UpdateTendrils();
   void UpdateFuses();
   void UpdateShadows();
+  void AddChunk(Chunk* chunk);
+  auto AcquireDrawSnapshot() -> BGDynamicsDrawSnapshot*;
   auto CreateDrawSnapshot() -> BGDynamicsDrawSnapshot*;
   void CalcERPCFM(dReal stiffness, dReal damping, dReal* erp, dReal* cfm);
 
@@ -174,13 +184,18 @@ class BGDynamicsServer {
   int step_count_{};
   std::mutex step_count_mutex_;
   std::unique_ptr<ParticleSet> spark_particles_{};
-  std::list<Chunk*> chunks_;
+  // Chunks are kept in per-type lists (in order of creation) so snapshot
+  // building knows its counts up front and can fill each type's
+  // transforms in a single linear pass.
+  std::vector<Chunk*> chunks_[kChunkTypeCount];
   std::list<Field*> fields_;
   std::list<Tendril*> tendrils_;
   int tendril_count_thick_{};
   int tendril_count_thin_{};
   int chunk_count_{};
   std::unique_ptr<BGDynamicsHeightCache> height_cache_;
+  std::mutex draw_snapshot_pool_mutex_;
+  std::vector<BGDynamicsDrawSnapshot*> draw_snapshot_pool_;
   std::unique_ptr<CollisionCache> collision_cache_;
   float time_ms_{};  // Internal time step.
   float debris_friction_{1.0f};
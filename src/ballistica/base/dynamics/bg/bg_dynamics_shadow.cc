@@ -5,6 +5,7 @@
 #include "ballistica/base/dynamics/bg/bg_dynamics_server.h"
 #include "ballistica/base/dynamics/bg/bg_dynamics_shadow_data.h"
 #include "ballistica/base/graphics/graphics.h"
+#include "ballistica/base/graphics/support/frame_def.h"
 
 namespace ballistica::base {
 
@@ -40,7 +41,7 @@ auto BGDynamicsShadow::GetPosition() const -> const Vector3f& {
 }
 
 void BGDynamicsShadow::GetValues(float* scale, float* density) const {
-  assert(g_base->InLogicThread());
+  assert(FrameDef::InDrawThread());
   assert(scale);
   assert(density);
 
@@ -8,13 +8,13 @@ void ObjectComponent::WriteConfig() {
   // If they didn't give us a texture, just use a blank white texture.
   // This is not a common case and easier than forking all our shaders to
   // create non-textured versions.
-  if (!texture_.Exists()) {
+  if (texture_ == nullptr) {
     texture_ = g_base->assets->SysTexture(SysTextureID::kWhite);
   }
   if (reflection_ == ReflectionType::kNone) {
-    assert(!double_sided_);               // Unsupported combo.
-    assert(!colorize_texture_.Exists());  // Unsupported combo.
-    assert(!have_color_add_);             // Unsupported combo.
+    assert(!double_sided_);      // Unsupported combo.
+    assert(!colorize_texture_);  // Unsupported combo.
+    assert(!have_color_add_);    // Unsupported combo.
     if (light_shadow_ == LightShadowType::kNone) {
       if (transparent_) {
         ConfigForShading(ShadingType::kObjectTransparent);
@@ -44,8 +44,8 @@ void ObjectComponent::WriteConfig() {
     }
   } else {
     if (light_shadow_ == LightShadowType::kNone) {
-      assert(!double_sided_);               // Unsupported combo.
-      assert(!colorize_texture_.Exists());  // Unsupported combo.
+      assert(!double_sided_);      // Unsupported combo.
+      assert(!colorize_texture_);  // Unsupported combo.
       if (transparent_) {
         assert(!world_space_);  // Unsupported combo.
         if (have_color_add_) {
@@ -85,7 +85,7 @@ void ObjectComponent::WriteConfig() {
       // With add.
       assert(!transparent_);  // Unsupported combo.
       if (!have_color_add_) {
-        if (colorize_texture_.Exists()) {
+        if (colorize_texture_ != nullptr) {
           assert(!double_sided_);  // Unsupported combo.
           assert(!world_space_);   // Unsupported combo.
           if (do_colorize_2_) {
@@ -146,7 +146,7 @@ void ObjectComponent::WriteConfig() {
       } else {
         assert(!double_sided_);  // Unsupported combo.
         assert(!world_space_);   // Unsupported config.
-        if (colorize_texture_.Exists()) {
+        if (colorize_texture_ != nullptr) {
           if (do_colorize_2_) {
             ConfigForShading(
                 ShadingType::kObjectReflectLightShadowAddColorized2);
@@ -139,8 +139,9 @@ class ObjectComponent : public RenderComponent {
   float reflection_scale_r_{1.0f};
   float reflection_scale_g_{1.0f};
   float reflection_scale_b_{1.0f};
-  Object::Ref<TextureAsset> texture_;
-  Object::Ref<TextureAsset> colorize_texture_;
+  // Raw pointers; see SimpleComponent.
+  TextureAsset* texture_{};
+  TextureAsset* colorize_texture_{};
 };
 
 }  // namespace ballistica::base
@@ -12,7 +12,7 @@ void RenderComponent::ScissorPush(const Rect& rect) {
 
 #if BA_DEBUG_BUILD
 void RenderComponent::ConfigForEmptyDebugChecks(bool transparent) {
-  assert(g_base->InLogicThread());
+  assert(FrameDef::InDrawThread());
   if (g_base->graphics->drawing_opaque_only() && transparent) {
     throw Exception("Transparent component submitted in opaque-only section");
   }
@@ -22,7 +22,7 @@ void RenderComponent::ConfigForEmptyDebugChecks(bool transparent) {
 }
 
 void RenderComponent::ConfigForShadingDebugChecks(ShadingType shading_type) {
-  assert(g_base->InLogicThread());
+  assert(FrameDef::InDrawThread());
   if (g_base->graphics->drawing_opaque_only()
       && Graphics::IsShaderTransparent(shading_type)) {
     throw Exception("Transparent component submitted in opaque-only section");
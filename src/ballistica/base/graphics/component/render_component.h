@@ -54,11 +54,11 @@ class RenderComponent {
 
  public:
   explicit RenderComponent(RenderPass* pass) : pass_(pass) {
-    assert(g_base->InLogicThread());
+    assert(FrameDef::InDrawThread());
   }
 
   ~RenderComponent() {
-    assert(g_base->InLogicThread());
+    assert(FrameDef::InDrawThread());
 
     if (state_ != State::kSubmitted) {
       Submit();
@@ -104,7 +104,7 @@ class RenderComponent {
   void DrawMesh(Mesh* m, int flags = 0) {
     EnsureDrawing();
     if (m->IsValid()) {
-      cmd_buffer_->frame_def()->AddMesh(m);
+      cmd_buffer_->AddMesh(m);
       cmd_buffer_->PutCommand(RenderCommandBuffer::Command::kDrawMesh);
       cmd_buffer_->PutInt(flags);
       cmd_buffer_->PutMeshData(m->mesh_data_client_handle()->mesh_data);
@@ -29,7 +29,7 @@ class SimpleComponent : public RenderComponent {
 
   void SetTexture(const Object::Ref<TextureAsset>& t) {
     EnsureConfiguring();
-    texture_ = t;
+    texture_ = t.Get();
   }
 
   /// Used with colorize color 1 and 2. Red areas of the texture will get
@@ -53,7 +53,7 @@ class SimpleComponent : public RenderComponent {
 
   void ClearMaskUV2Texture() {
     EnsureConfiguring();
-    mask_uv2_texture_.Clear();
+    mask_uv2_texture_ = nullptr;
   }
 
   void SetDoubleSided(bool enable) {
@@ -146,10 +146,13 @@ class SimpleComponent : public RenderComponent {
   float glow_amount_{};
   float glow_blur_{};
   float flatness_{};
-  Object::Ref<TextureAsset> texture_;
-  Object::Ref<TextureAsset> colorize_texture_;
-  Object::Ref<TextureAsset> mask_texture_;
-  Object::Ref<TextureAsset> mask_uv2_texture_;
+  // Raw pointers; the frame-def takes references once these are written to
+  // a command buffer. Not touching ref-counts here also lets components be
+  // built in worker threads during parallel node drawing.
+  TextureAsset* texture_{};
+  TextureAsset* colorize_texture_{};
+  TextureAsset* mask_texture_{};
+  TextureAsset* mask_uv2_texture_{};
 };
 
 }  // namespace ballistica::base
@@ -879,12 +879,7 @@ void Graphics::BuildAndPushFrameDef() {
   ClearFrameDefDeleteList();
 
   // Clear our blotches out regardless of whether we rendered them.
-  blotch_indices_.clear();
-  blotch_verts_.clear();
-  blotch_soft_indices_.clear();
-  blotch_soft_verts_.clear();
-  blotch_soft_obj_indices_.clear();
-  blotch_soft_obj_verts_.clear();
+  ClearBlotches();
 
   assert(building_frame_def_);
   building_frame_def_ = false;
@@ -1244,6 +1239,16 @@ void Graphics::ReleaseFadeEndCommand() { fade_end_call_.Clear(); }
 
 auto Graphics::ValueTest(const std::string& arg, double* absval,
                          double* deltaval, double* outval) -> bool {
+  if (arg == "drawBatching") {
+    if (absval) {
+      draw_batching_ = static_cast<bool>(*absval);
+    }
+    if (deltaval) {
+      draw_batching_ = (*deltaval > 0.5);
+    }
+    *outval = static_cast<double>(draw_batching_);
+    return true;
+  }
   return false;
 }
 
@@ -1251,7 +1256,7 @@ void Graphics::DoDrawBlotch(std::vector<uint16_t>* indices,
                             std::vector<VertexSprite>* verts,
                             const Vector3f& pos, float size, float r, float g,
                             float b, float a) {
-  assert(g_base->InLogicThread());
+  assert(FrameDef::InDrawThread());
   assert(indices && verts);
 
   // Add verts.
@@ -1325,6 +1330,62 @@ void Graphics::DoDrawBlotch(std::vector<uint16_t>* indices,
   }
 }
 
+void Graphics::ClearBlotches() {
+  assert(g_base->InLogicThread());
+  blotch_indices_.clear();
+  blotch_verts_.clear();
+  blotch_soft_indices_.clear();
+  blotch_soft_verts_.clear();
+  blotch_soft_obj_indices_.clear();
+  blotch_soft_obj_verts_.clear();
+}
+
+void Graphics::BeginBlotchChunks(int count) {
+  assert(g_base->InLogicThread());
+  assert(count > 0 && blotch_chunk_count_ == 0);
+  if (blotch_chunks_.size() < static_cast<size_t>(count)) {
+    blotch_chunks_.resize(count);
+  }
+  blotch_chunk_count_ = count;
+}
+
+// Append chunk blotches to a regular list, shifting indices to match.
+static void AppendBlotchChunk_(std::vector<uint16_t>* indices,
+                               std::vector<VertexSprite>* verts,
+                               std::vector<uint16_t>* chunk_indices,
+                               std::vector<VertexSprite>* chunk_verts) {
+  auto offset = verts->size();
+  assert(offset + chunk_verts->size() <= 65536);
+  verts->insert(verts->end(), chunk_verts->begin(), chunk_verts->end());
+  indices->reserve(indices->size() + chunk_indices->size());
+  for (auto index : *chunk_indices) {
+    indices->push_back(static_cast<uint16_t>(index + offset));
+  }
+  chunk_indices->clear();
+  chunk_verts->clear();
+}
+
+void Graphics::EndBlotchChunks() {
+  assert(g_base->InLogicThread());
+  assert(blotch_chunk_count_ > 0);
+  for (int i = 0; i < blotch_chunk_count_; ++i) {
+    auto& chunk{blotch_chunks_[i]};
+    AppendBlotchChunk_(&blotch_indices_, &blotch_verts_, &chunk.indices,
+                       &chunk.verts);
+    AppendBlotchChunk_(&blotch_soft_indices_, &blotch_soft_verts_,
+                       &chunk.soft_indices, &chunk.soft_verts);
+    AppendBlotchChunk_(&blotch_soft_obj_indices_, &blotch_soft_obj_verts_,
+                       &chunk.soft_obj_indices, &chunk.soft_obj_verts);
+  }
+  blotch_chunk_count_ = 0;
+}
+
+auto Graphics::GetThreadBlotchChunk_() -> BlotchChunk_* {
+  int chunk = FrameDef::thread_draw_chunk();
+  assert(chunk >= 0 && chunk < blotch_chunk_count_);
+  return &blotch_chunks_[chunk];
+}
+
 void Graphics::DrawRadialMeter(MeshIndexedSimpleFull* m, float amt) {
   // FIXME - we're updating this every frame so we should use pure dynamic
   //  data; not a mix of static and dynamic.
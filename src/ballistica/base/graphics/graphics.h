@@ -134,11 +134,22 @@ class Graphics {
   // rendering for efficient batches).
   void DrawBlotch(const Vector3f& pos, float size, float r, float g, float b,
                   float a) {
+    if (blotch_chunk_count_) {
+      auto* chunk = GetThreadBlotchChunk_();
+      DoDrawBlotch(&chunk->indices, &chunk->verts, pos, size, r, g, b, a);
+      return;
+    }
     DoDrawBlotch(&blotch_indices_, &blotch_verts_, pos, size, r, g, b, a);
   }
 
   void DrawBlotchSoft(const Vector3f& pos, float size, float r, float g,
                       float b, float a) {
+    if (blotch_chunk_count_) {
+      auto* chunk = GetThreadBlotchChunk_();
+      DoDrawBlotch(&chunk->soft_indices, &chunk->soft_verts, pos, size, r, g,
+                   b, a);
+      return;
+    }
     DoDrawBlotch(&blotch_soft_indices_, &blotch_soft_verts_, pos, size, r, g, b,
                  a);
   }
@@ -146,10 +157,24 @@ class Graphics {
   // Draw a soft blotch on objects; not terrain.
   void DrawBlotchSoftObj(const Vector3f& pos, float size, float r, float g,
                          float b, float a) {
+    if (blotch_chunk_count_) {
+      auto* chunk = GetThreadBlotchChunk_();
+      DoDrawBlotch(&chunk->soft_obj_indices, &chunk->soft_obj_verts, pos, size,
+                   r, g, b, a);
+      return;
+    }
     DoDrawBlotch(&blotch_soft_obj_indices_, &blotch_soft_obj_verts_, pos, size,
                  r, g, b, a);
   }
 
+  /// Discard any blotches drawn since the last frame was built.
+  void ClearBlotches();
+
+  /// Per-chunk blotch lists for parallel node drawing; called by
+  /// FrameDef::BeginParallelDraw() and FrameDef::EndParallelDraw().
+  void BeginBlotchChunks(int count);
+  void EndBlotchChunks();
+
   // Enable progress bar drawing locally.
   void EnableProgressBar(bool fade_in);
 
@@ -274,6 +299,10 @@ class Graphics {
   void set_gyro_vals(const Vector3f& vals) { gyro_vals_ = vals; }
   auto show_net_info() const { return show_net_info_; }
   void set_show_net_info(bool val) { show_net_info_ = val; }
+
+  /// Whether render passes merge like mesh draws into instanced draws when
+  /// frame-defs are completed. See RenderCommandBuffer::BatchDraws().
+  auto draw_batching() const { return draw_batching_; }
   auto GetDebugGraph(const std::string& name, bool smoothed) -> NetGraph*;
 
   // Used by meshes.
@@ -360,6 +389,14 @@ class Graphics {
   ScreenMessages* const screenmessages;
 
  protected:
+  struct BlotchChunk_ {
+    std::vector<uint16_t> indices;
+    std::vector<VertexSprite> verts;
+    std::vector<uint16_t> soft_indices;
+    std::vector<VertexSprite> soft_verts;
+    std::vector<uint16_t> soft_obj_indices;
+    std::vector<VertexSprite> soft_obj_verts;
+  };
   virtual ~Graphics();
   virtual void DoDrawFade(FrameDef* frame_def, float amt);
   static void CalcVirtualRes_(float* x, float* y);
@@ -372,6 +409,7 @@ class Graphics {
   void DoDrawBlotch(std::vector<uint16_t>* indices,
                     std::vector<VertexSprite>* verts, const Vector3f& pos,
                     float size, float r, float g, float b, float a);
+  auto GetThreadBlotchChunk_() -> BlotchChunk_*;
   auto GetEmptyFrameDef() -> FrameDef*;
   void InitInternalComponents(FrameDef* frame_def);
   void DrawMiscOverlays(FrameDef* frame_def);
@@ -388,6 +426,7 @@ class Graphics {
   int frame_def_count_{};
   int frame_def_count_filtered_{};
   int next_settings_index_{};
+  int blotch_chunk_count_{};
   TextureQuality texture_quality_placeholder_{};
   bool drawing_transparent_only_{};
   bool drawing_opaque_only_{};
@@ -404,6 +443,7 @@ class Graphics {
   bool show_fps_{};
   bool show_ping_{};
   bool show_net_info_{};
+  bool draw_batching_{true};
   bool tv_border_{};
   bool floor_reflection_{};
   bool building_frame_def_{};
@@ -444,6 +484,7 @@ class Graphics {
   std::vector<VertexSprite> blotch_soft_verts_;
   std::vector<uint16_t> blotch_soft_obj_indices_;
   std::vector<VertexSprite> blotch_soft_obj_verts_;
+  std::vector<BlotchChunk_> blotch_chunks_;
   std::vector<FrameDef*> frame_def_delete_list_;
   std::vector<MeshData*> mesh_data_creates_;
   std::vector<MeshData*> mesh_data_destroys_;
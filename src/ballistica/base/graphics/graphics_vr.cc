@@ -116,8 +116,7 @@ auto GraphicsVR::ValueTest(const std::string& arg, double* absval,
       *outval = camera->vr_extra_offset().z;
     }
   } else {
-    // Unhandled.
-    return false;
+    return Graphics::ValueTest(arg, absval, deltaval, outval);
   }
   return true;
 }
@@ -20,6 +20,9 @@ class MeshBuffer : public MeshBufferBase {
       : elements(initial_size) {
     memcpy(&elements[0], initial_data, initial_size * sizeof(T));
   }
+  auto GetDataSize() const -> size_t override {
+    return elements.size() * sizeof(T);
+  }
   std::vector<T> elements;
 };
 
@@ -15,6 +15,9 @@ namespace ballistica::base {
 class MeshBufferBase : public Object {
  public:
   uint32_t state;  // which dynamicState value on the mesh this corresponds to
+
+  /// Size in bytes of the data this buffer holds.
+  virtual auto GetDataSize() const -> size_t = 0;
 };
 
 }  // namespace ballistica::base
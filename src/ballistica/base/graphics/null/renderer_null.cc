@@ -0,0 +1,715 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/graphics/null/renderer_null.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ballistica/base/app_adapter/app_adapter.h"
+#include "ballistica/base/assets/mesh_asset_renderer_data.h"
+#include "ballistica/base/assets/texture_asset_preload_data.h"
+#include "ballistica/base/assets/texture_asset_renderer_data.h"
+#include "ballistica/base/graphics/mesh/mesh_renderer_data.h"
+#include "ballistica/core/platform/core_platform.h"
+#include "ballistica/shared/ballistica.h"
+
+namespace ballistica::base {
+
+static const char kTraceMagic[] = "BANRTRC1";
+
+// Only log this many validation errors per renderer; a broken buffer
+// tends to break the same way every frame.
+static constexpr int kMaxLoggedErrors{10};
+
+// State shared with other threads.
+struct NullRendererShared_ {
+  std::mutex mutex;
+  RendererNull::Stats stats;
+  std::string trace_request;
+  bool active{};
+};
+
+static auto GetShared_() -> NullRendererShared_& {
+  // Intentionally leaked.
+  static auto* shared = new NullRendererShared_();
+  return *shared;
+}
+
+static void AddStats_(RendererNull::Stats* stats,
+                      const RendererNull::Stats& other) {
+  stats->frames += other.frames;
+  stats->buffers += other.buffers;
+  stats->commands += other.commands;
+  stats->draws += other.draws;
+  stats->instanced_draws += other.instanced_draws;
+  stats->batched_draws_saved += other.batched_draws_saved;
+  stats->shader_binds += other.shader_binds;
+  stats->shader_changes += other.shader_changes;
+  stats->texture_binds += other.texture_binds;
+  stats->state_changes += other.state_changes;
+  stats->blits += other.blits;
+  stats->upload_bytes += other.upload_bytes;
+  stats->validation_errors += other.validation_errors;
+}
+
+static auto GetTextureFormatBytesPerPixel_(TextureFormat format) -> int {
+  switch (format) {
+    case TextureFormat::kRGBA_8888:
+      return 4;
+    case TextureFormat::kRGB_888:
+      return 3;
+    case TextureFormat::kRGBA_4444:
+    case TextureFormat::kRGB_565:
+      return 2;
+    default:
+      return 0;
+  }
+}
+
+class RendererNull::TextureDataNull : public TextureAssetRendererData {
+ public:
+  TextureDataNull(const TextureAsset& texture, RendererNull* renderer)
+      : texture_{&texture}, renderer_{renderer} {}
+
+  // Tally what a real renderer would have pushed to the GPU.
+  void Load() override {
+    assert(g_base->app_adapter->InGraphicsContext());
+    size_t bytes{};
+    for (auto&& preload_data : texture_->preload_datas()) {
+      for (int level = preload_data.base_level;
+           level < kMaxTextureLevels && preload_data.buffers[level] != nullptr;
+           ++level) {
+        if (preload_data.sizes[level] > 0) {
+          // Compressed formats give us sizes explicitly.
+          bytes += preload_data.sizes[level];
+        } else {
+          bytes += static_cast<size_t>(preload_data.widths[level])
+                   * static_cast<size_t>(preload_data.heights[level])
+                   * GetTextureFormatBytesPerPixel_(
+                       preload_data.formats[level]);
+        }
+      }
+    }
+    renderer_->AddUploadBytes_(bytes);
+  }
+
+ private:
+  const TextureAsset* texture_;
+  RendererNull* renderer_;
+};
+
+class RendererNull::MeshAssetDataNull : public MeshAssetRendererData {
+ public:
+  MeshAssetDataNull(const MeshAsset& mesh, RendererNull* renderer) {
+    assert(g_base->app_adapter->InGraphicsContext());
+    renderer->AddUploadBytes_(
+        mesh.vertices().size() * sizeof(VertexObjectFull)
+        + mesh.indices8().size() + mesh.indices16().size() * sizeof(uint16_t)
+        + mesh.indices32().size() * sizeof(uint32_t));
+  }
+};
+
+class RendererNull::MeshDataNull : public MeshRendererData {};
+
+class RendererNull::RenderTargetNull : public RenderTarget {
+ public:
+  // Screen constructor.
+  RenderTargetNull() : RenderTarget(Type::kScreen) {
+    depth_ = true;
+    OnScreenSizeChange();
+  }
+
+  // Framebuffer constructor.
+  RenderTargetNull(int width, int height, bool depth)
+      : RenderTarget(Type::kFramebuffer) {
+    physical_width_ = static_cast<float>(width);
+    physical_height_ = static_cast<float>(height);
+    depth_ = depth;
+  }
+
+  void DrawBegin(bool clear, float clear_r, float clear_g, float clear_b,
+                 float clear_a) override {}
+};
+
+RendererNull::RendererNull() {
+  assert(g_base->app_adapter->InGraphicsContext());
+  auto& shared{GetShared_()};
+  std::scoped_lock lock(shared.mutex);
+  assert(!shared.active);
+  shared.active = true;
+}
+
+RendererNull::~RendererNull() {
+  if (trace_file_) {
+    fclose(trace_file_);
+  }
+  auto& shared{GetShared_()};
+  std::scoped_lock lock(shared.mutex);
+  shared.active = false;
+}
+
+auto RendererNull::active() -> bool {
+  auto& shared{GetShared_()};
+  std::scoped_lock lock(shared.mutex);
+  return shared.active;
+}
+
+auto RendererNull::GetStats() -> Stats {
+  auto& shared{GetShared_()};
+  std::scoped_lock lock(shared.mutex);
+  return shared.stats;
+}
+
+void RendererNull::ResetStats() {
+  auto& shared{GetShared_()};
+  std::scoped_lock lock(shared.mutex);
+  shared.stats = {};
+}
+
+auto RendererNull::GetStatsString() -> std::string {
+  auto stats = GetStats();
+  auto per_frame = [&stats](int64_t val) {
+    return stats.frames > 0
+               ? static_cast<double>(val) / static_cast<double>(stats.frames)
+               : 0.0;
+  };
+  char buffer[512];
+  snprintf(buffer, sizeof(buffer),
+           "Null renderer: %lld frames; per frame: %.1f draws"
+           " (%.1f instanced, %.1f saved by batching),"
+           " %.1f shader binds (%.1f changes),"
+           " %.1f texture binds, %.1f state changes, %.1f blits,"
+           " %.1f commands in %.1f buffers; %lld KB uploaded;"
+           " %lld validation errors.",
+           static_cast<long long>(stats.frames),  // NOLINT
+           per_frame(stats.draws), per_frame(stats.instanced_draws),
+           per_frame(stats.batched_draws_saved),
+           per_frame(stats.shader_binds), per_frame(stats.shader_changes),
+           per_frame(stats.texture_binds), per_frame(stats.state_changes),
+           per_frame(stats.blits), per_frame(stats.commands),
+           per_frame(stats.buffers),
+           static_cast<long long>(stats.upload_bytes / 1024),  // NOLINT
+           static_cast<long long>(stats.validation_errors));   // NOLINT
+  return buffer;
+}
+
+void RendererNull::RequestTrace(const std::string& path) {
+  BA_PRECONDITION(!path.empty());
+  auto& shared{GetShared_()};
+  std::scoped_lock lock(shared.mutex);
+  shared.trace_request = path;
+}
+
+auto RendererNull::GetAutoGraphicsQuality() -> GraphicsQuality {
+  // Exercise everything we can.
+  return GraphicsQuality::kHigher;
+}
+
+auto RendererNull::GetAutoTextureQuality() -> TextureQuality {
+  return TextureQuality::kHigh;
+}
+
+auto RendererNull::NewMeshAssetData(const MeshAsset& mesh)
+    -> Object::Ref<MeshAssetRendererData> {
+  return Object::New<MeshAssetRendererData, MeshAssetDataNull>(mesh, this);
+}
+
+auto RendererNull::NewTextureData(const TextureAsset& texture)
+    -> Object::Ref<TextureAssetRendererData> {
+  return Object::New<TextureAssetRendererData, TextureDataNull>(texture,
+                                                                 this);
+}
+
+auto RendererNull::NewMeshData(MeshDataType type,
+                               MeshDrawType draw_type) -> MeshRendererData* {
+  return new MeshDataNull();
+}
+
+void RendererNull::DeleteMeshData(MeshRendererData* data, MeshDataType type) {
+  assert(data && data == dynamic_cast<MeshDataNull*>(data));
+  delete data;
+}
+
+void RendererNull::UpdateMeshes(
+    const std::vector<Object::Ref<MeshDataClientHandle>>& meshes,
+    const std::vector<int8_t>& index_sizes,
+    const std::vector<Object::Ref<MeshBufferBase>>& buffers) {
+  for (auto&& buffer : buffers) {
+    // Buffers that didn't change since last time come through empty.
+    if (buffer.Exists()) {
+      AddUploadBytes_(buffer->GetDataSize());
+    }
+  }
+}
+
+auto RendererNull::GetShaderArgs_(ShadingType type) -> ShaderArgs_ {
+  // Ints, floats, and textures each shading type reads from a buffer
+  // (these must be kept in sync with RendererGL).
+  constexpr auto kS{ProgramFamily_::kSimple};
+  constexpr auto kO{ProgramFamily_::kObject};
+  constexpr auto kX{ProgramFamily_::kOther};
+  switch (type) {
+    case ShadingType::kSimpleColor:
+      return {0, 3, 0, kS};
+    case ShadingType::kSimpleColorTransparent:
+    case ShadingType::kSimpleColorTransparentDoubleSided:
+      return {1, 4, 0, kS};
+    case ShadingType::kSimpleTexture:
+      return {0, 0, 1, kS};
+    case ShadingType::kSimpleTextureModulated:
+      return {0, 3, 1, kS};
+    case ShadingType::kSimpleTextureModulatedColorized:
+      return {0, 6, 2, kS};
+    case ShadingType::kSimpleTextureModulatedColorized2:
+      return {0, 9, 2, kS};
+    case ShadingType::kSimpleTextureModulatedColorized2Masked:
+      return {0, 10, 3, kS};
+    case ShadingType::kSimpleTextureModulatedTransparent:
+    case ShadingType::kSimpleTextureModulatedTransparentDoubleSided:
+      return {1, 4, 1, kS};
+    case ShadingType::kSimpleTextureModulatedTransFlatness:
+      return {1, 5, 1, kS};
+    case ShadingType::kSimpleTextureModulatedTransparentColorized:
+      return {1, 7, 2, kS};
+    case ShadingType::kSimpleTextureModulatedTransparentColorized2:
+      return {1, 10, 2, kS};
+    case ShadingType::kSimpleTextureModulatedTransparentColorized2Masked:
+      return {1, 10, 3, kS};
+    case ShadingType::kSimpleTextureModulatedTransparentShadow:
+      return {1, 8, 2, kS};
+    case ShadingType::kSimpleTexModulatedTransShadowFlatness:
+      return {1, 9, 2, kS};
+    case ShadingType::kSimpleTextureModulatedTransparentGlow:
+      return {1, 6, 1, kS};
+    case ShadingType::kSimpleTextureModulatedTransparentGlowMaskUV2:
+      return {1, 6, 2, kS};
+    case ShadingType::kSpecial:
+      return {1, 0, 0, kS};
+    case ShadingType::kObject:
+      return {0, 3, 1, kO};
+    case ShadingType::kObjectTransparent:
+      return {1, 4, 1, kO};
+    case ShadingType::kObjectLightShadow:
+      return {2, 3, 1, kO};
+    case ShadingType::kObjectLightShadowTransparent:
+      return {2, 4, 1, kO};
+    case ShadingType::kObjectReflect:
+      return {1, 6, 2, kO};
+    case ShadingType::kObjectReflectTransparent:
+      return {1, 7, 2, kO};
+    case ShadingType::kObjectReflectAddTransparent:
+      return {1, 10, 2, kO};
+    case ShadingType::kObjectReflectLightShadow:
+    case ShadingType::kObjectReflectLightShadowDoubleSided:
+      return {2, 6, 2, kO};
+    case ShadingType::kObjectReflectLightShadowColorized:
+      return {1, 9, 3, kO};
+    case ShadingType::kObjectReflectLightShadowColorized2:
+      return {1, 12, 3, kO};
+    case ShadingType::kObjectReflectLightShadowAdd:
+      return {1, 9, 2, kO};
+    case ShadingType::kObjectReflectLightShadowAddColorized:
+      return {1, 12, 3, kO};
+    case ShadingType::kObjectReflectLightShadowAddColorized2:
+      return {1, 15, 3, kO};
+    case ShadingType::kSmoke:
+    case ShadingType::kSmokeOverlay:
+      return {0, 4, 1, kX};
+    case ShadingType::kPostProcess:
+    case ShadingType::kPostProcessEyes:
+    case ShadingType::kShield:
+      return {0, 0, 0, kX};
+    case ShadingType::kPostProcessNormalDistort:
+      return {0, 1, 0, kX};
+    case ShadingType::kSprite:
+      return {2, 4, 1, kX};
+    default:
+      throw Exception("Unhandled shading type "
+                      + std::to_string(static_cast<int>(type)) + ".");
+  }
+}
+
+void RendererNull::ValidationError_(const std::string& msg) {
+  frame_stats_.validation_errors++;
+  if (logged_error_count_ < kMaxLoggedErrors) {
+    logged_error_count_++;
+    Log(LogLevel::kError, "RendererNull: " + msg);
+  }
+}
+
+auto RendererNull::ReadArgs_(RenderCommandBuffer* buffer, int ints, int floats,
+                             int textures, int meshes,
+                             int mesh_datas) -> bool {
+  auto have = [](size_t remaining, int count) {
+    return remaining >= static_cast<size_t>(count);
+  };
+  if (!have(buffer->ints_remaining(), ints)
+      || !have(buffer->floats_remaining(), floats)
+      || !have(buffer->textures_remaining(), textures)
+      || !have(buffer->meshes_remaining(), meshes)
+      || !have(buffer->mesh_datas_remaining(), mesh_datas)) {
+    ValidationError_("Command buffer ran out of values.");
+    return false;
+  }
+  for (int i = 0; i < ints; ++i) {
+    args_ints_.push_back(buffer->GetInt());
+  }
+  for (int i = 0; i < floats; ++i) {
+    args_floats_.push_back(buffer->GetFloat());
+  }
+  for (int i = 0; i < textures; ++i) {
+    auto* texture = buffer->GetTexture();
+    if (texture == nullptr || !texture->loaded()) {
+      ValidationError_("Null or unloaded texture in command buffer.");
+      return false;
+    }
+    if (trace_file_) {
+      args_names_.push_back(texture->GetName());
+    }
+  }
+  for (int i = 0; i < meshes; ++i) {
+    auto* mesh = buffer->GetMesh();
+    if (mesh == nullptr || !mesh->loaded()) {
+      ValidationError_("Null or unloaded mesh in command buffer.");
+      return false;
+    }
+    if (trace_file_) {
+      args_names_.push_back(mesh->GetName());
+    }
+  }
+  for (int i = 0; i < mesh_datas; ++i) {
+    buffer->GetMeshRendererData<MeshDataNull>();
+    if (trace_file_) {
+      args_names_.emplace_back();
+    }
+  }
+  frame_stats_.texture_binds += textures;
+  args_texture_count_ += textures;
+  args_mesh_count_ += meshes + mesh_datas;
+  return true;
+}
+
+auto RendererNull::ProcessCommand_(RenderCommandBuffer* buffer,
+                                   RenderCommandBuffer::Command cmd) -> bool {
+  using Command = RenderCommandBuffer::Command;
+
+  // Anything that draws (or sets shader values) needs a shader bound.
+  switch (cmd) {
+    case Command::kDrawMeshAsset:
+    case Command::kDrawMeshAssetInstanced:
+    case Command::kDrawMesh:
+    case Command::kDrawScreenQuad:
+    case Command::kBeginDebugDrawTriangles:
+    case Command::kBeginDebugDrawLines:
+      if (program_family_ == ProgramFamily_::kNone) {
+        ValidationError_("Draw command with no shader bound.");
+        return false;
+      }
+      break;
+    case Command::kSimpleComponentInlineColor:
+      if (program_family_ != ProgramFamily_::kSimple) {
+        ValidationError_("Simple inline color without a simple shader.");
+        return false;
+      }
+      break;
+    case Command::kObjectComponentInlineColor:
+    case Command::kObjectComponentInlineAddColor:
+      if (program_family_ != ProgramFamily_::kObject) {
+        ValidationError_("Object inline color without an object shader.");
+        return false;
+      }
+      break;
+    default:
+      break;
+  }
+
+  switch (cmd) {
+    case Command::kShader: {
+      if (!ReadArgs_(buffer, 1, 0, 0, 0, 0)) {
+        return false;
+      }
+      int shader = args_ints_.back();
+      if (shader < 0 || shader >= static_cast<int>(ShadingType::kCount)) {
+        ValidationError_("Invalid shading type " + std::to_string(shader)
+                         + ".");
+        return false;
+      }
+      auto args = GetShaderArgs_(static_cast<ShadingType>(shader));
+      if (!ReadArgs_(buffer, args.ints, args.floats, args.textures, 0, 0)) {
+        return false;
+      }
+      frame_stats_.shader_binds++;
+      if (shader != shader_) {
+        frame_stats_.shader_changes++;
+        shader_ = shader;
+      }
+      program_family_ = args.family;
+      return true;
+    }
+    case Command::kSimpleComponentInlineColor:
+    case Command::kObjectComponentInlineColor:
+    case Command::kRotate:
+      return ReadArgs_(buffer, 0, 4, 0, 0, 0);
+    case Command::kObjectComponentInlineAddColor:
+    case Command::kDebugDrawVertex3:
+    case Command::kTranslate3:
+    case Command::kScale3:
+    case Command::kTranslateToProjectedPoint:
+      return ReadArgs_(buffer, 0, 3, 0, 0, 0);
+    case Command::kTranslate2:
+    case Command::kScale2:
+      return ReadArgs_(buffer, 0, 2, 0, 0, 0);
+    case Command::kScaleUniform:
+      return ReadArgs_(buffer, 0, 1, 0, 0, 0);
+    case Command::kMultMatrix:
+      return ReadArgs_(buffer, 0, 16, 0, 0, 0);
+    case Command::kDrawMeshAsset:
+      frame_stats_.draws++;
+      return ReadArgs_(buffer, 1, 0, 0, 1, 0);
+    case Command::kDrawMeshAssetInstanced: {
+      // Flags, mesh, and then a matrix count and that many matrices.
+      if (!ReadArgs_(buffer, 2, 0, 0, 1, 0)) {
+        return false;
+      }
+      int count = args_ints_.back();
+      if (count < 0) {
+        ValidationError_("Negative instance count.");
+        return false;
+      }
+      frame_stats_.instanced_draws++;
+      frame_stats_.draws += count;
+      return ReadArgs_(buffer, 0, count * 16, 0, 0, 0);
+    }
+    case Command::kDrawMesh:
+      frame_stats_.draws++;
+      return ReadArgs_(buffer, 1, 0, 0, 0, 1);
+    case Command::kDrawScreenQuad:
+      frame_stats_.draws++;
+      return true;
+    case Command::kScissorPush:
+      scissor_depth_++;
+      frame_stats_.state_changes++;
+      return ReadArgs_(buffer, 0, 4, 0, 0, 0);
+    case Command::kScissorPop:
+      if (scissor_depth_ <= 0) {
+        ValidationError_("Scissor pop without matching push.");
+        return false;
+      }
+      scissor_depth_--;
+      frame_stats_.state_changes++;
+      return true;
+    case Command::kPushTransform:
+      transform_depth_++;
+      return true;
+    case Command::kPopTransform:
+      if (transform_depth_ <= 0) {
+        ValidationError_("Transform pop without matching push.");
+        return false;
+      }
+      transform_depth_--;
+      return true;
+    case Command::kFlipCullFace:
+      FlipCullFace();
+      return true;
+    case Command::kCursorTranslate:
+#if BA_VR_BUILD
+    case Command::kTransformToRightHand:
+    case Command::kTransformToLeftHand:
+    case Command::kTransformToHead:
+#endif
+    case Command::kBeginDebugDrawTriangles:
+    case Command::kBeginDebugDrawLines:
+    case Command::kEndDebugDraw:
+      return true;
+    default:
+      ValidationError_("Invalid command "
+                       + std::to_string(static_cast<int>(cmd)) + ".");
+      return false;
+  }
+}
+
+void RendererNull::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
+                                              const RenderPass& pass,
+                                              RenderTarget* render_target) {
+  frame_stats_.buffers++;
+  frame_stats_.batched_draws_saved += buffer->batched_draws_saved();
+  transform_depth_ = 0;
+  scissor_depth_ = 0;
+  trace_buffer_.clear();
+  trace_command_count_ = 0;
+
+  buffer->ReadBegin();
+  bool valid{true};
+  RenderCommandBuffer::Command cmd;
+  while ((cmd = buffer->GetCommand()) != RenderCommandBuffer::Command::kEnd) {
+    frame_stats_.commands++;
+    args_ints_.clear();
+    args_floats_.clear();
+    args_names_.clear();
+    args_texture_count_ = 0;
+    args_mesh_count_ = 0;
+    if (!ProcessCommand_(buffer, cmd)) {
+      // Values are likely misaligned from here on out; give up on the
+      // rest of this buffer.
+      valid = false;
+      break;
+    }
+    if (trace_file_) {
+      TraceCommand_(cmd);
+    }
+  }
+  if (valid) {
+    if (transform_depth_ != 0 || scissor_depth_ != 0) {
+      ValidationError_("Unbalanced transform or scissor push/pop.");
+    } else if (!buffer->IsEmpty()) {
+      ValidationError_("Command buffer has unread values.");
+    }
+  }
+
+  if (trace_file_) {
+    uint8_t header[2] = {'B', static_cast<uint8_t>(pass.type())};
+    fwrite(header, sizeof(header), 1, trace_file_);
+    fwrite(&trace_command_count_, sizeof(trace_command_count_), 1,
+           trace_file_);
+    if (!trace_buffer_.empty()) {
+      fwrite(trace_buffer_.data(), trace_buffer_.size(), 1, trace_file_);
+    }
+  }
+}
+
+void RendererNull::TraceBytes_(const void* data, size_t size) {
+  auto* bytes = static_cast<const uint8_t*>(data);
+  trace_buffer_.insert(trace_buffer_.end(), bytes, bytes + size);
+}
+
+void RendererNull::TraceCommand_(RenderCommandBuffer::Command cmd) {
+  uint8_t cmd_val = static_cast<uint8_t>(cmd);
+  uint8_t int_count = static_cast_check_fit<uint8_t>(args_ints_.size());
+  auto float_count = static_cast_check_fit<uint32_t>(args_floats_.size());
+  uint8_t texture_count = static_cast_check_fit<uint8_t>(args_texture_count_);
+  uint8_t mesh_count = static_cast_check_fit<uint8_t>(args_mesh_count_);
+  TraceBytes_(&cmd_val, 1);
+  TraceBytes_(&int_count, 1);
+  TraceBytes_(&float_count, sizeof(float_count));
+  TraceBytes_(&texture_count, 1);
+  TraceBytes_(&mesh_count, 1);
+  for (int val : args_ints_) {
+    auto val32 = static_cast<int32_t>(val);
+    TraceBytes_(&val32, sizeof(val32));
+  }
+  if (!args_floats_.empty()) {
+    TraceBytes_(args_floats_.data(), args_floats_.size() * sizeof(float));
+  }
+  for (auto&& name : args_names_) {
+    auto size = static_cast<uint16_t>(std::min(name.size(), size_t{65535}));
+    TraceBytes_(&size, sizeof(size));
+    TraceBytes_(name.data(), size);
+  }
+  trace_command_count_++;
+}
+
+void RendererNull::RenderFrameDefEnd() {
+  frame_stats_.frames++;
+  std::string trace_request;
+  {
+    auto& shared{GetShared_()};
+    std::scoped_lock lock(shared.mutex);
+    AddStats_(&shared.stats, frame_stats_);
+    trace_request.swap(shared.trace_request);
+  }
+  frame_stats_ = {};
+
+  if (trace_file_) {
+    uint8_t end = 'E';
+    fwrite(&end, 1, 1, trace_file_);
+    fclose(trace_file_);
+    trace_file_ = nullptr;
+    Log(LogLevel::kInfo, "Wrote render trace to '" + trace_path_ + "'.");
+  }
+  if (!trace_request.empty()) {
+    trace_file_ = g_core->platform->FOpen(trace_request.c_str(), "wb");
+    if (trace_file_) {
+      trace_path_ = trace_request;
+      fwrite(kTraceMagic, strlen(kTraceMagic), 1, trace_file_);
+    } else {
+      Log(LogLevel::kError,
+          "Unable to open render trace file '" + trace_request + "'.");
+    }
+  }
+}
+
+void RendererNull::SetState_(bool* state, bool val) {
+  if (*state != val) {
+    *state = val;
+    frame_stats_.state_changes++;
+  }
+}
+
+void RendererNull::SetDepthWriting(bool enable) {
+  SetState_(&depth_writing_, enable);
+}
+
+void RendererNull::SetDepthTesting(bool enable) {
+  SetState_(&depth_testing_, enable);
+}
+
+void RendererNull::SetDrawAtEqualDepth(bool enable) {
+  SetState_(&draw_at_equal_depth_, enable);
+}
+
+void RendererNull::SetDepthRange(float min, float max) {
+  frame_stats_.state_changes++;
+}
+
+void RendererNull::FlipCullFace() { frame_stats_.state_changes++; }
+
+void RendererNull::BlitBuffer(RenderTarget* src, RenderTarget* dst,
+                              bool depth, bool linear_interpolation,
+                              bool force_shader_blit, bool invalidate_source) {
+  frame_stats_.blits++;
+}
+
+auto RendererNull::NewScreenRenderTarget() -> RenderTarget* {
+  return Object::NewDeferred<RenderTargetNull>();
+}
+
+auto RendererNull::NewFramebufferRenderTarget(
+    int width, int height, bool linear_interp, bool depth, bool texture,
+    bool depth_texture, bool high_quality, bool msaa,
+    bool alpha) -> Object::Ref<RenderTarget> {
+  return Object::New<RenderTarget, RenderTargetNull>(width, height, depth);
+}
+
+void RendererNull::DrawDebug() {}
+
+void RendererNull::CheckForErrors() {}
+
+void RendererNull::UpdateVignetteTex_(bool force) {}
+
+void RendererNull::GenerateCameraBufferBlurPasses() {}
+
+void RendererNull::InvalidateFramebuffer(bool color, bool depth,
+                                         bool target_read_framebuffer) {}
+
+void RendererNull::PushGroupMarker(const char* label) {}
+
+void RendererNull::PopGroupMarker() {}
+
+auto RendererNull::IsMSAAEnabled() const -> bool { return false; }
+
+void RendererNull::UpdateMSAAEnabled_() {}
+
+void RendererNull::VREyeRenderBegin() {}
+
+void RendererNull::CardboardDisableScissor() {}
+
+void RendererNull::CardboardEnableScissor() {}
+
+#if BA_VR_BUILD
+void RendererNull::VRSyncRenderStates() {}
+#endif
+
+}  // namespace ballistica::base
@@ -0,0 +1,168 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_GRAPHICS_NULL_RENDERER_NULL_H_
+#define BALLISTICA_BASE_GRAPHICS_NULL_RENDERER_NULL_H_
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "ballistica/base/graphics/renderer/renderer.h"
+
+namespace ballistica::base {
+
+/// A renderer that consumes frames without touching a GPU.
+///
+/// Command buffers are fully walked and validated (argument counts per
+/// command and shader, transform/scissor balance, etc.) and we keep counts
+/// of draws, state changes and the bytes a real renderer would have
+/// uploaded. This lets the entire frame-building and rendering pipeline be
+/// benchmarked on machines with no GL (CI boxes running SDL's dummy video
+/// driver, for instance). It can also write a binary trace of a frame's
+/// command stream for offline inspection or diffing.
+class RendererNull : public Renderer {
+  class TextureDataNull;
+  class MeshAssetDataNull;
+  class MeshDataNull;
+  class RenderTargetNull;
+
+ public:
+  struct Stats {
+    int64_t frames{};
+    int64_t buffers{};
+    int64_t commands{};
+    int64_t draws{};
+    int64_t instanced_draws{};
+    int64_t batched_draws_saved{};
+    int64_t shader_binds{};
+    int64_t shader_changes{};
+    int64_t texture_binds{};
+    int64_t state_changes{};
+    int64_t blits{};
+    int64_t upload_bytes{};
+    int64_t validation_errors{};
+  };
+
+  RendererNull();
+  ~RendererNull() override;
+
+  /// Whether a null renderer currently exists. Can be called from any
+  /// thread.
+  static auto active() -> bool;
+
+  /// Return cumulative stats from the null renderer. Can be called from
+  /// any thread.
+  static auto GetStats() -> Stats;
+  static auto GetStatsString() -> std::string;
+  static void ResetStats();
+
+  /// Write a binary trace of the next full frame rendered to the provided
+  /// path. Can be called from any thread.
+  ///
+  /// Trace layout (all values little-endian as written by the host):
+  ///   char[8] "BANRTRC1", then per command buffer:
+  ///   u8 'B', u8 pass-type, u32 command-count, then per command:
+  ///   u8 command, u8 int-count, u32 float-count, u8 texture-count,
+  ///   u8 mesh-count, followed by that many i32s and f32s and then a
+  ///   u16-length-prefixed name for each texture and mesh (dynamic meshes
+  ///   have empty names).
+  ///   The file ends with a single u8 'E'.
+  static void RequestTrace(const std::string& path);
+
+  auto GetAutoGraphicsQuality() -> GraphicsQuality override;
+  auto GetAutoTextureQuality() -> TextureQuality override;
+  auto NewMeshAssetData(const MeshAsset& mesh)
+      -> Object::Ref<MeshAssetRendererData> override;
+  auto NewTextureData(const TextureAsset& texture)
+      -> Object::Ref<TextureAssetRendererData> override;
+  auto NewMeshData(MeshDataType type,
+                   MeshDrawType draw_type) -> MeshRendererData* override;
+  void DeleteMeshData(MeshRendererData* data, MeshDataType type) override;
+  void ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
+                                  const RenderPass& pass,
+                                  RenderTarget* render_target) override;
+  void SetDepthRange(float min, float max) override;
+  void FlipCullFace() override;
+
+ protected:
+  void DrawDebug() override;
+  void CheckForErrors() override;
+  void UpdateVignetteTex_(bool force) override;
+  void GenerateCameraBufferBlurPasses() override;
+  void UpdateMeshes(
+      const std::vector<Object::Ref<MeshDataClientHandle>>& meshes,
+      const std::vector<int8_t>& index_sizes,
+      const std::vector<Object::Ref<MeshBufferBase>>& buffers) override;
+  void SetDepthWriting(bool enable) override;
+  void SetDepthTesting(bool enable) override;
+  void SetDrawAtEqualDepth(bool enable) override;
+  void InvalidateFramebuffer(bool color, bool depth,
+                             bool target_read_framebuffer) override;
+  auto NewScreenRenderTarget() -> RenderTarget* override;
+  auto NewFramebufferRenderTarget(int width, int height, bool linear_interp,
+                                  bool depth, bool texture, bool depth_texture,
+                                  bool high_quality, bool msaa, bool alpha)
+      -> Object::Ref<RenderTarget> override;
+  void PushGroupMarker(const char* label) override;
+  void PopGroupMarker() override;
+  void BlitBuffer(RenderTarget* src, RenderTarget* dst, bool depth,
+                  bool linear_interpolation, bool force_shader_blit,
+                  bool invalidate_source) override;
+  auto IsMSAAEnabled() const -> bool override;
+  void UpdateMSAAEnabled_() override;
+  void VREyeRenderBegin() override;
+  void RenderFrameDefEnd() override;
+  void CardboardDisableScissor() override;
+  void CardboardEnableScissor() override;
+#if BA_VR_BUILD
+  void VRSyncRenderStates() override;
+#endif
+
+ private:
+  // Which family of GL program a shading type binds; inline color
+  // commands are only valid following particular families.
+  enum class ProgramFamily_ : uint8_t { kNone, kSimple, kObject, kOther };
+  struct ShaderArgs_ {
+    uint8_t ints;
+    uint8_t floats;
+    uint8_t textures;
+    ProgramFamily_ family;
+  };
+  static auto GetShaderArgs_(ShadingType type) -> ShaderArgs_;
+  auto ProcessCommand_(RenderCommandBuffer* buffer,
+                       RenderCommandBuffer::Command cmd) -> bool;
+  auto ReadArgs_(RenderCommandBuffer* buffer, int ints, int floats,
+                 int textures, int meshes, int mesh_datas) -> bool;
+  void ValidationError_(const std::string& msg);
+  void SetState_(bool* state, bool val);
+  void AddUploadBytes_(size_t bytes) {
+    frame_stats_.upload_bytes += static_cast<int64_t>(bytes);
+  }
+  void TraceCommand_(RenderCommandBuffer::Command cmd);
+  void TraceBytes_(const void* data, size_t size);
+
+  Stats frame_stats_;
+  ProgramFamily_ program_family_{};
+  int shader_{-1};
+  int transform_depth_{};
+  int scissor_depth_{};
+  bool depth_writing_{};
+  bool depth_testing_{};
+  bool draw_at_equal_depth_{};
+  FILE* trace_file_{};
+  std::string trace_path_;
+  std::vector<uint8_t> trace_buffer_;
+  uint32_t trace_command_count_{};
+  int logged_error_count_{};
+
+  // Args read for the current command.
+  std::vector<int> args_ints_;
+  std::vector<float> args_floats_;
+  std::vector<std::string> args_names_;
+  int args_texture_count_{};
+  int args_mesh_count_{};
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_GRAPHICS_NULL_RENDERER_NULL_H_
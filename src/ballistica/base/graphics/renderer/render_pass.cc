@@ -3,6 +3,7 @@
 #include "ballistica/base/graphics/renderer/render_pass.h"
 
 #include "ballistica/base/app_adapter/app_adapter.h"
+#include "ballistica/base/graphics/graphics.h"
 #include "ballistica/base/graphics/graphics_server.h"
 #include "ballistica/base/graphics/renderer/renderer.h"
 
@@ -388,6 +389,28 @@ void RenderPass::SetCamera(
   cam_area_of_interest_points_ = area_of_interest_points;
 }
 
+auto RenderPass::GetViewFrustum() const -> ViewFrustum {
+  // Mirrors the projection setup in SetFrustum().
+  float tan_l, tan_r, tan_b, tan_t;
+  if (cam_use_fov_tangents_) {
+    tan_l = cam_fov_l_tan_;
+    tan_r = cam_fov_r_tan_;
+    tan_b = cam_fov_b_tan_;
+    tan_t = cam_fov_t_tan_;
+  } else {
+    tan_b = tan_t = tanf((cam_fov_y_ / 2.0f) * kPi / 180.0f);
+    if (cam_fov_x_ > 0.0f) {
+      tan_l = tan_r = tanf((cam_fov_x_ / 2.0f) * kPi / 180.0f);
+    } else {
+      tan_l = tan_r = tan_t * GetPhysicalAspectRatio();
+    }
+  }
+  ViewFrustum frustum;
+  frustum.Set(cam_pos_, cam_target_, cam_up_, cam_near_clip_, cam_far_clip_,
+              tan_l, tan_r, tan_b, tan_t);
+  return frustum;
+}
+
 void RenderPass::Reset() {
   virtual_width_ = 0;
   virtual_height_ = 0;
@@ -488,16 +511,76 @@ void RenderPass::SetFrustum(float near_val, float far_val) {
 }
 
 void RenderPass::Complete() {
+  assert(g_base->InLogicThread());
+  bool draw_batching = g_base->graphics->draw_batching();
   if (UsesWorldLists()) {
-    for (auto& command : commands_) {
+    for (int i = 0; i < static_cast<int>(ShadingType::kCount); ++i) {
+      auto& command{commands_[i]};
+      if (draw_batching) {
+        // Opaque lists are depth-tested so draw order within them doesn't
+        // matter; transparent ones need to keep theirs.
+        command->BatchDraws(
+            !Graphics::IsShaderTransparent(static_cast<ShadingType>(i)));
+      }
       command->Finalize();
     }
   } else {
+    if (draw_batching) {
+      commands_flat_->BatchDraws(false);
+      commands_flat_transparent_->BatchDraws(false);
+    }
     commands_flat_->Finalize();
     commands_flat_transparent_->Finalize();
   }
 }
 
+void RenderPass::BeginChunks(int count) {
+  assert(g_base->InLogicThread());
+  assert(count > 0 && chunk_count_ == 0);
+  while (chunks_.size() < static_cast<size_t>(count)) {
+    auto chunk = std::make_unique<ChunkCommands_>();
+    auto make_buffer = [this] {
+      auto buffer = std::make_unique<RenderCommandBuffer>();
+      buffer->set_frame_def(frame_def_);
+      buffer->set_defers_frame_def_refs(true);
+      return buffer;
+    };
+    if (UsesWorldLists()) {
+      for (auto& command : chunk->commands) {
+        command = make_buffer();
+      }
+    } else {
+      chunk->flat = make_buffer();
+      chunk->flat_transparent = make_buffer();
+    }
+    chunks_.push_back(std::move(chunk));
+  }
+  chunk_count_ = count;
+}
+
+void RenderPass::EndChunks() {
+  assert(g_base->InLogicThread());
+  assert(chunk_count_ > 0);
+  for (int i = 0; i < chunk_count_; ++i) {
+    auto& chunk{*chunks_[i]};
+    if (UsesWorldLists()) {
+      for (int j = 0; j < static_cast<int>(ShadingType::kCount); ++j) {
+        commands_[j]->Append(chunk.commands[j].get());
+      }
+    } else {
+      commands_flat_->Append(chunk.flat.get());
+      commands_flat_transparent_->Append(chunk.flat_transparent.get());
+    }
+  }
+  chunk_count_ = 0;
+}
+
+auto RenderPass::GetThreadChunk_() const -> ChunkCommands_* {
+  int chunk = FrameDef::thread_draw_chunk();
+  assert(chunk >= 0 && chunk < chunk_count_);
+  return chunks_[chunk].get();
+}
+
 auto RenderPass::HasDrawCommands() const -> bool {
   if (UsesWorldLists()) {
     throw Exception();
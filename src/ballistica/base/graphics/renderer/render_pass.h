@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "ballistica/base/base.h"
+#include "ballistica/base/graphics/support/view_frustum.h"
 #include "ballistica/shared/math/matrix44f.h"
 
 namespace ballistica::base {
@@ -97,6 +98,10 @@ class RenderPass {
                  float fov_y, bool use_fov_tangents, float fov_tan_l,
                  float fov_tan_r, float fov_tan_b, float fov_tan_t,
                  const std::vector<Vector3f>& area_of_interest_points);
+  /// Return the world-space view volume for the camera most recently set
+  /// via SetCamera(). Unlike our matrices, this is available in the logic
+  /// thread while the frame is being built.
+  auto GetViewFrustum() const -> ViewFrustum;
   auto frame_def() const -> FrameDef* { return frame_def_; }
   void Render(RenderTarget* t, bool transparent);
   auto tex_project_matrix() const -> const Matrix44f& {
@@ -115,6 +120,14 @@ class RenderPass {
   void Complete();
   void Reset();
 
+  /// Set up per-chunk command buffers for parallel drawing (see
+  /// FrameDef::BeginParallelDraw()). While active, our command accessors
+  /// return the buffers for the calling thread's chunk.
+  void BeginChunks(int count);
+
+  /// Append all chunk buffers to our regular ones in chunk order.
+  void EndChunks();
+
   // Whether this pass draws stuff from the per-shader command lists
   auto UsesWorldLists() const -> bool {
     switch (type()) {
@@ -136,12 +149,21 @@ class RenderPass {
     }
   }
   auto commands_flat() const -> RenderCommandBuffer* {
+    if (chunk_count_) {
+      return GetThreadChunk_()->flat.get();
+    }
     return commands_flat_.get();
   }
   auto commands_flat_transparent() const -> RenderCommandBuffer* {
+    if (chunk_count_) {
+      return GetThreadChunk_()->flat_transparent.get();
+    }
     return commands_flat_transparent_.get();
   }
   auto GetCommands(ShadingType type) const -> RenderCommandBuffer* {
+    if (chunk_count_) {
+      return GetThreadChunk_()->commands[static_cast<int>(type)].get();
+    }
     return commands_[static_cast<int>(type)].get();
   }
 
@@ -150,7 +172,15 @@ class RenderPass {
   }
 
  private:
+  // Deferred command buffers for one chunk of parallel drawing.
+  struct ChunkCommands_ {
+    std::unique_ptr<RenderCommandBuffer>
+        commands[static_cast<int>(ShadingType::kCount)];
+    std::unique_ptr<RenderCommandBuffer> flat;
+    std::unique_ptr<RenderCommandBuffer> flat_transparent;
+  };
   void SetFrustum(float near_val, float far_val);
+  auto GetThreadChunk_() const -> ChunkCommands_*;
 
   bool cam_use_fov_tangents_{};
   bool floor_reflection_{};
@@ -189,6 +219,11 @@ class RenderPass {
       commands_[static_cast<int>(ShadingType::kCount)];
   std::unique_ptr<RenderCommandBuffer> commands_flat_;
   std::unique_ptr<RenderCommandBuffer> commands_flat_transparent_;
+
+  // Chunk buffers are kept around between frames so their allocations get
+  // reused.
+  std::vector<std::unique_ptr<ChunkCommands_>> chunks_;
+  int chunk_count_{};
 };
 
 }  // namespace ballistica::base
@@ -82,6 +82,9 @@ class Camera : public Object {
   auto happy_thoughts_mode() const -> bool { return happy_thoughts_mode_; }
   auto NewAreaOfInterest(bool inFocus = true) -> AreaOfInterest*;
   void DeleteAreaOfInterest(AreaOfInterest* a);
+  auto areas_of_interest() const -> const std::list<AreaOfInterest>& {
+    return areas_of_interest_;
+  }
   auto mode() const -> CameraMode { return mode_; }
   void set_vr_offset(const Vector3f& val) { vr_offset_ = val; }
   void set_vr_extra_offset(const Vector3f& val) { vr_extra_offset_ = val; }
@@ -10,6 +10,9 @@
 
 namespace ballistica::base {
 
+// The chunk this thread is drawing into during parallel node drawing.
+static thread_local int g_thread_draw_chunk{-1};
+
 FrameDef::FrameDef()
     : light_pass_(new RenderPass(RenderPass::Type::kLightPass, this)),
       light_shadow_pass_(
@@ -114,6 +117,7 @@ void FrameDef::Reset() {
 
 void FrameDef::Complete() {
   assert(!defining_component_);
+  assert(parallel_draw_chunk_count_ == 0);
   light_pass_->Complete();
   light_shadow_pass_->Complete();
   beauty_pass_->Complete();
@@ -129,6 +133,64 @@ void FrameDef::Complete() {
   blit_pass_->Complete();
 }
 
+auto FrameDef::thread_draw_chunk() -> int { return g_thread_draw_chunk; }
+
+void FrameDef::SetThreadDrawChunk(int chunk) { g_thread_draw_chunk = chunk; }
+
+auto FrameDef::InDrawThread() -> bool {
+  return g_thread_draw_chunk >= 0 || g_base->InLogicThread();
+}
+
+void FrameDef::BeginParallelDraw(int chunk_count) {
+  assert(g_base->InLogicThread());
+  assert(chunk_count > 0);
+  BA_PRECONDITION(parallel_draw_chunk_count_ == 0);
+  parallel_draw_chunk_count_ = chunk_count;
+#if BA_DEBUG_BUILD
+  chunk_active_render_components_.assign(chunk_count, nullptr);
+#endif
+  light_pass_->BeginChunks(chunk_count);
+  light_shadow_pass_->BeginChunks(chunk_count);
+  beauty_pass_->BeginChunks(chunk_count);
+  beauty_pass_bg_->BeginChunks(chunk_count);
+  overlay_pass_->BeginChunks(chunk_count);
+  overlay_front_pass_->BeginChunks(chunk_count);
+  if (g_core->vr_mode()) {
+    overlay_fixed_pass_->BeginChunks(chunk_count);
+    overlay_flat_pass_->BeginChunks(chunk_count);
+    vr_cover_pass_->BeginChunks(chunk_count);
+  }
+  overlay_3d_pass_->BeginChunks(chunk_count);
+  blit_pass_->BeginChunks(chunk_count);
+  g_base->graphics->BeginBlotchChunks(chunk_count);
+}
+
+void FrameDef::EndParallelDraw() {
+  assert(g_base->InLogicThread());
+  assert(g_thread_draw_chunk == -1);
+  BA_PRECONDITION(parallel_draw_chunk_count_ > 0);
+#if BA_DEBUG_BUILD
+  for (auto* c : chunk_active_render_components_) {
+    assert(c == nullptr);
+  }
+#endif
+  light_pass_->EndChunks();
+  light_shadow_pass_->EndChunks();
+  beauty_pass_->EndChunks();
+  beauty_pass_bg_->EndChunks();
+  overlay_pass_->EndChunks();
+  overlay_front_pass_->EndChunks();
+  if (g_core->vr_mode()) {
+    overlay_fixed_pass_->EndChunks();
+    overlay_flat_pass_->EndChunks();
+    vr_cover_pass_->EndChunks();
+  }
+  overlay_3d_pass_->EndChunks();
+  blit_pass_->EndChunks();
+  g_base->graphics->EndBlotchChunks();
+  parallel_draw_chunk_count_ = 0;
+}
+
 void FrameDef::AddMesh(Mesh* mesh) {
   // Add this mesh's data to the frame only if we haven't yet.
   if (mesh->last_frame_def_num() != frame_number_) {
@@ -137,6 +137,25 @@ class FrameDef {
     }
   }
   void AddMesh(Mesh* mesh);
+
+  /// Parallel node drawing. Between these calls, a thread whose draw-chunk
+  /// is set (see SetThreadDrawChunk()) records into per-chunk command
+  /// buffers in each of our passes (and per-chunk blotch lists in
+  /// Graphics). EndParallelDraw() appends those to the regular ones in
+  /// chunk order, so the result is identical to drawing everything
+  /// serially in that order. Both calls must come from the logic thread.
+  void BeginParallelDraw(int chunk_count);
+  void EndParallelDraw();
+  auto parallel_draw_chunk_count() const { return parallel_draw_chunk_count_; }
+
+  /// The chunk the current thread is drawing into, or -1 if none.
+  static auto thread_draw_chunk() -> int;
+  static void SetThreadDrawChunk(int chunk);
+
+  /// Whether the current thread can currently build draw commands: the
+  /// logic thread, or any thread drawing a chunk.
+  static auto InDrawThread() -> bool;
+
   void set_needs_clear(bool val) { needs_clear_ = val; }
   auto needs_clear() const -> bool { return needs_clear_; }
 
@@ -207,9 +226,19 @@ class FrameDef {
 #if BA_DEBUG_BUILD
   // For debugging; there should ever only be a single RenderComponent writing
   // commands to us at once.
-  auto active_render_component() const { return active_render_component_; }
+  // (Tracked per chunk during parallel drawing).
+  auto active_render_component() const -> RenderComponent* {
+    int chunk = thread_draw_chunk();
+    return chunk >= 0 ? chunk_active_render_components_[chunk]
+                      : active_render_component_;
+  }
   void set_active_render_component(RenderComponent* c) {
-    active_render_component_ = c;
+    int chunk = thread_draw_chunk();
+    if (chunk >= 0) {
+      chunk_active_render_components_[chunk] = c;
+    } else {
+      active_render_component_ = c;
+    }
   }
 #endif
 
@@ -250,6 +279,7 @@ class FrameDef {
   // before new ones are started (so we dont get scrambled command buffers).
   bool defining_component_{};
   RenderComponent* active_render_component_{};
+  std::vector<RenderComponent*> chunk_active_render_components_;
 #endif
 
   std::unique_ptr<RenderPass> light_pass_;
@@ -271,6 +301,7 @@ class FrameDef {
   microsecs_t display_time_elapsed_millisecs_{};
   int64_t frame_number_{};
   int64_t frame_number_filtered_{};
+  int parallel_draw_chunk_count_{};
   Vector3f shadow_offset_{0.0f, 0.0f, 0.0f};
   Vector2f shadow_scale_{1.0f, 1.0f};
   Vector3f tint_{1.0f, 1.0f, 1.0f};
@@ -0,0 +1,377 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/graphics/support/render_command_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "ballistica/base/assets/mesh_asset.h"
+
+namespace ballistica::base {
+
+namespace {
+
+// A kShader command and everything up to the next one.
+struct BatchSegment {
+  size_t cmd_begin;
+  size_t cmd_end;
+  size_t i_begin;
+  size_t i_end;
+  size_t f_begin;
+  size_t f_end;
+  size_t m_begin;
+  size_t m_end;
+  size_t t_begin;
+  size_t t_end;
+  size_t md_begin;
+  size_t md_end;
+  size_t shader_ints;
+  size_t shader_floats;
+  int state{-1};
+  bool batchable{};
+};
+
+// A single mesh draw lifted out of a batchable segment.
+struct BatchItem {
+  int state;
+  int mesh_order;
+  int flags;
+  MeshAsset* mesh;
+  Matrix44f matrix;
+};
+
+// Output streams we build into; these get swapped with the buffer's own so
+// we hang on to their capacity from frame to frame.
+struct BatchScratch {
+  std::vector<BatchSegment> segments;
+  std::vector<BatchItem> items;
+  std::vector<int> state_segments;
+  std::unordered_multimap<uint64_t, int> state_hashes;
+  std::unordered_map<MeshAsset*, int> mesh_orders;
+};
+
+auto HashBytes(uint64_t hash, const void* data, size_t size) -> uint64_t {
+  // FNV-1a.
+  auto* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ bytes[i]) * 1099511628211ull;
+  }
+  return hash;
+}
+
+}  // namespace
+
+auto RenderCommandBuffer::BatchDraws(bool allow_reorder) -> int {
+  assert(!finalized_);
+  batched_draws_saved_ = 0;
+
+  // Quick out if there's nothing to merge.
+  int draw_count{};
+  for (auto cmd : commands_) {
+    if (cmd == Command::kDrawMeshAsset && ++draw_count > 1) {
+      break;
+    }
+  }
+  if (draw_count < 2 || shader_marks_.empty()) {
+    return 0;
+  }
+
+  static thread_local BatchScratch scratch;
+  auto& segments{scratch.segments};
+  auto& items{scratch.items};
+  segments.clear();
+  items.clear();
+  scratch.state_segments.clear();
+  scratch.state_hashes.clear();
+  scratch.mesh_orders.clear();
+
+  // Carve the buffer up into segments. Anything before the first shader
+  // is just passed through.
+  auto add_segment = [this, &segments](const Mark_& begin, const Mark_& end) {
+    BatchSegment seg{};
+    seg.cmd_begin = begin.commands;
+    seg.cmd_end = end.commands;
+    seg.i_begin = begin.ivals;
+    seg.i_end = end.ivals;
+    seg.f_begin = begin.fvals;
+    seg.f_end = end.fvals;
+    seg.m_begin = begin.meshes;
+    seg.m_end = end.meshes;
+    seg.t_begin = begin.textures;
+    seg.t_end = end.textures;
+    seg.md_begin = begin.mesh_datas;
+    seg.md_end = end.mesh_datas;
+    segments.push_back(seg);
+  };
+  if (shader_marks_.front().commands > 0) {
+    add_segment(Mark_{}, shader_marks_.front());
+  }
+  for (size_t i = 0; i < shader_marks_.size(); ++i) {
+    add_segment(shader_marks_[i], i + 1 < shader_marks_.size()
+                                      ? shader_marks_[i + 1]
+                                      : GetMark_());
+  }
+
+  // Find segments we can break into items: a shader followed by nothing
+  // but push/transform/draw-mesh-asset/pop sequences. We don't know how
+  // many values the shader itself wrote, but we know what everything
+  // else reads, so the shader gets the remainder.
+  for (auto&& seg : segments) {
+    if (commands_[seg.cmd_begin] != Command::kShader
+        || seg.md_end != seg.md_begin) {
+      continue;
+    }
+    size_t body_ints{}, body_floats{}, body_meshes{};
+    int depth{};
+    bool valid{true};
+    for (size_t c = seg.cmd_begin + 1; c < seg.cmd_end && valid; ++c) {
+      switch (commands_[c]) {
+        case Command::kPushTransform:
+          valid = (++depth == 1);
+          break;
+        case Command::kPopTransform:
+          valid = (--depth == 0);
+          break;
+        case Command::kTranslate2:
+        case Command::kScale2:
+          valid = (depth == 1);
+          body_floats += 2;
+          break;
+        case Command::kTranslate3:
+        case Command::kScale3:
+          valid = (depth == 1);
+          body_floats += 3;
+          break;
+        case Command::kScaleUniform:
+          valid = (depth == 1);
+          body_floats += 1;
+          break;
+        case Command::kRotate:
+          valid = (depth == 1);
+          body_floats += 4;
+          break;
+        case Command::kMultMatrix:
+          valid = (depth == 1);
+          body_floats += 16;
+          break;
+        case Command::kDrawMeshAsset:
+          body_ints += 1;
+          body_meshes += 1;
+          break;
+        default:
+          valid = false;
+          break;
+      }
+    }
+    if (!valid || depth != 0 || body_meshes == 0
+        || body_meshes != seg.m_end - seg.m_begin
+        || body_ints >= seg.i_end - seg.i_begin
+        || body_floats > seg.f_end - seg.f_begin) {
+      continue;
+    }
+    seg.shader_ints = seg.i_end - seg.i_begin - body_ints;
+    seg.shader_floats = seg.f_end - seg.f_begin - body_floats;
+    seg.batchable = true;
+
+    // Identical shader state (including textures) shares a state id.
+    uint64_t hash = 14695981039346656037ull;
+    hash = HashBytes(hash, &ivals_[seg.i_begin], seg.shader_ints * sizeof(int));
+    hash = HashBytes(hash, fvals_.data() + seg.f_begin,
+                     seg.shader_floats * sizeof(float));
+    hash = HashBytes(hash, textures_.data() + seg.t_begin,
+                     (seg.t_end - seg.t_begin) * sizeof(TextureAsset*));
+    auto range = scratch.state_hashes.equal_range(hash);
+    for (auto i = range.first; i != range.second && seg.state == -1; ++i) {
+      auto& other{segments[scratch.state_segments[i->second]]};
+      if (other.shader_ints == seg.shader_ints
+          && other.shader_floats == seg.shader_floats
+          && other.t_end - other.t_begin == seg.t_end - seg.t_begin
+          && std::equal(ivals_.begin() + seg.i_begin,
+                        ivals_.begin() + seg.i_begin + seg.shader_ints,
+                        ivals_.begin() + other.i_begin)
+          && !memcmp(fvals_.data() + seg.f_begin,
+                     fvals_.data() + other.f_begin,
+                     seg.shader_floats * sizeof(float))
+          && std::equal(textures_.begin() + seg.t_begin,
+                        textures_.begin() + seg.t_end,
+                        textures_.begin() + other.t_begin)) {
+        seg.state = i->second;
+      }
+    }
+    if (seg.state == -1) {
+      seg.state = static_cast<int>(scratch.state_segments.size());
+      scratch.state_segments.push_back(static_cast<int>(&seg - &segments[0]));
+      scratch.state_hashes.emplace(hash, seg.state);
+    }
+  }
+
+  // Now rebuild our streams, passing non-batchable segments through as-is
+  // and merging items between them.
+  std::vector<Command> commands;
+  std::vector<float> fvals;
+  std::vector<int> ivals;
+  std::vector<MeshAsset*> meshes;
+  std::vector<TextureAsset*> textures;
+  std::vector<MeshData*> mesh_datas;
+  std::vector<Mark_> shader_marks;
+  commands.reserve(commands_.size());
+  fvals.reserve(fvals_.size());
+  ivals.reserve(ivals_.size());
+  meshes.reserve(meshes_.size());
+  textures.reserve(textures_.size());
+  mesh_datas.reserve(mesh_datas_.size());
+
+  auto get_mark = [&] {
+    return Mark_{commands.size(), ivals.size(),    fvals.size(),
+                 meshes.size(),   textures.size(), mesh_datas.size()};
+  };
+  int item_count{};
+  int instanced_count{};
+
+  auto flush_items = [&] {
+    if (items.empty()) {
+      return;
+    }
+    if (allow_reorder) {
+      std::stable_sort(items.begin(), items.end(),
+                       [](const BatchItem& a, const BatchItem& b) {
+                         if (a.state != b.state) {
+                           return a.state < b.state;
+                         }
+                         if (a.mesh_order != b.mesh_order) {
+                           return a.mesh_order < b.mesh_order;
+                         }
+                         return a.flags < b.flags;
+                       });
+    }
+    int current_state{-1};
+    size_t i{};
+    while (i < items.size()) {
+      auto& item{items[i]};
+      if (item.state != current_state) {
+        auto& seg{segments[scratch.state_segments[item.state]]};
+        shader_marks.push_back(get_mark());
+        commands.push_back(Command::kShader);
+        ivals.insert(ivals.end(), ivals_.begin() + seg.i_begin,
+                     ivals_.begin() + seg.i_begin + seg.shader_ints);
+        fvals.insert(fvals.end(), fvals_.begin() + seg.f_begin,
+                     fvals_.begin() + seg.f_begin + seg.shader_floats);
+        textures.insert(textures.end(), textures_.begin() + seg.t_begin,
+                        textures_.begin() + seg.t_end);
+        current_state = item.state;
+      }
+      size_t end = i + 1;
+      while (end < items.size() && items[end].state == item.state
+             && items[end].mesh == item.mesh
+             && items[end].flags == item.flags) {
+        ++end;
+      }
+      commands.push_back(Command::kDrawMeshAssetInstanced);
+      ivals.push_back(item.flags);
+      meshes.push_back(item.mesh);
+      ivals.push_back(static_cast<int>(end - i));
+      for (size_t j = i; j < end; ++j) {
+        fvals.insert(fvals.end(), items[j].matrix.m, items[j].matrix.m + 16);
+      }
+      instanced_count++;
+      i = end;
+    }
+    item_count += static_cast<int>(items.size());
+    items.clear();
+  };
+
+  for (auto&& seg : segments) {
+    if (!seg.batchable) {
+      flush_items();
+      if (commands_[seg.cmd_begin] == Command::kShader) {
+        shader_marks.push_back(get_mark());
+      }
+      commands.insert(commands.end(), commands_.begin() + seg.cmd_begin,
+                      commands_.begin() + seg.cmd_end);
+      ivals.insert(ivals.end(), ivals_.begin() + seg.i_begin,
+                   ivals_.begin() + seg.i_end);
+      fvals.insert(fvals.end(), fvals_.begin() + seg.f_begin,
+                   fvals_.begin() + seg.f_end);
+      meshes.insert(meshes.end(), meshes_.begin() + seg.m_begin,
+                    meshes_.begin() + seg.m_end);
+      textures.insert(textures.end(), textures_.begin() + seg.t_begin,
+                      textures_.begin() + seg.t_end);
+      mesh_datas.insert(mesh_datas.end(), mesh_datas_.begin() + seg.md_begin,
+                        mesh_datas_.begin() + seg.md_end);
+      continue;
+    }
+
+    // Lift out each draw along with its accumulated transform (applied
+    // the same way the renderer would apply them).
+    size_t iv = seg.i_begin + seg.shader_ints;
+    size_t fv = seg.f_begin + seg.shader_floats;
+    size_t mv = seg.m_begin;
+    Matrix44f matrix{kMatrix44fIdentity};
+    for (size_t c = seg.cmd_begin + 1; c < seg.cmd_end; ++c) {
+      const float* f = fvals_.data() + fv;
+      switch (commands_[c]) {
+        case Command::kPushTransform:
+        case Command::kPopTransform:
+          matrix = kMatrix44fIdentity;
+          break;
+        case Command::kTranslate2:
+          matrix = Matrix44fTranslate(Vector3f(f[0], f[1], 0.0f)) * matrix;
+          fv += 2;
+          break;
+        case Command::kTranslate3:
+          matrix = Matrix44fTranslate(Vector3f(f[0], f[1], f[2])) * matrix;
+          fv += 3;
+          break;
+        case Command::kScale2:
+          matrix = Matrix44fScale(Vector3f(f[0], f[1], 1.0f)) * matrix;
+          fv += 2;
+          break;
+        case Command::kScale3:
+          matrix = Matrix44fScale(Vector3f(f[0], f[1], f[2])) * matrix;
+          fv += 3;
+          break;
+        case Command::kScaleUniform:
+          matrix = Matrix44fScale(Vector3f(f[0], f[0], f[0])) * matrix;
+          fv += 1;
+          break;
+        case Command::kRotate:
+          matrix = Matrix44fRotate(Vector3f(f[1], f[2], f[3]), f[0]) * matrix;
+          fv += 4;
+          break;
+        case Command::kMultMatrix:
+          matrix = *reinterpret_cast<const Matrix44f*>(f) * matrix;
+          fv += 16;
+          break;
+        case Command::kDrawMeshAsset: {
+          auto* mesh = meshes_[mv++];
+          auto order = scratch.mesh_orders.emplace(
+              mesh, static_cast<int>(scratch.mesh_orders.size()));
+          items.push_back(
+              {seg.state, order.first->second, ivals_[iv++], mesh, matrix});
+          break;
+        }
+        default:
+          FatalError("Unexpected command in batchable segment.");
+      }
+    }
+    assert(iv == seg.i_end && fv == seg.f_end && mv == seg.m_end);
+  }
+  flush_items();
+
+  int saved = item_count - instanced_count;
+  if (saved > 0) {
+    commands_.swap(commands);
+    fvals_.swap(fvals);
+    ivals_.swap(ivals);
+    meshes_.swap(meshes);
+    textures_.swap(textures);
+    mesh_datas_.swap(mesh_datas);
+    shader_marks_.swap(shader_marks);
+    batched_draws_saved_ = saved;
+  }
+  return saved;
+}
+
+}  // namespace ballistica::base
@@ -55,6 +55,9 @@ class RenderCommandBuffer {
   RenderCommandBuffer() = default;
   void PutCommand(Command c) {
     assert(!finalized_);
+    if (c == Command::kShader) {
+      shader_marks_.push_back(GetMark_());
+    }
     commands_.push_back(c);
   }
 
@@ -257,14 +260,18 @@ class RenderCommandBuffer {
   void PutMeshAsset(MeshAsset* mesh) {
     assert(frame_def_);
     assert(!finalized_);
-    frame_def_->AddComponent(Object::Ref<Asset>(mesh));
+    if (!defers_frame_def_refs_) {
+      frame_def_->AddComponent(Object::Ref<Asset>(mesh));
+    }
     meshes_.push_back(mesh);
   }
 
   void PutTexture(TextureAsset* texture) {
     assert(frame_def_);
     assert(!finalized_);
-    frame_def_->AddComponent(Object::Ref<Asset>(texture));
+    if (!defers_frame_def_refs_) {
+      frame_def_->AddComponent(Object::Ref<Asset>(texture));
+    }
     textures_.push_back(texture);
   }
 
@@ -276,10 +283,23 @@ class RenderCommandBuffer {
   void PutCubeMapTexture(TextureAsset* texture) {
     assert(frame_def_);
     assert(!finalized_);
-    frame_def_->AddComponent(Object::Ref<Asset>(texture));
+    if (!defers_frame_def_refs_) {
+      frame_def_->AddComponent(Object::Ref<Asset>(texture));
+    }
     textures_.push_back(texture);
   }
 
+  /// Register a mesh about to be drawn through us with our frame-def.
+  void AddMesh(Mesh* mesh) {
+    assert(frame_def_);
+    assert(!finalized_);
+    if (defers_frame_def_refs_) {
+      deferred_meshes_.push_back(mesh);
+    } else {
+      frame_def_->AddMesh(mesh);
+    }
+  }
+
   void PutMeshData(MeshData* mesh_data) {
     assert(!finalized_);
     mesh_datas_.push_back(mesh_data);
@@ -503,9 +523,63 @@ class RenderCommandBuffer {
     meshes_.resize(0);
     textures_.resize(0);
     mesh_datas_.resize(0);
+    deferred_meshes_.resize(0);
+    shader_marks_.resize(0);
+    batched_draws_saved_ = 0;
     finalized_ = false;
   }
 
+  /// Append everything written to a deferred buffer (see
+  /// set_defers_frame_def_refs()) to the end of this one and reset it.
+  /// This is where our frame-def picks up references to the assets and
+  /// meshes the other buffer used, so it must happen in the logic thread.
+  void Append(RenderCommandBuffer* other) {
+    assert(frame_def_ && other->frame_def_ == frame_def_);
+    assert(!finalized_ && !other->finalized_);
+    assert(!defers_frame_def_refs_ && other->defers_frame_def_refs_);
+    for (auto* mesh : other->meshes_) {
+      frame_def_->AddComponent(Object::Ref<Asset>(mesh));
+    }
+    for (auto* texture : other->textures_) {
+      frame_def_->AddComponent(Object::Ref<Asset>(texture));
+    }
+    for (auto* mesh : other->deferred_meshes_) {
+      frame_def_->AddMesh(mesh);
+    }
+    auto base = GetMark_();
+    for (auto&& mark : other->shader_marks_) {
+      shader_marks_.push_back(
+          {mark.commands + base.commands, mark.ivals + base.ivals,
+           mark.fvals + base.fvals, mark.meshes + base.meshes,
+           mark.textures + base.textures, mark.mesh_datas + base.mesh_datas});
+    }
+    commands_.insert(commands_.end(), other->commands_.begin(),
+                     other->commands_.end());
+    fvals_.insert(fvals_.end(), other->fvals_.begin(), other->fvals_.end());
+    ivals_.insert(ivals_.end(), other->ivals_.begin(), other->ivals_.end());
+    meshes_.insert(meshes_.end(), other->meshes_.begin(),
+                   other->meshes_.end());
+    textures_.insert(textures_.end(), other->textures_.begin(),
+                     other->textures_.end());
+    mesh_datas_.insert(mesh_datas_.end(), other->mesh_datas_.begin(),
+                       other->mesh_datas_.end());
+    other->Reset();
+  }
+
+  /// Coalesce simple mesh draws sharing identical shader state into
+  /// instanced draws, so each distinct shader/texture/mesh combo gets set
+  /// up once. Only draws wrapped in their own transform push/pop (or
+  /// untransformed) with plain translate/rotate/scale/matrix transforms
+  /// are touched; anything else stays put and acts as a barrier. If
+  /// allow_reorder is true, draws between barriers are also grouped by
+  /// state (only valid for depth-tested opaque lists); otherwise only
+  /// adjacent matches merge. Call just before Finalize(). Returns the
+  /// number of draw commands saved.
+  auto BatchDraws(bool allow_reorder) -> int;
+
+  /// Draw commands saved by BatchDraws().
+  auto batched_draws_saved() const { return batched_draws_saved_; }
+
   // Call once done writing to buffer.
   void Finalize() {
     assert(!finalized_);
@@ -546,6 +620,23 @@ class RenderCommandBuffer {
         && (mesh_datas_index_ == mesh_datas_.size()));
   }
 
+  // Unread values in each stream. The Get calls above only bounds-check in
+  // debug builds, so anything wanting to validate a buffer before trusting
+  // it should check these first.
+  auto ints_remaining() const -> size_t { return ivals_.size() - ivals_index_; }
+  auto floats_remaining() const -> size_t {
+    return fvals_.size() - fvals_index_;
+  }
+  auto meshes_remaining() const -> size_t {
+    return meshes_.size() - meshes_index_;
+  }
+  auto textures_remaining() const -> size_t {
+    return textures_.size() - textures_index_;
+  }
+  auto mesh_datas_remaining() const -> size_t {
+    return mesh_datas_.size() - mesh_datas_index_;
+  }
+
   auto frame_def() const -> FrameDef* {
     assert(frame_def_);
     return frame_def_;
@@ -553,20 +644,45 @@ class RenderCommandBuffer {
 
   void set_frame_def(FrameDef* f) { frame_def_ = f; }
 
+  /// Deferred buffers don't touch their frame-def (or any ref-counts) while
+  /// being written to, which allows them to be filled from worker threads.
+  /// They must then be passed to Append() on a regular buffer, which does
+  /// that bookkeeping in the logic thread.
+  auto defers_frame_def_refs() const { return defers_frame_def_refs_; }
+  void set_defers_frame_def_refs(bool val) { defers_frame_def_refs_ = val; }
+
  private:
+  // Stream positions at a kShader command.
+  struct Mark_ {
+    size_t commands;
+    size_t ivals;
+    size_t fvals;
+    size_t meshes;
+    size_t textures;
+    size_t mesh_datas;
+  };
+  auto GetMark_() const -> Mark_ {
+    return {commands_.size(), ivals_.size(),    fvals_.size(),
+            meshes_.size(),   textures_.size(), mesh_datas_.size()};
+  }
+
   std::vector<Command> commands_;
   std::vector<float> fvals_;
   std::vector<int> ivals_;
   std::vector<MeshAsset*> meshes_{};
   std::vector<TextureAsset*> textures_{};
   std::vector<MeshData*> mesh_datas_{};
+  std::vector<Mesh*> deferred_meshes_{};
+  std::vector<Mark_> shader_marks_;
   unsigned int commands_index_{};
   unsigned int fvals_index_{};
   unsigned int ivals_index_{};
   unsigned int meshes_index_{};
   unsigned int textures_index_{};
   unsigned int mesh_datas_index_{};
+  int batched_draws_saved_{};
   bool finalized_{};
+  bool defers_frame_def_refs_{};
   FrameDef* frame_def_{};
 };
 
@@ -0,0 +1,45 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/graphics/support/view_frustum.h"
+
+namespace ballistica::base {
+
+void ViewFrustum::Set(const Vector3f& pos, const Vector3f& target,
+                      const Vector3f& up, float near_clip, float far_clip,
+                      float tan_l, float tan_r, float tan_b, float tan_t) {
+  Vector3f fwd = (target - pos).Normalized();
+  Vector3f right = Vector3f::Cross(fwd, up).Normalized();
+  Vector3f up2 = Vector3f::Cross(right, fwd);
+
+  // All normals point inward; a point is inside a plane when
+  // dot(normal, point) + offset >= 0. Side planes pass through the camera
+  // position so they don't need normalizing for our sign tests.
+  planes_[0].normal = fwd;
+  planes_[0].offset = -fwd.Dot(pos) - near_clip;
+  planes_[1].normal = -fwd;
+  planes_[1].offset = fwd.Dot(pos) + far_clip;
+  planes_[2].normal = fwd * tan_l + right;
+  planes_[3].normal = fwd * tan_r - right;
+  planes_[4].normal = fwd * tan_b + up2;
+  planes_[5].normal = fwd * tan_t - up2;
+  for (int i = 2; i < 6; ++i) {
+    planes_[i].offset = -planes_[i].normal.Dot(pos);
+  }
+}
+
+auto ViewFrustum::IntersectsBox(const Vector3f& min,
+                                const Vector3f& max) const -> bool {
+  for (auto&& plane : planes_) {
+    // Test the box corner furthest along the plane normal; if even that is
+    // outside, the whole box is.
+    const Vector3f& n{plane.normal};
+    Vector3f p{n.x >= 0.0f ? max.x : min.x, n.y >= 0.0f ? max.y : min.y,
+               n.z >= 0.0f ? max.z : min.z};
+    if (n.Dot(p) + plane.offset < 0.0f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace ballistica::base
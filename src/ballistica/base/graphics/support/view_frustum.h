@@ -0,0 +1,43 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_GRAPHICS_SUPPORT_VIEW_FRUSTUM_H_
+#define BALLISTICA_BASE_GRAPHICS_SUPPORT_VIEW_FRUSTUM_H_
+
+#include "ballistica/shared/math/vector3f.h"
+
+namespace ballistica::base {
+
+/// A perspective view volume in world space, used for rejecting things
+/// that can't possibly be visible before we bother building draw
+/// commands for them.
+class ViewFrustum {
+ public:
+  /// Set up from a camera; tangents are of the half-angles to each edge of
+  /// the view (as with the fov-tangent camera setup in RenderPass).
+  void Set(const Vector3f& pos, const Vector3f& target, const Vector3f& up,
+           float near_clip, float far_clip, float tan_l, float tan_r,
+           float tan_b, float tan_t);
+
+  /// Return whether an axis-aligned box may overlap the view. This is
+  /// conservative; boxes near corners of the volume may pass even if
+  /// they're just outside.
+  auto IntersectsBox(const Vector3f& min, const Vector3f& max) const -> bool;
+
+  /// Same as IntersectsBox() but for the box's mirror image across the
+  /// y=0 plane (what floor reflections draw).
+  auto IntersectsBoxMirrored(const Vector3f& min, const Vector3f& max) const
+      -> bool {
+    return IntersectsBox({min.x, -max.y, min.z}, {max.x, -min.y, max.z});
+  }
+
+ private:
+  struct Plane_ {
+    Vector3f normal;
+    float offset;
+  };
+  Plane_ planes_[6]{};
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_GRAPHICS_SUPPORT_VIEW_FRUSTUM_H_
@@ -24,6 +24,13 @@ Logic::Logic() : display_timers_(new TimerList()) {
   if (val && *val == "1") {
     debug_log_display_time_ = true;
   }
+
+  // Enable headless max-speed mode via env var. This only takes effect in
+  // headless builds.
+  auto max_speed_val = g_core->platform->GetEnv("BA_HEADLESS_MAX_SPEED");
+  if (max_speed_val && *max_speed_val == "1" && g_core->HeadlessMode()) {
+    headless_max_speed_ = true;
+  }
 }
 
 void Logic::OnMainThreadStartApp() {
@@ -99,8 +106,12 @@ void Logic::OnGraphicsReady() {
     // Anyone dealing in display-time should be able to handle a wide
     // variety of rates anyway. NOTE: This length is currently milliseconds.
     headless_display_time_step_timer_ = event_loop()->NewTimer(
-        kHeadlessMinDisplayTimeStep, true,
+        headless_max_speed_ ? 0 : kHeadlessMinDisplayTimeStep, true,
         NewLambdaRunnable([this] { StepDisplayTime_(); }).Get());
+    if (headless_max_speed_) {
+      ResetHeadlessMaxSpeedStats_();
+      Log(LogLevel::kInfo, "Headless max-speed mode enabled.");
+    }
   } else {
     // In gui mode, push an initial frame to the graphics server. From this
     // point it will be self-sustaining, sending us a frame request each
@@ -382,8 +393,54 @@ void Logic::OnAppModeChanged() {
           "Resetting headless display step timer due to app-mode change.");
     }
     assert(headless_display_time_step_timer_);
-    headless_display_time_step_timer_->SetLength(kHeadlessMinDisplayTimeStep);
+    headless_display_time_step_timer_->SetLength(
+        headless_max_speed_ ? 0 : kHeadlessMinDisplayTimeStep);
+  }
+}
+
+void Logic::SetHeadlessMaxSpeed(bool enable) {
+  assert(g_base->InLogicThread());
+  if (!g_core->HeadlessMode()) {
+    throw Exception("Max-speed mode is only available in headless mode.");
   }
+  if (enable == headless_max_speed_) {
+    return;
+  }
+  headless_max_speed_ = enable;
+  if (enable) {
+    ResetHeadlessMaxSpeedStats_();
+  }
+
+  // Snap out of any sleep we're in (or back into regular pacing). Note
+  // that this may get called before our timer exists; in that case it will
+  // get created with the right length.
+  if (headless_display_time_step_timer_) {
+    headless_display_time_step_timer_->SetLength(
+        enable ? 0 : kHeadlessMinDisplayTimeStep);
+  }
+  Log(LogLevel::kInfo, std::string("Headless max-speed mode ")
+                           + (enable ? "enabled." : "disabled."));
+}
+
+void Logic::ResetHeadlessMaxSpeedStats_() {
+  auto real_time = core::CorePlatform::GetCurrentMicrosecs();
+  headless_max_speed_start_display_time_ = display_time_microsecs_;
+  headless_max_speed_start_real_time_ = real_time;
+  headless_max_speed_last_report_real_time_ = real_time;
+}
+
+auto Logic::GetHeadlessMaxSpeedRatio() const -> double {
+  if (!headless_max_speed_) {
+    return 0.0;
+  }
+  auto real_elapsed = core::CorePlatform::GetCurrentMicrosecs()
+                      - headless_max_speed_start_real_time_;
+  if (real_elapsed <= 0) {
+    return 0.0;
+  }
+  auto sim_elapsed =
+      display_time_microsecs_ - headless_max_speed_start_display_time_;
+  return static_cast<double>(sim_elapsed) / static_cast<double>(real_elapsed);
 }
 
 void Logic::UpdateDisplayTimeForHeadlessMode_() {
@@ -398,11 +455,23 @@ void Logic::UpdateDisplayTimeForHeadlessMode_() {
 
   auto app_time_microsecs = g_core->GetAppTimeMicrosecs();
 
-  // Set our int based time vals so we can exactly hit timers.
-  auto old_display_time_microsecs = display_time_microsecs_;
-  display_time_microsecs_ = app_time_microsecs;
-  display_time_increment_microsecs_ =
-      display_time_microsecs_ - old_display_time_microsecs;
+  if (headless_max_speed_) {
+    // In max-speed mode we ignore how much real time has passed and
+    // simply advance by a fixed step each time through, dragging app-time
+    // along with us so app-timers stay consistent with display-time. Using
+    // a constant step keeps results deterministic.
+    display_time_increment_microsecs_ = kHeadlessMaxSpeedDisplayTimeStep;
+    display_time_microsecs_ += display_time_increment_microsecs_;
+    if (display_time_microsecs_ > app_time_microsecs) {
+      g_core->AdvanceAppTime(display_time_microsecs_ - app_time_microsecs);
+    }
+  } else {
+    // Set our int based time vals so we can exactly hit timers.
+    auto old_display_time_microsecs = display_time_microsecs_;
+    display_time_microsecs_ = app_time_microsecs;
+    display_time_increment_microsecs_ =
+        display_time_microsecs_ - old_display_time_microsecs;
+  }
 
   // And then our float time vals are driven by our int ones.
   display_time_ = static_cast<double>(display_time_microsecs_) / 1000000.0;
@@ -419,6 +488,23 @@ void Logic::UpdateDisplayTimeForHeadlessMode_() {
 
 void Logic::PostUpdateDisplayTimeForHeadlessMode_() {
   assert(g_base->InLogicThread());
+
+  // In max-speed mode we never sleep; we just go again immediately
+  // (though our event loop still processes messages between steps).
+  if (headless_max_speed_) {
+    auto real_time = core::CorePlatform::GetCurrentMicrosecs();
+    if (real_time - headless_max_speed_last_report_real_time_
+        >= kHeadlessMaxSpeedReportInterval) {
+      headless_max_speed_last_report_real_time_ = real_time;
+      char buffer[256];
+      snprintf(buffer, sizeof(buffer),
+               "Headless max-speed: %.2f simulated seconds per wall second.",
+               GetHeadlessMaxSpeedRatio());
+      Log(LogLevel::kInfo, buffer);
+    }
+    headless_display_time_step_timer_->SetLength(0);
+    return;
+  }
   // At this point we've stepped our app-mode, so let's ask it how long
   // we've got until the next event. We'll plug this into our display-update
   // timer so we can try to sleep exactly until that point.
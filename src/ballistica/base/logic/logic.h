@@ -21,6 +21,14 @@ const microsecs_t kHeadlessMaxDisplayTimeStep{500000};
 /// limit on stepping overhead in cases where events are densely packed.
 const microsecs_t kHeadlessMinDisplayTimeStep{1000};
 
+/// The display-time step used by headless max-speed mode. This is exactly
+/// two sim steps, which lets sessions advance cleanly and deterministically.
+const microsecs_t kHeadlessMaxSpeedDisplayTimeStep{16000};
+
+/// How often (in real microseconds) headless max-speed mode logs its
+/// simulated-seconds-per-wall-second rate.
+const microsecs_t kHeadlessMaxSpeedReportInterval{10000000};
+
 /// The logic subsystem of the app. This runs on a dedicated thread and is
 /// where most high level app logic happens. Much app functionality
 /// including UI calls must be run on the logic thread.
@@ -122,10 +130,23 @@ class Logic {
 
   auto app_active() const { return app_active_; }
 
+  /// Enable or disable headless max-speed mode. In this mode display-time
+  /// advances by a fixed step each time through the loop with no real
+  /// sleeping, and app-time is dragged along with it. This lets bots,
+  /// soak-tests, and replay analysis run as fast as the CPU allows. Only
+  /// available in headless mode.
+  void SetHeadlessMaxSpeed(bool enable);
+  auto headless_max_speed() const { return headless_max_speed_; }
+
+  /// Return simulated display-time seconds per wall-clock second since
+  /// headless max-speed mode was last enabled (or 0 if it is not enabled).
+  auto GetHeadlessMaxSpeedRatio() const -> double;
+
  private:
   void UpdateDisplayTimeForFrameDraw_();
   void UpdateDisplayTimeForHeadlessMode_();
   void PostUpdateDisplayTimeForHeadlessMode_();
+  void ResetHeadlessMaxSpeedStats_();
   void CompleteAppBootstrapping_();
   void ProcessPendingWork_();
   void UpdatePendingWorkTimer_();
@@ -138,6 +159,9 @@ class Logic {
 
   // Headless scheduling.
   Timer* headless_display_time_step_timer_{};
+  microsecs_t headless_max_speed_start_display_time_{};
+  microsecs_t headless_max_speed_start_real_time_{};
+  microsecs_t headless_max_speed_last_report_real_time_{};
 
   // GUI scheduling.
   seconds_t last_display_time_update_app_time_{-1.0};
@@ -150,6 +174,7 @@ class Logic {
   bool app_bootstrapping_complete_{};
   bool have_pending_loads_{};
   bool debug_log_display_time_{};
+  bool headless_max_speed_{};
   bool applied_app_config_{};
   bool shutting_down_{};
   bool shutdown_completed_{};
@@ -2,19 +2,215 @@
 
 #include "ballistica/base/networking/network_reader.h"
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include "ballistica/base/app_mode/app_mode.h"
 #include "ballistica/base/input/support/remote_app_server.h"
 #include "ballistica/base/logic/logic.h"
 #include "ballistica/core/platform/core_platform.h"
 #include "ballistica/shared/foundation/event_loop.h"
 #include "ballistica/shared/generic/json.h"
+#include "ballistica/shared/generic/json_arena.h"
 #include "ballistica/shared/math/vector3f.h"
 #include "ballistica/shared/networking/sockaddr.h"
 
 namespace ballistica::base {
 
+// Admission budgets, in packets per second; buckets hold up to two
+// seconds' worth for bursts. Known addresses get theirs per connection
+// since several clients can share an address behind a NAT.
+static const float kKnownPacketsPerSecond{1000.0f};
+static const float kUnknownPacketsPerSecond{20.0f};
+
+// For all unknown senders combined; catches floods from spoofed or
+// rotating addresses that per-source budgets can't.
+static const float kUnknownTotalPacketsPerSecond{400.0f};
+
+static const size_t kMaxTrackedSources{4096};
+static const millisecs_t kSourcePruneInterval{10000};
+
+// Client requests carry an app-instance id; anything this big is junk.
+static const size_t kMaxClientRequestSize{256};
+
 NetworkReader::NetworkReader() = default;
 
+// Budgets are per address (not address and port) so hopping ports buys a
+// sender nothing.
+static auto SourceKey_(const sockaddr* addr) -> std::string {
+  if (addr->sa_family == AF_INET6) {
+    auto* a = reinterpret_cast<const sockaddr_in6*>(addr);
+    return {reinterpret_cast<const char*>(&a->sin6_addr),
+            sizeof(a->sin6_addr)};
+  }
+  auto* a = reinterpret_cast<const sockaddr_in*>(addr);
+  return {reinterpret_cast<const char*>(&a->sin_addr), sizeof(a->sin_addr)};
+}
+
+// Refill a token bucket for elapsed time and take a token from it if
+// there is one.
+static auto TakeToken_(float* tokens, millisecs_t* last_refill_time,
+                       millisecs_t now, float rate) -> bool {
+  auto elapsed = static_cast<float>(now - *last_refill_time) * 0.001f;
+  *last_refill_time = now;
+  *tokens = std::min(rate * 2.0f, *tokens + std::max(0.0f, elapsed) * rate);
+  if (*tokens < 1.0f) {
+    return false;
+  }
+  *tokens -= 1.0f;
+  return true;
+}
+
+// Size checks matching what the handlers for each type will accept; no
+// sense waking anyone up for something they'll just ignore.
+static auto IsWellFormed_(const char* data, size_t size) -> bool {
+  switch (data[0]) {
+    case BA_PACKET_SIMPLE_PING:
+      return true;
+    case BA_PACKET_JSON_PING:
+    case BA_PACKET_JSON_PONG:
+      return size > 1;
+    case BA_PACKET_HOST_QUERY:
+      return size == 5;
+    case BA_PACKET_CLIENT_REQUEST:
+      return size > 4 && size <= kMaxClientRequestSize;
+    case BA_PACKET_CLIENT_ACCEPT:
+      return size == 3;
+    case BA_PACKET_CLIENT_DENY:
+    case BA_PACKET_CLIENT_DENY_ALREADY_IN_PARTY:
+    case BA_PACKET_CLIENT_DENY_VERSION_MISMATCH:
+    case BA_PACKET_CLIENT_DENY_PARTY_FULL:
+    case BA_PACKET_DISCONNECT_FROM_CLIENT_REQUEST:
+    case BA_PACKET_DISCONNECT_FROM_CLIENT_ACK:
+    case BA_PACKET_DISCONNECT_FROM_HOST_REQUEST:
+    case BA_PACKET_DISCONNECT_FROM_HOST_ACK:
+      return size == 2;
+    case BA_PACKET_CLIENT_GAMEPACKET_COMPRESSED:
+    case BA_PACKET_HOST_GAMEPACKET_COMPRESSED:
+      return size > 2;
+    default:
+      return false;
+  }
+}
+
+void NetworkReader::AddKnownPeer(const SockAddr& addr) {
+  std::scoped_lock lock(admission_mutex_);
+  auto& source{sources_[SourceKey_(addr.AsSockAddr())]};
+  if (source.known_count == 0) {
+    // Start them out with a full bucket at their new rate.
+    source.tokens = kKnownPacketsPerSecond * 2.0f;
+    source.last_refill_time = core::CorePlatform::GetCurrentMillisecs();
+  }
+  source.known_count++;
+}
+
+void NetworkReader::RemoveKnownPeer(const SockAddr& addr) {
+  std::scoped_lock lock(admission_mutex_);
+  auto i = sources_.find(SourceKey_(addr.AsSockAddr()));
+  if (i == sources_.end() || i->second.known_count <= 0) {
+    BA_LOG_ONCE(LogLevel::kError, "RemoveKnownPeer called for unknown peer.");
+    return;
+  }
+  auto& source{i->second};
+  source.known_count--;
+  source.tokens = std::min(source.tokens, kUnknownPacketsPerSecond * 2.0f);
+}
+
+auto NetworkReader::admission_stats() -> AdmissionStats {
+  std::scoped_lock lock(admission_mutex_);
+  return admission_stats_;
+}
+
+void NetworkReader::PruneSources_(millisecs_t now) {
+  last_source_prune_time_ = now;
+  for (auto i = sources_.begin(); i != sources_.end();) {
+    // Unknown sources that have been quiet long enough to have a full
+    // bucket again are no different from new ones.
+    if (i->second.known_count == 0
+        && now - i->second.last_refill_time > kSourcePruneInterval) {
+      i = sources_.erase(i);
+    } else {
+      ++i;
+    }
+  }
+}
+
+auto NetworkReader::AdmitPacket_(const sockaddr_storage& from,
+                                 const char* data, size_t size) -> bool {
+  switch (data[0]) {
+    case BA_PACKET_POKE:
+    case BA_PACKET_REMOTE_PING:
+    case BA_PACKET_REMOTE_PONG:
+    case BA_PACKET_REMOTE_ID_REQUEST:
+    case BA_PACKET_REMOTE_ID_RESPONSE:
+    case BA_PACKET_REMOTE_DISCONNECT:
+    case BA_PACKET_REMOTE_STATE:
+    case BA_PACKET_REMOTE_STATE2:
+    case BA_PACKET_REMOTE_STATE_ACK:
+    case BA_PACKET_REMOTE_DISCONNECT_ACK:
+    case BA_PACKET_REMOTE_GAME_QUERY:
+    case BA_PACKET_REMOTE_GAME_RESPONSE:
+      // Our own pokes, and remote-app traffic which the remote server
+      // handles (and polices) right here in this thread.
+      return true;
+    default:
+      break;
+  }
+
+  std::scoped_lock lock(admission_mutex_);
+  if (!IsWellFormed_(data, size)) {
+    admission_stats_.dropped_malformed++;
+    return false;
+  }
+
+  // Prune on a fixed interval only; a full table is no reason to scan it
+  // again (spoofed senders can keep it full) since untracked senders just
+  // fall back on the shared budget below.
+  millisecs_t now = core::CorePlatform::GetCurrentMillisecs();
+  if (now - last_source_prune_time_ > kSourcePruneInterval) {
+    PruneSources_(now);
+  }
+
+  auto key{SourceKey_(reinterpret_cast<const sockaddr*>(&from))};
+  auto i = sources_.find(key);
+  if (i != sources_.end() && i->second.known_count > 0) {
+    auto& source{i->second};
+    if (!TakeToken_(&source.tokens, &source.last_refill_time, now,
+                    kKnownPacketsPerSecond
+                        * static_cast<float>(source.known_count))) {
+      admission_stats_.dropped_known_rate++;
+      return false;
+    }
+    admission_stats_.admitted++;
+    return true;
+  }
+
+  // Unknown sender; they need to fit in both the shared budget and their
+  // own. If we're tracking too many sources to add this one, the shared
+  // budget alone has to do.
+  if (!TakeToken_(&unknown_total_.tokens, &unknown_total_.last_refill_time,
+                  now, kUnknownTotalPacketsPerSecond)) {
+    admission_stats_.dropped_unknown_flood++;
+    BA_LOG_ONCE(LogLevel::kWarning,
+                "Dropping excessive udp input from unknown senders;"
+                " (could this be a flood attack?).");
+    return false;
+  }
+  if (i == sources_.end() && sources_.size() < kMaxTrackedSources) {
+    i = sources_.emplace(key, Source_{kUnknownPacketsPerSecond * 2.0f, now})
+            .first;
+  }
+  if (i != sources_.end()
+      && !TakeToken_(&i->second.tokens, &i->second.last_refill_time, now,
+                     kUnknownPacketsPerSecond)) {
+    admission_stats_.dropped_unknown_rate++;
+    return false;
+  }
+  admission_stats_.admitted++;
+  return true;
+}
+
 void NetworkReader::SetPort(int port) {
   assert(g_core->InMainThread());
   // Currently can't switch once this is set.
@@ -265,6 +461,9 @@ auto NetworkReader::RunThread_() -> int {
             }
             break;
           }
+          if (!AdmitPacket_(from, buffer, rresult2)) {
+            continue;
+          }
           switch (buffer[0]) {
             case BA_PACKET_POKE:
               break;
@@ -301,10 +500,8 @@ auto NetworkReader::RunThread_() -> int {
                 std::vector<char> s_buffer(rresult2);
                 memcpy(s_buffer.data(), buffer + 1, rresult2 - 1);
                 s_buffer[rresult2 - 1] = 0;  // terminate string
-                cJSON* data = cJSON_Parse(s_buffer.data());
-                if (data != nullptr) {
-                  cJSON_Delete(data);
-                }
+                JsonArena arena;
+                arena.Parse(s_buffer.data());
               }
               break;
             }
@@ -378,6 +575,10 @@ void NetworkReader::PushIncomingUDPPacketCall_(const std::vector<uint8_t>& data,
   // Avoid buffer-full errors if something is causing us to write too often;
   // these are unreliable messages so its ok to just drop them.
   if (!g_base->logic->event_loop()->CheckPushSafety()) {
+    {
+      std::scoped_lock lock(admission_mutex_);
+      admission_stats_.dropped_queue_full++;
+    }
     BA_LOG_ONCE(
         LogLevel::kError,
         "Ignoring excessive udp-connection input packets; (could this be a "
@@ -8,6 +8,7 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "ballistica/base/base.h"
@@ -22,6 +23,18 @@ namespace ballistica::base {
 // ensure the sockets exist before doing the actual write.
 class NetworkReader {
  public:
+  /// Counts of incoming packets by what became of them. Packets only
+  /// reach the logic thread after passing admission (validation plus
+  /// per-source rate budgets) in the reader thread.
+  struct AdmissionStats {
+    uint64_t admitted{};
+    uint64_t dropped_malformed{};
+    uint64_t dropped_known_rate{};
+    uint64_t dropped_unknown_rate{};
+    uint64_t dropped_unknown_flood{};
+    uint64_t dropped_queue_full{};
+  };
+
   NetworkReader();
   void SetPort(int port);
   void OnAppSuspend();
@@ -32,7 +45,23 @@ class NetworkReader {
   auto sd4() const { return sd4_; }
   auto sd6() const { return sd6_; }
 
+  /// Register an address as having a live connection to us (or us to it).
+  /// Packets from known addresses get a far bigger rate budget than those
+  /// from unknown senders. Each add must be matched by a remove.
+  void AddKnownPeer(const SockAddr& addr);
+  void RemoveKnownPeer(const SockAddr& addr);
+
+  auto admission_stats() -> AdmissionStats;
+
  private:
+  struct Source_ {
+    float tokens{};
+    millisecs_t last_refill_time{};
+    int known_count{};
+  };
+  auto AdmitPacket_(const sockaddr_storage& from, const char* data,
+                    size_t size) -> bool;
+  void PruneSources_(millisecs_t now);
   void DoSelect_(bool* can_read_4, bool* can_read_6);
   void DoPoll_(bool* can_read_4, bool* can_read_6);
   void OpenSockets_();
@@ -58,6 +87,14 @@ class NetworkReader {
   std::mutex paused_mutex_;
   std::condition_variable paused_cv_;
   std::unique_ptr<RemoteAppServer> remote_server_;
+
+  // Admission state; touched by the reader thread per packet and by the
+  // logic thread as connections come and go.
+  std::mutex admission_mutex_;
+  std::unordered_map<std::string, Source_> sources_;
+  Source_ unknown_total_;
+  millisecs_t last_source_prune_time_{};
+  AdmissionStats admission_stats_;
 };
 
 }  // namespace ballistica::base
@@ -68,6 +68,10 @@ namespace ballistica::base {
 #define BA_SCENEPACKET_MESSAGE_UNRELIABLE 18
 #define BA_SCENEPACKET_DISCONNECT 19
 #define BA_SCENEPACKET_KEEPALIVE 20
+// Delivered immediately regardless of reliable-message ordering (and
+// possibly more than once or not at all). Only used for messages that
+// handle their own ordering, such as remote-player input frames.
+#define BA_SCENEPACKET_MESSAGE_UNSEQUENCED 21
 
 // Messages is our high level layer that sits on top of scene-packets.
 // They can be any size and will always arrive in the order they were sent
@@ -100,6 +104,9 @@ namespace ballistica::base {
 // to the BA_JMESSAGE types below.
 #define BA_MESSAGE_JMESSAGE 20
 #define BA_MESSAGE_CLIENT_PLAYER_PROFILES_JSON 21
+// Redundant, self-sequencing input sent via BA_SCENEPACKET_MESSAGE_UNSEQUENCED
+// to hosts that advertise support for it (see RemoteInputStreamOut).
+#define BA_MESSAGE_REMOTE_PLAYER_INPUT_FRAMES 22
 
 #define BA_JMESSAGE_SCREEN_MESSAGE 0
 
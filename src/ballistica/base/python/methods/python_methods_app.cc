@@ -1695,6 +1695,58 @@ static PyMethodDef PyInvokeMainMenuDef = {
     "\n"
     "This is essentially the same as pressing the menu button on a controller.",
 };
+
+// ------------------------- set_headless_max_speed ----------------------------
+
+static auto PySetHeadlessMaxSpeed(PyObject* self, PyObject* args,
+                                  PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  int enable;
+  static const char* kwlist[] = {"enable", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "p",
+                                   const_cast<char**>(kwlist), &enable)) {
+    return nullptr;
+  }
+  BA_PRECONDITION(g_base->InLogicThread());
+  g_base->logic->SetHeadlessMaxSpeed(enable);
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySetHeadlessMaxSpeedDef = {
+    "set_headless_max_speed",            // name
+    (PyCFunction)PySetHeadlessMaxSpeed,  // method
+    METH_VARARGS | METH_KEYWORDS,        // flags
+
+    "set_headless_max_speed(enable: bool) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Run headless display-time (and thus app and session time) in fixed\n"
+    "steps as fast as the CPU allows instead of at real-time pace.",
+};
+
+// ----------------------- headless_max_speed_ratio ----------------------------
+
+static auto PyHeadlessMaxSpeedRatio(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  return PyFloat_FromDouble(g_base->logic->GetHeadlessMaxSpeedRatio());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyHeadlessMaxSpeedRatioDef = {
+    "headless_max_speed_ratio",            // name
+    (PyCFunction)PyHeadlessMaxSpeedRatio,  // method
+    METH_NOARGS,                           // flags
+
+    "headless_max_speed_ratio() -> float\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return simulated seconds per wall second in headless max-speed mode\n"
+    "(or 0.0 if it is not enabled).",
+};
 // -----------------------------------------------------------------------------
 
 auto PythonMethodsApp::GetMethods() -> std::vector<PyMethodDef> {
@@ -1754,6 +1806,8 @@ auto PythonMethodsApp::GetMethods() -> std::vector<PyMethodDef> {
       PyGraphicsShutdownBeginDef,
       PyGraphicsShutdownIsCompleteDef,
       PyInvokeMainMenuDef,
+      PySetHeadlessMaxSpeedDef,
+      PyHeadlessMaxSpeedRatioDef,
   };
 }
 
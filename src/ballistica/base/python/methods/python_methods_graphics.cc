@@ -5,6 +5,7 @@
 #include "ballistica/base/app_adapter/app_adapter.h"
 #include "ballistica/base/assets/assets.h"
 #include "ballistica/base/graphics/graphics.h"
+#include "ballistica/base/graphics/null/renderer_null.h"
 #include "ballistica/base/graphics/support/camera.h"
 #include "ballistica/base/graphics/support/screen_messages.h"
 #include "ballistica/base/graphics/text/text_graphics.h"
@@ -786,6 +787,73 @@ static PyMethodDef PyShowProgressBarDef = {
     "Category: **General Utility Functions**",
 };
 
+// ---------------------------- null_renderer_stats ----------------------------
+
+static auto PyNullRendererStats(PyObject* self, PyObject* args,
+                                PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  int reset{};
+  static const char* kwlist[] = {"reset", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|p",
+                                   const_cast<char**>(kwlist), &reset)) {
+    return nullptr;
+  }
+  if (!RendererNull::active()) {
+    Py_RETURN_NONE;
+  }
+  auto stats = RendererNull::GetStatsString();
+  if (reset) {
+    RendererNull::ResetStats();
+  }
+  return PyUnicode_FromString(stats.c_str());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyNullRendererStatsDef = {
+    "null_renderer_stats",             // name
+    (PyCFunction)PyNullRendererStats,  // method
+    METH_VARARGS | METH_KEYWORDS,      // flags
+
+    "null_renderer_stats(reset: bool = False) -> str | None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return a summary of draw/state/upload counts from the null renderer\n"
+    "(or None if it is not in use), optionally resetting them.",
+};
+
+// ---------------------------- null_renderer_trace ----------------------------
+
+static auto PyNullRendererTrace(PyObject* self, PyObject* args,
+                                PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  const char* path;
+  static const char* kwlist[] = {"path", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "s",
+                                   const_cast<char**>(kwlist), &path)) {
+    return nullptr;
+  }
+  if (!RendererNull::active()) {
+    throw Exception("The null renderer is not in use.");
+  }
+  RendererNull::RequestTrace(path);
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyNullRendererTraceDef = {
+    "null_renderer_trace",             // name
+    (PyCFunction)PyNullRendererTrace,  // method
+    METH_VARARGS | METH_KEYWORDS,      // flags
+
+    "null_renderer_trace(path: str) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Have the null renderer write a binary trace of the next frame's\n"
+    "command stream to the given path.",
+};
+
 // -----------------------------------------------------------------------------
 
 auto PythonMethodsGraphics::GetMethods() -> std::vector<PyMethodDef> {
@@ -813,6 +881,8 @@ auto PythonMethodsGraphics::GetMethods() -> std::vector<PyMethodDef> {
       PyFullscreenControlKeyShortcutDef,
       PyFullscreenControlGetDef,
       PyFullscreenControlSetDef,
+      PyNullRendererStatsDef,
+      PyNullRendererTraceDef,
   };
 }
 
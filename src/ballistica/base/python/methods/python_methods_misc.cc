@@ -6,6 +6,7 @@
 #include <unordered_map>
 
 #include "ballistica/base/app_adapter/app_adapter.h"
+#include "ballistica/base/assets/assets_server.h"
 #include "ballistica/base/assets/sound_asset.h"
 #include "ballistica/base/input/input.h"
 #include "ballistica/base/platform/base_platform.h"
@@ -593,6 +594,34 @@ static PyMethodDef PyPrintLoadInfoDef = {
     "Category: **General Utility Functions**",
 };
 
+// ----------------------------- sound_load_stats ------------------------------
+
+static auto PySoundLoadStats(PyObject* self, PyObject* args,
+                             PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  int reset{};
+  static const char* kwlist[] = {"reset", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|p",
+                                   const_cast<char**>(kwlist), &reset)) {
+    return nullptr;
+  }
+  return PyUnicode_FromString(SoundAsset::GetLoadStatsString(reset).c_str());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySoundLoadStatsDef = {
+    "sound_load_stats",             // name
+    (PyCFunction)PySoundLoadStats,  // method
+    METH_VARARGS | METH_KEYWORDS,   // flags
+
+    "sound_load_stats(reset: bool = False) -> str\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return total and average times for sound loads that had to decode\n"
+    "(cold) and ones served from the decoded audio cache (warm).",
+};
+
 // -------------------------- get_replays_dir ----------------------------------
 
 static auto PyGetReplaysDir(PyObject* self, PyObject* args,
@@ -617,6 +646,57 @@ static PyMethodDef PyGetReplaysDirDef = {
     "(internal)",
 };
 
+// -------------------------- get_replay_writer_stats --------------------------
+
+static auto PyGetReplayWriterStats(PyObject* self, PyObject* args,
+                                   PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  static const char* kwlist[] = {nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "",
+                                   const_cast<char**>(kwlist))) {
+    return nullptr;
+  }
+  auto stats = g_base->assets_server->replay_writer()->stats();
+  double mean_write_time =
+      stats.blocks_written > 0 ? static_cast<double>(stats.total_write_time)
+                                     / static_cast<double>(stats.blocks_written)
+                               : 0.0;
+  return Py_BuildValue(
+      "{sLsLsLsLsLsLsLsdsLsLsLsL}", "backlog_bytes",
+      static_cast<long long>(stats.backlog_bytes),  // NOLINT
+      "peak_backlog_bytes",
+      static_cast<long long>(stats.peak_backlog_bytes),  // NOLINT
+      "pool_bytes", static_cast<long long>(stats.pool_bytes),  // NOLINT
+      "bytes_written", static_cast<long long>(stats.bytes_written),  // NOLINT
+      "blocks_written",
+      static_cast<long long>(stats.blocks_written),  // NOLINT
+      "last_write_time",
+      static_cast<long long>(stats.last_write_time),  // NOLINT
+      "max_write_time",
+      static_cast<long long>(stats.max_write_time),  // NOLINT
+      "mean_write_time", mean_write_time, "syncs",
+      static_cast<long long>(stats.syncs),  // NOLINT
+      "max_sync_time", static_cast<long long>(stats.max_sync_time),  // NOLINT
+      "stalls", static_cast<long long>(stats.stalls),  // NOLINT
+      "replays_cut_off",
+      static_cast<long long>(stats.replays_cut_off));  // NOLINT
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetReplayWriterStatsDef = {
+    "get_replay_writer_stats",            // name
+    (PyCFunction)PyGetReplayWriterStats,  // method
+    METH_VARARGS | METH_KEYWORDS,         // flags
+
+    "get_replay_writer_stats() -> dict[str, Any]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return replay writer metrics: bytes waiting to reach the disk (now and\n"
+    "peak), block pool size, totals written, per-block write and sync times\n"
+    "in microseconds, and how often the disk held up or cut off a replay.",
+};
+
 // --------------------- get_appconfig_default_value ---------------------------
 
 static auto PyGetAppConfigDefaultValue(PyObject* self, PyObject* args,
@@ -1856,7 +1936,9 @@ auto PythonMethodsMisc::GetMethods() -> std::vector<PyMethodDef> {
       PyGetAppConfigDefaultValueDef,
       PyAppConfigGetBuiltinKeysDef,
       PyGetReplaysDirDef,
+      PyGetReplayWriterStatsDef,
       PyPrintLoadInfoDef,
+      PySoundLoadStatsDef,
       PyPrintContextDef,
       PyDebugPrintPyErrDef,
       PyWorkspacesInUseDef,
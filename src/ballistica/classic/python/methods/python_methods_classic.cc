@@ -84,6 +84,115 @@ static auto PyValueTest(PyObject* self, PyObject* args,
     }
     appmode->set_dynamics_sync_time(std::max(0, appmode->dynamics_sync_time()));
     return_val = appmode->dynamics_sync_time();
+  } else if (!strcmp(arg, "dynamicsBlendTime")) {
+    auto* appmode = scene_v1::SceneV1AppMode::GetSingleton();
+    if (have_change) {
+      appmode->set_dynamics_blend_time(appmode->dynamics_blend_time()
+                                       + static_cast<int>(change));
+    }
+    if (have_absolute) {
+      appmode->set_dynamics_blend_time(static_cast<int>(absolute));
+    }
+    appmode->set_dynamics_blend_time(
+        std::max(0, appmode->dynamics_blend_time()));
+    return_val = appmode->dynamics_blend_time();
+  } else if (!strcmp(arg, "interestRadius")) {
+    auto* appmode = scene_v1::SceneV1AppMode::GetSingleton();
+    if (have_change) {
+      appmode->set_interest_radius(appmode->interest_radius()
+                                   + static_cast<float>(change));
+    }
+    if (have_absolute) {
+      appmode->set_interest_radius(static_cast<float>(absolute));
+    }
+    appmode->set_interest_radius(std::max(0.0f, appmode->interest_radius()));
+    return_val = appmode->interest_radius();
+  } else if (!strcmp(arg, "clientBandwidthCap")) {
+    auto* appmode = scene_v1::SceneV1AppMode::GetSingleton();
+    if (have_change) {
+      appmode->set_client_bytes_per_second_cap(
+          appmode->client_bytes_per_second_cap()
+          + static_cast<int64_t>(change));
+    }
+    if (have_absolute) {
+      appmode->set_client_bytes_per_second_cap(
+          static_cast<int64_t>(absolute));
+    }
+    appmode->set_client_bytes_per_second_cap(
+        std::max(int64_t{0}, appmode->client_bytes_per_second_cap()));
+    return_val = static_cast<double>(appmode->client_bytes_per_second_cap());
+  } else if (!strcmp(arg, "multiParty")) {
+    auto* appmode = scene_v1::SceneV1AppMode::GetSingleton();
+    if (have_change && change > 0.5f) {
+      appmode->set_multi_party_enabled(true);
+    }
+    if (have_change && change < -0.5f) {
+      appmode->set_multi_party_enabled(false);
+    }
+    if (have_absolute) {
+      appmode->set_multi_party_enabled(static_cast<bool>(absolute));
+    }
+    return_val = appmode->multi_party_enabled();
+  } else if (!strcmp(arg, "viewCulling")) {
+    auto* appmode = scene_v1::SceneV1AppMode::GetSingleton();
+    if (have_change && change > 0.5f) {
+      appmode->set_view_culling(true);
+    }
+    if (have_change && change < -0.5f) {
+      appmode->set_view_culling(false);
+    }
+    if (have_absolute) {
+      appmode->set_view_culling(static_cast<bool>(absolute));
+    }
+    return_val = appmode->view_culling();
+  } else if (!strcmp(arg, "soundBudgeting")) {
+    auto* appmode = scene_v1::SceneV1AppMode::GetSingleton();
+    if (have_change && change > 0.5f) {
+      appmode->set_sound_budgeting(true);
+    }
+    if (have_change && change < -0.5f) {
+      appmode->set_sound_budgeting(false);
+    }
+    if (have_absolute) {
+      appmode->set_sound_budgeting(static_cast<bool>(absolute));
+    }
+    return_val = appmode->sound_budgeting();
+  } else if (!strcmp(arg, "parallelNodeDrawing")) {
+    auto* appmode = scene_v1::SceneV1AppMode::GetSingleton();
+    if (have_change && change > 0.5f) {
+      appmode->set_parallel_node_drawing(true);
+    }
+    if (have_change && change < -0.5f) {
+      appmode->set_parallel_node_drawing(false);
+    }
+    if (have_absolute) {
+      appmode->set_parallel_node_drawing(static_cast<bool>(absolute));
+    }
+    return_val = appmode->parallel_node_drawing();
+  } else if (!strcmp(arg, "parallelPhysicsIslands")) {
+    auto* appmode = scene_v1::SceneV1AppMode::GetSingleton();
+    if (have_change && change > 0.5f) {
+      appmode->set_parallel_physics_islands(true);
+    }
+    if (have_change && change < -0.5f) {
+      appmode->set_parallel_physics_islands(false);
+    }
+    if (have_absolute) {
+      appmode->set_parallel_physics_islands(static_cast<bool>(absolute));
+    }
+    return_val = appmode->parallel_physics_islands();
+  } else if (!strcmp(arg, "unreliableRemoteInput")) {
+    auto* appmode = scene_v1::SceneV1AppMode::GetSingleton();
+    if (have_change && change > 0.5f) {
+      appmode->set_unreliable_remote_input(true);
+    }
+    if (have_change && change < -0.5f) {
+      appmode->set_unreliable_remote_input(false);
+    }
+    if (have_absolute) {
+      appmode->set_unreliable_remote_input(static_cast<bool>(absolute));
+    }
+    return_val = appmode->unreliable_remote_input();
   } else if (!strcmp(arg, "showNetInfo")) {
     if (have_change && change > 0.5f) {
       g_base->graphics->set_show_net_info(true);
@@ -327,6 +327,15 @@ auto CoreFeatureSet::GetAppTimeSeconds() -> seconds_t {
   return static_cast<seconds_t>(app_time_microsecs_) / 1000000;
 }
 
+void CoreFeatureSet::AdvanceAppTime(microsecs_t amount) {
+  if (amount <= 0) {
+    return;
+  }
+  UpdateAppTime();
+  std::scoped_lock lock(app_time_mutex_);
+  app_time_microsecs_ += amount;
+}
+
 void CoreFeatureSet::UpdateAppTime() {
   microsecs_t t = CorePlatform::GetCurrentMicrosecs();
 
@@ -90,6 +90,13 @@ class CoreFeatureSet {
   /// progressing while the app is suspended and will never go backwards.
   auto GetAppTimeSeconds() -> seconds_t;
 
+  /// Jump app-time forward by the provided amount (in addition to whatever
+  /// real time passes). This is used by headless max-speed mode to keep
+  /// app-time in sync with simulated display-time without actually
+  /// sleeping. App-time never goes backwards so negative values are
+  /// ignored.
+  void AdvanceAppTime(microsecs_t amount);
+
   /// Are we in the 'main' thread? The thread that first inited Core is
   /// considered the 'main' thread; on most platforms it is the one where
   /// UI calls must be run/etc.
@@ -2,6 +2,8 @@
 
 #include "ballistica/scene_v1/connection/connection.h"
 
+#include <algorithm>
+
 #include "ballistica/base/base.h"
 #include "ballistica/base/networking/networking.h"
 #include "ballistica/base/support/huffman.h"
@@ -9,6 +11,7 @@
 #include "ballistica/core/platform/core_platform.h"
 #include "ballistica/scene_v1/scene_v1.h"
 #include "ballistica/shared/generic/json.h"
+#include "ballistica/shared/generic/json_arena.h"
 #include "ballistica/shared/generic/utils.h"
 #include "ballistica/shared/math/vector3f.h"
 
@@ -94,8 +97,18 @@ void Connection::HandleResends(millisecs_t real_time,
         current_ping_ = static_cast<float>(real_time - msg.first_send_time);
         last_ping_measure_time_ = real_time;
       }
+
+      // Messages that were never resent give unambiguous rtt samples.
+      if (msg.last_send_time == msg.first_send_time) {
+        auto rtt = static_cast<float>(real_time - msg.first_send_time);
+        smoothed_rtt_ =
+            smoothed_rtt_ == 0.0f ? rtt : smoothed_rtt_ * 0.875f + rtt * 0.125f;
+      }
     }
     msg.acked = true;
+
+    // They've got everything up through this one.
+    reliable_bytes_acked_ = std::max(reliable_bytes_acked_, msg.end_offset);
   }
 
   // Re-send up to 9 un-acked packets if it's been long enough.
@@ -239,6 +252,20 @@ void Connection::HandleGamePacket(const std::vector<uint8_t>& data) {
       break;
     }
 
+    case BA_SCENEPACKET_MESSAGE_UNSEQUENCED: {
+      // Expect 1 byte type, 3 byte acks, at least 1 byte payload.
+      if (data.size() < 5) {
+        BA_LOG_ONCE(LogLevel::kError,
+                    "Got invalid BA_SCENEPACKET_MESSAGE_UNSEQUENCED packet.");
+        return;
+      }
+      millisecs_t real_time = g_core->GetAppTimeMillisecs();
+      HandleResends(real_time, data, 1);
+      std::vector<uint8_t> msg_data(data.begin() + 4, data.end());
+      HandleUnsequencedMessagePacket(msg_data);
+      break;
+    }
+
     default:
       Log(LogLevel::kError, "Connection got unknown packet type: "
                                 + std::to_string(static_cast<int>(data[0])));
@@ -307,6 +334,8 @@ void Connection::SendReliableMessage(const std::vector<uint8_t>& data) {
   msg.data = data;
   msg.first_send_time = msg.last_send_time = real_time;
   msg.resend_time = kPacketResendTime;
+  reliable_bytes_sent_ += static_cast<int64_t>(data.size());
+  msg.end_offset = reliable_bytes_sent_;
   msg.acked = false;
 
   // Add our header/acks and go ahead and send this one out.
@@ -350,13 +379,35 @@ void Connection::SendUnreliableMessage(const std::vector<uint8_t>& data) {
   SendGamePacket(data_out);
 }
 
+void Connection::SendUnsequencedMessage(const std::vector<uint8_t>& data) {
+  assert(!data.empty());
+
+  // For now we just silently drop anything bigger than our max packet size.
+  if (data.size() + 4 > kMaxPacketSize) {
+    BA_LOG_ONCE(LogLevel::kError,
+                "Error: Dropping outgoing unsequenced packet of size "
+                    + std::to_string(data.size()) + ".");
+    return;
+  }
+
+  // If our connection is going down, silently ignore this.
+  if (connection_dying_) {
+    return;
+  }
+
+  // 1 byte for type, 3 for acks.
+  std::vector<uint8_t> data_out(data.size() + 4);
+  data_out[0] = BA_SCENEPACKET_MESSAGE_UNSEQUENCED;
+  EmbedAcks(g_core->GetAppTimeMillisecs(), &data_out, 1);
+  memcpy(&(data_out[4]), &(data[0]), data.size());
+  SendGamePacket(data_out);
+}
+
 void Connection::SendJMessage(cJSON* val) {
-  char* s = cJSON_PrintUnformatted(val);
-  auto s_len = static_cast<size_t>(strlen(s));
-  std::vector<uint8_t> msg(1u + s_len + 1u);
-  msg[0] = BA_MESSAGE_JMESSAGE;
-  memcpy(msg.data() + 1u, s, s_len + 1u);
-  free(s);
+  // Write the json straight into the message (including terminating char).
+  std::vector<uint8_t> msg{BA_MESSAGE_JMESSAGE};
+  JsonWriter(&msg).Value(val);
+  msg.push_back(0);
   SendReliableMessage(msg);
 }
 
@@ -377,6 +428,8 @@ void Connection::Update() {
     bytes_out_ = packet_count_out_ = bytes_out_compressed_ = 0;
     bytes_in_ = bytes_in_compressed_ = packet_count_in_ = 0;
     resend_packet_count_ = resend_bytes_out_ = 0;
+    last_bytes_acked_ = reliable_bytes_acked_ - bytes_acked_at_last_update_;
+    bytes_acked_at_last_update_ = reliable_bytes_acked_;
   }
 
   if (can_communicate() && real_time - last_ack_send_time_ > kKeepaliveDelay) {
@@ -424,6 +477,9 @@ void Connection::Update() {
   }
 }
 
+void Connection::HandleUnsequencedMessagePacket(
+    const std::vector<uint8_t>& buffer) {}
+
 void Connection::HandleMessagePacket(const std::vector<uint8_t>& buffer) {
   switch (buffer[0]) {
     // Re-assemble multipart messages that come in and pass them along as
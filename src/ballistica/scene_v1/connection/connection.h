@@ -30,6 +30,12 @@ class Connection : public Object {
   // between other unreliable/reliable messages.
   void SendUnreliableMessage(const std::vector<uint8_t>& data);
 
+  // Send an unsequenced message; these may be dropped or duplicated and
+  // are handled as soon as they arrive, regardless of where the reliable
+  // message stream is at. Only for messages that can sort out their own
+  // ordering (see HandleUnsequencedMessagePacket()).
+  void SendUnsequencedMessage(const std::vector<uint8_t>& data);
+
   // Send a json-based reliable message.
   void SendJMessage(cJSON* val);
   virtual void Update();
@@ -40,6 +46,11 @@ class Connection : public Object {
   // Called when the next in-order message is available.
   virtual void HandleMessagePacket(const std::vector<uint8_t>& buffer) = 0;
 
+  // Called immediately when an unsequenced message arrives. The default
+  // implementation ignores them.
+  virtual void HandleUnsequencedMessagePacket(
+      const std::vector<uint8_t>& buffer);
+
   // Request an orderly disconnect.
   virtual void RequestDisconnect() = 0;
 
@@ -64,6 +75,18 @@ class Connection : public Object {
     return last_resend_bytes_out_;
   }
   auto current_ping() const -> float { return current_ping_; }
+
+  /// Round trip time in milliseconds, smoothed over recent acks.
+  auto smoothed_rtt() const -> float { return smoothed_rtt_; }
+
+  /// Reliable message bytes sent but not yet acked.
+  auto GetReliableBytesInFlight() const -> int64_t {
+    return reliable_bytes_sent_ - reliable_bytes_acked_;
+  }
+
+  /// Reliable message bytes acked over the last second; a measure of what
+  /// the link has actually been delivering.
+  auto GetBytesAckedPerSecond() const -> int64_t { return last_bytes_acked_; }
   auto can_communicate() const -> bool { return can_communicate_; }
   auto peer_spec() const -> const PlayerSpec& { return peer_spec_; }
   void HandleGamePacketCompressed(const std::vector<uint8_t>& data);
@@ -100,6 +123,8 @@ class Connection : public Object {
     millisecs_t first_send_time;
     millisecs_t last_send_time;
     millisecs_t resend_time;
+    // Total reliable bytes sent through the end of this message.
+    int64_t end_offset;
     bool acked;
   };
 
@@ -107,6 +132,11 @@ class Connection : public Object {
   // This prevents any SendGamePacketCompressed() calls from happening.
   bool connection_dying_{};
   float current_ping_{};
+  float smoothed_rtt_{};
+  int64_t reliable_bytes_sent_{};
+  int64_t reliable_bytes_acked_{};
+  int64_t bytes_acked_at_last_update_{};
+  int64_t last_bytes_acked_{};
   int64_t last_resend_bytes_out_{};
   int64_t last_bytes_out_{};
   int64_t last_bytes_out_compressed_{};
@@ -23,31 +23,54 @@ auto ConnectionSet::GetConnectionToHostUDP() -> ConnectionToHostUDP* {
   return h ? h->GetAsUDP() : nullptr;
 }
 
-void ConnectionSet::RegisterClientController(ClientControllerInterface* c) {
+void ConnectionSet::RegisterClientController(ClientControllerInterface* c,
+                                             int party_id) {
+  auto& controller{client_controllers_[party_id]};
+
   // This shouldn't happen, but if there's already a controller registered,
   // detach all clients from it.
-  if (client_controller_) {
+  if (controller) {
     Log(LogLevel::kError,
         "RegisterClientController() called "
         "but already have a controller; bad.");
     for (auto&& i : connections_to_clients_) {
       assert(i.second.Exists());
-      i.second->SetController(nullptr);
+      if (i.second->party_id() == party_id) {
+        i.second->SetController(nullptr);
+      }
     }
   }
 
   // Ok, now assign the new and attach all currently-connected clients to it.
-  client_controller_ = c;
-  if (client_controller_) {
+  controller = c;
+  if (controller) {
     for (auto&& i : connections_to_clients_) {
       assert(i.second.Exists());
-      if (i.second->can_communicate()) {
-        i.second->SetController(client_controller_);
+      if (i.second->can_communicate() && i.second->party_id() == party_id) {
+        i.second->SetController(controller);
       }
     }
   }
 }
 
+auto ConnectionSet::SetClientParty(int client_id, int party_id) -> bool {
+  assert(g_base->InLogicThread());
+  auto i = connections_to_clients_.find(client_id);
+  if (i == connections_to_clients_.end() || !i->second.Exists()) {
+    return false;
+  }
+  ConnectionToClient* client = i->second.Get();
+  if (client->party_id() == party_id) {
+    return true;
+  }
+  client->RemovePlayers();
+  client->set_party_id(party_id);
+  if (client->can_communicate()) {
+    client->SetController(client_controller(party_id));
+  }
+  return true;
+}
+
 void ConnectionSet::Update() {
   // First do housekeeping on our client/host connections.
   for (auto&& i : connections_to_clients_) {
@@ -403,21 +426,26 @@ void ConnectionSet::PushDisconnectFromHostCall() {
 void ConnectionSet::UnregisterClientController(ClientControllerInterface* c) {
   assert(c);
 
+  auto controller = client_controllers_.begin();
+  while (controller != client_controllers_.end() && controller->second != c) {
+    ++controller;
+  }
+
   // This shouldn't happen.
-  if (client_controller_ != c) {
+  if (controller == client_controllers_.end()) {
     Log(LogLevel::kError,
         "UnregisterClientController() called with a non-registered "
         "controller");
     return;
   }
 
-  // Ok, detach all our controllers from this guy.
-  if (client_controller_) {
-    for (auto&& i : connections_to_clients_) {
+  // Ok, detach all of its clients from this guy.
+  for (auto&& i : connections_to_clients_) {
+    if (i.second->party_id() == controller->first) {
       i.second->SetController(nullptr);
     }
   }
-  client_controller_ = nullptr;
+  client_controllers_.erase(controller);
 }
 
 void ConnectionSet::ForceDisconnectClients() {
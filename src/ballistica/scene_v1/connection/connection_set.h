@@ -19,8 +19,11 @@ class ConnectionSet {
 
   // Whoever wants to wrangle current client connections should call this
   // to register itself. Note that it must explicitly call unregister when
-  // unregistering itself.
-  void RegisterClientController(ClientControllerInterface* c);
+  // unregistering itself. Each party (see
+  // SceneV1AppMode::LaunchPartySession()) has its own controller; clients
+  // start out in party 0.
+  void RegisterClientController(ClientControllerInterface* c,
+                                int party_id = 0);
   void UnregisterClientController(ClientControllerInterface* c);
 
   // Quick test as to whether there are clients. Does not check if they are
@@ -40,10 +43,16 @@ class ConnectionSet {
       -> const std::unordered_map<int, Object::Ref<ConnectionToClient> >& {
     return connections_to_clients_;
   }
-  auto client_controller() -> ClientControllerInterface* {
-    return client_controller_;
+  auto client_controller(int party_id = 0) -> ClientControllerInterface* {
+    auto i = client_controllers_.find(party_id);
+    return i == client_controllers_.end() ? nullptr : i->second;
   }
 
+  // Move a client to a different party, handing it over to that party's
+  // controller. Any players it has are removed from its old party's
+  // session. Returns false if there is no such client.
+  auto SetClientParty(int client_id, int party_id) -> bool;
+
   // Simple thread safe query.
   auto has_connection_to_host() const -> bool {
     return has_connection_to_host_;
@@ -106,7 +115,7 @@ class ConnectionSet {
   std::unordered_map<int, Object::Ref<ConnectionToClient> >
       connections_to_clients_;
   Object::Ref<ConnectionToHost> connection_to_host_;
-  ClientControllerInterface* client_controller_{};
+  std::unordered_map<int, ClientControllerInterface*> client_controllers_;
 
   // Simple flag for thread-safe access.
   bool has_connection_to_host_{};
@@ -2,6 +2,8 @@
 
 #include "ballistica/scene_v1/connection/connection_to_client.h"
 
+#include <algorithm>
+
 #include "ballistica/base/assets/assets.h"
 #include "ballistica/base/audio/audio.h"
 #include "ballistica/base/networking/networking.h"
@@ -16,6 +18,7 @@
 #include "ballistica/scene_v1/support/host_session.h"
 #include "ballistica/scene_v1/support/scene_v1_app_mode.h"
 #include "ballistica/shared/generic/json.h"
+#include "ballistica/shared/generic/json_arena.h"
 #include "ballistica/shared/generic/utils.h"
 #include "ballistica/shared/python/python_sys.h"
 
@@ -24,6 +27,17 @@ namespace ballistica::scene_v1 {
 // How long new clients have to wait before starting a kick vote.
 const int kNewClientKickVoteDelay = 60000;
 
+// Reliable data can be in flight for this long (or for 4 round trips if
+// longer) before we start sending a client less.
+const float kMinSendBacklogMillisecs = 500.0f;
+
+// How many calm once-per-second checks before we send a client more again.
+const int kCalmSendLevelUpdates = 3;
+
+// Base session-command flush interval for raised send levels, for when
+// buffer-time is shorter (it defaults to 0; flushing every message).
+const millisecs_t kMinSendFlushMillisecs = 20;
+
 ConnectionToClient::ConnectionToClient(int id)
     : id_(id),
       protocol_version_{
@@ -128,6 +142,59 @@ void ConnectionToClient::Update() {
     }
     last_hand_shake_send_time_ = real_time;
   }
+
+  if (can_communicate()) {
+    UpdateSendLevel_(real_time);
+  }
+}
+
+auto ConnectionToClient::GetSendFlushInterval() const -> millisecs_t {
+  // Shipping less often means fewer but bigger messages; less overhead.
+  millisecs_t buffer_time = SceneV1AppMode::GetSingleton()->buffer_time();
+  if (send_level_ == 0) {
+    return buffer_time;
+  }
+  return std::max(buffer_time, kMinSendFlushMillisecs) * (1 + send_level_);
+}
+
+auto ConnectionToClient::GetSendCorrectionInterval() const -> millisecs_t {
+  return SceneV1AppMode::GetSingleton()->dynamics_sync_time()
+         * (1 + send_level_);
+}
+
+void ConnectionToClient::UpdateSendLevel_(millisecs_t real_time) {
+  // Our rate measurements update once per second, so no use going faster.
+  if (real_time - last_send_level_update_time_ < 1000) {
+    return;
+  }
+  last_send_level_update_time_ = real_time;
+
+  // Back off when we're going over the configured cap or when reliable
+  // data is piling up faster than they're acking it. Ease back in only
+  // after things have been comfortably calm for a few seconds.
+  auto* appmode = SceneV1AppMode::GetSingleton();
+  int64_t cap = appmode->client_bytes_per_second_cap();
+  int64_t out_rate = GetBytesOutPerSecondCompressed();
+  float backlog_millisecs =
+      static_cast<float>(GetReliableBytesInFlight()) * 1000.0f
+      / static_cast<float>(std::max(GetBytesAckedPerSecond(), int64_t{1000}));
+  float max_backlog_millisecs =
+      std::max(kMinSendBacklogMillisecs, 4.0f * smoothed_rtt());
+  bool over = (cap > 0 && out_rate > cap)
+              || backlog_millisecs > max_backlog_millisecs;
+  bool calm = (cap <= 0 || out_rate * 10 < cap * 7)
+              && backlog_millisecs < max_backlog_millisecs * 0.5f;
+  if (over) {
+    send_level_ = std::min(kMaxSendLevel, send_level_ + 1);
+    calm_send_level_updates_ = 0;
+  } else if (calm && send_level_ > 0) {
+    if (++calm_send_level_updates_ >= kCalmSendLevelUpdates) {
+      send_level_--;
+      calm_send_level_updates_ = 0;
+    }
+  } else {
+    calm_send_level_updates_ = 0;
+  }
 }
 
 void ConnectionToClient::HandleGamePacket(const std::vector<uint8_t>& data) {
@@ -163,8 +230,8 @@ void ConnectionToClient::HandleGamePacket(const std::vector<uint8_t>& data) {
         std::vector<char> string_buffer(data.size() - 3 + 1);
         memcpy(&(string_buffer[0]), &(data[3]), data.size() - 3);
         string_buffer[string_buffer.size() - 1] = 0;
-        cJSON* handshake = cJSON_Parse(string_buffer.data());
-        if (handshake) {
+        JsonArena arena;
+        if (cJSON* handshake = arena.Parse(string_buffer.data())) {
           if (cJSON* pspec = cJSON_GetObjectItem(handshake, "s")) {
             set_peer_spec(PlayerSpec(pspec->valuestring));
           }
@@ -174,7 +241,6 @@ void ConnectionToClient::HandleGamePacket(const std::vector<uint8_t>& data) {
           if (cJSON* pubdeviceid = cJSON_GetObjectItem(handshake, "d")) {
             public_device_id_ = pubdeviceid->valuestring;
           }
-          cJSON_Delete(handshake);
         }
       } else {
         // (KILL THIS WHEN kProtocolVersionClientMin >= 33)
@@ -262,6 +328,9 @@ void ConnectionToClient::HandleGamePacket(const std::vector<uint8_t>& data) {
                 info_dict, "n",
                 cJSON_CreateString(appmode->public_party_name().c_str()));
           }
+
+          // Let them know they can send us unsequenced input frames.
+          cJSON_AddItemToObject(info_dict, "ri", cJSON_CreateNumber(1));
           std::string info = cJSON_PrintUnformatted(info_dict);
           cJSON_Delete(info_dict);
 
@@ -291,8 +360,9 @@ void ConnectionToClient::HandleGamePacket(const std::vector<uint8_t>& data) {
 
         // Lastly, we hand this connection over to whoever is currently
         // feeding client connections.
-        if (appmode->connections()->client_controller()) {
-          SetController(appmode->connections()->client_controller());
+        if (auto* controller =
+                appmode->connections()->client_controller(party_id_)) {
+          SetController(controller);
         }
       }
       break;
@@ -306,6 +376,40 @@ void ConnectionToClient::HandleGamePacket(const std::vector<uint8_t>& data) {
       break;
   }
 }
+
+void ConnectionToClient::HandleUnsequencedMessagePacket(
+    const std::vector<uint8_t>& buffer) {
+  assert(g_base->InLogicThread());
+  assert(!buffer.empty());
+
+  // Ignore anything that shows up before we're fully on speaking terms.
+  if (!can_communicate()) {
+    return;
+  }
+  switch (buffer[0]) {
+    case BA_MESSAGE_REMOTE_PLAYER_INPUT_FRAMES: {
+      bool valid = remote_input_stream_.HandleMessage(
+          buffer, [this](int device_index, InputType type, float value) {
+            if (ClientInputDevice* client_input_device =
+                    GetClientInputDevice(device_index)) {
+              client_input_device->PassInputCommand(type, value);
+            }
+          });
+      if (!valid) {
+        BA_LOG_ONCE(LogLevel::kError,
+                    "Error: invalid remote-player-input-frames packet");
+      }
+      break;
+    }
+    default:
+      // Only messages that sequence themselves are allowed here.
+      BA_LOG_ONCE(LogLevel::kError,
+                  "Got unexpected unsequenced message type: "
+                      + std::to_string(static_cast<int>(buffer[0])));
+      break;
+  }
+}
+
 void ConnectionToClient::Error(const std::string& msg) {
   // Take no further action at this time aside from printing it.
   // If we receive any more messages from the client we'll respond
@@ -365,11 +469,9 @@ void ConnectionToClient::HandleMessagePacket(
   switch (buffer[0]) {
     case BA_MESSAGE_JMESSAGE: {
       if (buffer.size() >= 3 && buffer[buffer.size() - 1] == 0) {
-        cJSON* msg =
-            cJSON_Parse(reinterpret_cast<const char*>(buffer.data() + 1));
-        if (msg) {
-          cJSON_Delete(msg);
-        }
+        JsonArena arena;
+        arena.ParseCopy(reinterpret_cast<const char*>(buffer.data() + 1),
+                        buffer.size() - 2);
       }
       break;
     }
@@ -394,7 +496,8 @@ void ConnectionToClient::HandleMessagePacket(
         memcpy(str_buffer.data(), buffer.data() + 1, buffer.size() - 1);
         str_buffer[str_buffer.size() - 1] = 0;
 
-        cJSON* info = cJSON_Parse(str_buffer.data());
+        JsonArena arena;
+        cJSON* info = arena.Parse(str_buffer.data());
         if (info) {
           cJSON* b = cJSON_GetObjectItem(info, "b");
           if (b) {
@@ -426,7 +529,6 @@ void ConnectionToClient::HandleMessagePacket(
                 token_, our_handshake_player_spec_str_ + our_handshake_salt_,
                 peer_hash_, build_number_);
           }
-          cJSON_Delete(info);
         } else {
           Log(LogLevel::kError,
               "Got invalid json in clientinfo message: '"
@@ -653,8 +755,7 @@ void ConnectionToClient::HandleMessagePacket(
             "msg.");
         break;
       }
-      if (auto* hs =
-              dynamic_cast<HostSession*>(appmode->GetForegroundSession())) {
+      if (auto* hs = appmode->GetPartyHostSession(party_id_)) {
         if (!cid->AttachedToPlayer()) {
           bool still_waiting_for_auth =
               (appmode->require_client_authentication()
@@ -714,7 +815,7 @@ auto ConnectionToClient::GetCombinedSpec() -> PlayerSpec {
 
   // Look for players coming from this client-connection.
   // If we find any, make a spec out of their name(s).
-  if (auto* hs = dynamic_cast<HostSession*>(appmode->GetForegroundSession())) {
+  if (auto* hs = appmode->GetPartyHostSession(party_id_)) {
     std::string p_name_combined;
     for (auto&& p : hs->players()) {
       auto* delegate = p->input_device_delegate();
@@ -747,6 +848,21 @@ auto ConnectionToClient::GetCombinedSpec() -> PlayerSpec {
   return peer_spec();
 }
 
+void ConnectionToClient::RemovePlayers() {
+  for (auto&& i : client_input_devices_) {
+    auto* cid_delegate =
+        dynamic_cast<ClientInputDeviceDelegate*>(&i.second->delegate());
+    if (cid_delegate == nullptr) {
+      continue;
+    }
+    if (Player* player = cid_delegate->GetPlayer()) {
+      if (HostSession* host_session = player->GetHostSession()) {
+        host_session->RemovePlayer(player);
+      }
+    }
+  }
+}
+
 auto ConnectionToClient::GetClientInputDevice(int remote_id)
     -> ClientInputDevice* {
   auto i = client_input_devices_.find(remote_id);
@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "ballistica/scene_v1/connection/connection.h"
+#include "ballistica/scene_v1/connection/remote_input_stream.h"
 #include "ballistica/scene_v1/scene_v1.h"
 
 namespace ballistica::scene_v1 {
@@ -15,11 +16,15 @@ namespace ballistica::scene_v1 {
 /// Connection to a party client if we're the host.
 class ConnectionToClient : public Connection {
  public:
+  static constexpr int kMaxSendLevel{3};
+
   explicit ConnectionToClient(int id);
   ~ConnectionToClient() override;
   void Update() override;
   void HandleMessagePacket(const std::vector<uint8_t>& buffer) override;
   void HandleGamePacket(const std::vector<uint8_t>& buffer) override;
+  void HandleUnsequencedMessagePacket(
+      const std::vector<uint8_t>& buffer) override;
   auto id() const -> int { return id_; }
 
   // More efficient than dynamic_cast (hmm do we still want this?).
@@ -42,6 +47,13 @@ class ConnectionToClient : public Connection {
   /// account id has been verified by the master server.
   auto IsAdmin() const -> bool;
 
+  /// The party this client belongs to (see ConnectionSet::SetClientParty()).
+  auto party_id() const -> int { return party_id_; }
+  void set_party_id(int val) { party_id_ = val; }
+
+  /// Remove any players this client has in its party's session.
+  void RemovePlayers();
+
   auto kick_voted() const { return kick_voted_; }
   auto set_kick_voted(bool val) { kick_voted_ = val; }
   auto kick_vote_choice() const { return kick_vote_choice_; }
@@ -60,7 +72,19 @@ class ConnectionToClient : public Connection {
     return protocol_version_;
   }
 
+  /// How far we're currently cutting back on what we send this client, from
+  /// 0 (everything, as often as possible) up to kMaxSendLevel, based on how
+  /// well their link has been keeping up.
+  auto send_level() const -> int { return send_level_; }
+
+  /// How often to ship this client the session commands we've built up.
+  auto GetSendFlushInterval() const -> millisecs_t;
+
+  /// How often to send this client dynamics corrections.
+  auto GetSendCorrectionInterval() const -> millisecs_t;
+
  private:
+  void UpdateSendLevel_(millisecs_t real_time);
   virtual auto ShouldPrintIncompatibleClientErrors() const -> bool;
   auto GetClientInputDevice(int remote_id) -> ClientInputDevice*;
   void Error(const std::string& error_msg) override;
@@ -72,8 +96,13 @@ class ConnectionToClient : public Connection {
   std::string public_device_id_;
   ClientControllerInterface* controller_{};
   std::unordered_map<int, ClientInputDevice*> client_input_devices_;
+  RemoteInputStreamIn remote_input_stream_;
   millisecs_t last_hand_shake_send_time_{};
+  millisecs_t last_send_level_update_time_{};
+  int send_level_{};
+  int calm_send_level_updates_{};
   int id_{-1};
+  int party_id_{};
   int build_number_{};
   bool got_client_info_{};
   bool kick_voted_{};
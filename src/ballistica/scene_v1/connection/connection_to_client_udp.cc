@@ -3,6 +3,7 @@
 #include "ballistica/scene_v1/connection/connection_to_client_udp.h"
 
 #include "ballistica/base/logic/logic.h"
+#include "ballistica/base/networking/network_reader.h"
 #include "ballistica/base/networking/network_writer.h"
 #include "ballistica/scene_v1/connection/connection_set.h"
 #include "ballistica/scene_v1/support/scene_v1_app_mode.h"
@@ -18,12 +19,16 @@ ConnectionToClientUDP::ConnectionToClientUDP(const SockAddr& addr,
       client_instance_uuid_(std::move(client_name)),
       last_client_response_time_millisecs_(
           static_cast<millisecs_t>(g_base->logic->display_time() * 1000.0)),
-      did_die_(false) {}
+      did_die_(false) {
+  // Let the reader give their traffic a connected client's budget.
+  g_base->network_reader->AddKnownPeer(*addr_);
+}
 
 ConnectionToClientUDP::~ConnectionToClientUDP() {
   // This prevents anything from trying to send
   // (and thus crashing in pure-virtual SendGamePacketCompressed) as we die.
   set_connection_dying(true);
+  g_base->network_reader->RemoveKnownPeer(*addr_);
 }
 
 void ConnectionToClientUDP::SendGamePacketCompressed(
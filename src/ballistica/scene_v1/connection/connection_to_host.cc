@@ -14,6 +14,7 @@
 #include "ballistica/scene_v1/support/scene_v1_app_mode.h"
 #include "ballistica/scene_v1/support/scene_v1_input_device_delegate.h"
 #include "ballistica/shared/generic/json.h"
+#include "ballistica/shared/generic/json_arena.h"
 #include "ballistica/shared/generic/utils.h"
 #include "ballistica/shared/python/python_sys.h"
 
@@ -168,8 +169,8 @@ void ConnectionToHost::HandleGamePacket(const std::vector<uint8_t>& data) {
           std::vector<char> string_buffer(data.size() - 3 + 1);
           memcpy(&(string_buffer[0]), &(data[3]), data.size() - 3);
           string_buffer[string_buffer.size() - 1] = 0;
-          cJSON* handshake = cJSON_Parse(string_buffer.data());
-          if (handshake) {
+          JsonArena arena;
+          if (cJSON* handshake = arena.Parse(string_buffer.data())) {
             // We hash this to prove that we're us; keep it around.
             peer_hash_input_ = "";
             cJSON* pspec = cJSON_GetObjectItem(handshake, "s");
@@ -181,7 +182,6 @@ void ConnectionToHost::HandleGamePacket(const std::vector<uint8_t>& data) {
             if (salt) {
               peer_hash_input_ += salt->valuestring;
             }
-            cJSON_Delete(handshake);
           }
         } else {
           // (KILL THIS WHEN kProtocolVersionClientMin >= 33)
@@ -324,8 +324,8 @@ void ConnectionToHost::HandleMessagePacket(const std::vector<uint8_t>& buffer) {
         std::vector<char> str_buffer(buffer.size());
         memcpy(&(str_buffer[0]), &(buffer[1]), buffer.size() - 1);
         str_buffer[str_buffer.size() - 1] = 0;
-        cJSON* info = cJSON_Parse(reinterpret_cast<const char*>(&(buffer[1])));
-        if (info) {
+        JsonArena arena;
+        if (cJSON* info = arena.Parse(str_buffer.data())) {
           // Build number.
           cJSON* b = cJSON_GetObjectItem(info, "b");
           if (b) {
@@ -338,7 +338,11 @@ void ConnectionToHost::HandleMessagePacket(const std::vector<uint8_t>& buffer) {
           if (n != nullptr) {
             party_name_ = Utils::GetValidUTF8(n->valuestring, "bsmhi");
           }
-          cJSON_Delete(info);
+          // Unreliable remote-input support.
+          cJSON* ri = cJSON_GetObjectItem(info, "ri");
+          if (ri != nullptr && cJSON_IsNumber(ri)) {
+            supports_unreliable_input_ = (ri->valueint != 0);
+          }
         } else {
           Log(LogLevel::kError, "got invalid json in hostinfo message");
         }
@@ -366,8 +370,10 @@ void ConnectionToHost::HandleMessagePacket(const std::vector<uint8_t>& buffer) {
       // High level json messages (nice and easy to expand on but not
       // especially efficient).
       if (buffer.size() >= 3 && buffer[buffer.size() - 1] == 0) {
+        JsonArena arena;
         cJSON* msg =
-            cJSON_Parse(reinterpret_cast<const char*>(buffer.data() + 1));
+            arena.ParseCopy(reinterpret_cast<const char*>(buffer.data() + 1),
+                            buffer.size() - 2);
         if (msg) {
           cJSON* type = cJSON_GetObjectItem(msg, "t");
           if (type != nullptr) {
@@ -396,7 +402,6 @@ void ConnectionToHost::HandleMessagePacket(const std::vector<uint8_t>& buffer) {
                 break;
             }
           }
-          cJSON_Delete(msg);
         }
       }
       break;
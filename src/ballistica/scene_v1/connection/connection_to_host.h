@@ -4,6 +4,7 @@
 #define BALLISTICA_SCENE_V1_CONNECTION_CONNECTION_TO_HOST_H_
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "ballistica/scene_v1/connection/connection.h"
@@ -29,6 +30,14 @@ class ConnectionToHost : public Connection {
     return party_name_;
   }
 
+  /// Whether the host accepts BA_MESSAGE_REMOTE_PLAYER_INPUT_FRAMES.
+  auto supports_unreliable_input() const { return supports_unreliable_input_; }
+
+  /// Return the next input frame seq for a local input device.
+  auto NextRemoteInputFrameSeq(int device_index) -> uint32_t {
+    return next_remote_input_frame_seqs_[device_index]++;
+  }
+
  private:
   std::string party_name_;
   std::string peer_hash_input_;
@@ -37,9 +46,11 @@ class ConnectionToHost : public Connection {
   bool ignore_old_attach_remote_player_packets_{};
   bool printed_connect_message_{};
   bool got_host_info_{};
+  bool supports_unreliable_input_{};
   int protocol_version_{-1};
   int build_number_{};
   millisecs_t last_ping_send_time_{};
+  std::unordered_map<int, uint32_t> next_remote_input_frame_seqs_;
   // the client-session that we're driving
   Object::WeakRef<ClientSession> client_session_;
 };
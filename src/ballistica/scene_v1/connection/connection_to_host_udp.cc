@@ -4,6 +4,7 @@
 
 #include "ballistica/base/assets/assets.h"
 #include "ballistica/base/logic/logic.h"
+#include "ballistica/base/networking/network_reader.h"
 #include "ballistica/base/networking/network_writer.h"
 #include "ballistica/scene_v1/connection/connection_set.h"
 #include "ballistica/scene_v1/support/scene_v1_app_mode.h"
@@ -33,6 +34,9 @@ ConnectionToHostUDP::ConnectionToHostUDP(const SockAddr& addr)
       last_host_response_time_millisecs_(
           static_cast<millisecs_t>(g_base->logic->display_time() * 1000.0)) {
   GetRequestID_();
+
+  // Let the reader give the host's traffic a connection's budget.
+  g_base->network_reader->AddKnownPeer(*addr_);
   if (auto* appmode = SceneV1AppMode::GetActiveOrWarn()) {
     if (appmode->connections()->GetPrintUDPConnectProgress()) {
       ScreenMessage(g_base->assets->GetResourceString("connectingToPartyText"));
@@ -44,6 +48,7 @@ ConnectionToHostUDP::~ConnectionToHostUDP() {
   // This prevents anything from trying to send (and thus crashing in
   // pure-virtual SendGamePacketCompressed) as we die.
   set_connection_dying(true);
+  g_base->network_reader->RemoveKnownPeer(*addr_);
 }
 
 void ConnectionToHostUDP::GetRequestID_() {
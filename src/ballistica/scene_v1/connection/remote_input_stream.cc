@@ -0,0 +1,358 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/scene_v1/connection/remote_input_stream.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "ballistica/base/networking/networking.h"
+#include "ballistica/shared/ballistica.h"
+
+namespace ballistica::scene_v1 {
+
+// Message header: type, device index, frame count.
+static constexpr size_t kMessageHeaderSize{3};
+
+// Frame header: seq, command count.
+static constexpr size_t kFrameHeaderSize{5};
+
+// Largest message we build; leaves room for the unsequenced scene-packet
+// header (type plus acks).
+static constexpr size_t kMaxMessageSize{kMaxPacketSize - 4};
+
+static constexpr size_t kCommandSize{RemoteInputStreamOut::kCommandSize};
+
+// Most room the trailing input state can take: a count plus at most one
+// command per input type.
+static constexpr size_t kMaxStateSize{
+    1 + static_cast<size_t>(InputType::kLast) * kCommandSize};
+
+// Presses and releases of a button share a channel (keyed by the press);
+// axes are their own channels.
+static auto GetInputChannel(InputType type) -> InputType {
+  switch (type) {
+    case InputType::kJumpRelease:
+      return InputType::kJumpPress;
+    case InputType::kPunchRelease:
+      return InputType::kPunchPress;
+    case InputType::kBombRelease:
+      return InputType::kBombPress;
+    case InputType::kPickUpRelease:
+      return InputType::kPickUpPress;
+    case InputType::kFlyRelease:
+      return InputType::kFlyPress;
+    case InputType::kStartRelease:
+      return InputType::kStartPress;
+    case InputType::kHoldPositionRelease:
+      return InputType::kHoldPositionPress;
+    case InputType::kLeftRelease:
+      return InputType::kLeftPress;
+    case InputType::kRightRelease:
+      return InputType::kRightPress;
+    case InputType::kUpRelease:
+      return InputType::kUpPress;
+    case InputType::kDownRelease:
+      return InputType::kDownPress;
+    default:
+      return type;
+  }
+}
+
+void RemoteInputStreamOut::AddFrame(uint32_t seq, const uint8_t* commands,
+                                    size_t size) {
+  assert(size % kCommandSize == 0);
+  assert(size / kCommandSize <= 255);
+  assert(kMessageHeaderSize + kFrameHeaderSize + size + kMaxStateSize
+         <= kMaxMessageSize);
+  frames_.push_back({seq, std::vector<uint8_t>(commands, commands + size)});
+  for (size_t i = 0; i < size; i += kCommandSize) {
+    auto type = static_cast<InputType>(commands[i]);
+    float value;
+    memcpy(&value, commands + i + 1, sizeof(value));
+    state_[GetInputChannel(type)] = {type, value};
+  }
+  while (frames_.size() > kRedundantFrames) {
+    frames_.pop_front();
+  }
+  sends_remaining_ = kRedundantFrames;
+}
+
+auto RemoteInputStreamOut::BuildMessage(int device_index)
+    -> std::vector<uint8_t> {
+  assert(!frames_.empty());
+
+  // Our full input state always goes along; include as many of our most
+  // recent frames as will fit alongside it.
+  size_t state_size = 1 + state_.size() * kCommandSize;
+  size_t size = kMessageHeaderSize + state_size;
+  size_t first = frames_.size();
+  while (first > 0) {
+    size_t frame_size = kFrameHeaderSize + frames_[first - 1].commands.size();
+    if (size + frame_size > kMaxMessageSize) {
+      break;
+    }
+    size += frame_size;
+    first--;
+  }
+  assert(first < frames_.size());
+
+  std::vector<uint8_t> msg(size);
+  msg[0] = BA_MESSAGE_REMOTE_PLAYER_INPUT_FRAMES;
+  msg[1] = static_cast_check_fit<uint8_t>(device_index);
+  msg[2] = static_cast<uint8_t>(frames_.size() - first);
+  size_t offset = kMessageHeaderSize;
+  for (size_t i = first; i < frames_.size(); ++i) {
+    auto& frame{frames_[i]};
+    memcpy(msg.data() + offset, &frame.seq, sizeof(frame.seq));
+    msg[offset + 4] =
+        static_cast<uint8_t>(frame.commands.size() / kCommandSize);
+    offset += kFrameHeaderSize;
+    if (!frame.commands.empty()) {
+      memcpy(msg.data() + offset, frame.commands.data(),
+             frame.commands.size());
+      offset += frame.commands.size();
+    }
+  }
+  msg[offset] = static_cast<uint8_t>(state_.size());
+  offset++;
+  for (auto&& i : state_) {
+    msg[offset] = static_cast<uint8_t>(i.second.first);
+    memcpy(msg.data() + offset + 1, &i.second.second,
+           sizeof(i.second.second));
+    offset += kCommandSize;
+  }
+  assert(offset == size);
+  if (sends_remaining_ > 0) {
+    sends_remaining_--;
+  }
+  return msg;
+}
+
+auto RemoteInputStreamIn::HandleMessage(const std::vector<uint8_t>& buffer,
+                                        const CommandFunc& func) -> bool {
+  if (buffer.size() < kMessageHeaderSize
+      || buffer[0] != BA_MESSAGE_REMOTE_PLAYER_INPUT_FRAMES) {
+    return false;
+  }
+  int device_index = buffer[1];
+  int frame_count = buffer[2];
+
+  // Validate the whole thing before applying anything.
+  size_t offset = kMessageHeaderSize;
+  for (int i = 0; i < frame_count; ++i) {
+    if (offset + kFrameHeaderSize > buffer.size()) {
+      return false;
+    }
+    offset += kFrameHeaderSize + buffer[offset + 4] * kCommandSize;
+  }
+  if (offset + 1 > buffer.size()
+      || offset + 1 + buffer[offset] * kCommandSize != buffer.size()) {
+    return false;
+  }
+
+  // Frames are oldest first; apply any at or beyond our next expected seq.
+  // We compare with signed differences so this all keeps working if seqs
+  // ever wrap.
+  auto next_seq_i = next_seqs_.find(device_index);
+  bool have_next_seq = (next_seq_i != next_seqs_.end());
+  uint32_t next_seq = have_next_seq ? next_seq_i->second : 0;
+  auto& state{states_[device_index]};
+  uint32_t seq{};
+  offset = kMessageHeaderSize;
+  for (int i = 0; i < frame_count; ++i) {
+    memcpy(&seq, buffer.data() + offset, sizeof(seq));
+    int command_count = buffer[offset + 4];
+    offset += kFrameHeaderSize;
+    auto diff = static_cast<int32_t>(seq - next_seq);
+    if (have_next_seq && diff < 0) {
+      frames_duplicate_++;
+      offset += command_count * kCommandSize;
+      continue;
+    }
+    if (have_next_seq) {
+      // Anything we skipped over is gone for good.
+      frames_lost_ += diff;
+    }
+    for (int j = 0; j < command_count; ++j) {
+      auto type = static_cast<InputType>(buffer[offset]);
+      float value;
+      memcpy(&value, buffer.data() + offset + 1, sizeof(value));
+      offset += kCommandSize;
+      state[GetInputChannel(type)] = {type, value};
+      func(device_index, type, value);
+    }
+    frames_applied_++;
+    next_seq = seq + 1;
+    have_next_seq = true;
+  }
+  if (have_next_seq) {
+    next_seqs_[device_index] = next_seq;
+  }
+
+  // If this message is current as of our newest frame, bring anything we
+  // missed in lost frames in line with the state it carries. (Stale
+  // messages arriving out of order are ignored here since their state
+  // would be a step backwards).
+  int state_count = buffer[offset];
+  offset++;
+  if (frame_count > 0 && seq + 1 == next_seq) {
+    for (int i = 0; i < state_count; ++i) {
+      auto type = static_cast<InputType>(buffer[offset]);
+      float value;
+      memcpy(&value, buffer.data() + offset + 1, sizeof(value));
+      offset += kCommandSize;
+      auto& applied{state[GetInputChannel(type)]};
+      if (applied.first != type || applied.second != value) {
+        applied = {type, value};
+        commands_resynced_++;
+        func(device_index, type, value);
+      }
+    }
+  }
+  return true;
+}
+
+namespace {
+
+// Matches the re-send timing in Connection.
+constexpr int kSimResendTime{100};
+constexpr int kSimBucketSize{20};
+constexpr int kSimBucketCount{20};
+
+struct SimResults {
+  std::vector<int> latencies;
+  int lost{};
+};
+
+auto SimPercentile(const std::vector<int>& sorted, float fraction) -> int {
+  if (sorted.empty()) {
+    return 0;
+  }
+  auto index = static_cast<size_t>(fraction
+                                   * static_cast<float>(sorted.size() - 1));
+  return sorted[index];
+}
+
+auto SimSummary(SimResults* results) -> std::string {
+  auto& l{results->latencies};
+  std::sort(l.begin(), l.end());
+  char buffer[128];
+  snprintf(buffer, sizeof(buffer),
+           "p50=%dms p95=%dms p99=%dms max=%dms lost=%d",
+           SimPercentile(l, 0.5f), SimPercentile(l, 0.95f),
+           SimPercentile(l, 0.99f), l.empty() ? 0 : l.back(), results->lost);
+  return buffer;
+}
+
+}  // namespace
+
+auto RunRemoteInputLatencySimulation(float loss, int latency, int interval,
+                                     int frame_count) -> std::string {
+  BA_PRECONDITION(loss >= 0.0f && loss < 1.0f);
+  BA_PRECONDITION(latency >= 0);
+  BA_PRECONDITION(interval > 0);
+  BA_PRECONDITION(frame_count > 0);
+
+  uint32_t seed = 12345;
+  auto lost = [&seed, loss] {
+    seed = seed * 1664525u + 1013904223u;
+    return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24) < loss;
+  };
+
+  // Reliable path: each frame is its own message, re-sent with doubling
+  // delays until one gets through, and messages are only handled in order.
+  SimResults reliable;
+  {
+    int last_handled_time = 0;
+    for (int i = 0; i < frame_count; ++i) {
+      int gen_time = i * interval;
+      int send_time = gen_time;
+      int resend_time = kSimResendTime;
+      while (lost()) {
+        send_time += resend_time;
+        resend_time *= 2;
+      }
+      int handled_time = std::max(send_time + latency, last_handled_time);
+      last_handled_time = handled_time;
+      reliable.latencies.push_back(handled_time - gen_time);
+    }
+  }
+
+  // Redundant path: the real stream classes over a link that drops
+  // whole messages.
+  SimResults redundant;
+  {
+    RemoteInputStreamOut out;
+    RemoteInputStreamIn in;
+    std::vector<int> handled_times(frame_count, -1);
+    int now = 0;
+    auto handle = [&handled_times, &now](int, InputType, float value) {
+      auto frame = static_cast<size_t>(value);
+      assert(frame < handled_times.size() && handled_times[frame] == -1);
+      handled_times[frame] = now;
+    };
+    for (int i = 0; i < frame_count || out.ShouldResend(); ++i) {
+      if (i < frame_count) {
+        uint8_t command[RemoteInputStreamOut::kCommandSize];
+        command[0] = static_cast<uint8_t>(InputType::kRun);
+        auto value = static_cast<float>(i);
+        memcpy(command + 1, &value, sizeof(value));
+        out.AddFrame(static_cast<uint32_t>(i), command, sizeof(command));
+      }
+      auto msg = out.BuildMessage(0);
+      if (!lost()) {
+        // Arrivals all share one latency so they land in send order.
+        now = i * interval + latency;
+        bool valid = in.HandleMessage(msg, handle);
+        assert(valid);
+        (void)valid;
+      }
+    }
+    for (int i = 0; i < frame_count; ++i) {
+      if (handled_times[i] == -1) {
+        redundant.lost++;
+      } else {
+        redundant.latencies.push_back(handled_times[i] - i * interval);
+      }
+    }
+  }
+
+  // Build histograms.
+  std::vector<int> reliable_buckets(kSimBucketCount + 1);
+  std::vector<int> redundant_buckets(kSimBucketCount + 1);
+  for (int l : reliable.latencies) {
+    reliable_buckets[std::min(l / kSimBucketSize, kSimBucketCount)]++;
+  }
+  for (int l : redundant.latencies) {
+    redundant_buckets[std::min(l / kSimBucketSize, kSimBucketCount)]++;
+  }
+
+  char buffer[256];
+  snprintf(buffer, sizeof(buffer),
+           "Remote input latency simulation: %d frames every %dms, %.1f%% "
+           "loss, %dms one-way latency.",
+           frame_count, interval, loss * 100.0f, latency);
+  std::string out = buffer;
+  out += "\n  reliable:  " + SimSummary(&reliable);
+  out += "\n  redundant: " + SimSummary(&redundant) + " ("
+         + std::to_string(RemoteInputStreamOut::kRedundantFrames)
+         + " frames per message)";
+  out += "\n  latency      reliable  redundant";
+  for (int i = 0; i <= kSimBucketCount; ++i) {
+    if (reliable_buckets[i] == 0 && redundant_buckets[i] == 0) {
+      continue;
+    }
+    std::string label =
+        (i < kSimBucketCount)
+            ? std::to_string(i * kSimBucketSize) + "-"
+                  + std::to_string((i + 1) * kSimBucketSize - 1) + "ms"
+            : std::to_string(i * kSimBucketSize) + "+ms";
+    snprintf(buffer, sizeof(buffer), "\n  %-11s  %8d  %9d", label.c_str(),
+             reliable_buckets[i], redundant_buckets[i]);
+    out += buffer;
+  }
+  return out;
+}
+
+}  // namespace ballistica::scene_v1
@@ -0,0 +1,114 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SCENE_V1_CONNECTION_REMOTE_INPUT_STREAM_H_
+#define BALLISTICA_SCENE_V1_CONNECTION_REMOTE_INPUT_STREAM_H_
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ballistica/shared/foundation/types.h"
+
+namespace ballistica::scene_v1 {
+
+/// Remote-player input sent over the unsequenced (unreliable, no
+/// head-of-line blocking) message path.
+///
+/// Each batch of input commands a client ships becomes a numbered frame,
+/// and every message carries the last few frames, so isolated packet
+/// losses get covered by the next message instead of stalling behind a
+/// reliable re-send. The host applies each frame at most once and always
+/// in order.
+///
+/// Frames only cover the last few sends, so a longer run of losses can
+/// swallow a press or release outright. To recover from that, every
+/// message also carries the full current input state (the latest command
+/// seen on each button and axis); after applying a message's frames the
+/// host re-issues any of those that differ from what it last applied, so
+/// a dropped release can't leave a button held.
+///
+/// Message layout (BA_MESSAGE_REMOTE_PLAYER_INPUT_FRAMES):
+///   u8 message-type, u8 input-device-index, u8 frame-count,
+///   then per frame (oldest first): u32 seq, u8 command-count, and
+///   command-count (u8 input-type, f32 value) pairs; then u8 state-count
+///   and state-count (u8 input-type, f32 value) pairs.
+class RemoteInputStreamOut {
+ public:
+  /// How many frames each message carries (and thus how many times each
+  /// frame gets sent).
+  static constexpr int kRedundantFrames{4};
+
+  /// Bytes per input command in frames and in the classic reliable
+  /// BA_MESSAGE_REMOTE_PLAYER_INPUT_COMMANDS message.
+  static constexpr size_t kCommandSize{5};
+
+  /// Add a frame of raw commands (kCommandSize bytes each).
+  void AddFrame(uint32_t seq, const uint8_t* commands, size_t size);
+
+  /// Build a message containing our current input state and as many
+  /// recent frames as fit (the newest one always fits). Each call counts as
+  /// a send for ShouldResend().
+  auto BuildMessage(int device_index) -> std::vector<uint8_t>;
+
+  /// Whether our newest frame has yet to go out kRedundantFrames times.
+  /// Senders should keep sending messages while this is true, even
+  /// without new input, so a trailing frame isn't lost with one packet.
+  auto ShouldResend() const -> bool { return sends_remaining_ > 0; }
+
+ private:
+  struct Frame_ {
+    uint32_t seq;
+    std::vector<uint8_t> commands;
+  };
+  std::deque<Frame_> frames_;
+
+  // Latest command (type and value) per input channel.
+  std::map<InputType, std::pair<InputType, float> > state_;
+  int sends_remaining_{};
+};
+
+class RemoteInputStreamIn {
+ public:
+  using CommandFunc =
+      std::function<void(int device_index, InputType type, float value)>;
+
+  /// Parse a BA_MESSAGE_REMOTE_PLAYER_INPUT_FRAMES message, calling func
+  /// for each command in frames we haven't yet applied, in order, and then
+  /// for any state the message carries that we missed. Returns false if the
+  /// message is malformed.
+  auto HandleMessage(const std::vector<uint8_t>& buffer,
+                     const CommandFunc& func) -> bool;
+
+  auto frames_applied() const { return frames_applied_; }
+  auto frames_duplicate() const { return frames_duplicate_; }
+  auto frames_lost() const { return frames_lost_; }
+  auto commands_resynced() const { return commands_resynced_; }
+
+ private:
+  // Next expected frame seq per input-device index.
+  std::unordered_map<int, uint32_t> next_seqs_;
+
+  // Latest command we've applied per input channel per input-device index.
+  std::unordered_map<int, std::map<InputType, std::pair<InputType, float> > >
+      states_;
+  int64_t frames_applied_{};
+  int64_t frames_duplicate_{};
+  int64_t frames_lost_{};
+  int64_t commands_resynced_{};
+};
+
+/// Simulate a stream of input frames over a lossy link using both the
+/// classic reliable path (in-order delivery with timed re-sends) and the
+/// redundant unreliable path, returning delivery latency histograms for
+/// each.
+auto RunRemoteInputLatencySimulation(float loss, int latency, int interval,
+                                     int frame_count) -> std::string;
+
+}  // namespace ballistica::scene_v1
+
+#endif  // BALLISTICA_SCENE_V1_CONNECTION_REMOTE_INPUT_STREAM_H_
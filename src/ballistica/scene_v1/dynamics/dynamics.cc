@@ -9,9 +9,12 @@
 #include "ballistica/core/core.h"
 #include "ballistica/scene_v1/assets/scene_sound.h"
 #include "ballistica/scene_v1/dynamics/collision.h"
+#include "ballistica/scene_v1/dynamics/material/batch_call_material_action.h"
 #include "ballistica/scene_v1/dynamics/material/material_action.h"
 #include "ballistica/scene_v1/dynamics/part.h"
 #include "ballistica/scene_v1/support/scene.h"
+#include "ballistica/scene_v1/support/scene_v1_app_mode.h"
+#include "ballistica/shared/generic/worker_pool.h"
 #include "ode/ode_collision_kernel.h"
 #include "ode/ode_collision_util.h"
 
@@ -23,6 +26,24 @@ namespace ballistica::scene_v1 {
 //  we may get contacts only at one end of an object, etc.
 #define MAX_CONTACTS 20
 
+// Below this many gathered pairs we just run narrowphase tests inline.
+static constexpr size_t kMinParallelNarrowphasePairs{64};
+
+// Pairs handed to a worker at a time when running in parallel.
+static constexpr size_t kNarrowphaseGrainSize{16};
+
+// Hands ODE's independent islands out to our worker pool.
+static void DispatchIslands(void* dispatch_data, int island_count,
+                            dIslandJobFunction* job, void* job_data) {
+  WorkerPool::Shared()->ParallelFor(
+      static_cast<size_t>(island_count), 1,
+      [job, job_data](size_t begin, size_t end, int /*slot*/) {
+        for (size_t i = begin; i < end; ++i) {
+          job(job_data, static_cast<int>(i));
+        }
+      });
+}
+
 // Given two parts, returns true if part1 is major in
 // the storage order.
 static auto IsInStoreOrder(int64_t node1, int part1, int64_t node2,
@@ -80,8 +101,8 @@ class Dynamics::CollisionEvent_ {
  public:
   Object::Ref<MaterialAction> action;
   Object::Ref<Collision> collision;
-  Object::WeakRef<Node> node1;  // first event node
-  Object::WeakRef<Node> node2;  // second event node
+  Handle<Node> node1;  // first event node
+  Handle<Node> node2;  // second event node
   CollisionEvent_(Node* node1_in, Node* node2_in,
                   const Object::Ref<MaterialAction>& action_in,
                   const Object::Ref<Collision>& collision_in)
@@ -132,6 +153,13 @@ class Dynamics::Impl_ {
   friend class Dynamics;
 };
 
+// (Collision is header-only so its pool lives here alongside its sole
+// allocation site).
+auto Collision::GetSlabPool() -> SlabPool* {
+  static SlabPool* pool = SlabPool::Create("scene_v1::Collision");
+  return pool;
+}
+
 Dynamics::Dynamics(Scene* scene_in)
     : scene_(scene_in),
       collision_cache_(new base::CollisionCache()),
@@ -440,10 +468,12 @@ void Dynamics::ProcessCollision_() {
     }
   }
 
-  // Process all standard collisions. This will trigger our callback which
-  // do the real work (add collisions to list, store commands to be
-  // called, etc).
-  dSpaceCollide(ode_space_, this, &DoCollideCallback_);
+  // Process all standard collisions. Broadphase gathers candidate pairs,
+  // their narrowphase tests then get run (possibly across worker threads),
+  // and finally results are applied in order to do the real work (add
+  // collisions to list, store commands to be called, etc).
+  dSpaceCollide(ode_space_, this, &DoGatherCallback_);
+  RunGatheredNarrowphase_();
 
   // Collide our trimeshes against everything.
   collision_cache_->CollideAgainstSpace(ode_space_, this, &DoCollideCallback_);
@@ -507,6 +537,19 @@ void Dynamics::ProcessCollision_() {
   }
   active_collision_ = nullptr;
   collision_events_.clear();
+
+  // Now hand batch calls everything they gathered.
+  if (!pending_batch_calls_.empty()) {
+    std::vector<Object::Ref<BatchCallMaterialAction> > batch_calls;
+    batch_calls.swap(pending_batch_calls_);
+    for (auto&& action : batch_calls) {
+      action->Flush();
+    }
+  }
+}
+
+void Dynamics::AddPendingBatchCall(BatchCallMaterialAction* action) {
+  pending_batch_calls_.emplace_back(action);
 }
 
 void Dynamics::Process() {
@@ -514,7 +557,13 @@ void Dynamics::Process() {
   // Update this once so we can recycle results.
   real_time_ = g_core->GetAppTimeMillisecs();
   ProcessCollision_();
-  dWorldQuickStep(ode_world_, kGameStepSeconds);
+  if (SceneV1AppMode::GetSingleton()->parallel_physics_islands()
+      && WorkerPool::Shared()->thread_count() > 0) {
+    dWorldQuickStepIslands(ode_world_, kGameStepSeconds, &DispatchIslands,
+                           nullptr);
+  } else {
+    dWorldQuickStep(ode_world_, kGameStepSeconds);
+  }
   dJointGroupEmpty(ode_contact_group_);
   in_process_ = false;
 }
@@ -575,11 +624,28 @@ void Dynamics::CollideCallback_(dGeomID o1, dGeomID o2) {
     return;
   }
 
+  if (!PassesCollidePrechecks_(r1, r2)) {
+    return;
+  }
+
+  // Perhaps an optimization could be to avoid collision testing
+  // if we're certain two materials will never result in a collision?
+  // I don't think calculating full material-states before each collision
+  // detection test would be economical but if there's a simple way to know
+  // they'll never collide.
+  dContact contact[MAX_CONTACTS];  // up to MAX_CONTACTS contacts per pair
+  if (int numc =
+          dCollide(o1, o2, MAX_CONTACTS, &contact[0].geom, sizeof(dContact))) {
+    HandleContacts_(o1, o2, contact, numc);
+  }
+}
+
+auto Dynamics::PassesCollidePrechecks_(RigidBody* r1, RigidBody* r2) -> bool {
   // Check their overall types to count out some basics
   // (landscapes never collide against landscapes, etc).
   if (!((r1->collide_type() & r2->collide_mask())
         && (r2->collide_type() & r1->collide_mask()))) {  // NOLINT
-    return;
+    return false;
   }
 
   Part* p1 = r1->part();
@@ -587,518 +653,583 @@ void Dynamics::CollideCallback_(dGeomID o1, dGeomID o2) {
   assert(p1 && p2);
 
   // Pre-filter collisions.
-  if (!(p1->node()->PreFilterCollision(r1, r2)
-        && p2->node()->PreFilterCollision(r2, r1))) {
+  return p1->node()->PreFilterCollision(r1, r2)
+         && p2->node()->PreFilterCollision(r2, r1);
+}
+
+void Dynamics::DoGatherCallback_(void* data, dGeomID o1, dGeomID o2) {
+  auto* d = static_cast<Dynamics*>(data);
+  d->GatherCallback_(o1, o2);
+}
+
+// Broadphase callback for our main space. Rather than running narrowphase
+// tests immediately, we just record pairs that pass our prechecks so their
+// tests can be run in parallel. Nothing here depends on results of other
+// pairs, so gathering everything up front doesn't change any outcomes.
+void Dynamics::GatherCallback_(dGeomID o1, dGeomID o2) {
+  auto* r1 = static_cast<RigidBody*>(dGeomGetData(o1));
+  auto* r2 = static_cast<RigidBody*>(dGeomGetData(o2));
+  assert(r1 && r2);
+
+  // Trimeshes are handled separately through our collision cache.
+  assert(dGeomGetClass(o1) != dTriMeshClass
+         && dGeomGetClass(o2) != dTriMeshClass);
+
+  if (!PassesCollidePrechecks_(r1, r2)) {
     return;
   }
 
-  // Perhaps an optimization could be to avoid collision testing
-  // if we're certain two materials will never result in a collision?
-  // I don't think calculating full material-states before each collision
-  // detection test would be economical but if there's a simple way to know
-  // they'll never collide.
-  dContact contact[MAX_CONTACTS];  // up to MAX_CONTACTS contacts per pair
-  if (int numc =
-          dCollide(o1, o2, MAX_CONTACTS, &contact[0].geom, sizeof(dContact))) {
-    MaterialContext* cc1;
-    MaterialContext* cc2;
+  size_t index = collide_pairs_.size();
+  collide_pairs_.push_back({o1, o2, 0});
+  if (collide_contacts_.size() < collide_pairs_.size() * MAX_CONTACTS) {
+    collide_contacts_.resize(collide_pairs_.size() * MAX_CONTACTS);
+  }
 
-    // Create or acquire a collision.
-    Collision* c = GetCollision(p1, p2, &cc1, &cc2);
+  // Transform geoms temporarily modify their child geoms while being
+  // tested, so they can't safely be tested concurrently; just run those
+  // tests here. Everything else is pure and can be deferred.
+  if (dGeomGetClass(o1) == dGeomTransformClass
+      || dGeomGetClass(o2) == dGeomTransformClass) {
+    collide_pairs_[index].contact_count =
+        dCollide(o1, o2, MAX_CONTACTS,
+                 &collide_contacts_[index * MAX_CONTACTS].geom,
+                 sizeof(dContact));
+  } else {
+    deferred_pairs_.push_back(index);
+  }
+}
 
-    // If theres no physical collision between these two suckers we're done.
-    if (!c->collide) {
-      return;
+void Dynamics::RunGatheredNarrowphase_() {
+  auto test_pairs = [this](size_t begin, size_t end, int /*slot*/) {
+    for (size_t i = begin; i < end; ++i) {
+      auto& pair{collide_pairs_[deferred_pairs_[i]]};
+      pair.contact_count = dCollide(
+          pair.o1, pair.o2, MAX_CONTACTS,
+          &collide_contacts_[deferred_pairs_[i] * MAX_CONTACTS].geom,
+          sizeof(dContact));
     }
+  };
 
-    // Store body IDs for use in callback messages.
-    // There may be more than one body ID per part-on-part contact
-    // but we just keep one at the moment.
-    c->body_id_1 = r1->id();
-    c->body_id_2 = r2->id();
-
-    // Get average depth for all contacts.
-    if (numc > 0) {
-      float d = 0;
-      for (int i = 0; i < numc; i++) {
-        d += contact[i].geom.depth;
-      }
-      c->depth = d / static_cast<float>(numc);
+  // Farming out small amounts of work costs more than it saves.
+  if (deferred_pairs_.size() < kMinParallelNarrowphasePairs) {
+    test_pairs(0, deferred_pairs_.size(), 0);
+  } else {
+    WorkerPool::Shared()->ParallelFor(deferred_pairs_.size(),
+                                      kNarrowphaseGrainSize, test_pairs);
+  }
+
+  // Now apply results in our original broadphase order so that contact
+  // joints, collision creation, sounds, etc. are identical regardless of
+  // how the work above was split.
+  for (size_t i = 0; i < collide_pairs_.size(); ++i) {
+    auto& pair{collide_pairs_[i]};
+    if (pair.contact_count > 0) {
+      HandleContacts_(pair.o1, pair.o2, &collide_contacts_[i * MAX_CONTACTS],
+                      pair.contact_count);
     }
+  }
+  collide_pairs_.clear();
+  deferred_pairs_.clear();
+}
 
-    // Get average position for all contacts.
-    float apx = 0;
-    float apy = 0;
-    float apz = 0;
-    if (numc > 0) {
-      for (int i = 0; i < numc; i++) {
-        apx += contact[i].geom.pos[0];
-        apy += contact[i].geom.pos[1];
-        apz += contact[i].geom.pos[2];
-      }
-      auto fnumc = static_cast<float>(numc);
-      apx /= fnumc;
-      apy /= fnumc;
-      apz /= fnumc;
+// Apply the results of a narrowphase test that produced contacts.
+void Dynamics::HandleContacts_(dGeomID o1, dGeomID o2, dContact* contact,
+                               int numc) {
+  assert(numc > 0);
+  dBodyID b1 = dGeomGetBody(o1);
+  dBodyID b2 = dGeomGetBody(o2);
+  auto* r1 = static_cast<RigidBody*>(dGeomGetData(o1));
+  auto* r2 = static_cast<RigidBody*>(dGeomGetData(o2));
+  Part* p1 = r1->part();
+  Part* p2 = r2->part();
+
+  MaterialContext* cc1;
+  MaterialContext* cc2;
+
+  // Create or acquire a collision.
+  Collision* c = GetCollision(p1, p2, &cc1, &cc2);
+
+  // If theres no physical collision between these two suckers we're done.
+  if (!c->collide) {
+    return;
+  }
+
+  // Store body IDs for use in callback messages.
+  // There may be more than one body ID per part-on-part contact
+  // but we just keep one at the moment.
+  c->body_id_1 = r1->id();
+  c->body_id_2 = r2->id();
+
+  // Get average depth for all contacts.
+  if (numc > 0) {
+    float d = 0;
+    for (int i = 0; i < numc; i++) {
+      d += contact[i].geom.depth;
     }
-    c->x = apx;
-    c->y = apy;
-    c->z = apz;
-
-    // If theres an impact sound, skid sound, or roll sound attached to this
-    // collision, calculate applicable values.
-    // Impact is based on the component of the vector (force x relative
-    // velocity) that is parallel to the collision normal.
-    // Skid is the component tangential to the collision normal.
-    // Roll is based on tangential velocity multiplied by parallel force.
-    bool get_feedback_for_these_collisions = false;
-
-    if (cc1->complex_sound || cc2->complex_sound) {
-      millisecs_t real_time = real_time_;
-
-      // Its possible that we have more than one set of colliding things
-      // that resolve to the same collision record
-      // (multiple bodies in the same part, etc).
-      // However we can only calc feedback for the first one we come across
-      // (there's only one feedback buffer in the Collision).
-      if (c->claim_count == 1) {
-        get_feedback_for_these_collisions = true;
-      }
+    c->depth = d / static_cast<float>(numc);
+  }
 
-      dVector3 an;
-      an[0] = an[1] = an[2] = 0;
-      dVector3 b1v;
-      dVector3 b2v;
-      dVector3 b1cv;
-      dVector3 b2cv;
+  // Get average position for all contacts.
+  float apx = 0;
+  float apy = 0;
+  float apz = 0;
+  if (numc > 0) {
+    for (int i = 0; i < numc; i++) {
+      apx += contact[i].geom.pos[0];
+      apy += contact[i].geom.pos[1];
+      apz += contact[i].geom.pos[2];
+    }
+    auto fnumc = static_cast<float>(numc);
+    apx /= fnumc;
+    apy /= fnumc;
+    apz /= fnumc;
+  }
+  c->x = apx;
+  c->y = apy;
+  c->z = apz;
+
+  // If theres an impact sound, skid sound, or roll sound attached to this
+  // collision, calculate applicable values.
+  // Impact is based on the component of the vector (force x relative
+  // velocity) that is parallel to the collision normal.
+  // Skid is the component tangential to the collision normal.
+  // Roll is based on tangential velocity multiplied by parallel force.
+  bool get_feedback_for_these_collisions = false;
+
+  if (cc1->complex_sound || cc2->complex_sound) {
+    millisecs_t real_time = real_time_;
+
+    // Its possible that we have more than one set of colliding things
+    // that resolve to the same collision record
+    // (multiple bodies in the same part, etc).
+    // However we can only calc feedback for the first one we come across
+    // (there's only one feedback buffer in the Collision).
+    if (c->claim_count == 1) {
+      get_feedback_for_these_collisions = true;
+    }
 
-      // Get average collide normal for all contacts.
-      {
-        if (numc > 0) {
-          for (int i = 0; i < numc; i++) {
-            an[0] += contact[i].geom.normal[0];
-            an[1] += contact[i].geom.normal[1];
-            an[2] += contact[i].geom.normal[2];
-          }
-          auto fnumc = static_cast<float>(numc);
-          an[0] /= fnumc;
-          an[1] /= fnumc;
-          an[2] /= fnumc;
+    dVector3 an;
+    an[0] = an[1] = an[2] = 0;
+    dVector3 b1v;
+    dVector3 b2v;
+    dVector3 b1cv;
+    dVector3 b2cv;
+
+    // Get average collide normal for all contacts.
+    {
+      if (numc > 0) {
+        for (int i = 0; i < numc; i++) {
+          an[0] += contact[i].geom.normal[0];
+          an[1] += contact[i].geom.normal[1];
+          an[2] += contact[i].geom.normal[2];
         }
+        auto fnumc = static_cast<float>(numc);
+        an[0] /= fnumc;
+        an[1] /= fnumc;
+        an[2] /= fnumc;
+      }
 
-        const dReal* v;
-
-        // Get body velocities at the avg contact point in global coords.
-        if (b1) {
-          v = dBodyGetLinearVel(b1);
-          b1cv[0] = v[0];
-          b1cv[1] = v[1];
-          b1cv[2] = v[2];
-          dBodyGetPointVel(b1, apx, apy, apz, b1v);
-        } else {
-          b1cv[0] = b1cv[1] = b1cv[2] = 0;
-          b1v[0] = b1v[1] = b1v[2] = 0;
-        }
-        if (b2) {
-          v = dBodyGetLinearVel(b2);
-          b2cv[0] = v[0];
-          b2cv[1] = v[1];
-          b2cv[2] = v[2];
-          dBodyGetPointVel(b2, apx, apy, apz, b2v);
-        } else {
-          b2cv[0] = b2cv[1] = b2cv[2] = 0;
-          b2v[0] = b2v[1] = b2v[2] = 0;
-        }
+      const dReal* v;
+
+      // Get body velocities at the avg contact point in global coords.
+      if (b1) {
+        v = dBodyGetLinearVel(b1);
+        b1cv[0] = v[0];
+        b1cv[1] = v[1];
+        b1cv[2] = v[2];
+        dBodyGetPointVel(b1, apx, apy, apz, b1v);
+      } else {
+        b1cv[0] = b1cv[1] = b1cv[2] = 0;
+        b1v[0] = b1v[1] = b1v[2] = 0;
       }
+      if (b2) {
+        v = dBodyGetLinearVel(b2);
+        b2cv[0] = v[0];
+        b2cv[1] = v[1];
+        b2cv[2] = v[2];
+        dBodyGetPointVel(b2, apx, apy, apz, b2v);
+      } else {
+        b2cv[0] = b2cv[1] = b2cv[2] = 0;
+        b2v[0] = b2v[1] = b2v[2] = 0;
+      }
+    }
 
-      dVector3 local_feedback;
-      if (!c->collide_feedback.empty()) {
-        assert(b1 || b2);
-        dBodyID fb;
-        float affx = 0;
-        float affy = 0;
-        float affz = 0;
-        float aftx = 0;
-        float afty = 0;
-        float aftz = 0;
-
-        // Get one or the other force. Once we convert it to local
-        // it should be equal/opposite.
-        if (b1) {
-          fb = b1;
-          for (auto& i : c->collide_feedback) {
-            affx += i.f1[0];
-            affy += i.f1[1];
-            affz += i.f1[2];
-            aftx += i.t1[0];
-            afty += i.t1[1];
-            aftz += i.t1[2];
-          }
-        } else {
-          fb = b2;
-          for (auto& i : c->collide_feedback) {
-            affx += i.f2[0];
-            affy += i.f2[1];
-            affz += i.f2[2];
-            aftx += i.t2[0];
-            afty += i.t2[1];
-            aftz += i.t2[2];
-          }
+    dVector3 local_feedback;
+    if (!c->collide_feedback.empty()) {
+      assert(b1 || b2);
+      dBodyID fb;
+      float affx = 0;
+      float affy = 0;
+      float affz = 0;
+      float aftx = 0;
+      float afty = 0;
+      float aftz = 0;
+
+      // Get one or the other force. Once we convert it to local
+      // it should be equal/opposite.
+      if (b1) {
+        fb = b1;
+        for (auto& i : c->collide_feedback) {
+          affx += i.f1[0];
+          affy += i.f1[1];
+          affz += i.f1[2];
+          aftx += i.t1[0];
+          afty += i.t1[1];
+          aftz += i.t1[2];
         }
-        dMass mass;
-        dBodyGetMass(fb, &mass);
-
-        // Average them and divide by mass to normalize the force.
-        float count = c->collide_feedback.size();
-        affx /= (count * mass.mass * 10.0f);
-        affy /= (count * mass.mass * 10.0f);
-        affz /= (count * mass.mass * 10.0f);
-        aftx /= (count * mass.mass * 10.0f);
-        afty /= (count * mass.mass * 10.0f);
-        aftz /= (count * mass.mass * 10.0f);
-
-        // Get local feedback.
-        do_dBodyGetLocalFeedback(fb, apx, apy, apz, affx, affy, affz, aftx,
-                                 afty, aftz, local_feedback);
-
-        // TODO(ericf): normalize feedback based on body mass so all bodies can
-        //  use similar ranges? ...  hmm maybe not a good idea.. larger object
-        //  *should* be louder plus then we're using object mass, which doesnt
-        //  account for objects
-        //  connected to it via fixed constraints, etc
-        //  the sound should simply have a impulse associated with it -
-        //  anything less than that will scale appropriately
       } else {
-        local_feedback[0] = 0;
-        local_feedback[1] = 0;
-        local_feedback[2] = 0;
+        fb = b2;
+        for (auto& i : c->collide_feedback) {
+          affx += i.f2[0];
+          affy += i.f2[1];
+          affz += i.f2[2];
+          aftx += i.t2[0];
+          afty += i.t2[1];
+          aftz += i.t2[2];
+        }
       }
+      dMass mass;
+      dBodyGetMass(fb, &mass);
+
+      // Average them and divide by mass to normalize the force.
+      float count = c->collide_feedback.size();
+      affx /= (count * mass.mass * 10.0f);
+      affy /= (count * mass.mass * 10.0f);
+      affz /= (count * mass.mass * 10.0f);
+      aftx /= (count * mass.mass * 10.0f);
+      afty /= (count * mass.mass * 10.0f);
+      aftz /= (count * mass.mass * 10.0f);
+
+      // Get local feedback.
+      do_dBodyGetLocalFeedback(fb, apx, apy, apz, affx, affy, affz, aftx,
+                               afty, aftz, local_feedback);
+
+      // TODO(ericf): normalize feedback based on body mass so all bodies can
+      //  use similar ranges? ...  hmm maybe not a good idea.. larger object
+      //  *should* be louder plus then we're using object mass, which doesnt
+      //  account for objects
+      //  connected to it via fixed constraints, etc
+      //  the sound should simply have a impulse associated with it -
+      //  anything less than that will scale appropriately
+    } else {
+      local_feedback[0] = 0;
+      local_feedback[1] = 0;
+      local_feedback[2] = 0;
+    }
 
-      // Combine both velocities into one relative velocity for the contact
-      // point.
-      dVector3 rvel;
-      rvel[0] = b2v[0] - b1v[0];
-      rvel[1] = b2v[1] - b1v[1];
-      rvel[2] = b2v[2] - b1v[2];
-
-      // Get our overall relative velocity (at the objects' centers-of-gravity
-      // we use this to determine roll.
-      dVector3 crvel;
-      crvel[0] = b2cv[0] - b1cv[0];
-      crvel[1] = b2cv[1] - b1cv[1];
-      crvel[2] = b2cv[2] - b1cv[2];
-
-      // Now multiply our feedback force by our relative velocity and use the
-      // component of that which is parallel to our collide normal as "impact"
-      // and the tangential component as "skid".
+    // Combine both velocities into one relative velocity for the contact
+    // point.
+    dVector3 rvel;
+    rvel[0] = b2v[0] - b1v[0];
+    rvel[1] = b2v[1] - b1v[1];
+    rvel[2] = b2v[2] - b1v[2];
+
+    // Get our overall relative velocity (at the objects' centers-of-gravity
+    // we use this to determine roll.
+    dVector3 crvel;
+    crvel[0] = b2cv[0] - b1cv[0];
+    crvel[1] = b2cv[1] - b1cv[1];
+    crvel[2] = b2cv[2] - b1cv[2];
+
+    // Now multiply our feedback force by our relative velocity and use the
+    // component of that which is parallel to our collide normal as "impact"
+    // and the tangential component as "skid".
+    {
+      dVector3 vec = {local_feedback[0] * rvel[0],
+                      local_feedback[1] * rvel[1],
+                      local_feedback[2] * rvel[2]};
+      float cur_impact = std::abs(dDOT(an, vec)) / 3;
+      float vec_len = dVector3Length(vec);
+      float cur_skid = sqrtf(vec_len * vec_len - cur_impact * cur_impact) / 2;
+
+      // Roll is calculated as the component of force parallel to the normal
+      // multiplied by the tangential velocity component (relative
+      // center-of-gravity velocities - not at the contact point).
+      float cur_roll;
       {
-        dVector3 vec = {local_feedback[0] * rvel[0],
-                        local_feedback[1] * rvel[1],
-                        local_feedback[2] * rvel[2]};
-        float cur_impact = std::abs(dDOT(an, vec)) / 3;
-        float vec_len = dVector3Length(vec);
-        float cur_skid = sqrtf(vec_len * vec_len - cur_impact * cur_impact) / 2;
-
-        // Roll is calculated as the component of force parallel to the normal
-        // multiplied by the tangential velocity component (relative
-        // center-of-gravity velocities - not at the contact point).
-        float cur_roll;
-        {
-          float vparallel = dDOT(an, crvel);
-          float vec_len_2 = dVector3Length(crvel);
-          float vtangential =
-              sqrtf(vec_len_2 * vec_len_2 - vparallel * vparallel);
-          cur_roll = (vtangential);
-        }
-        cur_roll -= cur_impact;
-        cur_skid -= cur_impact;
-        if (cur_roll < 0) {
-          cur_roll = 0;
-        }
-        if (cur_skid < 0) {
-          cur_skid = 0;
+        float vparallel = dDOT(an, crvel);
+        float vec_len_2 = dVector3Length(crvel);
+        float vtangential =
+            sqrtf(vec_len_2 * vec_len_2 - vparallel * vparallel);
+        cur_roll = (vtangential);
+      }
+      cur_roll -= cur_impact;
+      cur_skid -= cur_impact;
+      if (cur_roll < 0) {
+        cur_roll = 0;
+      }
+      if (cur_skid < 0) {
+        cur_skid = 0;
+      }
+
+      // Weigh our new values with previous ones to get more smooth consistent
+      // values over time.
+      float impact_weight = 0.3f;
+      float skid_weight = 0.1f;
+      float roll_weight = 0.1f;
+
+      c->impact =
+          (1.0f - impact_weight) * c->impact + impact_weight * cur_impact;
+      c->skid = (1.0f - skid_weight) * c->skid + skid_weight * cur_skid;
+      c->roll = (1.0f - roll_weight) * c->roll + roll_weight * cur_roll;
+
+      // Draw debugging lines - red for impact, green for skid, blue for roll.
+      // if (scene_->getShowCollisions()) {
+      //     g_graphics_server->addDebugDrawObject(
+      //         new GraphicsServer::DebugDrawLine(
+      //             apx, apy, apz,
+      //             apx+0*0.5f*c->impact,
+      //             apy+1*0.5f*c->impact,
+      //             apz+0*0.5f*c->impact, 15, 1, 0, 0));
+      //     g_graphics_server->addDebugDrawObject(
+      //         new GraphicsServer::DebugDrawLine(
+      //             apx, apy, apz,
+      //             apx-0*0.5f*c->skid,
+      //             apy-1*0.5f*c->skid,
+      //             apz-0*0.5f*c->skid, 10, 0, 1, 0));
+      //     g_graphics_server->addDebugDrawObject(
+      //         new GraphicsServer::DebugDrawLine(
+      //             apx, apy, apz,
+      //             apx+1*0.5f*c->roll,
+      //             apy+0*0.5f*c->roll,
+      //             apz+0*0.5f*c->roll, 15, 0, 0, 1));
+      // }
+
+      // Play impact sounds if its been long enough since last.
+      // Clip if impact value is low enough (otherwise we'd be running tiny
+      // little impact sounds constantly).
+      // Also only play impact sound when our current impact is less than
+      // our average (so that as impact spikes we hit it near the top instead
+      // of on the way up).
+      if ((real_time - p1->last_impact_sound_time() >= 500)
+          || (real_time - p2->last_impact_sound_time() > 500)) {
+        float clip = 0.15f;
+        MaterialContext* contexts[] = {cc1, cc2};
+        for (auto context : contexts) {
+          for (auto&& i : context->impact_sounds) {
+            if (c->impact > i.target_impulse * clip
+                && cur_impact < c->impact) {
+              float volume = i.target_impulse > 0.0001f
+                                 ? (c->impact - (i.target_impulse * clip))
+                                       / (i.target_impulse * (1.0f - clip))
+                                 : 1.0f;
+
+              if (volume > 1) volume = 1;
+              assert(i.sound.Exists());
+              scene_->PlayDynamicsSound(i.sound.Get(), volume * i.volume,
+                                        {apx, apy, apz});
+              p1->set_last_impact_sound_time(real_time);
+              p2->set_last_impact_sound_time(real_time);
+              last_impact_sound_time_ = real_time;
+            }
+          }
         }
+      }
 
-        // Weigh our new values with previous ones to get more smooth consistent
-        // values over time.
-        float impact_weight = 0.3f;
-        float skid_weight = 0.1f;
-        float roll_weight = 0.1f;
-
-        c->impact =
-            (1.0f - impact_weight) * c->impact + impact_weight * cur_impact;
-        c->skid = (1.0f - skid_weight) * c->skid + skid_weight * cur_skid;
-        c->roll = (1.0f - roll_weight) * c->roll + roll_weight * cur_roll;
-
-        // Draw debugging lines - red for impact, green for skid, blue for roll.
-        // if (scene_->getShowCollisions()) {
-        //     g_graphics_server->addDebugDrawObject(
-        //         new GraphicsServer::DebugDrawLine(
-        //             apx, apy, apz,
-        //             apx+0*0.5f*c->impact,
-        //             apy+1*0.5f*c->impact,
-        //             apz+0*0.5f*c->impact, 15, 1, 0, 0));
-        //     g_graphics_server->addDebugDrawObject(
-        //         new GraphicsServer::DebugDrawLine(
-        //             apx, apy, apz,
-        //             apx-0*0.5f*c->skid,
-        //             apy-1*0.5f*c->skid,
-        //             apz-0*0.5f*c->skid, 10, 0, 1, 0));
-        //     g_graphics_server->addDebugDrawObject(
-        //         new GraphicsServer::DebugDrawLine(
-        //             apx, apy, apz,
-        //             apx+1*0.5f*c->roll,
-        //             apy+0*0.5f*c->roll,
-        //             apz+0*0.5f*c->roll, 15, 0, 0, 1));
-        // }
-
-        // Play impact sounds if its been long enough since last.
-        // Clip if impact value is low enough (otherwise we'd be running tiny
-        // little impact sounds constantly).
-        // Also only play impact sound when our current impact is less than
-        // our average (so that as impact spikes we hit it near the top instead
-        // of on the way up).
-        if ((real_time - p1->last_impact_sound_time() >= 500)
-            || (real_time - p2->last_impact_sound_time() > 500)) {
-          float clip = 0.15f;
-          MaterialContext* contexts[] = {cc1, cc2};
-          for (auto context : contexts) {
-            for (auto&& i : context->impact_sounds) {
-              if (c->impact > i.target_impulse * clip
-                  && cur_impact < c->impact) {
-                float volume = i.target_impulse > 0.0001f
-                                   ? (c->impact - (i.target_impulse * clip))
-                                         / (i.target_impulse * (1.0f - clip))
-                                   : 1.0f;
-
-                if (volume > 1) volume = 1;
+      // Play skid sounds.
+      {
+        float clip = 0.15f;
+        MaterialContext* contexts[] = {cc1, cc2};
+        for (auto context : contexts) {
+          for (auto&& i : context->skid_sounds) {
+            if (c->skid > i.target_impulse * clip) {
+              float volume = i.target_impulse > 0.0001f
+                                 ? (c->skid - (i.target_impulse * clip))
+                                       / (i.target_impulse * (1.0f - clip))
+                                 : 1.0f;
+              if (volume > 1) volume = 1;
+
+              // If we're already playing, just adjust volume
+              // and position - otherwise get a sound started.
+              if (i.playing) {
+                base::AudioSource* s =
+                    g_base->audio->SourceBeginExisting(i.play_id, 101);
+                if (s) {
+                  s->SetGain(volume * i.volume);
+                  s->SetPosition(apx, apy, apz);
+                  s->End();
+                } else {
+                  // Spare ourself some trouble next time.
+                  i.playing = false;
+                }
+              } else if ((real_time - p1->last_skid_sound_time() >= 250
+                          || real_time - p2->last_skid_sound_time() > 250)
+                         && scene_->ClaimDynamicsSoundBudget(
+                             volume * i.volume, {apx, apy, apz})) {
                 assert(i.sound.Exists());
                 if (base::AudioSource* source =
                         g_base->audio->SourceBeginNew()) {
+                  source->SetLooping(true);
                   source->SetGain(volume * i.volume);
                   source->SetPosition(apx, apy, apz);
-                  source->Play(i.sound->GetSoundData());
-                  p1->set_last_impact_sound_time(real_time);
-                  p2->set_last_impact_sound_time(real_time);
-                  last_impact_sound_time_ = real_time;
+                  i.play_id = source->Play(i.sound->GetSoundData());
+                  i.playing = true;
+                  p1->set_last_skid_sound_time(real_time);
+                  p2->set_last_skid_sound_time(real_time);
                   source->End();
                 }
               }
-            }
-          }
-        }
-
-        // Play skid sounds.
-        {
-          float clip = 0.15f;
-          MaterialContext* contexts[] = {cc1, cc2};
-          for (auto context : contexts) {
-            for (auto&& i : context->skid_sounds) {
-              if (c->skid > i.target_impulse * clip) {
-                float volume = i.target_impulse > 0.0001f
-                                   ? (c->skid - (i.target_impulse * clip))
-                                         / (i.target_impulse * (1.0f - clip))
-                                   : 1.0f;
-                if (volume > 1) volume = 1;
-
-                // If we're already playing, just adjust volume
-                // and position - otherwise get a sound started.
-                if (i.playing) {
-                  base::AudioSource* s =
-                      g_base->audio->SourceBeginExisting(i.play_id, 101);
-                  if (s) {
-                    s->SetGain(volume * i.volume);
-                    s->SetPosition(apx, apy, apz);
-                    s->End();
-                  } else {
-                    // Spare ourself some trouble next time.
-                    i.playing = false;
-                  }
-                } else if (real_time - p1->last_skid_sound_time() >= 250
-                           || real_time - p2->last_skid_sound_time() > 250) {
-                  assert(i.sound.Exists());
-                  if (base::AudioSource* source =
-                          g_base->audio->SourceBeginNew()) {
-                    source->SetLooping(true);
-                    source->SetGain(volume * i.volume);
-                    source->SetPosition(apx, apy, apz);
-                    i.play_id = source->Play(i.sound->GetSoundData());
-                    i.playing = true;
-                    p1->set_last_skid_sound_time(real_time);
-                    p2->set_last_skid_sound_time(real_time);
-                    source->End();
-                  }
-                }
-              } else {
-                // Skid values are low - stop any playing skid sounds.
-                if (i.playing) {
-                  g_base->audio->PushSourceFadeOutCall(i.play_id, 200);
-                  i.playing = false;
-                }
+            } else {
+              // Skid values are low - stop any playing skid sounds.
+              if (i.playing) {
+                g_base->audio->PushSourceFadeOutCall(i.play_id, 200);
+                i.playing = false;
               }
             }
           }
         }
+      }
 
-        // Play roll sounds.
-        {
-          float clip = 0.15f;
-          MaterialContext* contexts[] = {cc1, cc2};
-          for (auto context : contexts) {
-            for (auto&& i : context->roll_sounds) {
-              if (c->roll > i.target_impulse * clip) {
-                float volume = i.target_impulse > 0.0001f
-                                   ? (c->roll - (i.target_impulse * clip))
-                                         / (i.target_impulse * (1.0f - clip))
-                                   : 1;
-                if (volume > 1) volume = 1;
-
-                // If we're already playing, just adjust volume
-                // and position; otherwise get a sound started.
-                if (i.playing) {
-                  base::AudioSource* s =
-                      g_base->audio->SourceBeginExisting(i.play_id, 102);
-                  if (s) {
-                    s->SetGain(volume * i.volume);
-                    s->SetPosition(apx, apy, apz);
-                    s->End();
-                  } else {
-                    // spare ourself some trouble next time
-                    i.playing = false;
-                  }
-                } else if (real_time - p1->last_roll_sound_time() >= 250
-                           || real_time - p2->last_roll_sound_time() > 250) {
-                  assert(i.sound.Exists());
-                  if (base::AudioSource* source =
-                          g_base->audio->SourceBeginNew()) {
-                    source->SetLooping(true);
-                    source->SetGain(volume * i.volume);
-                    source->SetPosition(apx, apy, apz);
-                    i.play_id = source->Play(i.sound->GetSoundData());
-                    i.playing = true;
-                    p1->set_last_roll_sound_time(real_time);
-                    p2->set_last_roll_sound_time(real_time);
-                    source->End();
-                  }
-                }
-              } else {
-                // roll values are low - stop any playing roll sounds
-                if (i.playing) {
-                  g_base->audio->PushSourceFadeOutCall(i.play_id, 200);
+      // Play roll sounds.
+      {
+        float clip = 0.15f;
+        MaterialContext* contexts[] = {cc1, cc2};
+        for (auto context : contexts) {
+          for (auto&& i : context->roll_sounds) {
+            if (c->roll > i.target_impulse * clip) {
+              float volume = i.target_impulse > 0.0001f
+                                 ? (c->roll - (i.target_impulse * clip))
+                                       / (i.target_impulse * (1.0f - clip))
+                                 : 1;
+              if (volume > 1) volume = 1;
+
+              // If we're already playing, just adjust volume
+              // and position; otherwise get a sound started.
+              if (i.playing) {
+                base::AudioSource* s =
+                    g_base->audio->SourceBeginExisting(i.play_id, 102);
+                if (s) {
+                  s->SetGain(volume * i.volume);
+                  s->SetPosition(apx, apy, apz);
+                  s->End();
+                } else {
+                  // spare ourself some trouble next time
                   i.playing = false;
                 }
+              } else if ((real_time - p1->last_roll_sound_time() >= 250
+                          || real_time - p2->last_roll_sound_time() > 250)
+                         && scene_->ClaimDynamicsSoundBudget(
+                             volume * i.volume, {apx, apy, apz})) {
+                assert(i.sound.Exists());
+                if (base::AudioSource* source =
+                        g_base->audio->SourceBeginNew()) {
+                  source->SetLooping(true);
+                  source->SetGain(volume * i.volume);
+                  source->SetPosition(apx, apy, apz);
+                  i.play_id = source->Play(i.sound->GetSoundData());
+                  i.playing = true;
+                  p1->set_last_roll_sound_time(real_time);
+                  p2->set_last_roll_sound_time(real_time);
+                  source->End();
+                }
+              }
+            } else {
+              // roll values are low - stop any playing roll sounds
+              if (i.playing) {
+                g_base->audio->PushSourceFadeOutCall(i.play_id, 200);
+                i.playing = false;
               }
             }
           }
         }
       }
-      if (get_feedback_for_these_collisions) {
-        assert(numc >= 0);
-        c->collide_feedback.resize(static_cast<uint32_t>(numc));
-      }
     }
-
-    // Play collide sounds when new contacts happen
-    // or when the averaged collide-position relative to
-    // both objects changes by a largeish amount.
-    // (in a normal rolling or sliding situation, the collide position
-    // will stay relatively constant in at least one of the object's
-    // frame-of-reference)
-    bool play_collide_sounds = false;
-
-    // Normal sounds should just happen on initial contact creation.
-    if (c->contact_count == 0 && numc > 0) {
-      play_collide_sounds = true;
+    if (get_feedback_for_these_collisions) {
+      assert(numc >= 0);
+      c->collide_feedback.resize(static_cast<uint32_t>(numc));
     }
+  }
 
-    c->contact_count = numc;
+  // Play collide sounds when new contacts happen
+  // or when the averaged collide-position relative to
+  // both objects changes by a largeish amount.
+  // (in a normal rolling or sliding situation, the collide position
+  // will stay relatively constant in at least one of the object's
+  // frame-of-reference)
+  bool play_collide_sounds = false;
+
+  // Normal sounds should just happen on initial contact creation.
+  if (c->contact_count == 0 && numc > 0) {
+    play_collide_sounds = true;
+  }
 
-    if (play_collide_sounds) {
-      for (auto&& i : cc1->connect_sounds) {
-        assert(i.sound.Exists());
-        if (base::AudioSource* source = g_base->audio->SourceBeginNew()) {
-          source->SetPosition(apx, apy, apz);
-          source->SetGain(i.volume);
-          source->Play(i.sound->GetSoundData());
-          source->End();
-        }
-      }
-      for (auto&& i : cc2->connect_sounds) {
-        assert(i.sound.Exists());
-        if (base::AudioSource* source = g_base->audio->SourceBeginNew()) {
-          source->SetPosition(apx, apy, apz);
-          source->SetGain(i.volume);
-          source->Play(i.sound->GetSoundData());
-          source->End();
-        }
-      }
+  c->contact_count = numc;
+
+  if (play_collide_sounds) {
+    for (auto&& i : cc1->connect_sounds) {
+      assert(i.sound.Exists());
+      scene_->PlayDynamicsSound(i.sound.Get(), i.volume, {apx, apy, apz});
+    }
+    for (auto&& i : cc2->connect_sounds) {
+      assert(i.sound.Exists());
+      scene_->PlayDynamicsSound(i.sound.Get(), i.volume, {apx, apy, apz});
     }
+  }
 
-    // Set up collision constraints for this frame as long
-    // as theres at least one body involved.
-    if ((b1 || b2) && (cc1->physical && cc2->physical)) {
-      float friction = 1.2f * sqrtf(cc1->friction * cc2->friction);
-      float bounce = sqrtf(cc1->bounce * cc2->bounce);
-      float stiffness;
-      if (cc1->stiffness < 0.00000001f || cc2->stiffness < 0.00000001f) {
-        stiffness = 0.00000001f;
-      } else {
-        stiffness = 8000 * sqrtf(cc1->stiffness * cc2->stiffness);
-      }
-      float damping = 80 * cc1->damping + cc2->damping;
-      if ((stiffness < 0.00000001f) && (damping < 0.00000001f)) {
-        damping = 0.00000001f;
-      }
+  // Set up collision constraints for this frame as long
+  // as theres at least one body involved.
+  if ((b1 || b2) && (cc1->physical && cc2->physical)) {
+    float friction = 1.2f * sqrtf(cc1->friction * cc2->friction);
+    float bounce = sqrtf(cc1->bounce * cc2->bounce);
+    float stiffness;
+    if (cc1->stiffness < 0.00000001f || cc2->stiffness < 0.00000001f) {
+      stiffness = 0.00000001f;
+    } else {
+      stiffness = 8000 * sqrtf(cc1->stiffness * cc2->stiffness);
+    }
+    float damping = 80 * cc1->damping + cc2->damping;
+    if ((stiffness < 0.00000001f) && (damping < 0.00000001f)) {
+      damping = 0.00000001f;
+    }
 
-      // Cfm/erp (based off stiffness/damping).
-      float erp = (kGameStepSeconds * stiffness)
-                  / ((kGameStepSeconds * stiffness) + damping);
-      float cfm = 1.0f / ((kGameStepSeconds * stiffness) + damping);
-
-      // Normally a geom against a body does not automatically wake the body.
-      // However we explicitly do so in certain cases (if the geom is moving,
-      // etc).
-      if (r1->geom_wake_on_collide() || r2->geom_wake_on_collide()) {
-        if (b1) {
-          dBodyEnable(b1);
-        }
-        if (b2) {
-          dBodyEnable(b2);
-        }
+    // Cfm/erp (based off stiffness/damping).
+    float erp = (kGameStepSeconds * stiffness)
+                / ((kGameStepSeconds * stiffness) + damping);
+    float cfm = 1.0f / ((kGameStepSeconds * stiffness) + damping);
+
+    // Normally a geom against a body does not automatically wake the body.
+    // However we explicitly do so in certain cases (if the geom is moving,
+    // etc).
+    if (r1->geom_wake_on_collide() || r2->geom_wake_on_collide()) {
+      if (b1) {
+        dBodyEnable(b1);
       }
-      bool do_collide = true;
-
-      // Set up our contacts.
-      // FIXME should really do some merging in cases with > 15 or so contacts
-      //  (which seem to occur often with boxes and such).
-
-      for (int i = 0; i < numc; i += 1) {
-        // NOLINTNEXTLINE
-        contact[i].surface.mode = dContactBounce | dContactSoftCFM
-                                  | dContactSoftERP | dContactApprox1;
-        contact[i].surface.mu2 = 0;
-        contact[i].surface.bounce_vel = 0.1f;
-        contact[i].surface.mu = friction;
-        contact[i].surface.bounce = bounce;
-        contact[i].surface.soft_cfm = cfm;
-        contact[i].surface.soft_erp = erp;
+      if (b2) {
+        dBodyEnable(b2);
       }
+    }
+    bool do_collide = true;
+
+    // Set up our contacts.
+    // FIXME should really do some merging in cases with > 15 or so contacts
+    //  (which seem to occur often with boxes and such).
+
+    for (int i = 0; i < numc; i += 1) {
+      // NOLINTNEXTLINE
+      contact[i].surface.mode = dContactBounce | dContactSoftCFM
+                                | dContactSoftERP | dContactApprox1;
+      contact[i].surface.mu2 = 0;
+      contact[i].surface.bounce_vel = 0.1f;
+      contact[i].surface.mu = friction;
+      contact[i].surface.bounce = bounce;
+      contact[i].surface.soft_cfm = cfm;
+      contact[i].surface.soft_erp = erp;
+    }
 
-      // Let each side of the collision modify our stuff. If any party objects
-      // to the collision occurring, we scrap the whole plan.
-      if ((!r1->CallCollideCallbacks(contact, numc, r2))
-          || (!r2->CallCollideCallbacks(contact, numc, r1))) {
-        do_collide = false;
-      }
-      if (do_collide) {
-        collision_count_ += numc;
-        for (int i = 0; i < numc; i += 1) {
-          dJointID constraint =
-              dJointCreateContact(ode_world_, ode_contact_group_, contact + i);
-          dJointAttach(constraint, b1, b2);
-          if (get_feedback_for_these_collisions) {
-            dJointSetFeedback(constraint, &c->collide_feedback[i]);
-          }
+    // Let each side of the collision modify our stuff. If any party objects
+    // to the collision occurring, we scrap the whole plan.
+    if ((!r1->CallCollideCallbacks(contact, numc, r2))
+        || (!r2->CallCollideCallbacks(contact, numc, r1))) {
+      do_collide = false;
+    }
+    if (do_collide) {
+      collision_count_ += numc;
+      for (int i = 0; i < numc; i += 1) {
+        dJointID constraint =
+            dJointCreateContact(ode_world_, ode_contact_group_, contact + i);
+        dJointAttach(constraint, b1, b2);
+        if (get_feedback_for_these_collisions) {
+          dJointSetFeedback(constraint, &c->collide_feedback[i]);
         }
       }
     }
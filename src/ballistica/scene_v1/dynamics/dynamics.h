@@ -8,6 +8,7 @@
 
 #include "ballistica/base/base.h"
 #include "ballistica/scene_v1/scene_v1.h"
+#include "ballistica/shared/foundation/handle_table.h"
 #include "ballistica/shared/foundation/object.h"
 #include "ode/ode.h"
 
@@ -55,6 +56,10 @@ class Dynamics : public Object {
     collide_message_reverse_order_ = target_other;
   }
   auto in_collide_message() const { return in_collide_message_; }
+
+  /// Used by batch-call material actions to get flushed once the current
+  /// step's collision events have all run.
+  void AddPendingBatchCall(BatchCallMaterialAction* action);
   void Process();
   void IncrementSkidSoundCount() { skid_sound_count_++; }
   void DecrementSkidSoundCount() { skid_sound_count_--; }
@@ -90,12 +95,26 @@ class Dynamics : public Object {
                     MaterialContext** cc2) -> Collision*;
 
   std::vector<CollisionEvent_> collision_events_;
+  std::vector<Object::Ref<BatchCallMaterialAction> > pending_batch_calls_;
   void ResetODE_();
   void ShutdownODE_();
   static void DoCollideCallback_(void* data, dGeomID o1, dGeomID o2);
   void CollideCallback_(dGeomID o1, dGeomID o2);
+  static void DoGatherCallback_(void* data, dGeomID o1, dGeomID o2);
+  void GatherCallback_(dGeomID o1, dGeomID o2);
+  auto PassesCollidePrechecks_(RigidBody* r1, RigidBody* r2) -> bool;
+  void RunGatheredNarrowphase_();
+  void HandleContacts_(dGeomID o1, dGeomID o2, dContact* contact, int numc);
   void ProcessCollision_();
 
+  // A candidate pair from broadphase awaiting/holding narrowphase results.
+  // Contacts for pair n live at collide_contacts_[n * MAX_CONTACTS].
+  struct CollidePair_ {
+    dGeomID o1;
+    dGeomID o2;
+    int contact_count;
+  };
+
   int skid_sound_count_{};
   int roll_sound_count_{};
   int collision_count_{};
@@ -110,11 +129,14 @@ class Dynamics : public Object {
   millisecs_t last_impact_sound_time_{};
   Scene* scene_{};
   Collision* active_collision_{};
-  Object::WeakRef<Node> active_collide_src_node_;
-  Object::WeakRef<Node> active_collide_dst_node_;
+  Handle<Node> active_collide_src_node_;
+  Handle<Node> active_collide_dst_node_;
   std::vector<dGeomID> trimeshes_;
   std::unique_ptr<Impl_> impl_;
   std::unique_ptr<base::CollisionCache> collision_cache_;
+  std::vector<CollidePair_> collide_pairs_;
+  std::vector<size_t> deferred_pairs_;
+  std::vector<dContact> collide_contacts_;
 };
 
 }  // namespace ballistica::scene_v1
@@ -0,0 +1,96 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/scene_v1/dynamics/material/batch_call_material_action.h"
+
+#include "ballistica/scene_v1/assets/scene_sound.h"
+#include "ballistica/scene_v1/dynamics/collision.h"
+#include "ballistica/scene_v1/dynamics/dynamics.h"
+#include "ballistica/scene_v1/dynamics/material/material_context.h"
+#include "ballistica/scene_v1/node/node.h"
+#include "ballistica/scene_v1/support/scene.h"
+#include "ballistica/shared/python/python_ref.h"
+#include "ballistica/shared/python/python_sys.h"
+
+namespace ballistica::scene_v1 {
+
+BatchCallMaterialAction::BatchCallMaterialAction(bool at_disconnect_in,
+                                                 PyObject* call_obj_in)
+    : at_disconnect(at_disconnect_in),
+      call(Object::New<base::PythonContextCall>(call_obj_in)) {}
+
+void BatchCallMaterialAction::Apply(MaterialContext* context,
+                                    const Part* src_part, const Part* dst_part,
+                                    const Object::Ref<MaterialAction>& p) {
+  assert(context && src_part && dst_part);
+  if (at_disconnect) {
+    context->disconnect_actions.push_back(p);
+  } else {
+    context->connect_actions.push_back(p);
+  }
+}
+
+void BatchCallMaterialAction::Execute(Node* node1, Node* node2, Scene* scene) {
+  // Same rules as regular calls; connects need both nodes to still exist
+  // and disconnects need the src node.
+  if (!node1 || (!at_disconnect && !node2)) {
+    return;
+  }
+  Dynamics* dynamics = scene->dynamics();
+  Collision* c = dynamics->active_collision();
+  assert(c);
+
+  // Body ids match what get_collision_info() gives regular calls.
+  if (records_.empty()) {
+    dynamics->AddPendingBatchCall(this);
+  }
+  records_.push_back({Handle<Node>(node1), Handle<Node>(node2), c->body_id_2,
+                      c->body_id_1, c->depth, c->x, c->y, c->z, c->impact});
+}
+
+void BatchCallMaterialAction::Flush() {
+  assert(g_base->InLogicThread());
+  if (records_.empty()) {
+    return;
+  }
+
+  // Grab our records first in case the call triggers anything that could
+  // add more.
+  std::vector<Record_> records;
+  records.swap(records_);
+
+  PythonRef list(PyList_New(static_cast<Py_ssize_t>(records.size())),
+                 PythonRef::kSteal);
+  for (size_t i = 0; i < records.size(); ++i) {
+    auto& r{records[i]};
+    Node* source_node = r.source_node.Get();
+    Node* opposing_node = r.opposing_node.Get();
+    PyObject* source_obj{};
+    PyObject* opposing_obj{};
+    if (source_node) {
+      source_obj = source_node->NewPyRef();
+    } else {
+      source_obj = Py_None;
+      Py_INCREF(source_obj);
+    }
+    if (opposing_node) {
+      opposing_obj = opposing_node->NewPyRef();
+    } else {
+      opposing_obj = Py_None;
+      Py_INCREF(opposing_obj);
+    }
+    PyList_SET_ITEM(list.Get(), static_cast<Py_ssize_t>(i),
+                    Py_BuildValue("(NNiif(fff)f)", source_obj, opposing_obj,
+                                  r.source_body, r.opposing_body, r.depth, r.x,
+                                  r.y, r.z, r.impulse));
+  }
+  PythonRef args(Py_BuildValue("(O)", list.Get()), PythonRef::kSteal);
+  call->Run(args.Get());
+
+  // Hang on to our storage for next time if nothing new came in.
+  if (records_.empty()) {
+    records.clear();
+    records_.swap(records);
+  }
+}
+
+}  // namespace ballistica::scene_v1
@@ -0,0 +1,52 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SCENE_V1_DYNAMICS_MATERIAL_BATCH_CALL_MATERIAL_ACTION_H_
+#define BALLISTICA_SCENE_V1_DYNAMICS_MATERIAL_BATCH_CALL_MATERIAL_ACTION_H_
+
+#include <vector>
+
+#include "ballistica/base/python/support/python_context_call.h"
+#include "ballistica/scene_v1/dynamics/material/material_action.h"
+#include "ballistica/shared/ballistica.h"
+#include "ballistica/shared/foundation/handle_table.h"
+
+namespace ballistica::scene_v1 {
+
+/// Like PythonCallMaterialAction, but instead of making one call per
+/// collision it packs info for all of a step's collisions into a buffer
+/// and hands them to its callable in a single call (as a list of tuples)
+/// once the step's collisions have been processed.
+class BatchCallMaterialAction : public MaterialAction {
+ public:
+  BatchCallMaterialAction(bool at_disconnect_in, PyObject* call_obj_in);
+  void Apply(MaterialContext* context, const Part* src_part,
+             const Part* dst_part,
+             const Object::Ref<MaterialAction>& p) override;
+  void Execute(Node* node1, Node* node2, Scene* scene) override;
+  auto GetType() const -> Type override { return Type::SCRIPT_BATCH_CALL; }
+
+  /// Deliver everything gathered so far to our callable. Called by
+  /// Dynamics after running a step's collision events.
+  void Flush();
+
+  bool at_disconnect;
+  Object::Ref<base::PythonContextCall> call;
+
+ private:
+  struct Record_ {
+    Handle<Node> source_node;
+    Handle<Node> opposing_node;
+    int source_body;
+    int opposing_body;
+    float depth;
+    float x;
+    float y;
+    float z;
+    float impulse;
+  };
+  std::vector<Record_> records_;
+};
+
+}  // namespace ballistica::scene_v1
+
+#endif  // BALLISTICA_SCENE_V1_DYNAMICS_MATERIAL_BATCH_CALL_MATERIAL_ACTION_H_
@@ -14,6 +14,7 @@ class MaterialAction : public Object {
     NODE_MESSAGE,
     SCRIPT_COMMAND,
     SCRIPT_CALL,
+    SCRIPT_BATCH_CALL,
     SOUND,
     IMPACT_SOUND,
     SKID_SOUND,
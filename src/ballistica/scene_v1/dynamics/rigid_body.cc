@@ -2,6 +2,8 @@
 
 #include "ballistica/scene_v1/dynamics/rigid_body.h"
 
+#include <algorithm>
+
 #include "ballistica/base/graphics/component/render_component.h"
 #include "ballistica/base/graphics/renderer/renderer.h"
 #include "ballistica/scene_v1/assets/scene_collision_mesh.h"
@@ -33,6 +35,11 @@ namespace ballistica::scene_v1 {
 
 #define ABSOLUTE_EPSILON 0.001f
 
+auto RigidBody::GetSlabPool() -> SlabPool* {
+  static SlabPool* pool = SlabPool::Create("scene_v1::RigidBody");
+  return pool;
+}
+
 RigidBody::RigidBody(int id_in, Part* part_in, Type type_in, Shape shape_in,
                      uint32_t collide_type_in, uint32_t collide_mask_in,
                      SceneCollisionMesh* collision_mesh_in, uint32_t flags)
@@ -151,28 +158,55 @@ RigidBody::RigidBody(int id_in, Part* part_in, Type type_in, Shape shape_in,
   SetDimensions(dimensions_[0], dimensions_[1], dimensions_[2]);
 }
 
-void RigidBody::ApplyToRenderComponent(base::RenderComponent* c) {
+void RigidBody::GetAABB(Vector3f* min, Vector3f* max) {
+  assert(min && max && !geoms_.empty());
+  for (size_t i = 0; i < geoms_.size(); ++i) {
+    dReal aabb[6];
+    dGeomGetAABB(geoms_[i], aabb);
+    if (i == 0) {
+      *min = {aabb[0], aabb[2], aabb[4]};
+      *max = {aabb[1], aabb[3], aabb[5]};
+    } else {
+      *min = {std::min(min->x, aabb[0]), std::min(min->y, aabb[2]),
+              std::min(min->z, aabb[4])};
+      *max = {std::max(max->x, aabb[1]), std::max(max->y, aabb[3]),
+              std::max(max->z, aabb[5])};
+    }
+  }
+  *min += blend_offset_;
+  *max += blend_offset_;
+}
+
+void RigidBody::GetDrawnTransform_(float* pos, float* r) {
   const dReal* pos_in;
   const dReal* r_in;
-  auto geom = geoms_[0];
-  if (type() == scene_v1::RigidBody::Type::kBody) {
+  dMatrix3 blended_r;
+  if (type() == RigidBody::Type::kBody) {
     pos_in = dBodyGetPosition(body_);
-    r_in = dBodyGetRotation(body_);
+    if (blend_rotating_) {
+      dQuaternion q;
+      dQMultiply0(q, blend_rotation_, dBodyGetQuaternion(body_));
+      dRfromQ(blended_r, q);
+      r_in = blended_r;
+    } else {
+      r_in = dBodyGetRotation(body_);
+    }
   } else {
-    pos_in = dGeomGetPosition(geom);
-    r_in = dGeomGetRotation(geom);
+    pos_in = dGeomGetPosition(geoms_[0]);
+    r_in = dGeomGetRotation(geoms_[0]);
   }
-  float pos[3];
-  float r[12];
-  for (int x = 0; x < 3; x++) {
-    pos[x] = pos_in[x];
-  }
-  pos[0] += blend_offset().x;
-  pos[1] += blend_offset().y;
-  pos[2] += blend_offset().z;
+  pos[0] = pos_in[0] + blend_offset_.x;
+  pos[1] = pos_in[1] + blend_offset_.y;
+  pos[2] = pos_in[2] + blend_offset_.z;
   for (int x = 0; x < 12; x++) {
     r[x] = r_in[x];
   }
+}
+
+void RigidBody::ApplyToRenderComponent(base::RenderComponent* c) {
+  float pos[3];
+  float r[12];
+  GetDrawnTransform_(pos, r);
   float matrix[16];
   matrix[0] = r[0];
   matrix[1] = r[4];
@@ -674,26 +708,9 @@ void RigidBody::Joint::Kill() {
 
 auto RigidBody::GetTransform() -> Matrix44f {
   Matrix44f matrix{kMatrix44fIdentity};
-  const dReal* pos_in;
-  const dReal* r_in;
-  if (type() == RigidBody::Type::kBody) {
-    pos_in = dBodyGetPosition(body());
-    r_in = dBodyGetRotation(body());
-  } else {
-    pos_in = dGeomGetPosition(geom());
-    r_in = dGeomGetRotation(geom());
-  }
   float pos[3];
   float r[12];
-  for (int x = 0; x < 3; x++) {
-    pos[x] = pos_in[x];
-  }
-  pos[0] += blend_offset().x;
-  pos[1] += blend_offset().y;
-  pos[2] += blend_offset().z;
-  for (int x = 0; x < 12; x++) {
-    r[x] = r_in[x];
-  }
+  GetDrawnTransform_(pos, r);
   matrix.m[0] = r[0];
   matrix.m[1] = r[4];
   matrix.m[2] = r[8];
@@ -713,23 +730,68 @@ auto RigidBody::GetTransform() -> Matrix44f {
   return matrix;
 }
 
-void RigidBody::AddBlendOffset(float x, float y, float z) {
-  //  blend_offset_.x += x;
-  //  blend_offset_.y += y;
-  //  blend_offset_.z += z;
+void RigidBody::AddCorrectionBlend(const Vector3f& old_pos,
+                                   const dQuaternion old_q,
+                                   millisecs_t duration) {
+  assert(type_ == Type::kBody);
+  if (duration <= 0) {
+    blend_offset_ = blend_start_offset_ = {0.0f, 0.0f, 0.0f};
+    blend_rotating_ = false;
+    blend_duration_ = 0;
+    return;
+  }
+
+  // Pick our offsets so that we're drawn exactly where we were drawn before
+  // the correction (which may include an earlier blend still in progress).
+  const dReal* p = dBodyGetPosition(body_);
+  blend_start_offset_ = old_pos + blend_offset_ - Vector3f(p);
+  dQuaternion old_drawn_q;
+  if (blend_rotating_) {
+    dQMultiply0(old_drawn_q, blend_rotation_, old_q);
+  } else {
+    for (int i = 0; i < 4; ++i) {
+      old_drawn_q[i] = old_q[i];
+    }
+  }
+  dQMultiply2(blend_start_rotation_, old_drawn_q, dBodyGetQuaternion(body_));
+
+  // Keep to the short way around.
+  if (blend_start_rotation_[0] < 0.0f) {
+    for (auto& val : blend_start_rotation_) {
+      val = -val;
+    }
+  }
+  blend_rotating_ = blend_start_rotation_[0] < 0.99999f;
+  blend_time_ = part()->node()->scene()->time();
+  blend_duration_ = duration;
+  UpdateBlending();
 }
 
 void RigidBody::UpdateBlending() {
-  // FIXME - this seems broken. We never update blend_time_ currently
-  //  and its also set to time whereas we're comparing it with steps.
-  //  Should revisit.
-  //  millisecs_t diff = part()->node()->scene()->stepnum() - blend_time_;
-  //  diff = std::min(millisecs_t{10}, diff);
-  //  for (millisecs_t i = 0; i < diff; i++) {
-  //    blend_offset_.x *= 0.995f;
-  //    blend_offset_.y *= 0.995f;
-  //    blend_offset_.z *= 0.995f;
-  //  }
+  if (blend_duration_ <= 0) {
+    return;
+  }
+  millisecs_t elapsed = part()->node()->scene()->time() - blend_time_;
+  if (elapsed >= blend_duration_) {
+    blend_offset_ = {0.0f, 0.0f, 0.0f};
+    blend_rotating_ = false;
+    blend_duration_ = 0;
+    return;
+  }
+
+  // Ease linearly from our starting offsets down to nothing.
+  float remaining = 1.0f
+                    - static_cast<float>(elapsed)
+                          / static_cast<float>(blend_duration_);
+  blend_offset_ = blend_start_offset_ * remaining;
+  if (blend_rotating_) {
+    blend_rotation_[0] =
+        1.0f - remaining + blend_start_rotation_[0] * remaining;
+    for (int i = 1; i < 4; ++i) {
+      blend_rotation_[i] = blend_start_rotation_[i] * remaining;
+    }
+    dNormalize4(blend_rotation_);
+  }
 }
 
 }  // namespace ballistica::scene_v1
@@ -9,6 +9,7 @@
 #include "ballistica/base/base.h"
 #include "ballistica/scene_v1/scene_v1.h"
 #include "ballistica/shared/foundation/object.h"
+#include "ballistica/shared/generic/slab_pool.h"
 #include "ballistica/shared/math/matrix44f.h"
 #include "ode/ode.h"
 #include "ode/ode_joint.h"
@@ -38,6 +39,9 @@ class RigidBody : public Object {
     kBody
   };
 
+  static auto GetSlabPool() -> SlabPool*;
+  BA_SLAB_POOL_ALLOCATED(GetSlabPool());
+
   // Used to determine what kind of surface a body has and what surfaces it will
   // collide against a body defines its own collide type(s) and its mask for
   // what it will collide against collisions will only occur if each body's
@@ -178,14 +182,32 @@ class RigidBody : public Object {
   auto radius() const -> float { return dimensions_[0]; }
   auto GetTransform() -> Matrix44f;
   void UpdateBlending();
-  void AddBlendOffset(float x, float y, float z);
+
+  /// Called after a net correction has moved us from the given position
+  /// and orientation. Instead of popping to our new state, we're then drawn
+  /// easing over to it from where we were over the given duration (0 to
+  /// just snap).
+  void AddCorrectionBlend(const Vector3f& old_pos, const dQuaternion old_q,
+                          millisecs_t duration);
   auto blend_offset() const -> const Vector3f& { return blend_offset_; }
 
   void ApplyToRenderComponent(base::RenderComponent* c);
 
+  /// Get the world-space box enclosing all our geoms as drawn (including
+  /// any blend offset).
+  void GetAABB(Vector3f* min, Vector3f* max);
+
  private:
+  /// Our position and rotation matrix as drawn (including blending).
+  void GetDrawnTransform_(float* pos, float* r);
+
   Vector3f blend_offset_{0.0f, 0.0f, 0.0f};
+  Vector3f blend_start_offset_{0.0f, 0.0f, 0.0f};
+  dQuaternion blend_rotation_{1.0f, 0.0f, 0.0f, 0.0f};
+  dQuaternion blend_start_rotation_{1.0f, 0.0f, 0.0f, 0.0f};
+  bool blend_rotating_{};
   millisecs_t blend_time_{};
+  millisecs_t blend_duration_{};
 #if BA_DEBUG_BUILD
   float prev_pos_[3]{};
   float prev_vel_[3]{};
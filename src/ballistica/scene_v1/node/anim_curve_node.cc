@@ -35,6 +35,8 @@ static NodeType* node_type{};
 
 auto AnimCurveNode::InitType() -> NodeType* {
   node_type = new AnimCurveNodeType();
+  // Anim-curve nodes calc their outputs on demand; nothing to step.
+  node_type->set_step_all_call(Node::StepAllNoOp);
   return node_type;
 }
 
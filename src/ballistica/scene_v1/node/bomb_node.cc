@@ -34,6 +34,7 @@ static NodeType* node_type{};
 
 auto BombNode::InitType() -> NodeType* {
   node_type = new BombNodeType();
+  node_type->set_parallel_draw_safe(true);
   return node_type;
 }
 
@@ -67,6 +68,9 @@ void BombNode::Step() {
 void BombNode::Draw(base::FrameDef* frame_def) {
 #if !BA_HEADLESS_BUILD
   PropNode::Draw(frame_def);
+  if (!in_light_shadow_view()) {
+    return;
+  }
   float s_scale, s_density;
   shadow_.GetValues(&s_scale, &s_density);
   float intensity = SimpleNoise(static_cast<uint32_t>(id() + scene()->time()))
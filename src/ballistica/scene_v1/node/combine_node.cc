@@ -32,6 +32,8 @@ static NodeType* node_type{};
 
 auto CombineNode::InitType() -> NodeType* {
   node_type = new CombineNodeType();
+  // Combine nodes calc their outputs on demand; nothing to step.
+  node_type->set_step_all_call(Node::StepAllNoOp);
   return node_type;
 }
 
@@ -492,6 +492,17 @@ void FlagNode::Step() {
 
 auto FlagNode::GetRigidBody(int id) -> RigidBody* { return body_.Get(); }
 
+auto FlagNode::GetDrawBounds(Vector3f* min, Vector3f* max) -> bool {
+  if (!body_.Exists()) {
+    return false;
+  }
+  // Pad our pole out to cover the cloth.
+  body_->GetAABB(min, max);
+  *min -= {1.5f, 1.5f, 1.5f};
+  *max += {1.5f, 1.5f, 1.5f};
+  return true;
+}
+
 static auto FlagPointIndex(int x, int y) -> int {
   return kFlagSizeX * (y) + (x);
 }
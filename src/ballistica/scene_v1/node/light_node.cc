@@ -36,6 +36,7 @@ static NodeType* node_type{};
 
 auto LightNode::InitType() -> NodeType* {
   node_type = new LightNodeType();
+  node_type->set_step_all_call(StepAll);
   return node_type;
 }
 
@@ -45,6 +46,13 @@ auto LightNode::GetVolumeLightIntensity() -> float {
   return intensity_ * volume_intensity_scale_ * 0.02f;
 }
 
+void LightNode::StepAll(Node* const* nodes, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    assert(nodes[i]->type() == node_type);
+    static_cast<LightNode*>(nodes[i])->LightNode::Step();
+  }
+}
+
 void LightNode::Step() {
 #if !BA_HEADLESS_BUILD
   // create or destroy our light-volume as needed
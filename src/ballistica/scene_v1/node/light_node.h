@@ -15,6 +15,7 @@ class LightNode : public Node {
  public:
   static auto InitType() -> NodeType*;
   explicit LightNode(Scene* scene);
+  static void StepAll(Node* const* nodes, size_t count);
   void Draw(base::FrameDef* frame_def) override;
   void Step() override;
   auto position() const -> std::vector<float> { return position_; }
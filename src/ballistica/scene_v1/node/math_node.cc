@@ -31,6 +31,8 @@ static NodeType* node_type{};
 
 auto MathNode::InitType() -> NodeType* {
   node_type = new MathNodeType();
+  // Math nodes calc their outputs on demand; nothing to step.
+  node_type->set_step_all_call(Node::StepAllNoOp);
   return node_type;
 }
 
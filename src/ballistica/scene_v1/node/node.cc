@@ -21,6 +21,11 @@ NodeType::~NodeType() {
 
 Node::Node(Scene* scene_in, NodeType* node_type)
     : node_type_(node_type), scene_(scene_in) {}
+
+auto Node::GetSlabPool() -> SlabPool* {
+  static SlabPool* pool = SlabPool::Create("scene_v1::Node");
+  return pool;
+}
 void Node::AddToScene(Scene* scene) {
   // we should have already set our scene ptr in our constructor;
   // now we add ourself to its lists..
@@ -28,10 +33,7 @@ void Node::AddToScene(Scene* scene) {
   assert(scene_ == scene);
   assert(id_ == 0);
 
-  scene->AddNode(this, &id_, &iterator_);
-  // id_ = scene->next_node_id_++;
-  // our_iterator_ =
-  //     scene->nodes_.insert(scene->nodes_.end(), Object::Ref<Node>(this));
+  scene->AddNode(this, &id_);
   if (SessionStream* os = scene->GetSceneStream()) {
     os->AddNode(this);
   }
@@ -177,6 +179,7 @@ void Node::ConnectAttribute(NodeAttributeUnbound* src_attr, Node* dst_node,
   a->src_attr_index = src_attr->index();
   a->dst_node = dst_node;
   a->dst_attr_index = dst_attr->index();
+  scene_->MarkStepScheduleDirty();
   a->Update();
 }
 
@@ -10,7 +10,10 @@
 
 #include "ballistica/base/base.h"
 #include "ballistica/scene_v1/support/scene_v1_context.h"
+#include "ballistica/shared/foundation/handle_table.h"
 #include "ballistica/shared/foundation/object.h"
+#include "ballistica/shared/generic/slab_pool.h"
+#include "ballistica/shared/math/vector3f.h"
 #include "ballistica/shared/python/python_ref.h"
 
 namespace ballistica::scene_v1 {
@@ -21,7 +24,7 @@ namespace ballistica::scene_v1 {
     return Object::NewDeferred<BA_NODE_TYPE_CLASS>(sg); \
   }
 
-typedef std::list<Object::Ref<Node> > NodeList;
+typedef std::vector<Object::Ref<Node> > NodeList;
 
 // Base node class.
 class Node : public Object {
@@ -29,12 +32,25 @@ class Node : public Object {
   Node(Scene* scene, NodeType* node_type);
   ~Node() override;
 
+  /// All node types are carved out of a shared slab pool to keep them
+  /// packed together and off the general heap during heavy churn.
+  static auto GetSlabPool() -> SlabPool*;
+  BA_SLAB_POOL_ALLOCATED(GetSlabPool());
+
   /// Return the node's id in its scene.
   auto id() const -> int64_t { return id_; }
 
+  /// Our slot in our scene's node list; maintained by the scene.
+  auto scene_index() const -> size_t { return scene_index_; }
+  void set_scene_index(size_t val) { scene_index_ = val; }
+
   /// Called for each step of the sim.
   virtual void Step() {}
 
+  /// Batch step call for node types with no Step() logic of their own
+  /// (see NodeType::set_step_all_call()).
+  static void StepAllNoOp(Node* const* nodes, size_t count) {}
+
   /// Called when screen size changes.
   virtual void OnScreenSizeChange() {}
 
@@ -118,6 +134,24 @@ class Node : public Object {
   /// Called for each Node when it should render itself.
   virtual void Draw(base::FrameDef* frame_def);
 
+  /// Nodes can provide world-space bounds enclosing everything they draw
+  /// so the scene can skip drawing them when out of view. Return false
+  /// (the default) to always be drawn.
+  virtual auto GetDrawBounds(Vector3f* min, Vector3f* max) -> bool {
+    return false;
+  }
+
+  /// Whether our draw bounds are in view for the current draw; set by the
+  /// scene before calling Draw(). The beauty view includes floor
+  /// reflections and the light-shadow view covers the ground below us.
+  /// Nodes can skip components for whichever one they're culled from.
+  auto in_beauty_view() const { return in_beauty_view_; }
+  auto in_light_shadow_view() const { return in_light_shadow_view_; }
+  void set_draw_visibility(bool beauty, bool light_shadow) {
+    in_beauty_view_ = beauty;
+    in_light_shadow_view_ = light_shadow;
+  }
+
   /// Called for each node once construction is completed this can be a good
   /// time to create things from the initial attr set, etc
   virtual void OnCreate();
@@ -146,7 +180,6 @@ class Node : public Object {
   auto HasAttribute(const std::string& name) const -> bool;
   auto has_py_ref() -> bool { return (py_ref_ != nullptr); }
   void UpdateConnections();
-  auto iterator() -> NodeList::iterator { return iterator_; }
 
   void CheckBodies();
 
@@ -160,6 +193,10 @@ class Node : public Object {
 
   auto parts() const -> const std::vector<Part*>& { return parts_; }
 
+  /// For Handle<Node>; a cheaper alternative to Object::WeakRef<Node> in
+  /// hot paths.
+  auto handle_slot() const -> const HandleSlot<Node>& { return handle_slot_; }
+
   auto death_actions() const
       -> const std::vector<Object::Ref<base::PythonContextCall> >& {
     return death_actions_;
@@ -200,6 +237,8 @@ class Node : public Object {
   virtual void HandleMessage(const char* buffer);
 
  private:
+  // Up top so handles stay valid until everything else is gone.
+  HandleSlot<Node> handle_slot_{this};
   int64_t stream_id_{-1};
   NodeType* node_type_ = nullptr;
 
@@ -213,7 +252,9 @@ class Node : public Object {
   std::vector<Object::WeakRef<Node> > dependent_nodes_;
   std::vector<Part*> parts_;
   int64_t id_{};
-  NodeList::iterator iterator_;
+  size_t scene_index_{};
+  bool in_beauty_view_{true};
+  bool in_light_shadow_view_{true};
 
   // Put this stuff at the bottom so it gets killed first
   PythonRef delegate_;
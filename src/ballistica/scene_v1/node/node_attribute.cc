@@ -5,6 +5,7 @@
 #include "ballistica/scene_v1/node/node.h"
 #include "ballistica/scene_v1/node/node_attribute_connection.h"
 #include "ballistica/scene_v1/node/node_type.h"
+#include "ballistica/scene_v1/support/scene.h"
 
 namespace ballistica::scene_v1 {
 
@@ -95,6 +96,7 @@ void NodeAttributeUnbound::DisconnectIncoming(Node* node) {
 
     // Remove from our incoming list; this should kill the connection.
     node->attribute_connections_incoming_.erase(i);
+    node->scene()->MarkStepScheduleDirty();
 
 #if BA_DEBUG_BUILD
     if (test_ref.Exists()) {
@@ -2,12 +2,54 @@
 
 #include "ballistica/scene_v1/node/node_attribute_connection.h"
 
+#include <cstring>
+#include <string>
+#include <vector>
+
 #include "ballistica/scene_v1/node/node.h"
 #include "ballistica/scene_v1/node/node_attribute.h"
 #include "ballistica/scene_v1/node/node_type.h"
 
 namespace ballistica::scene_v1 {
 
+auto NodeAttributeConnection::GetSlabPool() -> SlabPool* {
+  static SlabPool* pool =
+      SlabPool::Create("scene_v1::NodeAttributeConnection");
+  return pool;
+}
+
+/// Return whether a value needs to be pushed through a connection. We
+/// skip the push when the src value is bit-identical to the last one we
+/// pushed *and* the dst still holds that value (it may have been changed
+/// by its node since, or its setter may transform values; in those cases
+/// we push every time as before). The dst check is only run when the src
+/// is unchanged since it can be comparatively expensive.
+template <typename F>
+static auto ShouldPush(NodeAttributeConnection* c, const void* data,
+                       size_t size, const F& dst_matches) -> bool {
+  if (c->have_last_value && c->last_value.size() == size
+      && (size == 0 || memcmp(c->last_value.data(), data, size) == 0)
+      && dst_matches()) {
+    return false;
+  }
+  c->last_value.assign(static_cast<const char*>(data), size);
+  c->have_last_value = true;
+  return true;
+}
+
+template <typename T>
+static auto BitsEqual(const T& a, const T& b) -> bool {
+  return memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+template <typename T>
+static auto BitsEqual(const std::vector<T>& a, const std::vector<T>& b)
+    -> bool {
+  return a.size() == b.size()
+         && (a.empty()
+             || memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+}
+
 void NodeAttributeConnection::Update() {
   assert(src_node.Exists() && dst_node.Exists());
   auto* src_node_p{src_node.Get()};
@@ -27,24 +69,60 @@ void NodeAttributeConnection::Update() {
         dst_node->type()->GetAttribute(dst_attr_index);
     assert(dst_attr);
     switch (dst_attr->type()) {
-      case NodeAttributeType::kFloat:
-        dst_attr->Set(dst_node.Get(), src_attr->GetAsFloat(src_node_p));
-        break;
-      case NodeAttributeType::kInt:
-        dst_attr->Set(dst_node.Get(), src_attr->GetAsInt(src_node_p));
-        break;
-      case NodeAttributeType::kBool:
-        dst_attr->Set(dst_node.Get(), src_attr->GetAsBool(src_node_p));
-        break;
-      case NodeAttributeType::kString:
-        dst_attr->Set(dst_node.Get(), src_attr->GetAsString(src_node_p));
-        break;
-      case NodeAttributeType::kIntArray:
-        dst_attr->Set(dst_node.Get(), src_attr->GetAsInts(src_node_p));
-        break;
-      case NodeAttributeType::kFloatArray:
-        dst_attr->Set(dst_node.Get(), src_attr->GetAsFloats(src_node_p));
-        break;
+      case NodeAttributeType::kFloat: {
+        float val = src_attr->GetAsFloat(src_node_p);
+        if (ShouldPush(this, &val, sizeof(val), [&] {
+              return BitsEqual(dst_attr->GetAsFloat(dst_node.Get()), val);
+            })) {
+          dst_attr->Set(dst_node.Get(), val);
+        }
+        break;
+      }
+      case NodeAttributeType::kInt: {
+        int64_t val = src_attr->GetAsInt(src_node_p);
+        if (ShouldPush(this, &val, sizeof(val), [&] {
+              return dst_attr->GetAsInt(dst_node.Get()) == val;
+            })) {
+          dst_attr->Set(dst_node.Get(), val);
+        }
+        break;
+      }
+      case NodeAttributeType::kBool: {
+        bool val = src_attr->GetAsBool(src_node_p);
+        if (ShouldPush(this, &val, sizeof(val), [&] {
+              return dst_attr->GetAsBool(dst_node.Get()) == val;
+            })) {
+          dst_attr->Set(dst_node.Get(), val);
+        }
+        break;
+      }
+      case NodeAttributeType::kString: {
+        auto val = src_attr->GetAsString(src_node_p);
+        if (ShouldPush(this, val.data(), val.size(), [&] {
+              return dst_attr->GetAsString(dst_node.Get()) == val;
+            })) {
+          dst_attr->Set(dst_node.Get(), val);
+        }
+        break;
+      }
+      case NodeAttributeType::kIntArray: {
+        auto vals = src_attr->GetAsInts(src_node_p);
+        if (ShouldPush(this, vals.data(), vals.size() * sizeof(int64_t), [&] {
+              return BitsEqual(dst_attr->GetAsInts(dst_node.Get()), vals);
+            })) {
+          dst_attr->Set(dst_node.Get(), vals);
+        }
+        break;
+      }
+      case NodeAttributeType::kFloatArray: {
+        auto vals = src_attr->GetAsFloats(src_node_p);
+        if (ShouldPush(this, vals.data(), vals.size() * sizeof(float), [&] {
+              return BitsEqual(dst_attr->GetAsFloats(dst_node.Get()), vals);
+            })) {
+          dst_attr->Set(dst_node.Get(), vals);
+        }
+        break;
+      }
       case NodeAttributeType::kNode:
         dst_attr->Set(dst_node.Get(), src_attr->GetAsNode(src_node_p));
         break;
@@ -4,15 +4,19 @@
 #define BALLISTICA_SCENE_V1_NODE_NODE_ATTRIBUTE_CONNECTION_H_
 
 #include <list>
+#include <string>
 
 #include "ballistica/scene_v1/scene_v1.h"
 #include "ballistica/shared/foundation/object.h"
+#include "ballistica/shared/generic/slab_pool.h"
 
 namespace ballistica::scene_v1 {
 
 class NodeAttributeConnection : public Object {
  public:
   NodeAttributeConnection() = default;
+  static auto GetSlabPool() -> SlabPool*;
+  BA_SLAB_POOL_ALLOCATED(GetSlabPool());
   void Update();
   Object::WeakRef<Node> src_node;
   int src_attr_index{};
@@ -20,6 +24,11 @@ class NodeAttributeConnection : public Object {
   int dst_attr_index{};
   bool have_error{};
   std::list<Object::Ref<NodeAttributeConnection> >::iterator src_iterator;
+
+  /// Raw bits of the last value pushed through this connection (for
+  /// plain value types). Lets us skip pushing values that haven't changed.
+  std::string last_value;
+  bool have_last_value{};
 };
 
 }  // namespace ballistica::scene_v1
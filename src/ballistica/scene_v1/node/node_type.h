@@ -56,6 +56,22 @@ class NodeType {
     return create_call_(sg);
   }
 
+  /// Optional batch step call for this type. When set, the scene may step
+  /// runs of this type's nodes with a single call instead of individual
+  /// virtual Step() calls, and may reorder them relative to unconnected
+  /// nodes of other types. Types should only opt in if stepping a node
+  /// has no side effects on other nodes beyond its attribute connections.
+  auto step_all_call() const -> NodeStepAllFunc* { return step_all_call_; }
+  void set_step_all_call(NodeStepAllFunc* call) { step_all_call_ = call; }
+
+  /// Whether this type's nodes may be drawn in worker threads when the
+  /// scene draws in parallel (see SceneV1AppMode::parallel_node_drawing()).
+  /// Types should only opt in if Draw() touches nothing beyond the node's
+  /// own state, render components, and blotches; notably no Python, no
+  /// ref-count changes, and no Graphics::overlay_node_z_depth().
+  auto parallel_draw_safe() const -> bool { return parallel_draw_safe_; }
+  void set_parallel_draw_safe(bool val) { parallel_draw_safe_ = val; }
+
   auto id() const -> int {
     assert(id_ >= 0);
     return id_;
@@ -69,6 +85,8 @@ class NodeType {
 
  private:
   NodeCreateFunc* create_call_;
+  NodeStepAllFunc* step_all_call_{};
+  bool parallel_draw_safe_{};
   int id_;
   std::string name_;
   std::unordered_map<std::string, NodeAttributeUnbound*> attributes_by_name_;
@@ -29,6 +29,7 @@ static NodeType* node_type{};
 
 auto PropNode::InitType() -> NodeType* {
   node_type = new PropNodeType();
+  node_type->set_parallel_draw_safe(true);
   return node_type;
 }
 
@@ -97,6 +98,18 @@ void PropNode::SetIsAreaOfInterest(bool val) {
   }
 }
 
+auto PropNode::GetDrawBounds(Vector3f* min, Vector3f* max) -> bool {
+  if (!body_.Exists()) {
+    return false;
+  }
+  // Our mesh can poke out past our collision shape a fair bit.
+  body_->GetAABB(min, max);
+  float pad = mesh_scale_ * extra_mesh_scale_;
+  *min -= {pad, pad, pad};
+  *max += {pad, pad, pad};
+  return true;
+}
+
 void PropNode::Draw(base::FrameDef* frame_def) {
 #if !BA_HEADLESS_BUILD
 
@@ -105,28 +118,30 @@ void PropNode::Draw(base::FrameDef* frame_def) {
     return;
   }
 
-  base::ObjectComponent c(frame_def->beauty_pass());
-  c.SetTexture(color_texture_.Exists() ? color_texture_->texture_data()
-                                       : nullptr);
-  c.SetLightShadow(base::LightShadowType::kObject);
-  if (reflection_ != base::ReflectionType::kNone) {
-    c.SetReflection(reflection_);
-    c.SetReflectionScale(reflection_scale_r_, reflection_scale_g_,
-                         reflection_scale_b_);
-  }
-  if (flashing_ && frame_def->frame_number_filtered() % 10 < 5) {
-    c.SetColor(1.2f, 1.2f, 1.2f);
-  }
-  {
-    auto xf = c.ScopedTransform();
-    body_->ApplyToRenderComponent(&c);
-    float s = mesh_scale_ * extra_mesh_scale_;
-    c.Scale(s, s, s);
-    c.DrawMeshAsset(mesh_->mesh_data());
+  if (in_beauty_view()) {
+    base::ObjectComponent c(frame_def->beauty_pass());
+    c.SetTexture(color_texture_.Exists() ? color_texture_->texture_data()
+                                         : nullptr);
+    c.SetLightShadow(base::LightShadowType::kObject);
+    if (reflection_ != base::ReflectionType::kNone) {
+      c.SetReflection(reflection_);
+      c.SetReflectionScale(reflection_scale_r_, reflection_scale_g_,
+                           reflection_scale_b_);
+    }
+    if (flashing_ && frame_def->frame_number_filtered() % 10 < 5) {
+      c.SetColor(1.2f, 1.2f, 1.2f);
+    }
+    {
+      auto xf = c.ScopedTransform();
+      body_->ApplyToRenderComponent(&c);
+      float s = mesh_scale_ * extra_mesh_scale_;
+      c.Scale(s, s, s);
+      c.DrawMeshAsset(mesh_->mesh_data());
+    }
+    c.Submit();
   }
-  c.Submit();
 
-  {  // Shadow.
+  if (in_light_shadow_view()) {  // Shadow.
     assert(body_.Exists());
     const dReal* pos_raw = dGeomGetPosition(body_->geom());
     float pos[3];
@@ -23,6 +23,7 @@ class PropNode : public Node {
   ~PropNode() override;
   void HandleMessage(const char* data) override;
   void Draw(base::FrameDef* frame_def) override;
+  auto GetDrawBounds(Vector3f* min, Vector3f* max) -> bool override;
   void Step() override;
   auto GetRigidBody(int id) -> RigidBody* override;
   auto is_area_of_interest() const -> bool {
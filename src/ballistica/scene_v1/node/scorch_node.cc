@@ -60,6 +60,15 @@ void ScorchNode::SetPosition(const std::vector<float>& vals) {
   position_ = vals;
 }
 
+auto ScorchNode::GetDrawBounds(Vector3f* min, Vector3f* max) -> bool {
+  // Our random sizes max out at 1.3x.
+  Vector3f pos(&position_[0]);
+  float s = size_ * 1.3f;
+  *min = pos - Vector3f(s, s, s);
+  *max = pos + Vector3f(s, s, s);
+  return true;
+}
+
 void ScorchNode::Draw(base::FrameDef* frame_def) {
   float o = presence_;
   // modulate opacity by local shadow density
@@ -15,6 +15,7 @@ class ScorchNode : public Node {
   explicit ScorchNode(Scene* scene);
   ~ScorchNode() override;
   void Draw(base::FrameDef* frame_def) override;
+  auto GetDrawBounds(Vector3f* min, Vector3f* max) -> bool override;
   auto position() const -> std::vector<float> { return position_; }
   void SetPosition(const std::vector<float>& vals);
   auto presence() const -> float { return presence_; }
@@ -2,6 +2,8 @@
 
 #include "ballistica/scene_v1/node/shield_node.h"
 
+#include <algorithm>
+
 #include "ballistica/base/graphics/component/object_component.h"
 #include "ballistica/base/graphics/component/post_process_component.h"
 #include "ballistica/base/graphics/component/shield_component.h"
@@ -110,6 +112,15 @@ void ShieldNode::Step() {
 #endif  // !BA_HEADLESS_BUILD
 }
 
+auto ShieldNode::GetDrawBounds(Vector3f* min, Vector3f* max) -> bool {
+  // Leave a bit of room for flashes; our health bar sits above us.
+  Vector3f pos(&position_[0]);
+  float r = radius_ * 1.2f;
+  *min = pos - Vector3f(r, r, r);
+  *max = pos + Vector3f(r, std::max(r, 1.5f), r);
+  return true;
+}
+
 void ShieldNode::Draw(base::FrameDef* frame_def) {
 #if !BA_HEADLESS_BUILD
 
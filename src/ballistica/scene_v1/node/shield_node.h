@@ -16,6 +16,7 @@ class ShieldNode : public Node {
   explicit ShieldNode(Scene* scene);
   ~ShieldNode() override;
   void Draw(base::FrameDef* frame_def) override;
+  auto GetDrawBounds(Vector3f* min, Vector3f* max) -> bool override;
   void Step() override;
   auto position() const -> std::vector<float> { return position_; }
   void SetPosition(const std::vector<float>& vals);
@@ -5907,6 +5907,19 @@ void SpazNode::Stand(float x, float y, float z, float angle) {
     PositionBodyForJoint(hair_ponytail_bottom_joint_);
 }
 
+auto SpazNode::GetDrawBounds(Vector3f* min, Vector3f* max) -> bool {
+  if (!body_torso_.Exists()) {
+    return false;
+  }
+  // Enough to cover flailing limbs plus names and other bits drawn over
+  // our heads.
+  const dReal* p = dBodyGetPosition(body_torso_->body());
+  Vector3f pos = Vector3f(p[0], p[1], p[2]) + body_torso_->blend_offset();
+  *min = pos - Vector3f(1.5f, 1.5f, 1.5f);
+  *max = pos + Vector3f(1.5f, 2.5f, 1.5f);
+  return true;
+}
+
 auto SpazNode::GetRigidBody(int id) -> RigidBody* {
   // Ewwww this should be automatic.
   switch (id) {
@@ -22,6 +22,7 @@ class SpazNode : public Node {
   void Step() override;
   void HandleMessage(const char* data) override;
   void Draw(base::FrameDef* frame_def) override;
+  auto GetDrawBounds(Vector3f* min, Vector3f* max) -> bool override;
   auto GetRigidBody(int id) -> RigidBody* override;
   void GetRigidBodyPickupLocations(int id, float* obj, float* character,
                                    float* hand1, float* hand2) override;
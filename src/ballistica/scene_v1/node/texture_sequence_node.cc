@@ -27,6 +27,7 @@ static NodeType* node_type{};
 
 auto TextureSequenceNode::InitType() -> NodeType* {
   node_type = new TextureSequenceNodeType();
+  node_type->set_step_all_call(StepAll);
   return node_type;
 }
 
@@ -55,6 +56,13 @@ auto TextureSequenceNode::output_texture() const -> SceneTexture* {
   return input_textures_[index_].Get();
 }
 
+void TextureSequenceNode::StepAll(Node* const* nodes, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    assert(nodes[i]->type() == node_type);
+    static_cast<TextureSequenceNode*>(nodes[i])->TextureSequenceNode::Step();
+  }
+}
+
 void TextureSequenceNode::Step() {
   if (sleep_count_ <= 0) {
     if (!input_textures_.empty()) {
@@ -14,6 +14,7 @@ class TextureSequenceNode : public Node {
  public:
   static auto InitType() -> NodeType*;
   explicit TextureSequenceNode(Scene* scene);
+  static void StepAll(Node* const* nodes, size_t count);
   void Step() override;
   auto rate() const -> int { return rate_; }
   void set_rate(int val);
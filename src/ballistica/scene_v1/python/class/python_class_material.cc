@@ -3,6 +3,7 @@
 #include "ballistica/scene_v1/python/class/python_class_material.h"
 
 #include "ballistica/base/logic/logic.h"
+#include "ballistica/scene_v1/dynamics/material/batch_call_material_action.h"
 #include "ballistica/scene_v1/dynamics/material/impact_sound_material_action.h"
 #include "ballistica/scene_v1/dynamics/material/material.h"
 #include "ballistica/scene_v1/dynamics/material/material_component.h"
@@ -347,6 +348,15 @@ PyMethodDef PythonClassMaterial::tp_methods[] = {
      "when the two parts first come in contact; `'at_disconnect'`\n"
      "means to fire once they cease being in contact.\n"
      "\n"
+     "###### `('batch_call', when, callable)`\n"
+     "> Like `'call'`, but instead of being called once per\n"
+     "collision, the callable is called at most once per step with a\n"
+     "list of all of that step's collisions. Each entry is a tuple of\n"
+     "`(sourcenode, opposingnode, sourcebody, opposingbody, depth,\n"
+     "position, impulse)`. Nodes that have since died show up as None.\n"
+     "This is much cheaper for frequent collisions and avoids the need\n"
+     "for bascenev1.getcollisioninfo() calls.\n"
+     "\n"
      "###### `('message', who, when, message_obj)`\n"
      "> Sends a message object;\n"
      "`who` can be either `'our_node'` or `'their_node'`, `when` can be\n"
@@ -598,6 +608,24 @@ void DoAddAction(PyObject* actions_obj,
     PyObject* call_obj = PyTuple_GET_ITEM(actions_obj, 2);
     (*actions).push_back(Object::New<MaterialAction, PythonCallMaterialAction>(
         at_disconnect, call_obj));
+  } else if (type == "batch_call") {
+    if (size != 3) {
+      throw Exception("Expected 3 values for batch_call action tuple.",
+                      PyExcType::kValue);
+    }
+    std::string when = Python::GetPyString(PyTuple_GET_ITEM(actions_obj, 1));
+    bool at_disconnect;
+    if (when == "at_connect") {
+      at_disconnect = false;
+    } else if (when == "at_disconnect") {
+      at_disconnect = true;
+    } else {
+      throw Exception("Invalid command execution time: '" + when + "'.",
+                      PyExcType::kValue);
+    }
+    PyObject* call_obj = PyTuple_GET_ITEM(actions_obj, 2);
+    (*actions).push_back(Object::New<MaterialAction, BatchCallMaterialAction>(
+        at_disconnect, call_obj));
   } else if (type == "message") {
     if (size < 4) {
       throw Exception("Expected >= 4 values for message action tuple.",
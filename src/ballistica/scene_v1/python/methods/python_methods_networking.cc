@@ -9,8 +9,13 @@
 #include "ballistica/scene_v1/connection/connection_set.h"
 #include "ballistica/scene_v1/connection/connection_to_client.h"
 #include "ballistica/scene_v1/connection/connection_to_host_udp.h"
+#include "ballistica/scene_v1/connection/remote_input_stream.h"
+#include "ballistica/scene_v1/node/node.h"
+#include "ballistica/scene_v1/node/node_type.h"
 #include "ballistica/scene_v1/python/scene_v1_python.h"
+#include "ballistica/scene_v1/support/client_session.h"
 #include "ballistica/scene_v1/support/scene_v1_app_mode.h"
+#include "ballistica/shared/generic/json_arena.h"
 #include "ballistica/shared/math/vector3f.h"
 #include "ballistica/shared/networking/sockaddr.h"
 #include "ballistica/shared/python/python.h"
@@ -520,6 +525,41 @@ static PyMethodDef PyDisconnectFromHostDef = {
     "Category: General Utility Functions",
 };
 
+// ----------------------------- set_client_party ------------------------------
+
+static auto PySetClientParty(PyObject* self, PyObject* args,
+                             PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  static const char* kwlist[] = {"client_id", "party_id", nullptr};
+  int client_id;
+  int party_id;
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "ii",
+                                   const_cast<char**>(kwlist), &client_id,
+                                   &party_id)) {
+    return nullptr;
+  }
+  auto* appmode = SceneV1AppMode::GetActiveOrThrow();
+  if (appmode->connections()->SetClientParty(client_id, party_id)) {
+    Py_RETURN_TRUE;
+  }
+  Py_RETURN_FALSE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySetClientPartyDef = {
+    "set_client_party",             // name
+    (PyCFunction)PySetClientParty,  // method
+    METH_VARARGS | METH_KEYWORDS,   // flags
+
+    "set_client_party(client_id: int, party_id: int) -> bool\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Move a client to the session serving a party (0 is the main session).\n"
+    "Its players leave its old party's session. Returns False if there is\n"
+    "no such client.",
+};
+
 // --------------------------- disconnect_client -------------------------------
 
 static auto PyDisconnectClient(PyObject* self, PyObject* args,
@@ -631,6 +671,190 @@ static PyMethodDef PyGetGamePortDef = {
     "Return the port ballistica is hosting on.",
 };
 
+// ------------------------ get_network_admission_stats ------------------------
+
+static auto PyGetNetworkAdmissionStats(PyObject* self, PyObject* args,
+                                       PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  static const char* kwlist[] = {nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "",
+                                   const_cast<char**>(kwlist))) {
+    return nullptr;
+  }
+  auto stats{g_base->network_reader->admission_stats()};
+  return Py_BuildValue(
+      "{sLsLsLsLsLsL}",
+      "admitted", static_cast<long long>(stats.admitted),  // NOLINT
+      "dropped_malformed",
+      static_cast<long long>(stats.dropped_malformed),  // NOLINT
+      "dropped_known_rate",
+      static_cast<long long>(stats.dropped_known_rate),  // NOLINT
+      "dropped_unknown_rate",
+      static_cast<long long>(stats.dropped_unknown_rate),  // NOLINT
+      "dropped_unknown_flood",
+      static_cast<long long>(stats.dropped_unknown_flood),  // NOLINT
+      "dropped_queue_full",
+      static_cast<long long>(stats.dropped_queue_full));  // NOLINT
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetNetworkAdmissionStatsDef = {
+    "get_network_admission_stats",            // name
+    (PyCFunction)PyGetNetworkAdmissionStats,  // method
+    METH_VARARGS | METH_KEYWORDS,             // flags
+
+    "get_network_admission_stats() -> dict[str, int]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return counts of incoming game packets admitted to the logic thread\n"
+    "and dropped in the network-reader thread, by reason.",
+};
+
+// ----------------------- get_dynamics_correction_stats -----------------------
+
+static auto PyGetDynamicsCorrectionStats(PyObject* self, PyObject* args,
+                                         PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  static const char* kwlist[] = {nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "",
+                                   const_cast<char**>(kwlist))) {
+    return nullptr;
+  }
+  auto* appmode = SceneV1AppMode::GetActiveOrThrow();
+  auto* session =
+      dynamic_cast<ClientSession*>(appmode->GetForegroundSession());
+  if (!session) {
+    Py_RETURN_NONE;
+  }
+  auto mean = [](const ClientSession::CorrectionStats& stats) {
+    return stats.count ? stats.total_error / stats.count : 0.0;
+  };
+  PyObject* py_bodies = PyList_New(0);
+  for (auto&& i : session->correction_stats()) {
+    int node_id = i.first.first;
+    Node* node = node_id < static_cast<int>(session->nodes().size())
+                     ? session->nodes()[node_id].Get()
+                     : nullptr;
+    std::string node_type = node ? node->type()->name() : "";
+    auto& stats{i.second};
+    PyObject* py_body = Py_BuildValue(
+        "{sisssisisisdsdsdsL}", "node_id", node_id, "node_type",
+        node_type.c_str(), "body_id", i.first.second, "count", stats.count,
+        "snapped", stats.snapped, "mean_error", mean(stats), "max_error",
+        static_cast<double>(stats.max_error), "last_error",
+        static_cast<double>(stats.last_error), "last_time",
+        static_cast<long long>(stats.last_time));  // NOLINT
+    PyList_Append(py_bodies, py_body);
+    Py_DECREF(py_body);
+  }
+  auto& totals{session->correction_totals()};
+  return Py_BuildValue(
+      "{sisisisisdsdsN}", "sync_time", appmode->dynamics_sync_time(),
+      "blend_time", appmode->dynamics_blend_time(), "count", totals.count,
+      "snapped", totals.snapped, "mean_error", mean(totals), "max_error",
+      static_cast<double>(totals.max_error), "bodies", py_bodies);
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetDynamicsCorrectionStatsDef = {
+    "get_dynamics_correction_stats",            // name
+    (PyCFunction)PyGetDynamicsCorrectionStats,  // method
+    METH_VARARGS | METH_KEYWORDS,               // flags
+
+    "get_dynamics_correction_stats() -> dict[str, Any] | None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return position error stats for dynamics corrections applied in the\n"
+    "current client session (or None if not in one), both overall and per\n"
+    "rigid body, for tuning dynamics sync and blend times.",
+};
+
+// --------------------------- get_client_send_stats ---------------------------
+
+static auto PyGetClientSendStats(PyObject* self, PyObject* args,
+                                 PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  static const char* kwlist[] = {nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "",
+                                   const_cast<char**>(kwlist))) {
+    return nullptr;
+  }
+  auto* appmode = SceneV1AppMode::GetActiveOrThrow();
+  PyObject* py_list = PyList_New(0);
+  for (auto&& i : appmode->connections()->connections_to_clients()) {
+    ConnectionToClient* c = i.second.Get();
+    if (!c || !c->can_communicate()) {
+      continue;
+    }
+    PyObject* py_client = Py_BuildValue(
+        "{sisisdsLsLsLsLsLsL}", "client_id", c->id(), "send_level",
+        c->send_level(), "rtt", static_cast<double>(c->smoothed_rtt()),
+        "bytes_out_per_second",
+        static_cast<long long>(c->GetBytesOutPerSecondCompressed()),  // NOLINT
+        "bytes_acked_per_second",
+        static_cast<long long>(c->GetBytesAckedPerSecond()),  // NOLINT
+        "bytes_in_flight",
+        static_cast<long long>(c->GetReliableBytesInFlight()),  // NOLINT
+        "resends_per_second",
+        static_cast<long long>(c->GetMessageResendsPerSecond()),  // NOLINT
+        "flush_interval",
+        static_cast<long long>(c->GetSendFlushInterval()),  // NOLINT
+        "correction_interval",
+        static_cast<long long>(c->GetSendCorrectionInterval()));  // NOLINT
+    PyList_Append(py_list, py_client);
+    Py_DECREF(py_client);
+  }
+  return py_list;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetClientSendStatsDef = {
+    "get_client_send_stats",            // name
+    (PyCFunction)PyGetClientSendStats,  // method
+    METH_VARARGS | METH_KEYWORDS,       // flags
+
+    "get_client_send_stats() -> list[dict[str, Any]]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return link estimates and the resulting send schedule for each\n"
+    "connected client.",
+};
+
+// ---------------------------- run_json_benchmark -----------------------------
+
+static auto PyRunJsonBenchmark(PyObject* self, PyObject* args,
+                               PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  int iterations{1000};
+  static const char* kwlist[] = {"iterations", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|i",
+                                   const_cast<char**>(kwlist), &iterations)) {
+    return nullptr;
+  }
+  auto result = RunJsonBenchmark(iterations);
+  Log(LogLevel::kInfo, result);
+  return PyUnicode_FromString(result.c_str());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyRunJsonBenchmarkDef = {
+    "run_json_benchmark",             // name
+    (PyCFunction)PyRunJsonBenchmark,  // method
+    METH_VARARGS | METH_KEYWORDS,     // flags
+
+    "run_json_benchmark(iterations: int = 1000) -> str\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Time cJSON against the arena parser and direct writer on party roster\n"
+    "and handshake payloads, logging and returning the results.",
+};
+
 // ------------------------ set_master_server_source ---------------------------
 
 static auto PySetMasterServerSource(PyObject* self,
@@ -818,6 +1042,44 @@ static PyMethodDef PyGetChatMessagesDef = {
     "(internal)",
 };
 
+// -------------------- run_remote_input_latency_simulation --------------------
+
+static auto PyRunRemoteInputLatencySimulation(PyObject* self, PyObject* args,
+                                              PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  float loss{0.05f};
+  int latency{50};
+  int interval{16};
+  int frames{2000};
+  static const char* kwlist[] = {"loss", "latency", "interval", "frames",
+                                 nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|fiii",
+                                   const_cast<char**>(kwlist), &loss,
+                                   &latency, &interval, &frames)) {
+    return nullptr;
+  }
+  auto result =
+      RunRemoteInputLatencySimulation(loss, latency, interval, frames);
+  Log(LogLevel::kInfo, result);
+  return PyUnicode_FromString(result.c_str());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyRunRemoteInputLatencySimulationDef = {
+    "run_remote_input_latency_simulation",           // name
+    (PyCFunction)PyRunRemoteInputLatencySimulation,  // method
+    METH_VARARGS | METH_KEYWORDS,                    // flags
+
+    "run_remote_input_latency_simulation(loss: float = 0.05,\n"
+    "  latency: int = 50, interval: int = 16, frames: int = 2000) -> str\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Simulate remote-player input over a lossy link using both reliable\n"
+    "messages and redundant unsequenced frames; logs and returns\n"
+    "delivery latency percentiles and histograms for each.",
+};
+
 // -----------------------------------------------------------------------------
 
 auto PythonMethodsNetworking::GetMethods() -> std::vector<PyMethodDef> {
@@ -827,8 +1089,13 @@ auto PythonMethodsNetworking::GetMethods() -> std::vector<PyMethodDef> {
       PyHostScanCycleDef,
       PySetMasterServerSourceDef,
       PyGetGamePortDef,
+      PyGetNetworkAdmissionStatsDef,
+      PyGetDynamicsCorrectionStatsDef,
+      PyGetClientSendStatsDef,
+      PyRunJsonBenchmarkDef,
       PyDisconnectFromHostDef,
       PyDisconnectClientDef,
+      PySetClientPartyDef,
       PyGetClientPublicDeviceUUIDDef,
       PyGetConnectionToHostInfoDef,
       PyGetConnectionToHostInfo2Def,
@@ -846,6 +1113,7 @@ auto PythonMethodsNetworking::GetMethods() -> std::vector<PyMethodDef> {
       PyGetPublicPartyEnabledDef,
       PyChatMessageDef,
       PyGetChatMessagesDef,
+      PyRunRemoteInputLatencySimulationDef,
   };
 }
 
@@ -27,9 +27,12 @@
 #include "ballistica/scene_v1/support/host_activity.h"
 #include "ballistica/scene_v1/support/host_session.h"
 #include "ballistica/scene_v1/support/scene_v1_app_mode.h"
+#include "ballistica/scene_v1/support/scene_spatial_index.h"
 #include "ballistica/scene_v1/support/scene_v1_input_device_delegate.h"
 #include "ballistica/scene_v1/support/session_stream.h"
+#include "ballistica/shared/foundation/handle_table.h"
 #include "ballistica/shared/generic/json.h"
+#include "ballistica/shared/generic/slab_pool.h"
 #include "ballistica/shared/generic/utils.h"
 #include "ballistica/shared/python/python_command.h"
 
@@ -345,6 +348,69 @@ static PyMethodDef PyNewHostSessionDef = {
     "(internal)",
 };
 
+// ----------------------------- new_party_session -----------------------------
+
+static auto PyNewPartySession(PyObject* self, PyObject* args,
+                              PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  static const char* kwlist[] = {"sessiontype", "party_id", nullptr};
+  PyObject* sessiontype_obj;
+  int party_id;
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "Oi",
+                                   const_cast<char**>(kwlist), &sessiontype_obj,
+                                   &party_id)) {
+    return nullptr;
+  }
+  auto* appmode = SceneV1AppMode::GetActiveOrThrow();
+  appmode->LaunchPartySession(sessiontype_obj, party_id);
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyNewPartySessionDef = {
+    "new_party_session",             // name
+    (PyCFunction)PyNewPartySession,  // method
+    METH_VARARGS | METH_KEYWORDS,    // flags
+
+    "new_party_session(sessiontype: type[bascenev1.Session],\n"
+    "  party_id: int) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Launch an extra host session for a party alongside the current one.\n"
+    "Requires multi-party hosting, which is off unless enabled with\n"
+    "value_test('multiParty', absolute=1).",
+};
+
+// ----------------------------- end_party_session -----------------------------
+
+static auto PyEndPartySession(PyObject* self, PyObject* args,
+                              PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  static const char* kwlist[] = {"party_id", nullptr};
+  int party_id;
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "i",
+                                   const_cast<char**>(kwlist), &party_id)) {
+    return nullptr;
+  }
+  auto* appmode = SceneV1AppMode::GetActiveOrThrow();
+  appmode->EndPartySession(party_id);
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyEndPartySessionDef = {
+    "end_party_session",             // name
+    (PyCFunction)PyEndPartySession,  // method
+    METH_VARARGS | METH_KEYWORDS,    // flags
+
+    "end_party_session(party_id: int) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Shut down a party session, moving its clients back to party 0.",
+};
+
 // -------------------------- new_replay_session -------------------------------
 
 static auto PyNewReplaySession(PyObject* self, PyObject* args,
@@ -910,6 +976,181 @@ static PyMethodDef PyGetNodesDef = {
     "Category: **Gameplay Functions**",
 };
 
+// ---------------------------- get_nodes_in_radius ----------------------------
+
+// Shared bits for our spatial query calls.
+static auto DoGetQueryScene() -> Scene* {
+  HostActivity* host_activity =
+      ContextRefSceneV1::FromCurrent().GetHostActivity();
+  if (!host_activity) {
+    throw Exception(PyExcType::kContext);
+  }
+  return host_activity->scene();
+}
+
+static auto DoGetQueryPoint(PyObject* obj) -> Vector3f {
+  std::vector<float> vals = Python::GetPyFloats(obj);
+  if (vals.size() != 3) {
+    throw Exception("Expected 3 floats for position.", PyExcType::kValue);
+  }
+  return {vals[0], vals[1], vals[2]};
+}
+
+static auto DoGetQueryFilter(PyObject* type_obj, PyObject* material_obj)
+    -> SceneSpatialIndex::Filter {
+  SceneSpatialIndex::Filter filter;
+  if (type_obj != Py_None) {
+    std::string type = Python::GetPyString(type_obj);
+    auto i = g_scene_v1->node_types().find(type);
+    if (i == g_scene_v1->node_types().end()) {
+      throw Exception("Invalid node type: '" + type + "'.", PyExcType::kValue);
+    }
+    filter.node_type = i->second;
+  }
+  if (material_obj != Py_None) {
+    filter.material = SceneV1Python::GetPyMaterial(material_obj);
+  }
+  return filter;
+}
+
+static auto DoBuildNodeList(const std::vector<Node*>& nodes) -> PyObject* {
+  PyObject* py_list = PyList_New(static_cast<Py_ssize_t>(nodes.size()));
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    PyList_SET_ITEM(py_list, static_cast<Py_ssize_t>(i), nodes[i]->NewPyRef());
+  }
+  return py_list;
+}
+
+static auto PyGetNodesInRadius(PyObject* self, PyObject* args,
+                               PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* pos_obj;
+  float radius;
+  PyObject* type_obj{Py_None};
+  PyObject* material_obj{Py_None};
+  static const char* kwlist[] = {"position", "radius", "type", "material",
+                                 nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "Of|OO",
+                                   const_cast<char**>(kwlist), &pos_obj,
+                                   &radius, &type_obj, &material_obj)) {
+    return nullptr;
+  }
+  Scene* scene = DoGetQueryScene();
+  auto filter = DoGetQueryFilter(type_obj, material_obj);
+  std::vector<Node*> nodes;
+  scene->spatial_index()->QueryRadius(DoGetQueryPoint(pos_obj), radius, filter,
+                                      &nodes);
+  return DoBuildNodeList(nodes);
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetNodesInRadiusDef = {
+    "get_nodes_in_radius",            // name
+    (PyCFunction)PyGetNodesInRadius,  // method
+    METH_VARARGS | METH_KEYWORDS,     // flags
+
+    "get_nodes_in_radius(position: Sequence[float], radius: float,\n"
+    "  type: str | None = None,\n"
+    "  material: bascenev1.Material | None = None)\n"
+    "  -> list[bascenev1.Node]\n"
+    "\n"
+    "Return nodes within a radius of a point, nearest first.\n"
+    "\n"
+    "Category: **Gameplay Functions**\n"
+    "\n"
+    "Only nodes with physics bodies are considered, each at the position\n"
+    "of its first body as of the last sim step. Results can be limited to\n"
+    "a node type and/or nodes with a part using a material. This is much\n"
+    "cheaper than checking positions of everything from getnodes().",
+};
+
+// ----------------------------- get_nodes_in_box ------------------------------
+
+static auto PyGetNodesInBox(PyObject* self, PyObject* args,
+                            PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* min_obj;
+  PyObject* max_obj;
+  PyObject* type_obj{Py_None};
+  PyObject* material_obj{Py_None};
+  static const char* kwlist[] = {"min", "max", "type", "material", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "OO|OO",
+                                   const_cast<char**>(kwlist), &min_obj,
+                                   &max_obj, &type_obj, &material_obj)) {
+    return nullptr;
+  }
+  Scene* scene = DoGetQueryScene();
+  auto filter = DoGetQueryFilter(type_obj, material_obj);
+  std::vector<Node*> nodes;
+  scene->spatial_index()->QueryBox(DoGetQueryPoint(min_obj),
+                                   DoGetQueryPoint(max_obj), filter, &nodes);
+  return DoBuildNodeList(nodes);
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetNodesInBoxDef = {
+    "get_nodes_in_box",            // name
+    (PyCFunction)PyGetNodesInBox,  // method
+    METH_VARARGS | METH_KEYWORDS,  // flags
+
+    "get_nodes_in_box(min: Sequence[float], max: Sequence[float],\n"
+    "  type: str | None = None,\n"
+    "  material: bascenev1.Material | None = None)\n"
+    "  -> list[bascenev1.Node]\n"
+    "\n"
+    "Return nodes within an axis-aligned box.\n"
+    "\n"
+    "Category: **Gameplay Functions**\n"
+    "\n"
+    "See bascenev1.get_nodes_in_radius() for details.",
+};
+
+// ----------------------------- get_nearest_nodes -----------------------------
+
+static auto PyGetNearestNodes(PyObject* self, PyObject* args,
+                              PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* pos_obj;
+  int count;
+  PyObject* type_obj{Py_None};
+  PyObject* material_obj{Py_None};
+  PyObject* max_distance_obj{Py_None};
+  static const char* kwlist[] = {"position", "count",        "type",
+                                 "material", "max_distance", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(
+          args, keywds, "Oi|OOO", const_cast<char**>(kwlist), &pos_obj, &count,
+          &type_obj, &material_obj, &max_distance_obj)) {
+    return nullptr;
+  }
+  Scene* scene = DoGetQueryScene();
+  auto filter = DoGetQueryFilter(type_obj, material_obj);
+  float max_distance = max_distance_obj == Py_None
+                           ? std::numeric_limits<float>::infinity()
+                           : Python::GetPyFloat(max_distance_obj);
+  std::vector<Node*> nodes;
+  scene->spatial_index()->QueryNearest(DoGetQueryPoint(pos_obj), count,
+                                       max_distance, filter, &nodes);
+  return DoBuildNodeList(nodes);
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetNearestNodesDef = {
+    "get_nearest_nodes",             // name
+    (PyCFunction)PyGetNearestNodes,  // method
+    METH_VARARGS | METH_KEYWORDS,    // flags
+
+    "get_nearest_nodes(position: Sequence[float], count: int,\n"
+    "  type: str | None = None,\n"
+    "  material: bascenev1.Material | None = None,\n"
+    "  max_distance: float | None = None) -> list[bascenev1.Node]\n"
+    "\n"
+    "Return up to `count` nodes nearest to a point, nearest first.\n"
+    "\n"
+    "Category: **Gameplay Functions**\n"
+    "\n"
+    "See bascenev1.get_nodes_in_radius() for details.",
+};
+
 // -------------------------- get_collision_info -------------------------------
 
 static auto DoGetCollideValue(Dynamics* dynamics, const Collision* c,
@@ -1674,6 +1915,175 @@ static PyMethodDef PyLsObjectsDef = {
     "It prints various info about the current object count, etc.",
 };
 
+// ------------------------------- ls_slab_pools -------------------------------
+
+static auto PyLsSlabPools(PyObject* self, PyObject* args,
+                          PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  SlabPool::LsPools();
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyLsSlabPoolsDef = {
+    "ls_slab_pools",               // name
+    (PyCFunction)PyLsSlabPools,    // method
+    METH_VARARGS | METH_KEYWORDS,  // flags
+
+    "ls_slab_pools() -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Log allocation counters for the slab pools backing nodes, bodies,\n"
+    "collisions, and other scene objects.",
+};
+
+// -------------------------- run_slab_pool_benchmark --------------------------
+
+static auto PyRunSlabPoolBenchmark(PyObject* self, PyObject* args,
+                                   PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  int iterations{1000};
+  static const char* kwlist[] = {"iterations", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|i",
+                                   const_cast<char**>(kwlist), &iterations)) {
+    return nullptr;
+  }
+  auto result = SlabPool::RunChurnBenchmark(iterations);
+  Log(LogLevel::kInfo, result);
+  return PyUnicode_FromString(result.c_str());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyRunSlabPoolBenchmarkDef = {
+    "run_slab_pool_benchmark",            // name
+    (PyCFunction)PyRunSlabPoolBenchmark,  // method
+    METH_VARARGS | METH_KEYWORDS,         // flags
+
+    "run_slab_pool_benchmark(iterations: int = 1000) -> str\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Time a node/collision-like allocation churn pattern through a slab\n"
+    "pool versus the regular heap; logs and returns a summary.",
+};
+
+// --------------------------- run_handle_benchmark ----------------------------
+
+static auto PyRunHandleBenchmark(PyObject* self, PyObject* args,
+                                 PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  int iterations{100};
+  static const char* kwlist[] = {"iterations", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|i",
+                                   const_cast<char**>(kwlist), &iterations)) {
+    return nullptr;
+  }
+  BA_PRECONDITION(g_base->InLogicThread());
+  auto result = RunHandleBenchmark(iterations);
+  Log(LogLevel::kInfo, result);
+  return PyUnicode_FromString(result.c_str());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyRunHandleBenchmarkDef = {
+    "run_handle_benchmark",             // name
+    (PyCFunction)PyRunHandleBenchmark,  // method
+    METH_VARARGS | METH_KEYWORDS,       // flags
+
+    "run_handle_benchmark(iterations: int = 100) -> str\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Time making, resolving, and invalidating generational handles versus\n"
+    "weak-refs to a set of objects; logs and returns a summary.",
+};
+
+// ------------------------------ get_scene_stats ------------------------------
+
+static auto PyGetSceneStats(PyObject* self, PyObject* args,
+                            PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  static const char* kwlist[] = {nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "",
+                                   const_cast<char**>(kwlist))) {
+    return nullptr;
+  }
+  BA_PRECONDITION(g_base->InLogicThread());
+  Scene* scene = SceneV1AppMode::GetActiveOrThrow()->GetForegroundScene();
+  if (scene == nullptr) {
+    Py_RETURN_NONE;
+  }
+  auto& stats{scene->stats()};
+  return Py_BuildValue(
+      "{sLsLsLsisisLsLsLsLsLsL}", "draws",
+      static_cast<long long>(stats.draws),  // NOLINT
+      "nodes_drawn",
+      static_cast<long long>(stats.nodes_drawn),  // NOLINT
+      "nodes_culled",
+      static_cast<long long>(stats.nodes_culled),  // NOLINT
+      "last_nodes_drawn", stats.last_nodes_drawn, "last_nodes_culled",
+      stats.last_nodes_culled, "steps",
+      static_cast<long long>(stats.steps),  // NOLINT
+      "sounds_requested",
+      static_cast<long long>(stats.sounds_requested),  // NOLINT
+      "sounds_played",
+      static_cast<long long>(stats.sounds_played),  // NOLINT
+      "sounds_merged",
+      static_cast<long long>(stats.sounds_merged),  // NOLINT
+      "sounds_inaudible",
+      static_cast<long long>(stats.sounds_inaudible),  // NOLINT
+      "sounds_over_budget",
+      static_cast<long long>(stats.sounds_over_budget));  // NOLINT
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetSceneStatsDef = {
+    "get_scene_stats",             // name
+    (PyCFunction)PyGetSceneStats,  // method
+    METH_VARARGS | METH_KEYWORDS,  // flags
+
+    "get_scene_stats() -> dict[str, int] | None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return running counts for the foreground scene, if any: scene nodes\n"
+    "drawn and culled by view culling (in total and for the most recent\n"
+    "draw), and positional sounds requested, played, merged, and dropped\n"
+    "(as inaudible or over budget) by sound budgeting.",
+};
+
+// ---------------------------- run_draw_benchmark -----------------------------
+
+static auto PyRunDrawBenchmark(PyObject* self, PyObject* args,
+                               PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  int nodes{500};
+  int frames{50};
+  static const char* kwlist[] = {"nodes", "frames", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|ii",
+                                   const_cast<char**>(kwlist), &nodes,
+                                   &frames)) {
+    return nullptr;
+  }
+  BA_PRECONDITION(g_base->InLogicThread());
+  return PyUnicode_FromString(Scene::RunDrawBenchmark(nodes, frames).c_str());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyRunDrawBenchmarkDef = {
+    "run_draw_benchmark",             // name
+    (PyCFunction)PyRunDrawBenchmark,  // method
+    METH_VARARGS | METH_KEYWORDS,     // flags
+
+    "run_draw_benchmark(nodes: int = 500, frames: int = 50) -> str\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Build frames for a synthetic scene of the given node count with\n"
+    "serial and parallel node drawing and return a timing summary.",
+};
+
 // --------------------------- ls_input_devices --------------------------------
 
 static auto PyLsInputDevices(PyObject* self, PyObject* args,
@@ -1866,6 +2276,8 @@ auto PythonMethodsScene::GetMethods() -> std::vector<PyMethodDef> {
   return {
       PyNewReplaySessionDef,
       PyNewHostSessionDef,
+      PyNewPartySessionDef,
+      PyEndPartySessionDef,
       PyGetSessionDef,
       PyGetActivityDef,
       PyNewActivityDef,
@@ -1890,10 +2302,18 @@ auto PythonMethodsScene::GetMethods() -> std::vector<PyMethodDef> {
       PyCameraShakeDef,
       PyGetCollisionInfoDef,
       PyGetNodesDef,
+      PyGetNodesInRadiusDef,
+      PyGetNodesInBoxDef,
+      PyGetNearestNodesDef,
       PySetInternalMusicDef,
       PyPrintNodesDef,
       PyNewNodeDef,
       PyLsObjectsDef,
+      PyLsSlabPoolsDef,
+      PyRunSlabPoolBenchmarkDef,
+      PyRunHandleBenchmarkDef,
+      PyGetSceneStatsDef,
+      PyRunDrawBenchmarkDef,
       PyTimeDef,
       PyTimerDef,
       PyBaseTimeDef,
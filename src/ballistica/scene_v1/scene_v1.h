@@ -107,7 +107,9 @@ class HostSession;
 struct JointFixedEF;
 class SceneV1InputDeviceDelegate;
 class MaterialAction;
+class BatchCallMaterialAction;
 class SceneMesh;
+class SceneSpatialIndex;
 class HostActivity;
 class Material;
 class MaterialComponent;
@@ -140,6 +142,7 @@ class Session;
 class SceneSound;
 class SceneTexture;
 typedef Node* NodeCreateFunc(Scene* sg);
+typedef void NodeStepAllFunc(Node* const* nodes, size_t count);
 
 /// Standard messages to send to nodes.
 enum class NodeMessageType {
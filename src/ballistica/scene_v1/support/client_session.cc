@@ -2,6 +2,8 @@
 
 #include "ballistica/scene_v1/support/client_session.h"
 
+#include <algorithm>
+
 #include "ballistica/base/audio/audio.h"
 #include "ballistica/base/dynamics/bg/bg_dynamics.h"
 #include "ballistica/base/graphics/graphics.h"
@@ -23,6 +25,10 @@
 
 namespace ballistica::scene_v1 {
 
+// Corrections moving bodies further than this (teleports, respawns, etc.)
+// are snapped to instead of blended.
+static const float kMaxCorrectionBlendDistance{3.0f};
+
 ClientSession::ClientSession() { ClearSessionObjs(); }
 
 void ClientSession::Reset(bool rewind) {
@@ -47,6 +53,8 @@ void ClientSession::ClearSessionObjs() {
   commands_pending_.clear();
   commands_.clear();
   base_time_buffered_ = 0;
+  correction_totals_ = {};
+  correction_stats_.clear();
 }
 
 auto ClientSession::DoesFillScreen() const -> bool {
@@ -235,6 +243,8 @@ void ClientSession::Update(int time_advance_millisecs, double time_advance) {
         }
         case SessionCommand::kDynamicsCorrection: {
           bool blend = current_cmd_[1];
+          millisecs_t blend_time =
+              SceneV1AppMode::GetSingleton()->dynamics_blend_time();
           uint32_t offset = 2;
           uint16_t node_count;
           memcpy(&node_count, current_cmd_.data() + offset, sizeof(node_count));
@@ -257,15 +267,23 @@ void ClientSession::Update(int time_advance_millisecs, double time_advance) {
               const char* p2 = p1;
               if (b) {
                 dBodyID body = b->body();
-                const dReal* p = dBodyGetPosition(body);
-                float old_x = p[0];
-                float old_y = p[1];
-                float old_z = p[2];
+                Vector3f old_pos(dBodyGetPosition(body));
+                const dReal* q = dBodyGetQuaternion(body);
+                dQuaternion old_q{q[0], q[1], q[2], q[3]};
                 b->ExtractFull(&p2);
                 if (p2 - p1 != body_data_len)
                   throw Exception("Invalid rbd correction data");
+
+                // Unblended corrections are full state restores (replay
+                // seeks and whatnot), so only regular ones count in stats.
                 if (blend) {
-                  b->AddBlendOffset(old_x - p[0], old_y - p[1], old_z - p[2]);
+                  float error =
+                      (Vector3f(dBodyGetPosition(body)) - old_pos).Length();
+                  bool snap = error > kMaxCorrectionBlendDistance;
+                  RecordCorrection_(static_cast<int>(node_id), bodyid, error,
+                                    snap);
+                  b->AddCorrectionBlend(old_pos, old_q,
+                                        snap ? 0 : blend_time);
                 }
               }
               offset += body_data_len;
@@ -548,6 +566,8 @@ void ClientSession::Update(int time_advance_millisecs, double time_advance) {
           Node* n = GetNode(id);
           n->scene()->DeleteNode(n);
           assert(!nodes_[id].Exists());
+          correction_stats_.erase(correction_stats_.lower_bound({id, 0}),
+                                  correction_stats_.lower_bound({id + 1, 0}));
           break;
         }
         case SessionCommand::kSetNodeAttrFloat: {
@@ -1037,6 +1057,19 @@ void ClientSession::HandleSessionMessage(const std::vector<uint8_t>& buffer) {
   }
 }
 
+void ClientSession::RecordCorrection_(int node_id, int body_id, float error,
+                                      bool snapped) {
+  for (auto* stats : {&correction_totals_,
+                      &correction_stats_[{node_id, body_id}]}) {
+    stats->count++;
+    stats->snapped += snapped;
+    stats->last_error = error;
+    stats->max_error = std::max(stats->max_error, error);
+    stats->total_error += error;
+    stats->last_time = base_time_millisecs_;
+  }
+}
+
 // Add a single command in.
 void ClientSession::AddCommand(const std::vector<uint8_t>& command) {
   // If this is a time-step command, we can dump everything we've been building
@@ -4,7 +4,9 @@
 #define BALLISTICA_SCENE_V1_SUPPORT_CLIENT_SESSION_H_
 
 #include <list>
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ballistica/scene_v1/support/client_controller_interface.h"
@@ -14,6 +16,17 @@ namespace ballistica::scene_v1 {
 
 class ClientSession : public Session {
  public:
+  /// Position error stats for dynamics corrections we've applied.
+  struct CorrectionStats {
+    int count{};
+    /// Corrections too big to blend which we simply snapped to.
+    int snapped{};
+    float last_error{};
+    float max_error{};
+    double total_error{};
+    millisecs_t last_time{};
+  };
+
   ClientSession();
   ~ClientSession() override;
 
@@ -54,6 +67,18 @@ class ClientSession : public Session {
   auto base_time() const { return base_time_millisecs_; }
   auto shutting_down() const { return shutting_down_; }
 
+  /// Stats for all corrections since our last reset.
+  auto correction_totals() const -> const CorrectionStats& {
+    return correction_totals_;
+  }
+
+  /// Stats per rigid body, keyed by node id and body id. Entries go away
+  /// along with their nodes.
+  auto correction_stats() const
+      -> const std::map<std::pair<int, int>, CorrectionStats>& {
+    return correction_stats_;
+  }
+
   auto scenes() const -> const std::vector<Object::Ref<Scene> >& {
     return scenes_;
   }
@@ -105,6 +130,7 @@ class ClientSession : public Session {
  private:
   void ClearSessionObjs();
   void AddCommand(const std::vector<uint8_t>& command);
+  void RecordCorrection_(int node_id, int body_id, float error, bool snapped);
 
   auto ReadByte() -> uint8_t;
   auto ReadInt32() -> int32_t;
@@ -139,6 +165,8 @@ class ClientSession : public Session {
   std::vector<Object::Ref<SceneSound> > sounds_;
   std::vector<Object::Ref<SceneCollisionMesh> > collision_meshes_;
   std::vector<Object::Ref<Material> > materials_;
+  CorrectionStats correction_totals_;
+  std::map<std::pair<int, int>, CorrectionStats> correction_stats_;
 };
 
 }  // namespace ballistica::scene_v1
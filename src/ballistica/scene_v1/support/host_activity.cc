@@ -345,10 +345,12 @@ void HostActivity::SetIsForeground(bool val) {
   // If we're foreground, set our scene as foreground.
   Scene* sg = scene();
   if (val && sg) {
-    // Set it locally.
-
-    if (auto* appmode = SceneV1AppMode::GetActiveOrWarn()) {
-      appmode->SetForegroundScene(sg);
+    // Set it locally (party sessions only go out to their clients).
+    HostSession* host_session = GetHostSession();
+    if (host_session && host_session->party_id() == 0) {
+      if (auto* appmode = SceneV1AppMode::GetActiveOrWarn()) {
+        appmode->SetForegroundScene(sg);
+      }
     }
 
     // Also push it to clients.
@@ -3,6 +3,7 @@
 #include "ballistica/scene_v1/support/host_session.h"
 
 #include "ballistica/base/graphics/graphics.h"
+#include "ballistica/base/logic/logic.h"
 #include "ballistica/base/python/base_python.h"
 #include "ballistica/base/python/support/python_context_call.h"
 #include "ballistica/scene_v1/assets/scene_data_asset.h"
@@ -20,8 +21,9 @@
 
 namespace ballistica::scene_v1 {
 
-HostSession::HostSession(PyObject* session_type_obj)
-    : last_kick_idle_players_decrement_time_(g_core->GetAppTimeMillisecs()) {
+HostSession::HostSession(PyObject* session_type_obj, int party_id)
+    : party_id_(party_id),
+      last_kick_idle_players_decrement_time_(g_core->GetAppTimeMillisecs()) {
   assert(g_base->logic);
   assert(g_base->InLogicThread());
   assert(session_type_obj != nullptr);
@@ -47,8 +49,9 @@ HostSession::HostSession(PyObject* session_type_obj)
   // would be boring.
   bool do_replay = !is_main_menu_;
 
-  // At the moment headless-server don't write replays.
-  if (g_core->HeadlessMode()) {
+  // At the moment headless-server don't write replays (and only one session
+  // at a time can).
+  if (g_core->HeadlessMode() || party_id_ != 0) {
     do_replay = false;
   }
 
@@ -60,11 +63,14 @@ HostSession::HostSession(PyObject* session_type_obj)
     output_stream_->AddScene(scene_.Get());
   }
 
-  // Fade in from our current blackness.
-  g_base->graphics->FadeScreen(true, 250, nullptr);
+  // Party sessions aren't shown locally.
+  if (party_id_ == 0) {
+    // Fade in from our current blackness.
+    g_base->graphics->FadeScreen(true, 250, nullptr);
 
-  // Start by showing the progress bar instead of hitching.
-  g_base->graphics->EnableProgressBar(true);
+    // Start by showing the progress bar instead of hitching.
+    g_base->graphics->EnableProgressBar(true);
+  }
 
   // Now's a good time to run garbage collection; there should be pretty much
   // no game stuff to speak of in existence (provided the last session went
@@ -93,7 +99,9 @@ HostSession::HostSession(PyObject* session_type_obj)
 
   // Lastly, keep the python layer fed with our latest player count in case
   // it is updating the master-server with our current/max player counts.
-  appmode->SetPublicPartyPlayerCount(static_cast<int>(players_.size()));
+  if (party_id_ == 0) {
+    appmode->SetPublicPartyPlayerCount(static_cast<int>(players_.size()));
+  }
 }
 
 auto HostSession::GetHostSession() -> HostSession* { return this; }
@@ -249,7 +257,9 @@ void HostSession::RequestPlayer(SceneV1InputDeviceDelegate* device) {
 
   // Lastly, keep the python layer fed with our latest player count in case it
   // is updating the master-server with our current/max player counts.
-  appmode->SetPublicPartyPlayerCount(static_cast<int>(players_.size()));
+  if (party_id_ == 0) {
+    appmode->SetPublicPartyPlayerCount(static_cast<int>(players_.size()));
+  }
 }
 
 void HostSession::RemovePlayer(Player* player) {
@@ -282,7 +292,9 @@ void HostSession::RemovePlayer(Player* player) {
 
       // Lastly, keep the python layer fed with our latest player count in case
       // it is updating the master-server with our current/max player counts.
-      appmode->SetPublicPartyPlayerCount(static_cast<int>(players_.size()));
+      if (party_id_ == 0) {
+        appmode->SetPublicPartyPlayerCount(static_cast<int>(players_.size()));
+      }
 
       return;
     }
@@ -529,12 +541,16 @@ void HostSession::Update(int time_advance_millisecs, double time_advance) {
 
     // After each time we step time, abort if we're taking too long. This way we
     // slow down if we're overloaded and have a better chance at maintaining
-    // a reasonable frame-rate/etc.
-    auto elapsed =
-        core::CorePlatform::GetCurrentMillisecs() - update_time_start;
-    if (elapsed >= 1000 / 30) {
-      too_slow = true;
-      break;
+    // a reasonable frame-rate/etc. We skip this in headless max-speed mode,
+    // where there is no frame-rate to maintain and where bailing based on
+    // wall time would make results non-deterministic.
+    if (!g_base->logic->headless_max_speed()) {
+      auto elapsed =
+          core::CorePlatform::GetCurrentMillisecs() - update_time_start;
+      if (elapsed >= 1000 / 30) {
+        too_slow = true;
+        break;
+      }
     }
   }
 
@@ -17,7 +17,7 @@ namespace ballistica::scene_v1 {
 
 class HostSession : public Session {
  public:
-  explicit HostSession(PyObject* session_type_obj);
+  explicit HostSession(PyObject* session_type_obj, int party_id = 0);
   ~HostSession() override;
 
   // Return a borrowed python ref.
@@ -79,6 +79,9 @@ class HostSession : public Session {
   }
   void RegisterContextCall(base::PythonContextCall* call) override;
   auto GetSceneStream() const -> SessionStream* { return output_stream_.Get(); }
+  /// The party we serve; 0 for the foreground session and positive for
+  /// extra sessions launched via SceneV1AppMode::LaunchPartySession().
+  auto party_id() const -> int { return party_id_; }
   auto is_main_menu() const -> bool {
     return is_main_menu_;
   }  // fixme remove this
@@ -118,6 +121,7 @@ class HostSession : public Session {
   TimerList base_timers_;
   Object::Ref<Scene> scene_;
   bool shutting_down_{};
+  int party_id_{};
 
   // Our list of Python calls created in the context of this activity. We
   // clear them as we are shutting down and ensure nothing runs after that
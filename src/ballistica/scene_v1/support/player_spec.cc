@@ -2,10 +2,13 @@
 
 #include "ballistica/scene_v1/support/player_spec.h"
 
+#include <vector>
+
 #include "ballistica/base/support/classic_soft.h"
 #include "ballistica/core/platform/core_platform.h"
 #include "ballistica/scene_v1/support/scene_v1_app_mode.h"
 #include "ballistica/shared/generic/json.h"
+#include "ballistica/shared/generic/json_arena.h"
 #include "ballistica/shared/generic/utils.h"
 
 namespace ballistica::scene_v1 {
@@ -13,7 +16,8 @@ namespace ballistica::scene_v1 {
 PlayerSpec::PlayerSpec() = default;
 
 PlayerSpec::PlayerSpec(const std::string& s) {
-  cJSON* root_obj = cJSON_Parse(s.c_str());
+  JsonArena arena;
+  cJSON* root_obj = arena.ParseCopy(s.c_str(), s.size());
   bool success = false;
   if (root_obj) {
     cJSON* name_obj = cJSON_GetObjectItem(root_obj, "n");
@@ -34,7 +38,6 @@ PlayerSpec::PlayerSpec(const std::string& s) {
       }
       success = true;
     }
-    cJSON_Delete(root_obj);
   }
   if (!success) {
     Log(LogLevel::kError, "Error creating PlayerSpec from string: '" + s + "'");
@@ -68,20 +71,20 @@ auto PlayerSpec::operator==(const PlayerSpec& spec) const -> bool {
 }
 
 auto PlayerSpec::GetSpecString() const -> std::string {
-  cJSON* root;
-  root = cJSON_CreateObject();
-  cJSON_AddStringToObject(root, "n", name_.c_str());
-  cJSON_AddStringToObject(
-      root, "a",
-      // classic::V1Account::AccountTypeToString(account_type_).c_str()
-      g_base->HaveClassic()
-          ? g_base->classic()->V1AccountTypeToString(v1_account_type_).c_str()
-          : "");
-  cJSON_AddStringToObject(root, "sn", short_name_.c_str());
-  char* out = cJSON_PrintUnformatted(root);
-  std::string out_s = out;
-  free(out);
-  cJSON_Delete(root);
+  std::vector<uint8_t> out;
+  JsonWriter writer(&out);
+  writer.BeginObject();
+  writer.Key("n");
+  writer.String(name_);
+  writer.Key("a");
+  // classic::V1Account::AccountTypeToString(account_type_).c_str()
+  writer.String(g_base->HaveClassic()
+                    ? g_base->classic()->V1AccountTypeToString(v1_account_type_)
+                    : "");
+  writer.Key("sn");
+  writer.String(short_name_);
+  writer.EndObject();
+  std::string out_s(out.begin(), out.end());
 
   // We should never allow ourself to have all this add up to more than 256.
   assert(out_s.size() < 256);
@@ -2,21 +2,64 @@
 
 #include "ballistica/scene_v1/support/scene.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
 #include "ballistica/base/audio/audio.h"
+#include "ballistica/base/audio/audio_source.h"
+#include "ballistica/base/graphics/renderer/render_pass.h"
 #include "ballistica/base/graphics/support/camera.h"
+#include "ballistica/base/graphics/support/frame_def.h"
 #include "ballistica/base/networking/networking.h"
 #include "ballistica/base/python/support/python_context_call.h"
+#include "ballistica/core/platform/core_platform.h"
+#include "ballistica/scene_v1/assets/scene_mesh.h"
 #include "ballistica/scene_v1/assets/scene_sound.h"
+#include "ballistica/scene_v1/assets/scene_texture.h"
 #include "ballistica/scene_v1/dynamics/dynamics.h"
 #include "ballistica/scene_v1/node/bomb_node.h"
+#include "ballistica/scene_v1/node/globals_node.h"
 #include "ballistica/scene_v1/node/node_attribute_connection.h"
 #include "ballistica/scene_v1/node/player_node.h"
 #include "ballistica/scene_v1/node/text_node.h"
 #include "ballistica/scene_v1/support/scene_v1_app_mode.h"
+#include "ballistica/scene_v1/support/scene_spatial_index.h"
 #include "ballistica/scene_v1/support/session_stream.h"
+#include "ballistica/shared/generic/worker_pool.h"
 
 namespace ballistica::scene_v1 {
 
+// How far below a node's draw bounds its shadows can land, and how far
+// they can spread sideways (our shadow light comes in at a slight angle).
+const float kViewCullShadowDrop = 10.0f;
+const float kViewCullShadowSpread = 2.0f;
+
+// Parallel node drawing only kicks in for at least this many visible
+// nodes, and splits runs of parallel-safe nodes into chunks of this size.
+const size_t kParallelDrawMinNodes = 64;
+const size_t kParallelDrawChunkSize = 32;
+
+// Same-sound plays within this distance of each other in a step get merged.
+const float kSoundMergeDistance = 2.0f;
+
+// Sounds estimated to be quieter than this everywhere in the area of
+// interest get dropped.
+const float kSoundMinAudibleGain = 0.01f;
+
+// Most positional sounds we'll play per step; past this we keep the
+// loudest.
+const int kMaxSoundsPerStep = 16;
+
+// These mirror the distance attenuation our audio server sets up.
+const float kSoundReferenceDistance = 5.0f;
+const float kSoundRolloffFactor = 0.3f;
+const float kSoundMaxDistance = 100.0f;
+
 auto Scene::GetSceneStream() const -> SessionStream* {
   return output_stream_.Get();
 }
@@ -34,7 +77,8 @@ void Scene::SetMapBounds(float xmin, float ymin, float zmin, float xmax,
 Scene::Scene(millisecs_t start_time)
     : time_(start_time),
       stepnum_(start_time / kGameStepMilliseconds),
-      last_step_real_time_(g_core->GetAppTimeMillisecs()) {
+      last_step_real_time_(g_core->GetAppTimeMillisecs()),
+      spatial_index_(std::make_unique<SceneSpatialIndex>(this)) {
   dynamics_ = Object::New<Dynamics>(this);
 
   // Reset world bounds to default.
@@ -65,10 +109,207 @@ Scene::~Scene() {
 
 void Scene::PlaySoundAtPosition(SceneSound* sound, float volume, float x,
                                 float y, float z, bool host_only) {
+  if (gathering_sounds_) {
+    stats_.sounds_requested++;
+    pending_sounds_.push_back(
+        {Object::Ref<SceneSound>(sound), volume, {x, y, z}, host_only, false});
+    return;
+  }
+  PlaySoundAtPositionNow_(sound, volume, {x, y, z}, host_only);
+}
+
+void Scene::PlayDynamicsSound(SceneSound* sound, float volume,
+                              const Vector3f& position) {
+  if (gathering_sounds_) {
+    stats_.sounds_requested++;
+    pending_sounds_.push_back(
+        {Object::Ref<SceneSound>(sound), volume, position, true, true});
+    return;
+  }
+  PlayDynamicsSoundNow_(sound, volume, position);
+}
+
+auto Scene::ClaimDynamicsSoundBudget(float volume, const Vector3f& position)
+    -> bool {
+  if (!gathering_sounds_) {
+    return true;
+  }
+  stats_.sounds_requested++;
+  if (volume * GetSoundAttenuation_(position) < kSoundMinAudibleGain) {
+    stats_.sounds_inaudible++;
+    return false;
+  }
+  if (sounds_played_this_step_ >= kMaxSoundsPerStep) {
+    stats_.sounds_over_budget++;
+    return false;
+  }
+  sounds_played_this_step_++;
+  stats_.sounds_played++;
+  return true;
+}
+
+void Scene::PlaySoundAtPositionNow_(SceneSound* sound, float volume,
+                                    const Vector3f& position,
+                                    bool host_only) {
   if (output_stream_.Exists() && !host_only) {
-    output_stream_->PlaySoundAtPosition(sound, volume, x, y, z);
+    output_stream_->PlaySoundAtPosition(sound, volume, position.x, position.y,
+                                        position.z);
+  }
+  g_base->audio->PlaySoundAtPosition(sound->GetSoundData(), volume,
+                                     position.x, position.y, position.z);
+}
+
+void Scene::PlayDynamicsSoundNow_(SceneSound* sound, float volume,
+                                  const Vector3f& position) {
+  if (base::AudioSource* source = g_base->audio->SourceBeginNew()) {
+    source->SetGain(volume);
+    source->SetPosition(position.x, position.y, position.z);
+    source->Play(sound->GetSoundData());
+    source->End();
   }
-  g_base->audio->PlaySoundAtPosition(sound->GetSoundData(), volume, x, y, z);
+}
+
+auto Scene::GetSoundAttenuation_(const Vector3f& position) const -> float {
+  // We don't know where any particular listener is, but cameras track the
+  // area of interest, so distance from its bounds gives a conservative
+  // (loud) estimate.
+  float dist{};
+  if (globals_node_) {
+    auto& bounds{globals_node_->area_of_interest_bounds()};
+    if (bounds.size() == 6) {
+      Vector3f offset{
+          std::max({bounds[0] - position.x, 0.0f, position.x - bounds[3]}),
+          std::max({bounds[1] - position.y, 0.0f, position.y - bounds[4]}),
+          std::max({bounds[2] - position.z, 0.0f, position.z - bounds[5]})};
+      dist = offset.Length();
+    }
+  }
+
+  // Inverse-distance-clamped, same as OpenAL.
+  dist = std::clamp(dist, kSoundReferenceDistance, kSoundMaxDistance);
+  return kSoundReferenceDistance
+         / (kSoundReferenceDistance
+            + kSoundRolloffFactor * (dist - kSoundReferenceDistance));
+}
+
+void Scene::FlushPendingSounds_() {
+  if (pending_sounds_.empty()) {
+    return;
+  }
+
+  // Merge plays of the same sound close to each other into one louder
+  // play. Volumes combine as uncorrelated sources would (root of the sum
+  // of squares), though never past full volume or the loudest play if that
+  // is louder, and the position lands at the volume-weighted center.
+  struct Merged {
+    PendingSound_* first;
+    float volume_sq;
+    float max_volume;
+    float weight;
+    Vector3f weighted_position;
+    float gain;
+  };
+  std::vector<Merged> merged;
+  merged.reserve(pending_sounds_.size());
+  float merge_dist_sq = kSoundMergeDistance * kSoundMergeDistance;
+  for (auto&& pending : pending_sounds_) {
+    float volume = std::max(pending.volume, 0.0f);
+    Merged* target{};
+    for (auto&& m : merged) {
+      if (m.first->sound.Get() == pending.sound.Get()
+          && m.first->host_only == pending.host_only
+          && m.first->dynamics == pending.dynamics
+          && (m.first->position - pending.position).LengthSquared()
+                 < merge_dist_sq) {
+        target = &m;
+        break;
+      }
+    }
+    if (target) {
+      target->volume_sq += volume * volume;
+      target->max_volume = std::max(target->max_volume, volume);
+      target->weight += volume;
+      target->weighted_position += pending.position * volume;
+      stats_.sounds_merged++;
+    } else {
+      merged.push_back({&pending, volume * volume, volume, volume,
+                        pending.position * volume, 0.0f});
+    }
+  }
+
+  // Drop anything too quiet to hear.
+  int audible{};
+  for (auto&& m : merged) {
+    if (m.weight > 0.0f) {
+      m.first->position = m.weighted_position / m.weight;
+    }
+    m.first->volume =
+        std::min(std::sqrt(m.volume_sq), std::max(m.max_volume, 1.0f));
+    m.gain = m.first->volume * GetSoundAttenuation_(m.first->position);
+    if (m.gain < kSoundMinAudibleGain) {
+      m.first = nullptr;
+      stats_.sounds_inaudible++;
+    } else {
+      audible++;
+    }
+  }
+
+  // If we're over budget, keep the loudest.
+  int budget = std::max(0, kMaxSoundsPerStep - sounds_played_this_step_);
+  if (audible > budget) {
+    std::vector<float> gains;
+    gains.reserve(audible);
+    for (auto&& m : merged) {
+      if (m.first) {
+        gains.push_back(m.gain);
+      }
+    }
+    // Everything louder than the cutoff stays, plus as many ties with it
+    // as still fit.
+    float cutoff{std::numeric_limits<float>::infinity()};
+    int ties_allowed{};
+    if (budget > 0) {
+      std::nth_element(gains.begin(), gains.begin() + (budget - 1),
+                       gains.end(), std::greater<>());
+      cutoff = gains[budget - 1];
+      ties_allowed = budget;
+      for (auto gain : gains) {
+        if (gain > cutoff) {
+          ties_allowed--;
+        }
+      }
+    }
+    for (auto&& m : merged) {
+      if (m.first) {
+        if (m.gain > cutoff) {
+          continue;
+        }
+        if (m.gain == cutoff && ties_allowed > 0) {
+          ties_allowed--;
+        } else {
+          m.first = nullptr;
+          stats_.sounds_over_budget++;
+        }
+      }
+    }
+  }
+
+  // Play what's left in the order it was originally requested.
+  for (auto&& m : merged) {
+    if (!m.first) {
+      continue;
+    }
+    if (m.first->dynamics) {
+      PlayDynamicsSoundNow_(m.first->sound.Get(), m.first->volume,
+                            m.first->position);
+    } else {
+      PlaySoundAtPositionNow_(m.first->sound.Get(), m.first->volume,
+                              m.first->position, m.first->host_only);
+    }
+    sounds_played_this_step_++;
+    stats_.sounds_played++;
+  }
+  pending_sounds_.clear();
 }
 
 void Scene::PlaySound(SceneSound* sound, float volume, bool host_only) {
@@ -90,17 +331,220 @@ auto Scene::IsOutOfBounds(float x, float y, float z) -> bool {
 }
 
 void Scene::Draw(base::FrameDef* frame_def) {
+  // Test nodes that provide draw bounds against the camera. VR tweaks its
+  // cameras after we've drawn, so we can't cull there.
+  bool cull =
+      SceneV1AppMode::GetSingleton()->view_culling() && !g_core->vr_mode();
+  base::ViewFrustum frustum;
+  bool reflections{};
+  if (cull) {
+    auto* beauty_pass = frame_def->beauty_pass();
+    frustum = beauty_pass->GetViewFrustum();
+    reflections = beauty_pass->floor_reflection();
+  }
+
+  // Gather the nodes we'll be drawing.
+  draw_nodes_.clear();
+  int culled{};
+  for (auto&& i : nodes()) {
+    bool in_beauty_view{true};
+    bool in_light_shadow_view{true};
+    Vector3f min, max;
+    if (cull && i->GetDrawBounds(&min, &max)) {
+      in_beauty_view =
+          frustum.IntersectsBox(min, max)
+          || (reflections && frustum.IntersectsBoxMirrored(min, max));
+      in_light_shadow_view = frustum.IntersectsBox(
+          {min.x - kViewCullShadowSpread, min.y - kViewCullShadowDrop,
+           min.z - kViewCullShadowSpread},
+          {max.x + kViewCullShadowSpread, max.y,
+           max.z + kViewCullShadowSpread});
+      if (!in_beauty_view && !in_light_shadow_view) {
+        culled++;
+        continue;
+      }
+    }
+    i->set_draw_visibility(in_beauty_view, in_light_shadow_view);
+    draw_nodes_.push_back(i.Get());
+  }
+  auto drawn = static_cast<int>(draw_nodes_.size());
+
   // Draw our nodes.
-  for (auto&& i : nodes_) {
-    g_base->graphics->PreNodeDraw();
-    i->Draw(frame_def);
-    g_base->graphics->PostNodeDraw();
+  if (SceneV1AppMode::GetSingleton()->parallel_node_drawing()
+      && draw_nodes_.size() >= kParallelDrawMinNodes) {
+    DrawNodesParallel_(frame_def);
+  } else {
+    DrawNodes_(frame_def);
   }
+  draw_nodes_.clear();
+
+  stats_.draws++;
+  stats_.nodes_drawn += drawn;
+  stats_.nodes_culled += culled;
+  stats_.last_nodes_drawn = drawn;
+  stats_.last_nodes_culled = culled;
 
   // Draw any dynamics debugging extras.
   dynamics_->Draw(frame_def);
 }
 
+void Scene::DrawNodes_(base::FrameDef* frame_def) {
+  for (auto* node : draw_nodes_) {
+    g_base->graphics->PreNodeDraw();
+    node->Draw(frame_def);
+    g_base->graphics->PostNodeDraw();
+  }
+}
+
+namespace {
+
+// Sets the current thread's frame-def draw chunk for its lifetime.
+class ScopedDrawChunk {
+ public:
+  explicit ScopedDrawChunk(int chunk) {
+    base::FrameDef::SetThreadDrawChunk(chunk);
+  }
+  ~ScopedDrawChunk() { base::FrameDef::SetThreadDrawChunk(-1); }
+};
+
+}  // namespace
+
+void Scene::DrawNodesParallel_(base::FrameDef* frame_def) {
+  // Split our nodes into chunks. Runs of parallel-safe nodes get chopped
+  // into fixed-size chunks to be drawn in workers; everything else is
+  // drawn here in the logic thread. Each chunk records into its own
+  // buffers which get appended in chunk order when we're done, so output
+  // matches a serial draw exactly.
+  draw_chunks_.clear();
+  for (size_t i = 0; i < draw_nodes_.size();) {
+    bool parallel = draw_nodes_[i]->type()->parallel_draw_safe();
+    size_t end = i + 1;
+    while (end < draw_nodes_.size()
+           && draw_nodes_[end]->type()->parallel_draw_safe() == parallel
+           && (!parallel || end - i < kParallelDrawChunkSize)) {
+      end++;
+    }
+    draw_chunks_.push_back({i, end, parallel});
+    i = end;
+  }
+
+  frame_def->BeginParallelDraw(static_cast<int>(draw_chunks_.size()));
+  try {
+    // Unsafe chunks go first, in order, so any shared state they touch
+    // (overlay z-depths and whatnot) evolves exactly as it would serially.
+    for (size_t c = 0; c < draw_chunks_.size(); ++c) {
+      auto& chunk{draw_chunks_[c]};
+      if (!chunk.parallel) {
+        ScopedDrawChunk scoped_chunk(static_cast<int>(c));
+        for (size_t i = chunk.begin; i < chunk.end; ++i) {
+          g_base->graphics->PreNodeDraw();
+          draw_nodes_[i]->Draw(frame_def);
+          g_base->graphics->PostNodeDraw();
+        }
+      }
+    }
+    WorkerPool::Shared()->ParallelFor(
+        draw_chunks_.size(), 1,
+        [this, frame_def](size_t begin, size_t end, int /*slot*/) {
+          for (size_t c = begin; c < end; ++c) {
+            auto& chunk{draw_chunks_[c]};
+            if (chunk.parallel) {
+              ScopedDrawChunk scoped_chunk(static_cast<int>(c));
+              for (size_t i = chunk.begin; i < chunk.end; ++i) {
+                draw_nodes_[i]->Draw(frame_def);
+              }
+            }
+          }
+        });
+  } catch (...) {
+    frame_def->EndParallelDraw();
+    throw;
+  }
+  frame_def->EndParallelDraw();
+}
+
+auto Scene::RunDrawBenchmark(int node_count, int frame_count) -> std::string {
+  assert(g_base->InLogicThread());
+  BA_PRECONDITION(node_count > 0);
+  BA_PRECONDITION(frame_count > 0);
+  if (g_core->HeadlessMode()) {
+    throw Exception("Draw benchmark is not available in headless builds.");
+  }
+
+  // A grid of props and bombs (parallel-safe) with the occasional shield
+  // mixed in (drawn serially).
+  auto scene = Object::New<Scene>(0);
+  auto mesh = Object::New<SceneMesh>("bomb", scene.Get());
+  auto texture = Object::New<SceneTexture>("bombColor", scene.Get());
+  auto side = static_cast<int>(ceilf(sqrtf(static_cast<float>(node_count))));
+  for (int i = 0; i < node_count; ++i) {
+    auto x = static_cast<float>(i % side) - 0.5f * static_cast<float>(side);
+    auto z = static_cast<float>(i / side) - 0.5f * static_cast<float>(side);
+    std::vector<float> position{x, 1.0f, z};
+    if (i % 20 == 19) {
+      Node* node = scene->NewNode("shield", "benchmark", nullptr);
+      node->GetAttribute("position").Set(position);
+      continue;
+    }
+    Node* node = scene->NewNode(i % 2 ? "bomb" : "prop", "benchmark", nullptr);
+    node->GetAttribute("body").Set(std::string("sphere"));
+    node->GetAttribute("mesh").Set(mesh.Get());
+    node->GetAttribute("color_texture").Set(texture.Get());
+    node->GetAttribute("position").Set(position);
+  }
+
+  // We're measuring draw cost, not culling.
+  auto* appmode = SceneV1AppMode::GetSingleton();
+  bool old_view_culling = appmode->view_culling();
+  bool old_parallel_node_drawing = appmode->parallel_node_drawing();
+  appmode->set_view_culling(false);
+
+  // Negative frame numbers keep our frames from colliding with real ones
+  // in per-asset/mesh frame-def bookkeeping.
+  static int64_t next_frame_number{-1};
+  base::FrameDef frame_def;
+  auto run = [&](bool parallel) -> microsecs_t {
+    appmode->set_parallel_node_drawing(parallel);
+    auto start = core::CorePlatform::GetCurrentMicrosecs();
+    for (int i = 0; i < frame_count; ++i) {
+      frame_def.Reset();
+      frame_def.set_frame_number(next_frame_number--);
+      scene->Draw(&frame_def);
+      frame_def.Complete();
+    }
+    return core::CorePlatform::GetCurrentMicrosecs() - start;
+  };
+  microsecs_t serial_time{};
+  microsecs_t parallel_time{};
+  try {
+    run(false);  // Warm-up.
+    serial_time = run(false);
+    parallel_time = run(true);
+  } catch (...) {
+    appmode->set_view_culling(old_view_culling);
+    appmode->set_parallel_node_drawing(old_parallel_node_drawing);
+    g_base->graphics->ClearBlotches();
+    throw;
+  }
+  appmode->set_view_culling(old_view_culling);
+  appmode->set_parallel_node_drawing(old_parallel_node_drawing);
+
+  // Don't let our blotches show up in the next real frame.
+  g_base->graphics->ClearBlotches();
+
+  char buffer[256];
+  snprintf(buffer, sizeof(buffer),
+           "Frame-def draw benchmark (%d nodes, %d frames, %d worker"
+           " threads): serial=%.1fus/frame parallel=%.1fus/frame (%.2fx).",
+           node_count, frame_count, WorkerPool::Shared()->thread_count(),
+           static_cast<double>(serial_time) / frame_count,
+           static_cast<double>(parallel_time) / frame_count,
+           parallel_time > 0 ? static_cast<double>(serial_time)
+                                   / static_cast<double>(parallel_time)
+                             : 0.0);
+  return buffer;
+}
+
 auto Scene::GetNodeMessageType(const std::string& type) -> NodeMessageType {
   assert(g_scene_v1 != nullptr);
   auto i = g_scene_v1->node_message_types().find(type);
@@ -135,21 +579,52 @@ void Scene::Step() {
 
   auto* appmode = SceneV1AppMode::GetActiveOrFatal();
 
+  // Gather positional sounds played during the step so they can be
+  // budgeted together.
+  gathering_sounds_ = appmode->sound_budgeting();
+  sounds_played_this_step_ = 0;
+  stats_.steps++;
+
   // Step all our nodes.
   {
     in_step_ = true;
     last_step_real_time_ = g_core->GetAppTimeMillisecs();
-    for (auto&& i : nodes_) {
-      Node* node = i.Get();
-      node->Step();
+    CompactNodes_();
+    if (step_schedule_dirty_) {
+      UpdateStepSchedule_();
+    }
+    for (auto&& batch : step_batches_) {
+      Node* const* nodes = step_order_.data() + batch.begin;
+      if (batch.step_all_call) {
+        batch.step_all_call(nodes, batch.count);
+      } else {
+        for (size_t i = 0; i < batch.count; ++i) {
+          nodes[i]->Step();
+        }
+      }
 
-      // Now that it's stepped, pump new values to any nodes it's connected to.
+      // Now that they're stepped, pump new values to any nodes they're
+      // connected to.
+      for (size_t i = 0; i < batch.count; ++i) {
+        nodes[i]->UpdateConnections();
+      }
+    }
+
+    // Any nodes created during the step (via callbacks/etc.) aren't in the
+    // schedule; they land at the end of our list so step them there.
+    for (size_t i = step_order_.size(); i < nodes_.size(); ++i) {
+      Node* node = nodes_[i].Get();
+      node->Step();
       node->UpdateConnections();
     }
     in_step_ = false;
   }
   bool is_foreground = (appmode->GetForegroundScene() == this);
 
+  // Sounds from node steps go out before the step command, as they always
+  // have.
+  FlushPendingSounds_();
+
   // Add a step command to the output stream.
   if (output_stream_.Exists()) {
     output_stream_->StepScene(this);
@@ -167,11 +642,113 @@ void Scene::Step() {
 
   // Lastly step our sim.
   dynamics_->Process();
+  spatial_index_->MarkDirty();
+  FlushPendingSounds_();
+  gathering_sounds_ = false;
 
   time_ += kGameStepMilliseconds;
   stepnum_++;
 }
 
+void Scene::UpdateStepSchedule_() {
+  // Nodes have always been stepped in creation order with each node
+  // pushing values through its outgoing attribute connections immediately
+  // after stepping. So for any two connected nodes, the earlier-created
+  // one steps and pushes before the later one steps. We preserve exactly
+  // that while letting batchable types cluster together: each node gets a
+  // 'wave' one past the highest wave of any earlier-created node it is
+  // connected to (in either direction), and we then step wave by wave.
+  // Nodes within a wave are never connected to each other, so runs of the
+  // same type within a wave can be stepped with a single batch call.
+  // Non-batchable nodes are additionally chained to each other so they
+  // keep their exact relative order (they may interact directly in ways
+  // we can't see).
+  size_t count = nodes_.size();
+  std::unordered_map<Node*, size_t> indices;
+  indices.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    indices[nodes_[i].Get()] = i;
+  }
+  std::vector<int> waves(count);
+  int last_unbatched_wave{-1};
+  auto wave_after = [&](Node* other, size_t index, int wave) {
+    auto i = indices.find(other);
+    if (i != indices.end() && i->second < index) {
+      wave = std::max(wave, waves[i->second] + 1);
+    }
+    return wave;
+  };
+  for (size_t i = 0; i < count; ++i) {
+    Node* node = nodes_[i].Get();
+    int wave{};
+    for (auto&& conn : node->attribute_connections_incoming()) {
+      wave = wave_after(conn.second->src_node.Get(), i, wave);
+    }
+    for (auto&& conn : node->attribute_connections()) {
+      wave = wave_after(conn->dst_node.Get(), i, wave);
+    }
+    if (node->type()->step_all_call() == nullptr) {
+      wave = std::max(wave, last_unbatched_wave + 1);
+      last_unbatched_wave = wave;
+    }
+    waves[i] = wave;
+  }
+
+  std::vector<size_t> order(count);
+  for (size_t i = 0; i < count; ++i) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    if (waves[a] != waves[b]) {
+      return waves[a] < waves[b];
+    }
+    int type_a = nodes_[a]->type()->id();
+    int type_b = nodes_[b]->type()->id();
+    if (type_a != type_b) {
+      return type_a < type_b;
+    }
+    return a < b;
+  });
+
+  step_order_.clear();
+  step_batches_.clear();
+  for (size_t i = 0; i < count; ++i) {
+    Node* node = nodes_[order[i]].Get();
+    NodeStepAllFunc* call = node->type()->step_all_call();
+    if (call && !step_batches_.empty()) {
+      auto& prev{step_batches_.back()};
+      Node* prev_node = step_order_[prev.begin];
+      if (prev.step_all_call == call && prev_node->type() == node->type()
+          && waves[order[i - 1]] == waves[order[i]]) {
+        prev.count++;
+        step_order_.push_back(node);
+        continue;
+      }
+    }
+    step_batches_.push_back({call, step_order_.size(), 1});
+    step_order_.push_back(node);
+  }
+  step_schedule_dirty_ = false;
+}
+
+void Scene::CompactNodes_() {
+  if (dead_node_count_ == 0) {
+    return;
+  }
+  size_t count{};
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    if (nodes_[i].Exists()) {
+      if (i != count) {
+        nodes_[count] = nodes_[i];
+        nodes_[count]->set_scene_index(count);
+      }
+      count++;
+    }
+  }
+  nodes_.resize(count);
+  dead_node_count_ = 0;
+}
+
 void Scene::DeleteNode(Node* node) {
   assert(node);
 
@@ -201,8 +778,15 @@ void Scene::DeleteNode(Node* node) {
 
   // Copy a strong ref to this node to keep it alive until we've wiped it from
   // the list. (so in its destructor it won't see itself on the list).
+  // We just empty its slot here; the list gets compacted in one pass
+  // before it is next walked so creation order is kept.
   Object::Ref<Node> temp_ref(node);
-  nodes_.erase(node->iterator());
+  size_t index = node->scene_index();
+  BA_PRECONDITION(index < nodes_.size() && nodes_[index].Get() == node);
+  nodes_[index].Clear();
+  dead_node_count_++;
+  step_schedule_dirty_ = true;
+  spatial_index_->MarkDirty();
 
   temp_ref.Clear();
 
@@ -229,14 +813,14 @@ void Scene::DeleteNode(Node* node) {
 
 void Scene::OnScreenSizeChange() {
   assert(g_base->InLogicThread());
-  for (auto&& i : nodes_) {
+  for (auto&& i : nodes()) {
     i->OnScreenSizeChange();  // New.
   }
 }
 
 void Scene::LanguageChanged() {
   assert(g_base->InLogicThread());
-  for (auto&& i : nodes_) {
+  for (auto&& i : nodes()) {
     i->OnLanguageChange();  // New.
   }
 }
@@ -297,7 +881,7 @@ void Scene::DumpNodes(SessionStream* out) {
   // First we go through and create all nodes.
   // We have to do this all at once before setting attrs since any node
   // can refer to any other in an attr set.
-  for (auto&& i : nodes_) {
+  for (auto&& i : nodes()) {
     Node* node = i.Get();
     assert(node);
 
@@ -308,7 +892,7 @@ void Scene::DumpNodes(SessionStream* out) {
   std::vector<std::pair<NodeAttribute, Node*> > node_attr_sets;
 
   // Now go through and set *most* node attr values.
-  for (auto&& i1 : nodes_) {
+  for (auto&& i1 : nodes()) {
     Node* node = i1.Get();
     assert(node);
 
@@ -404,7 +988,7 @@ void Scene::DumpNodes(SessionStream* out) {
 
   // Now run through all nodes once more and add an OnCreate() call
   // so they can do any post-create setup they need to.
-  for (auto&& i : nodes_) {
+  for (auto&& i : nodes()) {
     Node* node = i.Get();
     assert(node);
     out->NodeOnCreate(node);
@@ -416,7 +1000,7 @@ void Scene::DumpNodes(SessionStream* out) {
   }
 
   // And lastly re-establish node attribute-connections.
-  for (auto&& i : nodes_) {
+  for (auto&& i : nodes()) {
     Node* node = i.Get();
     assert(node);
     for (auto&& j : node->attribute_connections()) {
@@ -448,7 +1032,7 @@ auto Scene::GetCorrectionMessage(bool blended) -> std::vector<uint8_t> {
 
   std::vector<RigidBody*> dynamic_bodies;
 
-  for (auto&& i : nodes_) {
+  for (auto&& i : nodes()) {
     Node* n = i.Get();
     assert(n);
     if (n && !n->parts().empty()) {
@@ -534,10 +1118,13 @@ auto Scene::GetCorrectionMessage(bool blended) -> std::vector<uint8_t> {
 
 void Scene::SetOutputStream(SessionStream* val) { output_stream_ = val; }
 
-void Scene::AddNode(Node* node, int64_t* node_id, NodeList::iterator* i) {
-  assert(node && node_id && i);
+void Scene::AddNode(Node* node, int64_t* node_id) {
+  assert(node && node_id);
   *node_id = next_node_id_++;
-  *i = nodes_.insert(nodes_.end(), Object::Ref<Node>(node));
+  node->set_scene_index(nodes_.size());
+  nodes_.emplace_back(node);
+  step_schedule_dirty_ = true;
+  spatial_index_->MarkDirty();
 }
 
 }  // namespace ballistica::scene_v1
@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_SCENE_V1_SUPPORT_SCENE_H_
 #define BALLISTICA_SCENE_V1_SUPPORT_SCENE_H_
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -22,8 +23,27 @@ class Scene : public Object {
   void Draw(base::FrameDef* frame_def);
   auto NewNode(const std::string& type, const std::string& name,
                PyObject* delegate) -> Node*;
+
+  /// Play a sound at a position. During a step, these get gathered and
+  /// run through our sound budget at the end of the step (see
+  /// SceneV1AppMode::sound_budgeting()) instead of being played
+  /// immediately.
   void PlaySoundAtPosition(SceneSound* sound, float volume, float x, float y,
                            float z, bool host_only = false);
+
+  /// Play a one-shot collision sound (impact, connect, etc.) for our
+  /// dynamics. Every client simulates dynamics itself so these never go to
+  /// the output stream, but they share the step's sound budget with
+  /// PlaySoundAtPosition().
+  void PlayDynamicsSound(SceneSound* sound, float volume,
+                         const Vector3f& position);
+
+  /// Ask whether dynamics may start a looping collision sound (skid, roll)
+  /// now. Those hang on to their sources so can't be merged, but audible
+  /// ones still count against the step's sound budget, which this claims a
+  /// slot of on success.
+  auto ClaimDynamicsSoundBudget(float volume, const Vector3f& position)
+      -> bool;
   void PlaySound(SceneSound* sound, float volume, bool host_only = false);
   static auto GetNodeMessageType(const std::string& type_name)
       -> NodeMessageType;
@@ -31,8 +51,11 @@ class Scene : public Object {
   static auto GetNodeMessageFormat(NodeMessageType type) -> const char*;
   auto time() const -> millisecs_t { return time_; }
   auto stepnum() const -> int64_t { return stepnum_; }
-  auto nodes() const -> const NodeList& { return nodes_; }
-  void AddNode(Node*, int64_t* node_id, NodeList::iterator* i);
+  auto nodes() -> const NodeList& {
+    CompactNodes_();
+    return nodes_;
+  }
+  void AddNode(Node*, int64_t* node_id);
   void AddOutOfBoundsNode(Node* n) { out_of_bounds_nodes_.emplace_back(n); }
   auto IsOutOfBounds(float x, float y, float z) -> bool;
   auto dynamics() const -> Dynamics* {
@@ -40,13 +63,23 @@ class Scene : public Object {
     return dynamics_.Get();
   }
   auto in_step() const -> bool { return in_step_; }
+
+  /// Index of node positions for proximity queries. Reflects node
+  /// positions as of the last dynamics step.
+  auto spatial_index() const -> SceneSpatialIndex* {
+    return spatial_index_.get();
+  }
   void SetMapBounds(float x, float y, float z, float X, float Y, float Z);
   void OnScreenSizeChange();
   void LanguageChanged();
-  auto out_of_bounds_nodes() -> const std::vector<Object::WeakRef<Node> >& {
+  auto out_of_bounds_nodes() -> const std::vector<Handle<Node> >& {
     return out_of_bounds_nodes_;
   }
   void DeleteNode(Node* node);
+
+  /// Should be called when nodes are added/removed or attribute
+  /// connections change so the step schedule gets rebuilt.
+  void MarkStepScheduleDirty() { step_schedule_dirty_ = true; }
   auto shutting_down() const -> bool { return shutting_down_; }
   void set_shutting_down(bool val) { shutting_down_ = val; }
   auto GetSceneStream() const -> SessionStream*;
@@ -78,7 +111,63 @@ class Scene : public Object {
   auto globals_node() const -> GlobalsNode* { return globals_node_; }
   void set_globals_node(GlobalsNode* node) { globals_node_ = node; }
 
+  /// Running counts for this scene. Nodes drawn and culled are from view
+  /// culling in Draw() (see SceneV1AppMode::view_culling()); sounds are
+  /// positional script and dynamics sounds handled by the per-step sound
+  /// budget (see SceneV1AppMode::sound_budgeting()).
+  struct Stats {
+    int64_t draws{};
+    int64_t nodes_drawn{};
+    int64_t nodes_culled{};
+    int last_nodes_drawn{};
+    int last_nodes_culled{};
+    int64_t steps{};
+    int64_t sounds_requested{};
+    int64_t sounds_played{};
+    int64_t sounds_merged{};
+    int64_t sounds_inaudible{};
+    int64_t sounds_over_budget{};
+  };
+  auto stats() const -> const Stats& { return stats_; }
+
+  /// Build frame-defs for a synthetic scene of node_count nodes both
+  /// serially and in parallel, returning a summary of the timings.
+  static auto RunDrawBenchmark(int node_count, int frame_count) -> std::string;
+
  private:
+  /// A positional sound gathered during a step.
+  struct PendingSound_ {
+    Object::Ref<SceneSound> sound;
+    float volume;
+    Vector3f position;
+    bool host_only;
+    bool dynamics;
+  };
+  void PlaySoundAtPositionNow_(SceneSound* sound, float volume,
+                               const Vector3f& position, bool host_only);
+  void PlayDynamicsSoundNow_(SceneSound* sound, float volume,
+                             const Vector3f& position);
+  void FlushPendingSounds_();
+  auto GetSoundAttenuation_(const Vector3f& position) const -> float;
+
+  /// A run of nodes in draw_nodes_ drawn into one frame-def chunk.
+  struct DrawChunk_ {
+    size_t begin;
+    size_t end;
+    bool parallel;
+  };
+  void DrawNodes_(base::FrameDef* frame_def);
+  void DrawNodesParallel_(base::FrameDef* frame_def);
+
+  /// A run of nodes in step_order_ to be stepped together.
+  struct StepBatch_ {
+    NodeStepAllFunc* step_all_call;
+    size_t begin;
+    size_t count;
+  };
+  void UpdateStepSchedule_();
+  void CompactNodes_();
+
   GlobalsNode* globals_node_{};  // Current globals node (if any).
   std::unordered_map<int, Object::WeakRef<PlayerNode> > player_nodes_;
   int64_t stream_id_{-1};
@@ -88,6 +177,9 @@ class Scene : public Object {
   millisecs_t time_{};
   int64_t stepnum_{};
   bool in_step_{};
+  bool gathering_sounds_{};
+  int sounds_played_this_step_{};
+  std::vector<PendingSound_> pending_sounds_;
   int64_t next_node_id_{};
 
   // For globals real_time attr (so is consistent through the step.)
@@ -96,9 +188,19 @@ class Scene : public Object {
   bool shutting_down_{};
   float bounds_min_[3]{};
   float bounds_max_[3]{};
-  std::vector<Object::WeakRef<Node> > out_of_bounds_nodes_;
+  std::vector<Handle<Node> > out_of_bounds_nodes_;
+  /// Nodes in creation order. Deleted nodes leave an empty slot which
+  /// gets compacted out before the list is next walked.
   NodeList nodes_;
+  size_t dead_node_count_{};
+  Stats stats_;
+  std::vector<Node*> step_order_;
+  std::vector<StepBatch_> step_batches_;
+  bool step_schedule_dirty_{true};
+  std::vector<Node*> draw_nodes_;
+  std::vector<DrawChunk_> draw_chunks_;
   Object::Ref<Dynamics> dynamics_;
+  std::unique_ptr<SceneSpatialIndex> spatial_index_;
 };
 
 }  // namespace ballistica::scene_v1
@@ -0,0 +1,244 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/scene_v1/support/scene_spatial_index.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ballistica/scene_v1/dynamics/part.h"
+#include "ballistica/scene_v1/dynamics/rigid_body.h"
+#include "ballistica/scene_v1/node/node.h"
+#include "ballistica/scene_v1/support/scene.h"
+
+namespace ballistica::scene_v1 {
+
+// Roughly the size of a character; small enough that typical queries only
+// touch a handful of cells.
+const float kSpatialIndexCellSize = 4.0f;
+
+// Cell coords get packed into 21 bits each. Far-flung coords wrap, which
+// only means some extra distance checks.
+const uint64_t kSpatialIndexCellMask = (1ull << 21) - 1;
+
+static auto CellCoord_(float val) -> int64_t {
+  return static_cast<int64_t>(std::floor(val / kSpatialIndexCellSize));
+}
+
+static auto CellKey_(int64_t x, int64_t y, int64_t z) -> uint64_t {
+  return ((static_cast<uint64_t>(x) & kSpatialIndexCellMask) << 42)
+         | ((static_cast<uint64_t>(y) & kSpatialIndexCellMask) << 21)
+         | (static_cast<uint64_t>(z) & kSpatialIndexCellMask);
+}
+
+SceneSpatialIndex::SceneSpatialIndex(Scene* scene) : scene_(scene) {}
+
+void SceneSpatialIndex::Refresh_() {
+  if (!dirty_) {
+    return;
+  }
+  dirty_ = false;
+  entries_.clear();
+  cells_.clear();
+  for (auto&& node : scene_->nodes()) {
+    const RigidBody* found{};
+    for (auto* part : node->parts()) {
+      if (part == nullptr) {
+        continue;
+      }
+      for (auto* body : part->rigid_bodies()) {
+        if (body->type() == RigidBody::Type::kBody) {
+          found = body;
+          break;
+        }
+      }
+      if (found) {
+        break;
+      }
+    }
+    if (!found) {
+      continue;
+    }
+    const dReal* p = dBodyGetPosition(found->body());
+    Vector3f pos{p[0], p[1], p[2]};
+    entries_.push_back({node.Get(), pos,
+                        CellKey_(CellCoord_(pos.x), CellCoord_(pos.y),
+                                 CellCoord_(pos.z))});
+  }
+  if (entries_.empty()) {
+    return;
+  }
+
+  // Sorting by cell (stably, so equal-distance results come out in
+  // creation order) gives each cell a contiguous run of entries.
+  std::stable_sort(
+      entries_.begin(), entries_.end(),
+      [](const Entry_& a, const Entry_& b) { return a.cell < b.cell; });
+  bounds_min_ = bounds_max_ = entries_[0].position;
+  for (uint32_t i = 0; i < entries_.size(); ++i) {
+    auto& entry{entries_[i]};
+    bounds_min_.x = std::min(bounds_min_.x, entry.position.x);
+    bounds_min_.y = std::min(bounds_min_.y, entry.position.y);
+    bounds_min_.z = std::min(bounds_min_.z, entry.position.z);
+    bounds_max_.x = std::max(bounds_max_.x, entry.position.x);
+    bounds_max_.y = std::max(bounds_max_.y, entry.position.y);
+    bounds_max_.z = std::max(bounds_max_.z, entry.position.z);
+    if (cells_.empty() || cells_.back().key != entry.cell) {
+      cells_.push_back({entry.cell, i, i + 1});
+    } else {
+      cells_.back().end = i + 1;
+    }
+  }
+}
+
+template <typename F>
+void SceneSpatialIndex::ForEachInBox_(const Vector3f& min, const Vector3f& max,
+                                      F&& func) {
+  auto in_box = [&min, &max](const Vector3f& p) {
+    return p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y
+           && p.z >= min.z && p.z <= max.z;
+  };
+
+  // Clip to what we've actually got so huge boxes stay cheap.
+  Vector3f lo{std::max(min.x, bounds_min_.x), std::max(min.y, bounds_min_.y),
+              std::max(min.z, bounds_min_.z)};
+  Vector3f hi{std::min(max.x, bounds_max_.x), std::min(max.y, bounds_max_.y),
+              std::min(max.z, bounds_max_.z)};
+  if (entries_.empty() || lo.x > hi.x || lo.y > hi.y || lo.z > hi.z) {
+    return;
+  }
+  int64_t x0 = CellCoord_(lo.x);
+  int64_t y0 = CellCoord_(lo.y);
+  int64_t z0 = CellCoord_(lo.z);
+  int64_t x1 = CellCoord_(hi.x);
+  int64_t y1 = CellCoord_(hi.y);
+  int64_t z1 = CellCoord_(hi.z);
+
+  // If the box spans more cells than we have, just walk everything.
+  auto span = static_cast<double>(x1 - x0 + 1)
+              * static_cast<double>(y1 - y0 + 1)
+              * static_cast<double>(z1 - z0 + 1);
+  if (span >= static_cast<double>(cells_.size())) {
+    for (auto&& entry : entries_) {
+      if (in_box(entry.position)) {
+        func(entry);
+      }
+    }
+    return;
+  }
+  for (int64_t x = x0; x <= x1; ++x) {
+    for (int64_t y = y0; y <= y1; ++y) {
+      for (int64_t z = z0; z <= z1; ++z) {
+        uint64_t key = CellKey_(x, y, z);
+        auto cell = std::lower_bound(
+            cells_.begin(), cells_.end(), key,
+            [](const Cell_& c, uint64_t k) { return c.key < k; });
+        if (cell == cells_.end() || cell->key != key) {
+          continue;
+        }
+        for (uint32_t i = cell->begin; i < cell->end; ++i) {
+          if (in_box(entries_[i].position)) {
+            func(entries_[i]);
+          }
+        }
+      }
+    }
+  }
+}
+
+auto SceneSpatialIndex::Matches_(Node* node, const Filter& filter) -> bool {
+  if (filter.node_type && node->type() != filter.node_type) {
+    return false;
+  }
+  if (filter.material) {
+    for (auto* part : node->parts()) {
+      if (part && part->ContainsMaterial(filter.material)) {
+        return true;
+      }
+    }
+    return false;
+  }
+  return true;
+}
+
+void SceneSpatialIndex::GatherRadius_(const Vector3f& center, float radius,
+                                      const Filter& filter,
+                                      std::vector<Hit_>* hits) {
+  hits->clear();
+  float radius_squared = radius * radius;
+  Vector3f extent{radius, radius, radius};
+  ForEachInBox_(center - extent, center + extent, [&](const Entry_& entry) {
+    float dist_squared = (entry.position - center).LengthSquared();
+    if (dist_squared <= radius_squared && Matches_(entry.node, filter)) {
+      hits->push_back({entry.node, dist_squared});
+    }
+  });
+}
+
+void SceneSpatialIndex::QueryRadius(const Vector3f& center, float radius,
+                                    const Filter& filter,
+                                    std::vector<Node*>* results) {
+  results->clear();
+  Refresh_();
+  GatherRadius_(center, radius, filter, &hits_);
+  std::stable_sort(hits_.begin(), hits_.end(),
+                   [](const Hit_& a, const Hit_& b) {
+                     return a.distance_squared < b.distance_squared;
+                   });
+  for (auto&& hit : hits_) {
+    results->push_back(hit.node);
+  }
+}
+
+void SceneSpatialIndex::QueryBox(const Vector3f& min, const Vector3f& max,
+                                 const Filter& filter,
+                                 std::vector<Node*>* results) {
+  results->clear();
+  Refresh_();
+  ForEachInBox_(min, max, [&](const Entry_& entry) {
+    if (Matches_(entry.node, filter)) {
+      results->push_back(entry.node);
+    }
+  });
+}
+
+void SceneSpatialIndex::QueryNearest(const Vector3f& center, int count,
+                                     float max_distance, const Filter& filter,
+                                     std::vector<Node*>* results) {
+  results->clear();
+  Refresh_();
+  if (count <= 0 || entries_.empty()) {
+    return;
+  }
+
+  // Grow a search sphere until it holds enough matches; anything outside
+  // it is further than everything in it. Once it covers all our entries
+  // there's nothing more to find.
+  float reach{};
+  for (auto&& corner : {bounds_min_, bounds_max_}) {
+    Vector3f diff = corner - center;
+    reach = std::max({reach, std::abs(diff.x), std::abs(diff.y),
+                      std::abs(diff.z)});
+  }
+  reach *= 1.7321f;  // sqrt(3); box half-extent to enclosing sphere.
+  float radius = std::min(kSpatialIndexCellSize, max_distance);
+  while (true) {
+    GatherRadius_(center, radius, filter, &hits_);
+    if (hits_.size() >= static_cast<size_t>(count) || radius >= max_distance
+        || radius >= reach) {
+      break;
+    }
+    radius = std::min(radius * 2.0f, max_distance);
+  }
+  auto by_distance = [](const Hit_& a, const Hit_& b) {
+    return a.distance_squared < b.distance_squared;
+  };
+  std::stable_sort(hits_.begin(), hits_.end(), by_distance);
+  if (hits_.size() > static_cast<size_t>(count)) {
+    hits_.resize(static_cast<size_t>(count));
+  }
+  for (auto&& hit : hits_) {
+    results->push_back(hit.node);
+  }
+}
+
+}  // namespace ballistica::scene_v1
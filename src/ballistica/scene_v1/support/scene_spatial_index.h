@@ -0,0 +1,79 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SCENE_V1_SUPPORT_SCENE_SPATIAL_INDEX_H_
+#define BALLISTICA_SCENE_V1_SUPPORT_SCENE_SPATIAL_INDEX_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "ballistica/scene_v1/scene_v1.h"
+#include "ballistica/shared/math/vector3f.h"
+
+namespace ballistica::scene_v1 {
+
+/// A uniform grid of node positions for answering proximity queries
+/// without walking every node in a scene.
+///
+/// Each node with a dynamic rigid body is indexed at the position of its
+/// first such body; nodes without one are not indexed. The grid is rebuilt
+/// lazily on the first query after anything marks it dirty (the scene does
+/// so after each dynamics step and whenever nodes come or go).
+class SceneSpatialIndex {
+ public:
+  /// Optional restrictions on which nodes a query returns.
+  struct Filter {
+    NodeType* node_type{};
+    Material* material{};
+  };
+
+  explicit SceneSpatialIndex(Scene* scene);
+
+  void MarkDirty() { dirty_ = true; }
+
+  /// Nodes within a radius of a point, nearest first.
+  void QueryRadius(const Vector3f& center, float radius, const Filter& filter,
+                   std::vector<Node*>* results);
+
+  /// Nodes within an axis-aligned box, in no particular order.
+  void QueryBox(const Vector3f& min, const Vector3f& max,
+                const Filter& filter, std::vector<Node*>* results);
+
+  /// Up to count nodes nearest to a point (and no further than
+  /// max_distance), nearest first.
+  void QueryNearest(const Vector3f& center, int count, float max_distance,
+                    const Filter& filter, std::vector<Node*>* results);
+
+ private:
+  struct Entry_ {
+    Node* node;
+    Vector3f position;
+    uint64_t cell;
+  };
+  struct Cell_ {
+    uint64_t key;
+    uint32_t begin;
+    uint32_t end;
+  };
+  struct Hit_ {
+    Node* node;
+    float distance_squared;
+  };
+  void Refresh_();
+  template <typename F>
+  void ForEachInBox_(const Vector3f& min, const Vector3f& max, F&& func);
+  void GatherRadius_(const Vector3f& center, float radius,
+                     const Filter& filter, std::vector<Hit_>* hits);
+  static auto Matches_(Node* node, const Filter& filter) -> bool;
+
+  Scene* scene_;
+  bool dirty_{true};
+  std::vector<Entry_> entries_;
+  std::vector<Cell_> cells_;
+  std::vector<Hit_> hits_;
+  Vector3f bounds_min_{0.0f, 0.0f, 0.0f};
+  Vector3f bounds_max_{0.0f, 0.0f, 0.0f};
+};
+
+}  // namespace ballistica::scene_v1
+
+#endif  // BALLISTICA_SCENE_V1_SUPPORT_SCENE_SPATIAL_INDEX_H_
@@ -22,6 +22,7 @@
 #include "ballistica/scene_v1/support/host_session.h"
 #include "ballistica/shared/foundation/event_loop.h"
 #include "ballistica/shared/generic/json.h"
+#include "ballistica/shared/generic/json_arena.h"
 #include "ballistica/shared/generic/utils.h"
 #include "ballistica/ui_v1/ui_v1.h"
 
@@ -401,11 +402,10 @@ void SceneV1AppMode::HandleIncomingUDPPacket(const std::vector<uint8_t>& data,
 auto SceneV1AppMode::HandleJSONPing(const std::string& data_str)
     -> std::string {
   // Note to self - this is called in a non-logic thread.
-  cJSON* data = cJSON_Parse(data_str.c_str());
-  if (data == nullptr) {
+  JsonArena arena;
+  if (arena.ParseCopy(data_str.c_str(), data_str.size()) == nullptr) {
     return "";
   }
-  cJSON_Delete(data);
 
   // Ok lets include some basic info that might be pertinent to someone
   // pinging us. Currently that includes our current/max connection count.
@@ -430,11 +430,17 @@ auto SceneV1AppMode::GetPartySize() const -> int {
 
 auto SceneV1AppMode::GetHeadlessNextDisplayTimeStep() -> microsecs_t {
   std::optional<microsecs_t> min_time_to_next;
+  std::vector<Session*> sessions;
   for (auto&& i : sessions_) {
-    if (!i.Exists()) {
-      continue;
+    if (i.Exists()) {
+      sessions.push_back(i.Get());
     }
-    auto this_time_to_next = i->TimeToNextEvent();
+  }
+  for (auto&& i : party_sessions_) {
+    sessions.push_back(i.second.Get());
+  }
+  for (auto* session : sessions) {
+    auto this_time_to_next = session->TimeToNextEvent();
     if (this_time_to_next.has_value()) {
       if (!min_time_to_next.has_value()) {
         min_time_to_next = *this_time_to_next;
@@ -508,6 +514,11 @@ void SceneV1AppMode::StepDisplayTime() {
               g_base->logic->display_time_increment());
   }
 
+  for (auto&& i : party_sessions_) {
+    i.second->Update(static_cast<int>(legacy_display_time_millisecs_inc),
+                     g_base->logic->display_time_increment());
+  }
+
   // Go ahead and prune dead ones.
   PruneSessions_();
 
@@ -532,13 +543,9 @@ void SceneV1AppMode::StepDisplayTime() {
 auto SceneV1AppMode::GetGameRosterMessage_() -> std::vector<uint8_t> {
   // This message is simply a flattened json string of our roster (including
   // terminating char).
-  char* s = cJSON_PrintUnformatted(game_roster_);
-  auto s_len = strlen(s);
-  std::vector<uint8_t> msg(1 + s_len + 1);
-  msg[0] = BA_MESSAGE_PARTY_ROSTER;
-  memcpy(&(msg[1]), s, s_len + 1);
-  free(s);
-
+  std::vector<uint8_t> msg{BA_MESSAGE_PARTY_ROSTER};
+  JsonWriter(&msg).Value(game_roster_);
+  msg.push_back(0);
   return msg;
 }
 
@@ -1059,11 +1066,82 @@ void SceneV1AppMode::LaunchClientSession() {
   }
 }
 
+void SceneV1AppMode::LaunchPartySession(PyObject* session_type_obj,
+                                        int party_id) {
+  if (in_update_) {
+    throw Exception(
+        "can't launch a session from within a session update; use "
+        "babase.pushcall()");
+  }
+  assert(g_base->InLogicThread());
+  if (!multi_party_enabled_) {
+    throw Exception("Multi-party hosting is not enabled.");
+  }
+  if (party_id <= 0) {
+    throw Exception("Party sessions need a positive party id.");
+  }
+  if (party_sessions_.find(party_id) != party_sessions_.end()) {
+    throw Exception("Party " + std::to_string(party_id)
+                    + " already has a session.");
+  }
+  if (!dynamic_cast<HostSession*>(foreground_session_.Get())) {
+    throw Exception("Party sessions require a foreground host session.");
+  }
+
+  base::ScopedSetContext ssc(nullptr);
+
+  // New sessions make themselves foreground; party sessions never stay
+  // that way.
+  Object::WeakRef<Session> old_foreground_session(foreground_session_);
+  try {
+    auto s(Object::New<HostSession>(session_type_obj, party_id));
+    party_sessions_[party_id] = s;
+  } catch (const std::exception& e) {
+    SetForegroundSession(old_foreground_session.Get());
+    throw Exception(std::string("HostSession failed: ") + e.what());
+  }
+  SetForegroundSession(old_foreground_session.Get());
+}
+
+void SceneV1AppMode::EndPartySession(int party_id) {
+  if (in_update_) {
+    throw Exception(
+        "can't end a session from within a session update; use "
+        "babase.pushcall()");
+  }
+  assert(g_base->InLogicThread());
+  auto i = party_sessions_.find(party_id);
+  if (i == party_sessions_.end()) {
+    return;
+  }
+  for (auto&& c : connections_->connections_to_clients()) {
+    if (c.second.Exists() && c.second->party_id() == party_id) {
+      connections_->SetClientParty(c.first, 0);
+    }
+  }
+  party_sessions_.erase(i);
+}
+
+auto SceneV1AppMode::GetPartyHostSession(int party_id) const -> HostSession* {
+  if (party_id == 0) {
+    return dynamic_cast<HostSession*>(foreground_session_.Get());
+  }
+  auto i = party_sessions_.find(party_id);
+  return i == party_sessions_.end()
+             ? nullptr
+             : static_cast<HostSession*>(i->second.Get());
+}
+
 // Reset to a blank slate.
 void SceneV1AppMode::Reset_() {
   assert(g_base);
   assert(g_base->InLogicThread());
 
+  // Party sessions can't outlive the shared state we're about to reset.
+  while (!party_sessions_.empty()) {
+    EndPartySession(party_sessions_.begin()->first);
+  }
+
   // Tear down our existing session.
   foreground_session_.Clear();
   PruneSessions_();
@@ -65,6 +65,19 @@ class SceneV1AppMode : public base::AppMode {
   void LaunchReplaySession(const std::string& file_name);
   void LaunchClientSession();
 
+  /// Launch an extra host session serving party_id (which must be
+  /// positive) alongside the foreground session, which always serves party
+  /// 0. Clients are moved between parties with
+  /// ConnectionSet::SetClientParty(). Requires multi-party hosting to be
+  /// enabled.
+  void LaunchPartySession(PyObject* session_type_obj, int party_id);
+
+  /// Shut down a party session, moving its clients back to party 0.
+  void EndPartySession(int party_id);
+
+  /// Return the host session serving a party, if any.
+  auto GetPartyHostSession(int party_id) const -> HostSession*;
+
   auto GetNetworkDebugString() -> std::string override;
   auto GetDisplayPing() -> std::optional<float> override;
   auto HasConnectionToHost() const -> bool override;
@@ -179,10 +192,36 @@ class SceneV1AppMode : public base::AppMode {
 
   auto dynamics_sync_time() const { return dynamics_sync_time_; }
   void set_dynamics_sync_time(int val) { dynamics_sync_time_ = val; }
+  auto dynamics_blend_time() const { return dynamics_blend_time_; }
+  void set_dynamics_blend_time(int val) { dynamics_blend_time_ = val; }
+  auto interest_radius() const { return interest_radius_; }
+  void set_interest_radius(float val) { interest_radius_ = val; }
+  auto client_bytes_per_second_cap() const {
+    return client_bytes_per_second_cap_;
+  }
+  void set_client_bytes_per_second_cap(int64_t val) {
+    client_bytes_per_second_cap_ = val;
+  }
   auto delay_bucket_samples() const { return delay_bucket_samples_; }
   void set_delay_bucket_samples(int val) { delay_bucket_samples_ = val; }
   auto buffer_time() const { return buffer_time_; }
   void set_buffer_time(int val) { buffer_time_ = val; }
+  auto multi_party_enabled() const { return multi_party_enabled_; }
+  void set_multi_party_enabled(bool val) { multi_party_enabled_ = val; }
+  auto unreliable_remote_input() const { return unreliable_remote_input_; }
+  void set_unreliable_remote_input(bool val) {
+    unreliable_remote_input_ = val;
+  }
+  auto view_culling() const { return view_culling_; }
+  void set_view_culling(bool val) { view_culling_ = val; }
+  auto sound_budgeting() const { return sound_budgeting_; }
+  void set_sound_budgeting(bool val) { sound_budgeting_ = val; }
+  auto parallel_node_drawing() const { return parallel_node_drawing_; }
+  void set_parallel_node_drawing(bool val) { parallel_node_drawing_ = val; }
+  auto parallel_physics_islands() const { return parallel_physics_islands_; }
+  void set_parallel_physics_islands(bool val) {
+    parallel_physics_islands_ = val;
+  }
   void OnActivate() override;
   auto GetHeadlessNextDisplayTimeStep() -> microsecs_t override;
 
@@ -215,6 +254,8 @@ class SceneV1AppMode : public base::AppMode {
   std::vector<Object::Ref<Session> > sessions_;
   Object::WeakRef<Scene> foreground_scene_;
   Object::WeakRef<Session> foreground_session_;
+  // Extra host sessions by party id (see LaunchPartySession()).
+  std::map<int, Object::Ref<Session> > party_sessions_;
 
   bool chat_muted_{};
   bool in_update_{};
@@ -240,6 +281,14 @@ class SceneV1AppMode : public base::AppMode {
 
   // How often we send dynamics resync messages.
   int dynamics_sync_time_{500};
+  // How long clients take to visually ease into dynamics resyncs.
+  int dynamics_blend_time_{100};
+  // How far outside of the areas of interest cosmetic events still get
+  // sent to clients (0 sends everything everywhere).
+  float interest_radius_{};
+  // Clients going over this many bytes per second get sent less (0 for no
+  // cap; we still back off for clients whose links can't keep up).
+  int64_t client_bytes_per_second_cap_{};
   // How many steps we sample for each bucket.
   int delay_bucket_samples_{60};
 
@@ -247,6 +296,33 @@ class SceneV1AppMode : public base::AppMode {
   // it over the network.
   int buffer_time_{};
 
+  // Whether LaunchPartySession() is allowed.
+  bool multi_party_enabled_{};
+
+  // Whether to send remote-player input as redundant unsequenced frames
+  // (to hosts that support it) instead of reliable messages.
+  bool unreliable_remote_input_{};
+
+  // Whether scenes skip drawing nodes that are out of the camera's view.
+  bool view_culling_{true};
+
+  // Whether positional sounds played during scene steps go through a
+  // per-step budget. When enabled, plays of the same sound close together
+  // get merged, sounds too quiet to hear anywhere near the area of
+  // interest get dropped, and only a fixed count per step is kept (the
+  // loudest). This covers script sounds (including what clients get) as
+  // well as collision sounds from dynamics, which share the same budget.
+  bool sound_budgeting_{true};
+
+  // Whether scenes draw runs of parallel-draw-safe nodes (see
+  // NodeType::parallel_draw_safe()) in worker threads. Output is identical
+  // either way.
+  bool parallel_node_drawing_{};
+
+  // Whether independent physics islands get solved concurrently on worker
+  // threads (when there are any). Results are identical either way.
+  bool parallel_physics_islands_{};
+
   millisecs_t next_long_update_report_time_{};
   int debug_speed_exponent_{};
   int replay_speed_exponent_{};
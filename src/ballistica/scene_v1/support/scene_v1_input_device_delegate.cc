@@ -2,6 +2,8 @@
 
 #include "ballistica/scene_v1/support/scene_v1_input_device_delegate.h"
 
+#include <algorithm>
+
 #include "ballistica/base/input/device/input_device.h"
 #include "ballistica/base/networking/networking.h"
 #include "ballistica/base/support/plus_soft.h"
@@ -16,6 +18,10 @@
 
 namespace ballistica::scene_v1 {
 
+// Minimum time between redundant re-sends of our last input frame when
+// there's no new input to send.
+const int kRemoteInputResendInterval = 16;
+
 SceneV1InputDeviceDelegate::SceneV1InputDeviceDelegate() = default;
 
 SceneV1InputDeviceDelegate::~SceneV1InputDeviceDelegate() {
@@ -133,6 +139,9 @@ void SceneV1InputDeviceDelegate::AttachToRemotePlayer(
   }
   remote_player_ = connection_to_host;
   remote_player_id_ = remote_player_id;
+
+  // Frame seqs are per-connection; don't carry old frames over.
+  remote_input_stream_ = RemoteInputStreamOut();
 }
 
 void SceneV1InputDeviceDelegate::DetachFromPlayer() {
@@ -200,10 +209,35 @@ void SceneV1InputDeviceDelegate::ShipBufferIfFull() {
   millisecs_t real_time = g_core->GetAppTimeMillisecs();
 
   size_t size = remote_input_commands_buffer_.size();
-  if (size > 2
-      && (static_cast<int>(real_time - last_remote_input_commands_send_time_)
-              >= appmode->buffer_time()
-          || size > 400)) {
+  auto since_send =
+      static_cast<int>(real_time - last_remote_input_commands_send_time_);
+
+  // If the host supports it, ship commands as numbered frames over the
+  // unsequenced path; each message carries the last few frames so a lost
+  // packet doesn't stall everything behind a reliable re-send.
+  if (appmode->unreliable_remote_input() && hc->supports_unreliable_input()) {
+    int device_index = input_device().index();
+    if (size > 2 && (since_send >= appmode->buffer_time() || size > 400)) {
+      last_remote_input_commands_send_time_ = real_time;
+      remote_input_stream_.AddFrame(
+          hc->NextRemoteInputFrameSeq(device_index),
+          remote_input_commands_buffer_.data() + 2, size - 2);
+      hc->SendUnsequencedMessage(
+          remote_input_stream_.BuildMessage(device_index));
+      remote_input_commands_buffer_.clear();
+    } else if (remote_input_stream_.ShouldResend()
+               && since_send >= std::max(appmode->buffer_time(),
+                                         kRemoteInputResendInterval)) {
+      // Keep our last frame going out a few more times even without new
+      // input so its loss can still be covered.
+      last_remote_input_commands_send_time_ = real_time;
+      hc->SendUnsequencedMessage(
+          remote_input_stream_.BuildMessage(device_index));
+    }
+    return;
+  }
+
+  if (size > 2 && (since_send >= appmode->buffer_time() || size > 400)) {
     last_remote_input_commands_send_time_ = real_time;
     hc->SendReliableMessage(remote_input_commands_buffer_);
     remote_input_commands_buffer_.clear();
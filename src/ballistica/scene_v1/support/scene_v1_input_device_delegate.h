@@ -4,6 +4,7 @@
 #define BALLISTICA_SCENE_V1_SUPPORT_SCENE_V1_INPUT_DEVICE_DELEGATE_H_
 
 #include "ballistica/base/input/device/input_device_delegate.h"
+#include "ballistica/scene_v1/connection/remote_input_stream.h"
 #include "ballistica/scene_v1/support/player.h"
 
 namespace ballistica::scene_v1 {
@@ -73,6 +74,7 @@ class SceneV1InputDeviceDelegate : public base::InputDeviceDelegate {
 
   millisecs_t last_remote_input_commands_send_time_{};
   std::vector<uint8_t> remote_input_commands_buffer_;
+  RemoteInputStreamOut remote_input_stream_;
   int remote_player_id_{-1};
 
   BA_DISALLOW_CLASS_COPIES(SceneV1InputDeviceDelegate);
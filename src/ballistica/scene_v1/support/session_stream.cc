@@ -2,8 +2,14 @@
 
 #include "ballistica/scene_v1/support/session_stream.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "ballistica/base/assets/assets_server.h"
 #include "ballistica/base/dynamics/bg/bg_dynamics.h"
+#include "ballistica/base/graphics/graphics.h"
+#include "ballistica/base/graphics/support/area_of_interest.h"
+#include "ballistica/base/graphics/support/camera.h"
 #include "ballistica/base/networking/networking.h"
 #include "ballistica/scene_v1/assets/scene_collision_mesh.h"
 #include "ballistica/scene_v1/assets/scene_data_asset.h"
@@ -16,12 +22,19 @@
 #include "ballistica/scene_v1/dynamics/material/material_component.h"
 #include "ballistica/scene_v1/node/node_attribute.h"
 #include "ballistica/scene_v1/node/node_type.h"
+#include "ballistica/scene_v1/node/player_node.h"
+#include "ballistica/scene_v1/support/client_input_device_delegate.h"
 #include "ballistica/scene_v1/support/host_session.h"
+#include "ballistica/scene_v1/support/player.h"
 #include "ballistica/scene_v1/support/scene.h"
 #include "ballistica/scene_v1/support/scene_v1_app_mode.h"
 
 namespace ballistica::scene_v1 {
 
+// Clients at send-levels above these go without these cosmetic commands.
+const int kBGDynamicsPriority = 1;
+const int kSoundPriority = 2;
+
 SessionStream::SessionStream(HostSession* host_session, bool save_replay)
     : app_mode_{SceneV1AppMode::GetActiveOrThrow()},
       host_session_{host_session} {
@@ -43,7 +56,8 @@ SessionStream::SessionStream(HostSession* host_session, bool save_replay)
   // take responsibility for feeding all clients to this device.
   if (host_session_) {
     auto* appmode = SceneV1AppMode::GetActiveOrThrow();
-    appmode->connections()->RegisterClientController(this);
+    appmode->connections()->RegisterClientController(
+        this, host_session_->party_id());
   }
 }
 
@@ -207,6 +221,12 @@ void SessionStream::Flush() {
   if (!out_message_.empty()) {
     ShipSessionCommandsMessage();
   }
+
+  // Also push out anything being held back for slower clients.
+  millisecs_t real_time = g_core->GetAppTimeMillisecs();
+  for (auto& connection : connections_to_clients_) {
+    FlushClient_(connection, &client_send_states_[connection], real_time);
+  }
 }
 
 // Writes just a command.
@@ -357,16 +377,155 @@ void SessionStream::WriteChars(size_t count, const char* vals) {
 
 void SessionStream::ShipSessionCommandsMessage() {
   BA_PRECONDITION(!out_message_.empty());
-
-  // Send this message to all client-connections we're attached to.
+  millisecs_t real_time = g_core->GetAppTimeMillisecs();
+
+  // Queue this message up for all client-connections we're attached to,
+  // leaving out cosmetic stuff they've got no interest in or no room for.
+  // Most clients wind up with the same bounds and send-levels, so we only
+  // rebuild the filtered message when those change.
+  bool use_bounds =
+      !cosmetic_commands_.empty() && app_mode_->interest_radius() > 0.0f;
+  bool have_filtered{};
+  bool filtered{};
+  bool filtered_bounded{};
+  int filtered_level{};
+  Vector3f filtered_min{0.0f, 0.0f, 0.0f};
+  Vector3f filtered_max{0.0f, 0.0f, 0.0f};
   for (auto& connection : connections_to_clients_) {
-    (*connection).SendReliableMessage(out_message_);
+    const std::vector<uint8_t>* message{&out_message_};
+    if (!cosmetic_commands_.empty()) {
+      Vector3f min{0.0f, 0.0f, 0.0f};
+      Vector3f max{0.0f, 0.0f, 0.0f};
+      bool bounded = use_bounds && GetInterestBounds_(connection, &min, &max);
+      int level = connection->send_level();
+      if (bounded || level > 0) {
+        if (!have_filtered || bounded != filtered_bounded
+            || level != filtered_level
+            || (bounded && (min != filtered_min || max != filtered_max))) {
+          filtered = BuildFilteredMessage_(bounded ? &min : nullptr,
+                                           bounded ? &max : nullptr, level);
+          have_filtered = true;
+          filtered_bounded = bounded;
+          filtered_level = level;
+          filtered_min = min;
+          filtered_max = max;
+        }
+        if (filtered) {
+          message = &filtered_message_;
+        }
+      }
+    }
+
+    // Merge it into whatever they've got pending; both start with the
+    // same message type.
+    auto& state{client_send_states_[connection]};
+    if (state.pending.empty()) {
+      state.pending = *message;
+    } else {
+      state.pending.insert(state.pending.end(), message->begin() + 1,
+                           message->end());
+    }
+    if (real_time - state.last_flush_time
+        >= connection->GetSendFlushInterval()) {
+      FlushClient_(connection, &state, real_time);
+    }
   }
+
+  // Replays always get everything; the camera can go anywhere in them.
   if (writing_replay_) {
     AddMessageToReplay(out_message_);
   }
   out_message_.clear();
-  last_send_time_ = g_core->GetAppTimeMillisecs();
+  cosmetic_commands_.clear();
+  last_send_time_ = real_time;
+}
+
+void SessionStream::FlushClient_(ConnectionToClient* c,
+                                 ClientSendState_* state,
+                                 millisecs_t real_time) {
+  state->last_flush_time = real_time;
+  if (!state->pending.empty()) {
+    c->SendReliableMessage(state->pending);
+    state->pending.clear();
+  }
+}
+
+auto SessionStream::GetInterestBounds_(ConnectionToClient* c, Vector3f* min,
+                                       Vector3f* max) -> bool {
+  assert(host_session_);
+
+  // Client cameras frame the same areas of interest ours does (the attrs
+  // driving them are part of the stream), so everything on screen for
+  // them lies within the box around those.
+  base::Camera* camera = g_base->graphics->camera();
+  if (camera == nullptr || camera->mode() != base::CameraMode::kFollow) {
+    return false;
+  }
+  bool have_any{};
+  auto add_sphere = [min, max, &have_any](const Vector3f& pos, float radius) {
+    Vector3f sphere_min{pos.x - radius, pos.y - radius, pos.z - radius};
+    Vector3f sphere_max{pos.x + radius, pos.y + radius, pos.z + radius};
+    if (!have_any) {
+      *min = sphere_min;
+      *max = sphere_max;
+      have_any = true;
+      return;
+    }
+    *min = {std::min(min->x, sphere_min.x), std::min(min->y, sphere_min.y),
+            std::min(min->z, sphere_min.z)};
+    *max = {std::max(max->x, sphere_max.x), std::max(max->y, sphere_max.y),
+            std::max(max->z, sphere_max.z)};
+  };
+  for (auto&& aoi : camera->areas_of_interest()) {
+    add_sphere(aoi.position(), aoi.radius());
+  }
+
+  // Always include the client's own players too, whatever they're up to.
+  for (auto&& player : host_session_->players()) {
+    auto* delegate = dynamic_cast<ClientInputDeviceDelegate*>(
+        player->input_device_delegate());
+    if (delegate && delegate->connection_to_client() == c) {
+      if (auto* node = dynamic_cast<PlayerNode*>(player->node())) {
+        add_sphere(Vector3f(node->position()), 0.0f);
+      }
+    }
+  }
+  if (!have_any) {
+    return false;
+  }
+  float radius = app_mode_->interest_radius();
+  *min -= Vector3f(radius, radius, radius);
+  *max += Vector3f(radius, radius, radius);
+  return true;
+}
+
+auto SessionStream::BuildFilteredMessage_(const Vector3f* min,
+                                          const Vector3f* max,
+                                          int send_level) -> bool {
+  filtered_message_.clear();
+  size_t copied{};
+  for (auto&& cmd : cosmetic_commands_) {
+    const Vector3f& p{cmd.position};
+    if (send_level <= cmd.priority
+        && (min == nullptr
+            || (p.x >= min->x && p.y >= min->y && p.z >= min->z
+                && p.x <= max->x && p.y <= max->y && p.z <= max->z))) {
+      continue;
+    }
+    filtered_message_.insert(filtered_message_.end(),
+                             out_message_.begin() + copied,
+                             out_message_.begin() + cmd.offset);
+    copied = cmd.offset + cmd.size;
+  }
+
+  // Commands always follow the message-type byte, so this means nothing
+  // was left out.
+  if (copied == 0) {
+    return false;
+  }
+  filtered_message_.insert(filtered_message_.end(),
+                           out_message_.begin() + copied, out_message_.end());
+  return true;
 }
 
 void SessionStream::AddMessageToReplay(const std::vector<uint8_t>& message) {
@@ -394,16 +553,60 @@ void SessionStream::SendPhysicsCorrection(bool blend) {
 
   std::vector<std::vector<uint8_t> > messages;
   host_session_->GetCorrectionMessages(blend, &messages);
+  millisecs_t real_time = g_core->GetAppTimeMillisecs();
 
   // FIXME - have to send reliably at the moment since these will most likely be
   //  bigger than our unreliable packet limit. :-(
-  for (auto& message : messages) {
-    for (auto& connections_to_client : connections_to_clients_) {
-      (*connections_to_client).SendReliableMessage(message);
+  for (auto& connection : connections_to_clients_) {
+    // Corrections account for all commands so far, so anything pending
+    // needs to go out first.
+    auto& state{client_send_states_[connection]};
+    FlushClient_(connection, &state, real_time);
+    for (auto& message : messages) {
+      connection->SendReliableMessage(message);
     }
-    if (writing_replay_) {
+    state.last_correction_time = real_time;
+  }
+  if (writing_replay_) {
+    for (auto& message : messages) {
+      AddMessageToReplay(message);
+    }
+  }
+  last_physics_correction_time_ = real_time;
+}
+
+void SessionStream::SendScheduledPhysicsCorrections_(millisecs_t real_time) {
+  // Clients each get corrections at their own rate; replays at the base
+  // rate. Corrections are only built when someone is due for them.
+  std::vector<ConnectionToClient*> due;
+  for (auto& connection : connections_to_clients_) {
+    if (real_time - client_send_states_[connection].last_correction_time
+        >= connection->GetSendCorrectionInterval()) {
+      due.push_back(connection);
+    }
+  }
+  bool replay_due =
+      writing_replay_
+      && real_time - last_physics_correction_time_
+             >= app_mode_->dynamics_sync_time();
+  if (due.empty() && !replay_due) {
+    return;
+  }
+  std::vector<std::vector<uint8_t> > messages;
+  host_session_->GetCorrectionMessages(true, &messages);
+  for (auto* connection : due) {
+    auto& state{client_send_states_[connection]};
+    FlushClient_(connection, &state, real_time);
+    for (auto& message : messages) {
+      connection->SendReliableMessage(message);
+    }
+    state.last_correction_time = real_time;
+  }
+  if (replay_due) {
+    for (auto& message : messages) {
       AddMessageToReplay(message);
     }
+    last_physics_correction_time_ = real_time;
   }
 }
 
@@ -427,11 +630,17 @@ void SessionStream::EndCommand(bool is_time_set) {
   memcpy(&(out_message_[out_message_size]), &val, 2);
   memcpy(&(out_message_[out_message_size + 2]), &(out_command_[0]),
          out_command_.size());
+  if (out_command_cosmetic_) {
+    cosmetic_commands_.push_back({static_cast<size_t>(out_message_size),
+                                  2 + out_command_.size(),
+                                  out_command_position_,
+                                  out_command_priority_});
+    out_command_cosmetic_ = false;
+  }
 
   // When attached to a host-session, send this message to clients if it's been
   // long enough. Also send off occasional correction packets.
   if (host_session_) {
-    auto* appmode = SceneV1AppMode::GetSingleton();
     // Now if its been long enough *AND* this is a time-step command, send.
     millisecs_t real_time = g_core->GetAppTimeMillisecs();
     millisecs_t diff = real_time - last_send_time_;
@@ -443,12 +652,9 @@ void SessionStream::EndCommand(bool is_time_set) {
 
       // IMPORTANT: We only do this right after shipping off our pending session
       // commands; otherwise the client will get the correction that accounts
-      // for commands that they haven't been sent yet.
-      diff = real_time - last_physics_correction_time_;
-      if (diff >= appmode->dynamics_sync_time()) {
-        last_physics_correction_time_ = real_time;
-        SendPhysicsCorrection(true);
-      }
+      // for commands that they haven't been sent yet. (Clients whose commands
+      // are still being held back get them flushed first).
+      SendScheduledPhysicsCorrections_(real_time);
     }
   }
   out_command_.clear();
@@ -596,6 +802,7 @@ void SessionStream::SetForegroundScene(Scene* sg) {
 void SessionStream::RemoveNode(Node* n) {
   assert(IsValidNode(n));
   WriteCommandInt64(SessionCommand::kRemoveNode, n->stream_id());
+  last_attr_values_.erase(n->stream_id());
   Remove(n, &nodes_, &free_indices_nodes_);
   EndCommand();
 }
@@ -764,6 +971,12 @@ void SessionStream::ConnectNodeAttribute(Node* src_node,
                       src_node->stream_id(), src_attr->index(),
                       dst_node->stream_id(), dst_attr->index());
   EndCommand();
+
+  // The connection drives the dst value from here on.
+  auto i = last_attr_values_.find(dst_node->stream_id());
+  if (i != last_attr_values_.end()) {
+    i->second.erase(dst_attr->index());
+  }
 }
 
 void SessionStream::NodeMessage(Node* node, const char* buffer, size_t size) {
@@ -775,8 +988,30 @@ void SessionStream::NodeMessage(Node* node, const char* buffer, size_t size) {
   EndCommand();
 }
 
+template <typename F>
+auto SessionStream::IsRedundantAttrSet(const NodeAttribute& attr,
+                                       const void* data, size_t size,
+                                       const F& host_value_matches) -> bool {
+  auto& node_values{last_attr_values_[attr.node->stream_id()]};
+  auto i = node_values.find(attr.index());
+  if (i != node_values.end() && i->second.size() == size
+      && (size == 0 || memcmp(i->second.data(), data, size) == 0)
+      && !attr.node->attribute_connections_incoming().count(attr.index())
+      && host_value_matches()) {
+    return true;
+  }
+  node_values[attr.index()].assign(static_cast<const char*>(data), size);
+  return false;
+}
+
 void SessionStream::SetNodeAttr(const NodeAttribute& attr, float val) {
   assert(IsValidNode(attr.node));
+  if (IsRedundantAttrSet(attr, &val, sizeof(val), [&] {
+        float cur = attr.GetAsFloat();
+        return memcmp(&cur, &val, sizeof(val)) == 0;
+      })) {
+    return;
+  }
   WriteCommandInt64_2(SessionCommand::kSetNodeAttrFloat, attr.node->stream_id(),
                       attr.index());
   WriteFloat(val);
@@ -785,6 +1020,10 @@ void SessionStream::SetNodeAttr(const NodeAttribute& attr, float val) {
 
 void SessionStream::SetNodeAttr(const NodeAttribute& attr, int64_t val) {
   assert(IsValidNode(attr.node));
+  if (IsRedundantAttrSet(attr, &val, sizeof(val),
+                         [&] { return attr.GetAsInt() == val; })) {
+    return;
+  }
   WriteCommandInt64_3(SessionCommand::kSetNodeAttrInt32, attr.node->stream_id(),
                       attr.index(), val);
   EndCommand();
@@ -792,6 +1031,10 @@ void SessionStream::SetNodeAttr(const NodeAttribute& attr, int64_t val) {
 
 void SessionStream::SetNodeAttr(const NodeAttribute& attr, bool val) {
   assert(IsValidNode(attr.node));
+  if (IsRedundantAttrSet(attr, &val, sizeof(val),
+                         [&] { return attr.GetAsBool() == val; })) {
+    return;
+  }
   WriteCommandInt64_3(SessionCommand::kSetNodeAttrBool, attr.node->stream_id(),
                       attr.index(), val);
   EndCommand();
@@ -800,6 +1043,16 @@ void SessionStream::SetNodeAttr(const NodeAttribute& attr, bool val) {
 void SessionStream::SetNodeAttr(const NodeAttribute& attr,
                                 const std::vector<float>& vals) {
   assert(IsValidNode(attr.node));
+  if (IsRedundantAttrSet(attr, vals.data(), vals.size() * sizeof(float), [&] {
+        auto cur = attr.GetAsFloats();
+        return cur.size() == vals.size()
+               && (cur.empty()
+                   || memcmp(cur.data(), vals.data(),
+                             cur.size() * sizeof(float))
+                          == 0);
+      })) {
+    return;
+  }
   size_t count{vals.size()};
   WriteCommandInt64_3(SessionCommand::kSetNodeAttrFloats,
                       attr.node->stream_id(), attr.index(),
@@ -813,6 +1066,10 @@ void SessionStream::SetNodeAttr(const NodeAttribute& attr,
 void SessionStream::SetNodeAttr(const NodeAttribute& attr,
                                 const std::vector<int64_t>& vals) {
   assert(IsValidNode(attr.node));
+  if (IsRedundantAttrSet(attr, vals.data(), vals.size() * sizeof(int64_t),
+                         [&] { return attr.GetAsInts() == vals; })) {
+    return;
+  }
   size_t count{vals.size()};
   WriteCommandInt64_3(SessionCommand::kSetNodeAttrInt32s,
                       attr.node->stream_id(), attr.index(),
@@ -826,6 +1083,10 @@ void SessionStream::SetNodeAttr(const NodeAttribute& attr,
 void SessionStream::SetNodeAttr(const NodeAttribute& attr,
                                 const std::string& val) {
   assert(IsValidNode(attr.node));
+  if (IsRedundantAttrSet(attr, val.data(), val.size(),
+                         [&] { return attr.GetAsString() == val; })) {
+    return;
+  }
   WriteCommandInt64_2(SessionCommand::kSetNodeAttrString,
                       attr.node->stream_id(), attr.index());
   WriteString(val);
@@ -1101,6 +1362,9 @@ void SessionStream::PlaySoundAtPosition(SceneSound* sound, float volume,
   WriteFloat(x);
   WriteFloat(y);
   WriteFloat(z);
+  out_command_cosmetic_ = static_cast<bool>(host_session_);
+  out_command_priority_ = kSoundPriority;
+  out_command_position_ = {x, y, z};
   EndCommand();
 }
 
@@ -1119,6 +1383,9 @@ void SessionStream::EmitBGDynamics(const base::BGDynamicsEmission& e) {
   fvals[6] = e.scale;
   fvals[7] = e.spread;
   WriteFloats(8, fvals);
+  out_command_cosmetic_ = static_cast<bool>(host_session_);
+  out_command_priority_ = kBGDynamicsPriority;
+  out_command_position_ = e.position;
   EndCommand();
 }
 
@@ -1241,6 +1508,13 @@ void SessionStream::OnClientDisconnected(ConnectionToClient* c) {
   for (auto i = connections_to_clients_.begin();
        i != connections_to_clients_.end(); i++) {
     if (*i == c) {
+      // Anything we're holding back needs to go out before whatever they
+      // get sent next (a reset for a new controller, etc).
+      auto state = client_send_states_.find(c);
+      if (state != client_send_states_.end()) {
+        FlushClient_(c, &state->second, g_core->GetAppTimeMillisecs());
+        client_send_states_.erase(state);
+      }
       connections_to_clients_.erase(i);
       return;
     }
@@ -4,11 +4,13 @@
 #define BALLISTICA_SCENE_V1_SUPPORT_SESSION_STREAM_H_
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "ballistica/base/base.h"
 #include "ballistica/scene_v1/support/client_controller_interface.h"
 #include "ballistica/shared/foundation/object.h"
+#include "ballistica/shared/math/vector3f.h"
 
 namespace ballistica::scene_v1 {
 
@@ -92,11 +94,41 @@ class SessionStream : public Object, public ClientControllerInterface {
   auto IsValidCollisionMesh(SceneCollisionMesh* val) -> bool;
   auto IsValidMaterial(Material* val) -> bool;
 
+  // Returns true if a set of an attr to the provided value can be left out
+  // of the stream: the attr already holds the value on our end, nothing
+  // is driving it through a connection, and the last value we sent for it
+  // was bit-identical. Otherwise records the value as the last one sent.
+  template <typename F>
+  auto IsRedundantAttrSet(const NodeAttribute& attr, const void* data,
+                          size_t size, const F& host_value_matches) -> bool;
+
   void Flush();
   void AddMessageToReplay(const std::vector<uint8_t>& message);
   void Fail();
 
   void ShipSessionCommandsMessage();
+  void SendScheduledPhysicsCorrections_(millisecs_t real_time);
+
+  /// Get the box a client is interested in; cosmetic events outside of it
+  /// (plus our interest-radius) can be left out of its stream. Returns
+  /// false if everything is of interest.
+  auto GetInterestBounds_(ConnectionToClient* c, Vector3f* min,
+                          Vector3f* max) -> bool;
+
+  /// Fill filtered_message_ with out_message_ minus any cosmetic commands
+  /// outside the given box (if any) or below the priority a send-level
+  /// calls for. Returns false if nothing was left out.
+  auto BuildFilteredMessage_(const Vector3f* min, const Vector3f* max,
+                             int send_level) -> bool;
+
+  struct ClientSendState_ {
+    // Session-commands messages not yet sent, merged into one.
+    std::vector<uint8_t> pending;
+    millisecs_t last_flush_time{};
+    millisecs_t last_correction_time{};
+  };
+  void FlushClient_(ConnectionToClient* c, ClientSendState_* state,
+                    millisecs_t real_time);
   void SendPhysicsCorrection(bool blend);
   void EndCommand(bool is_time_set = false);
   void WriteString(const std::string& s);
@@ -136,16 +168,40 @@ class SessionStream : public Object, public ClientControllerInterface {
 
   // The complete message full of commands.
   std::vector<uint8_t> out_message_;
+
+  // Positional cosmetic commands (sounds and bg-dynamics emissions) in
+  // out_message_ which clients not interested in them can go without.
+  // Clients at send-levels above a command's priority go without too.
+  struct CosmeticCommand_ {
+    size_t offset;
+    size_t size;
+    Vector3f position;
+    int priority;
+  };
+  std::vector<CosmeticCommand_> cosmetic_commands_;
+  bool out_command_cosmetic_{};
+  int out_command_priority_{};
+  Vector3f out_command_position_{0.0f, 0.0f, 0.0f};
+  std::vector<uint8_t> filtered_message_;
+  std::unordered_map<ConnectionToClient*, ClientSendState_>
+      client_send_states_;
   std::vector<ConnectionToClient*> connections_to_clients_;
   std::vector<ConnectionToClient*> connections_to_clients_ignored_;
   SceneV1AppMode* app_mode_;
   bool writing_replay_{};
+  // When we last added corrections to our replay (clients each track
+  // their own in their send-states).
   millisecs_t last_physics_correction_time_{};
   millisecs_t last_send_time_{};
   millisecs_t time_{};
   std::vector<Scene*> scenes_;
   std::vector<size_t> free_indices_scene_graphs_;
   std::vector<Node*> nodes_;
+
+  // Raw bits of the last plain-value attr sets sent per node stream-id and
+  // attr index.
+  std::unordered_map<int64_t, std::unordered_map<int, std::string> >
+      last_attr_values_;
   std::vector<size_t> free_indices_nodes_;
   std::vector<Material*> materials_;
   std::vector<size_t> free_indices_materials_;
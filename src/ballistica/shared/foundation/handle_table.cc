@@ -0,0 +1,111 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/shared/foundation/handle_table.h"
+
+#include <cstdio>
+#include <vector>
+
+#include "ballistica/core/platform/core_platform.h"
+#include "ballistica/shared/ballistica.h"
+#include "ballistica/shared/foundation/object.h"
+
+namespace ballistica {
+
+// Something to point refs at; usable through either kind of ref.
+class BenchmarkTarget_ : public Object {
+ public:
+  explicit BenchmarkTarget_(int value) : value_(value) {}
+  auto value() const -> int { return value_; }
+  auto handle_slot() const -> const HandleSlot<BenchmarkTarget_>& {
+    return handle_slot_;
+  }
+
+ private:
+  int value_;
+  HandleSlot<BenchmarkTarget_> handle_slot_{this};
+};
+
+auto RunHandleBenchmark(int iterations) -> std::string {
+  BA_PRECONDITION(iterations > 0);
+
+  // A rough approximation of scene use: a few thousand live objects with
+  // a handful of refs each scattered around, read over and over, and then
+  // everything dying with its refs still around.
+  constexpr int kObjectCount = 4096;
+  constexpr int kRefsPerObject = 8;
+  constexpr int kRefCount = kObjectCount * kRefsPerObject;
+
+  struct Times {
+    microsecs_t make;
+    microsecs_t resolve;
+    microsecs_t kill;
+    int64_t checksum;
+  };
+
+  auto run = [&](auto* refs) -> Times {
+    Times times{};
+    std::vector<Object::Ref<BenchmarkTarget_> > objects;
+    objects.reserve(kObjectCount);
+    for (int i = 0; i < kObjectCount; ++i) {
+      objects.push_back(Object::New<BenchmarkTarget_>(i));
+    }
+    uint32_t seed = 12345;
+    auto next_rand = [&seed] {
+      seed = seed * 1664525u + 1013904223u;
+      return seed >> 8;
+    };
+
+    auto start = core::CorePlatform::GetCurrentMicrosecs();
+    refs->resize(kRefCount);
+    for (auto&& ref : *refs) {
+      ref = objects[next_rand() % kObjectCount].Get();
+    }
+    times.make = core::CorePlatform::GetCurrentMicrosecs() - start;
+
+    start = core::CorePlatform::GetCurrentMicrosecs();
+    for (int i = 0; i < iterations; ++i) {
+      for (auto&& ref : *refs) {
+        if (auto* obj = ref.Get()) {
+          times.checksum += obj->value();
+        }
+      }
+    }
+    times.resolve = core::CorePlatform::GetCurrentMicrosecs() - start;
+
+    start = core::CorePlatform::GetCurrentMicrosecs();
+    objects.clear();
+    times.kill = core::CorePlatform::GetCurrentMicrosecs() - start;
+
+    for (auto&& ref : *refs) {
+      BA_PRECONDITION(!ref.Exists());
+    }
+    refs->clear();
+    return times;
+  };
+
+  std::vector<Object::WeakRef<BenchmarkTarget_> > weak_refs;
+  std::vector<Handle<BenchmarkTarget_> > handles;
+  auto weak_ref_times = run(&weak_refs);
+  auto handle_times = run(&handles);
+  BA_PRECONDITION(weak_ref_times.checksum == handle_times.checksum);
+
+  char buffer[512];
+  snprintf(buffer, sizeof(buffer),
+           "Handle benchmark (%d objects, %d refs, %d passes):"
+           " make weakref=%lldus handle=%lldus;"
+           " resolve weakref=%lldus handle=%lldus;"
+           " kill weakref=%lldus handle=%lldus;"
+           " size weakref=%zuB handle=%zuB.",
+           kObjectCount, kRefCount, iterations,
+           static_cast<long long>(weak_ref_times.make),     // NOLINT
+           static_cast<long long>(handle_times.make),       // NOLINT
+           static_cast<long long>(weak_ref_times.resolve),  // NOLINT
+           static_cast<long long>(handle_times.resolve),    // NOLINT
+           static_cast<long long>(weak_ref_times.kill),     // NOLINT
+           static_cast<long long>(handle_times.kill),       // NOLINT
+           sizeof(Object::WeakRef<BenchmarkTarget_>),
+           sizeof(Handle<BenchmarkTarget_>));
+  return buffer;
+}
+
+}  // namespace ballistica
@@ -0,0 +1,718 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/shared/generic/json_arena.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "ballistica/core/platform/core_platform.h"
+#include "ballistica/shared/ballistica.h"
+
+namespace ballistica {
+
+// Parses into cJSON nodes allocated from an arena, unescaping strings
+// within the input buffer itself. Accepts exactly what cJSON_Parse() does
+// (including trailing garbage after the value, which cJSON ignores).
+class InPlaceParser_ {
+ public:
+  InPlaceParser_(JsonArena* arena, char* text) : arena_(arena), p_(text) {}
+
+  auto Run() -> cJSON* {
+    // cJSON skips a UTF-8 byte-order-mark; so do we.
+    if (strncmp(p_, "\xEF\xBB\xBF", 3) == 0) {
+      p_ += 3;
+    }
+    SkipSpace_();
+    return ParseValue_(0);
+  }
+
+ private:
+  auto NewItem_(int type) -> cJSON* {
+    auto* item = static_cast<cJSON*>(arena_->Alloc(sizeof(cJSON)));
+    memset(item, 0, sizeof(cJSON));
+    item->type = type;
+    return item;
+  }
+
+  void SkipSpace_() {
+    while (*p_ != 0 && static_cast<unsigned char>(*p_) <= 32) {
+      ++p_;
+    }
+  }
+
+  auto ParseValue_(int depth) -> cJSON* {
+    switch (*p_) {
+      case 'n':
+        if (strncmp(p_, "null", 4) == 0) {
+          p_ += 4;
+          return NewItem_(cJSON_NULL);
+        }
+        return nullptr;
+      case 'f':
+        if (strncmp(p_, "false", 5) == 0) {
+          p_ += 5;
+          return NewItem_(cJSON_False);
+        }
+        return nullptr;
+      case 't':
+        if (strncmp(p_, "true", 4) == 0) {
+          p_ += 4;
+          auto* item = NewItem_(cJSON_True);
+          item->valueint = 1;
+          return item;
+        }
+        return nullptr;
+      case '"': {
+        char* val = ParseString_();
+        if (val == nullptr) {
+          return nullptr;
+        }
+        auto* item = NewItem_(cJSON_String);
+        item->valuestring = val;
+        return item;
+      }
+      case '[':
+        return ParseArray_(depth);
+      case '{':
+        return ParseObject_(depth);
+      default:
+        if (*p_ == '-' || (*p_ >= '0' && *p_ <= '9')) {
+          return ParseNumber_();
+        }
+        return nullptr;
+    }
+  }
+
+  auto ParseNumber_() -> cJSON* {
+    // Like cJSON, take the run of number-ish chars and hand it to strtod
+    // (temporarily terminating it so strtod can't see past it).
+    char* end = p_;
+    while ((*end >= '0' && *end <= '9') || *end == '+' || *end == '-'
+           || *end == 'e' || *end == 'E' || *end == '.') {
+      ++end;
+    }
+    char saved = *end;
+    *end = 0;
+    char* parsed_end{};
+    double number = strtod(p_, &parsed_end);
+    *end = saved;
+    if (parsed_end == p_) {
+      return nullptr;
+    }
+    p_ = parsed_end;
+    auto* item = NewItem_(cJSON_Number);
+    item->valuedouble = number;
+    if (number >= INT_MAX) {
+      item->valueint = INT_MAX;
+    } else if (number <= static_cast<double>(INT_MIN)) {
+      item->valueint = INT_MIN;
+    } else {
+      item->valueint = static_cast<int>(number);
+    }
+    return item;
+  }
+
+  static auto ParseHex4_(const char* s, unsigned* out) -> bool {
+    unsigned val{};
+    for (int i = 0; i < 4; ++i) {
+      char c = s[i];
+      val <<= 4;
+      if (c >= '0' && c <= '9') {
+        val += static_cast<unsigned>(c - '0');
+      } else if (c >= 'a' && c <= 'f') {
+        val += static_cast<unsigned>(10 + c - 'a');
+      } else if (c >= 'A' && c <= 'F') {
+        val += static_cast<unsigned>(10 + c - 'A');
+      } else {
+        return false;
+      }
+    }
+    *out = val;
+    return true;
+  }
+
+  // Decode a \u escape (or surrogate pair of them) at p_ into out,
+  // advancing both. UTF-8 output is never longer than the escape text, so
+  // this is safe to do in place.
+  auto DecodeUTF16Escape_(char** out) -> bool {
+    unsigned code{};
+    if (!ParseHex4_(p_ + 2, &code)) {
+      return false;
+    }
+    p_ += 6;
+    if (code >= 0xDC00 && code <= 0xDFFF) {
+      return false;  // Lone low surrogate.
+    }
+    if (code >= 0xD800 && code <= 0xDBFF) {
+      unsigned low{};
+      if (p_[0] != '\\' || p_[1] != 'u' || !ParseHex4_(p_ + 2, &low)
+          || low < 0xDC00 || low > 0xDFFF) {
+        return false;
+      }
+      p_ += 6;
+      code = 0x10000 + (((code & 0x3FF) << 10) | (low & 0x3FF));
+    }
+    char*& o{*out};
+    if (code < 0x80) {
+      *o++ = static_cast<char>(code);
+    } else if (code < 0x800) {
+      *o++ = static_cast<char>(0xC0 | (code >> 6));
+      *o++ = static_cast<char>(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+      *o++ = static_cast<char>(0xE0 | (code >> 12));
+      *o++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+      *o++ = static_cast<char>(0x80 | (code & 0x3F));
+    } else {
+      *o++ = static_cast<char>(0xF0 | (code >> 18));
+      *o++ = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+      *o++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+      *o++ = static_cast<char>(0x80 | (code & 0x3F));
+    }
+    return true;
+  }
+
+  // Expects p_ at an opening quote; returns the unescaped, terminated
+  // string (which lives in the input buffer).
+  auto ParseString_() -> char* {
+    ++p_;
+    char* start = p_;
+    char* out = p_;
+    while (true) {
+      char c = *p_;
+      if (c == 0) {
+        return nullptr;
+      }
+      if (c == '"') {
+        break;
+      }
+      if (c != '\\') {
+        *out++ = c;
+        ++p_;
+        continue;
+      }
+      switch (p_[1]) {
+        case 'b':
+          *out++ = '\b';
+          break;
+        case 'f':
+          *out++ = '\f';
+          break;
+        case 'n':
+          *out++ = '\n';
+          break;
+        case 'r':
+          *out++ = '\r';
+          break;
+        case 't':
+          *out++ = '\t';
+          break;
+        case '"':
+        case '\\':
+        case '/':
+          *out++ = p_[1];
+          break;
+        case 'u':
+          if (!DecodeUTF16Escape_(&out)) {
+            return nullptr;
+          }
+          continue;
+        default:
+          return nullptr;
+      }
+      p_ += 2;
+    }
+    // Step past the closing quote before terminating; out may be sitting
+    // right on it.
+    ++p_;
+    *out = 0;
+    return start;
+  }
+
+  auto ParseArray_(int depth) -> cJSON* {
+    if (depth >= CJSON_NESTING_LIMIT) {
+      return nullptr;
+    }
+    ++p_;
+    auto* array = NewItem_(cJSON_Array);
+    SkipSpace_();
+    if (*p_ == ']') {
+      ++p_;
+      return array;
+    }
+    cJSON* tail{};
+    while (true) {
+      SkipSpace_();
+      cJSON* item = ParseValue_(depth + 1);
+      if (item == nullptr) {
+        return nullptr;
+      }
+      Link_(array, &tail, item);
+      SkipSpace_();
+      if (*p_ == ',') {
+        ++p_;
+      } else if (*p_ == ']') {
+        ++p_;
+        return array;
+      } else {
+        return nullptr;
+      }
+    }
+  }
+
+  auto ParseObject_(int depth) -> cJSON* {
+    if (depth >= CJSON_NESTING_LIMIT) {
+      return nullptr;
+    }
+    ++p_;
+    auto* object = NewItem_(cJSON_Object);
+    SkipSpace_();
+    if (*p_ == '}') {
+      ++p_;
+      return object;
+    }
+    cJSON* tail{};
+    while (true) {
+      SkipSpace_();
+      if (*p_ != '"') {
+        return nullptr;
+      }
+      char* key = ParseString_();
+      if (key == nullptr) {
+        return nullptr;
+      }
+      SkipSpace_();
+      if (*p_ != ':') {
+        return nullptr;
+      }
+      ++p_;
+      SkipSpace_();
+      cJSON* item = ParseValue_(depth + 1);
+      if (item == nullptr) {
+        return nullptr;
+      }
+      item->string = key;
+      Link_(object, &tail, item);
+      SkipSpace_();
+      if (*p_ == ',') {
+        ++p_;
+      } else if (*p_ == '}') {
+        ++p_;
+        return object;
+      } else {
+        return nullptr;
+      }
+    }
+  }
+
+  // Append to a child list the way cJSON lays them out (the head's prev
+  // points at the tail).
+  static void Link_(cJSON* parent, cJSON** tail, cJSON* item) {
+    if (*tail == nullptr) {
+      parent->child = item;
+    } else {
+      (*tail)->next = item;
+      item->prev = *tail;
+    }
+    *tail = item;
+    parent->child->prev = item;
+  }
+
+  JsonArena* arena_;
+  char* p_;
+};
+
+JsonArena::JsonArena(size_t block_size) : block_size_(block_size) {}
+
+JsonArena::~JsonArena() = default;
+
+auto JsonArena::Parse(char* text) -> cJSON* {
+  assert(text);
+  return InPlaceParser_(this, text).Run();
+}
+
+auto JsonArena::ParseCopy(const char* text, size_t length) -> cJSON* {
+  assert(text);
+  auto* copy = static_cast<char*>(Alloc(length + 1));
+  memcpy(copy, text, length);
+  copy[length] = 0;
+  return InPlaceParser_(this, copy).Run();
+}
+
+void JsonArena::Reset() {
+  block_index_ = 0;
+  block_offset_ = 0;
+}
+
+auto JsonArena::Alloc(size_t size) -> void* {
+  size = (size + 7) & ~static_cast<size_t>(7);
+  while (block_index_ < blocks_.size()) {
+    auto& block{blocks_[block_index_]};
+    if (block_offset_ + size <= block.second) {
+      void* ptr = block.first.get() + block_offset_;
+      block_offset_ += size;
+      return ptr;
+    }
+    ++block_index_;
+    block_offset_ = 0;
+  }
+  size_t new_size = std::max(block_size_, size);
+  blocks_.emplace_back(std::unique_ptr<char[]>(new char[new_size]), new_size);
+  block_index_ = blocks_.size() - 1;
+  block_offset_ = size;
+  return blocks_.back().first.get();
+}
+
+auto JsonArena::bytes_reserved() const -> size_t {
+  size_t total{};
+  for (auto&& block : blocks_) {
+    total += block.second;
+  }
+  return total;
+}
+
+void JsonWriter::Separate_() {
+  if (after_key_) {
+    after_key_ = false;
+    return;
+  }
+  if (!first_) {
+    out_->push_back(',');
+  }
+  first_ = false;
+}
+
+void JsonWriter::Append_(const char* data, size_t size) {
+  out_->insert(out_->end(), reinterpret_cast<const uint8_t*>(data),
+               reinterpret_cast<const uint8_t*>(data) + size);
+}
+
+void JsonWriter::BeginObject() {
+  Separate_();
+  out_->push_back('{');
+  first_ = true;
+}
+
+void JsonWriter::EndObject() {
+  assert(!after_key_);
+  out_->push_back('}');
+  first_ = false;
+}
+
+void JsonWriter::BeginArray() {
+  Separate_();
+  out_->push_back('[');
+  first_ = true;
+}
+
+void JsonWriter::EndArray() {
+  out_->push_back(']');
+  first_ = false;
+}
+
+void JsonWriter::Key(const char* key) {
+  assert(!after_key_);
+  Separate_();
+  AppendString_(key);
+  out_->push_back(':');
+  after_key_ = true;
+}
+
+void JsonWriter::String(const char* val) {
+  Separate_();
+  AppendString_(val);
+}
+
+void JsonWriter::Number(double val) {
+  Separate_();
+  int int_val;
+  if (val >= INT_MAX) {
+    int_val = INT_MAX;
+  } else if (val <= static_cast<double>(INT_MIN)) {
+    int_val = INT_MIN;
+  } else {
+    int_val = static_cast<int>(val);
+  }
+  AppendNumber_(val, int_val);
+}
+
+void JsonWriter::Bool(bool val) {
+  Separate_();
+  if (val) {
+    Append_("true", 4);
+  } else {
+    Append_("false", 5);
+  }
+}
+
+void JsonWriter::Null() {
+  Separate_();
+  Append_("null", 4);
+}
+
+void JsonWriter::Value(const cJSON* item) {
+  assert(item);
+  switch (item->type & 0xFF) {
+    case cJSON_False:
+      Bool(false);
+      break;
+    case cJSON_True:
+      Bool(true);
+      break;
+    case cJSON_Number:
+      Separate_();
+      AppendNumber_(item->valuedouble, item->valueint);
+      break;
+    case cJSON_Raw:
+      Separate_();
+      if (item->valuestring) {
+        Append_(item->valuestring, strlen(item->valuestring));
+      }
+      break;
+    case cJSON_String:
+      String(item->valuestring);
+      break;
+    case cJSON_Array:
+      BeginArray();
+      for (const cJSON* child = item->child; child; child = child->next) {
+        Value(child);
+      }
+      EndArray();
+      break;
+    case cJSON_Object:
+      BeginObject();
+      for (const cJSON* child = item->child; child; child = child->next) {
+        Key(child->string);
+        Value(child);
+      }
+      EndObject();
+      break;
+    default:
+      Null();
+      break;
+  }
+}
+
+void JsonWriter::AppendNumber_(double val, int int_val) {
+  // Same rules as cJSON's print_number().
+  char buffer[26];
+  int length;
+  if (std::isnan(val) || std::isinf(val)) {
+    length = snprintf(buffer, sizeof(buffer), "null");
+  } else if (val == static_cast<double>(int_val)) {
+    length = snprintf(buffer, sizeof(buffer), "%d", int_val);
+  } else {
+    length = snprintf(buffer, sizeof(buffer), "%1.15g", val);
+    double test = strtod(buffer, nullptr);
+    double max_val = std::max(std::fabs(test), std::fabs(val));
+    if (std::fabs(test - val) > max_val * DBL_EPSILON) {
+      length = snprintf(buffer, sizeof(buffer), "%1.17g", val);
+    }
+  }
+  if (length < 0 || length >= static_cast<int>(sizeof(buffer))) {
+    Append_("null", 4);
+    return;
+  }
+  char decimal_point = localeconv()->decimal_point[0];
+  if (decimal_point != '.') {
+    std::replace(buffer, buffer + length, decimal_point, '.');
+  }
+  Append_(buffer, static_cast<size_t>(length));
+}
+
+void JsonWriter::AppendString_(const char* val) {
+  out_->push_back('"');
+  if (val != nullptr) {
+    // Copy runs of plain chars in bulk; escape the rest like cJSON does.
+    const char* run = val;
+    const char* c = val;
+    for (; *c != 0; ++c) {
+      const char* escape;
+      char u_escape[8];
+      switch (*c) {
+        case '"':
+          escape = "\\\"";
+          break;
+        case '\\':
+          escape = "\\\\";
+          break;
+        case '\b':
+          escape = "\\b";
+          break;
+        case '\f':
+          escape = "\\f";
+          break;
+        case '\n':
+          escape = "\\n";
+          break;
+        case '\r':
+          escape = "\\r";
+          break;
+        case '\t':
+          escape = "\\t";
+          break;
+        default:
+          if (static_cast<unsigned char>(*c) >= 32) {
+            continue;
+          }
+          snprintf(u_escape, sizeof(u_escape), "\\u%04x",
+                   static_cast<unsigned char>(*c));
+          escape = u_escape;
+          break;
+      }
+      Append_(run, static_cast<size_t>(c - run));
+      Append_(escape, strlen(escape));
+      run = c + 1;
+    }
+    Append_(run, static_cast<size_t>(c - run));
+  }
+  out_->push_back('"');
+}
+
+// Roughly what goes over the wire; built with cJSON and printed
+// unformatted, just as the real thing is.
+static auto BuildPlayerSpec_(int index) -> std::string {
+  cJSON* spec = cJSON_CreateObject();
+  std::string name = "Player \xee\x80\x8c" + std::to_string(index);
+  cJSON_AddStringToObject(spec, "n", name.c_str());
+  cJSON_AddStringToObject(spec, "a", "Google Play");
+  cJSON_AddStringToObject(spec, "sn", ("P" + std::to_string(index)).c_str());
+  char* out = cJSON_PrintUnformatted(spec);
+  std::string out_s = out;
+  cJSON_free(out);
+  cJSON_Delete(spec);
+  return out_s;
+}
+
+static auto BuildRosterPayload_() -> std::string {
+  cJSON* roster = cJSON_CreateArray();
+  for (int client = 0; client < 8; ++client) {
+    cJSON* client_dict = cJSON_CreateObject();
+    cJSON_AddItemToObject(
+        client_dict, "spec",
+        cJSON_CreateString(BuildPlayerSpec_(client).c_str()));
+    cJSON* player_array = cJSON_CreateArray();
+    for (int player = 0; player < 2; ++player) {
+      cJSON* player_dict = cJSON_CreateObject();
+      std::string name = "Guy \"" + std::to_string(client * 2 + player) + "\"";
+      cJSON_AddItemToObject(player_dict, "n",
+                            cJSON_CreateString(name.c_str()));
+      cJSON_AddItemToObject(
+          player_dict, "nf",
+          cJSON_CreateString(("\xee\x80\x8c" + name).c_str()));
+      cJSON_AddItemToObject(player_dict, "i",
+                            cJSON_CreateNumber(client * 2 + player));
+      cJSON_AddItemToArray(player_array, player_dict);
+    }
+    cJSON_AddItemToObject(client_dict, "p", player_array);
+    cJSON_AddItemToObject(client_dict, "i", cJSON_CreateNumber(client - 1));
+    cJSON_AddItemToArray(roster, client_dict);
+  }
+  char* out = cJSON_PrintUnformatted(roster);
+  std::string out_s = out;
+  cJSON_free(out);
+  cJSON_Delete(roster);
+  return out_s;
+}
+
+static auto BuildHandshakePayload_() -> std::string {
+  cJSON* handshake = cJSON_CreateObject();
+  cJSON_AddStringToObject(handshake, "s", BuildPlayerSpec_(0).c_str());
+  cJSON_AddStringToObject(handshake, "l", "7c1f9e3a52b04d8e");
+  char* out = cJSON_PrintUnformatted(handshake);
+  std::string out_s = out;
+  cJSON_free(out);
+  cJSON_Delete(handshake);
+  return out_s;
+}
+
+auto RunJsonBenchmark(int iterations) -> std::string {
+  struct Times {
+    microsecs_t cjson_parse{};
+    microsecs_t arena_parse{};
+    microsecs_t cjson_print{};
+    microsecs_t writer_print{};
+  };
+  auto run = [iterations](const std::string& payload) {
+    Times times;
+    auto start = core::CorePlatform::GetCurrentMicrosecs();
+    for (int i = 0; i < iterations; ++i) {
+      cJSON* root = cJSON_Parse(payload.c_str());
+      BA_PRECONDITION(root);
+      cJSON_Delete(root);
+    }
+    times.cjson_parse = core::CorePlatform::GetCurrentMicrosecs() - start;
+
+    // In-place parsing eats its input, so this includes copying it into
+    // a (reused) buffer each time, as a receive path would.
+    JsonArena arena;
+    std::vector<char> text;
+    start = core::CorePlatform::GetCurrentMicrosecs();
+    for (int i = 0; i < iterations; ++i) {
+      text.assign(payload.c_str(), payload.c_str() + payload.size() + 1);
+      arena.Reset();
+      BA_PRECONDITION(arena.Parse(text.data()));
+    }
+    times.arena_parse = core::CorePlatform::GetCurrentMicrosecs() - start;
+
+    cJSON* root = cJSON_Parse(payload.c_str());
+    start = core::CorePlatform::GetCurrentMicrosecs();
+    for (int i = 0; i < iterations; ++i) {
+      char* out = cJSON_PrintUnformatted(root);
+      BA_PRECONDITION(out);
+      cJSON_free(out);
+    }
+    times.cjson_print = core::CorePlatform::GetCurrentMicrosecs() - start;
+
+    std::vector<uint8_t> out;
+    start = core::CorePlatform::GetCurrentMicrosecs();
+    for (int i = 0; i < iterations; ++i) {
+      out.clear();
+      JsonWriter(&out).Value(root);
+    }
+    times.writer_print = core::CorePlatform::GetCurrentMicrosecs() - start;
+    cJSON_Delete(root);
+
+    // Both sides should agree with cJSON byte for byte.
+    BA_PRECONDITION(std::string(out.begin(), out.end()) == payload);
+    text.assign(payload.c_str(), payload.c_str() + payload.size() + 1);
+    arena.Reset();
+    out.clear();
+    JsonWriter(&out).Value(arena.Parse(text.data()));
+    BA_PRECONDITION(std::string(out.begin(), out.end()) == payload);
+    return times;
+  };
+
+  auto roster = BuildRosterPayload_();
+  auto handshake = BuildHandshakePayload_();
+  auto roster_times = run(roster);
+  auto handshake_times = run(handshake);
+
+  char buffer[512];
+  snprintf(buffer, sizeof(buffer),
+           "JSON benchmark (%d iterations):"
+           " roster (%zuB) parse cjson=%lldus arena=%lldus,"
+           " print cjson=%lldus writer=%lldus;"
+           " handshake (%zuB) parse cjson=%lldus arena=%lldus,"
+           " print cjson=%lldus writer=%lldus.",
+           iterations, roster.size(),
+           static_cast<long long>(roster_times.cjson_parse),      // NOLINT
+           static_cast<long long>(roster_times.arena_parse),      // NOLINT
+           static_cast<long long>(roster_times.cjson_print),      // NOLINT
+           static_cast<long long>(roster_times.writer_print),     // NOLINT
+           handshake.size(),
+           static_cast<long long>(handshake_times.cjson_parse),   // NOLINT
+           static_cast<long long>(handshake_times.arena_parse),   // NOLINT
+           static_cast<long long>(handshake_times.cjson_print),   // NOLINT
+           static_cast<long long>(handshake_times.writer_print));  // NOLINT
+  return buffer;
+}
+
+}  // namespace ballistica
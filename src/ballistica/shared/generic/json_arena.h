@@ -0,0 +1,99 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SHARED_GENERIC_JSON_ARENA_H_
+#define BALLISTICA_SHARED_GENERIC_JSON_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ballistica/shared/generic/json.h"
+
+namespace ballistica {
+
+/// A bump allocator plus in-place parser for JSON on hot paths (network
+/// messages, handshakes, etc).
+///
+/// Parsing produces ordinary cJSON nodes, so all the read-only cJSON calls
+/// (cJSON_GetObjectItem(), cJSON_IsString(), etc.) work on the results and
+/// call sites can migrate from cJSON_Parse() gradually. Nodes are carved
+/// out of the arena instead of malloc'ed one at a time, and strings are
+/// unescaped and terminated right in the input buffer instead of being
+/// copied. This means:
+///   - The input buffer is modified and must outlive the results.
+///   - Results must never be passed to cJSON_Delete() or to anything that
+///     modifies them; they all go away at once when the arena is reset or
+///     destroyed.
+/// Arenas hold onto their memory between Reset() calls, so keeping one
+/// around for repeated parses avoids heap traffic entirely.
+class JsonArena {
+ public:
+  explicit JsonArena(size_t block_size = 4096);
+  ~JsonArena();
+
+  /// Parse a null-terminated buffer in place. Returns nullptr on error.
+  auto Parse(char* text) -> cJSON*;
+
+  /// Parse text we can't modify by first copying it into the arena.
+  auto ParseCopy(const char* text, size_t length) -> cJSON*;
+
+  /// Free everything allocated since the last reset, keeping our blocks.
+  void Reset();
+
+  auto Alloc(size_t size) -> void*;
+  auto bytes_reserved() const -> size_t;
+
+ private:
+  size_t block_size_;
+  std::vector<std::pair<std::unique_ptr<char[]>, size_t> > blocks_;
+  size_t block_index_{};
+  size_t block_offset_{};
+};
+
+/// Writes JSON straight onto the end of a byte buffer, such as a message
+/// being assembled for sending. Output is compact and byte-for-byte what
+/// cJSON_PrintUnformatted() would produce for the same values. Nothing is
+/// allocated beyond the buffer's own growth, so a reused buffer costs
+/// nothing at all.
+class JsonWriter {
+ public:
+  explicit JsonWriter(std::vector<uint8_t>* out) : out_(out) {}
+
+  void BeginObject();
+  void EndObject();
+  void BeginArray();
+  void EndArray();
+
+  /// Write an object key; the next call must write its value.
+  void Key(const char* key);
+
+  void String(const char* val);
+  void String(const std::string& val) { String(val.c_str()); }
+  void Number(double val);
+  void Bool(bool val);
+  void Null();
+
+  /// Write an existing cJSON tree (however it was created).
+  void Value(const cJSON* item);
+
+ private:
+  void Separate_();
+  void Append_(const char* data, size_t size);
+  void AppendNumber_(double val, int int_val);
+  void AppendString_(const char* val);
+
+  std::vector<uint8_t>* out_;
+  bool first_{true};
+  bool after_key_{};
+};
+
+/// Time cJSON against JsonArena/JsonWriter parsing and printing roster and
+/// handshake payloads, returning a summary.
+auto RunJsonBenchmark(int iterations) -> std::string;
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_SHARED_GENERIC_JSON_ARENA_H_
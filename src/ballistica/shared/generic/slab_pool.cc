@@ -0,0 +1,207 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/shared/generic/slab_pool.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "ballistica/core/platform/core_platform.h"
+#include "ballistica/shared/ballistica.h"
+
+namespace ballistica {
+
+// All pools ever created. Intentionally leaked along with the pools
+// themselves.
+static auto GetPoolRegistry_() -> std::vector<SlabPool*>& {
+  static auto* pools = new std::vector<SlabPool*>();
+  return *pools;
+}
+
+static auto GetPoolRegistryMutex_() -> std::mutex& {
+  static auto* mutex = new std::mutex();
+  return *mutex;
+}
+
+auto SlabPool::Create(const char* name) -> SlabPool* {
+  auto* pool = new SlabPool(name);
+  std::scoped_lock lock(GetPoolRegistryMutex_());
+  GetPoolRegistry_().push_back(pool);
+  return pool;
+}
+
+SlabPool::SlabPool(const char* name)
+    : name_{name}, classes_(kMaxPooledSize / kGranularity + 1) {}
+
+SlabPool::~SlabPool() {
+  for (auto* slab : slabs_) {
+    ::operator delete(slab);
+  }
+}
+
+auto SlabPool::ClassIndexForSize_(size_t size) -> size_t {
+  return std::max(size_t{1}, (size + kGranularity - 1) / kGranularity);
+}
+
+void SlabPool::AddSlab_(size_t class_index) {
+  size_t item_size = class_index * kGranularity;
+  size_t item_count = std::max(kMinItemsPerSlab, kTargetSlabSize / item_size);
+  size_t slab_size = item_size * item_count;
+  auto* slab = static_cast<char*>(::operator new(slab_size));
+
+  // Thread the new items onto the front of the free list. We go in reverse
+  // so that allocations march forward through the slab in address order.
+  auto& size_class{classes_[class_index]};
+  for (size_t i = item_count; i > 0; --i) {
+    auto* item = reinterpret_cast<FreeItem*>(slab + (i - 1) * item_size);
+    item->next = size_class.free_list;
+    size_class.free_list = item;
+  }
+  slabs_.push_back(slab);
+  size_class.slab_count++;
+  stats_.slab_count++;
+  stats_.slab_bytes += slab_size;
+}
+
+auto SlabPool::Alloc(size_t size) -> void* {
+  std::scoped_lock lock(mutex_);
+  stats_.allocs++;
+  stats_.live++;
+  stats_.peak_live = std::max(stats_.peak_live, stats_.live);
+  if (size > kMaxPooledSize) {
+    stats_.oversize_allocs++;
+    return ::operator new(size);
+  }
+  size_t class_index = ClassIndexForSize_(size);
+  auto& size_class{classes_[class_index]};
+  if (size_class.free_list == nullptr) {
+    AddSlab_(class_index);
+  }
+  FreeItem* item = size_class.free_list;
+  size_class.free_list = item->next;
+  return item;
+}
+
+void SlabPool::Free(void* ptr, size_t size) {
+  if (ptr == nullptr) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  stats_.frees++;
+  stats_.live--;
+  assert(stats_.live >= 0);
+  if (size > kMaxPooledSize) {
+    ::operator delete(ptr);
+    return;
+  }
+  size_t class_index = ClassIndexForSize_(size);
+  auto& size_class{classes_[class_index]};
+  auto* item = static_cast<FreeItem*>(ptr);
+  item->next = size_class.free_list;
+  size_class.free_list = item;
+}
+
+auto SlabPool::GetStats() -> Stats {
+  std::scoped_lock lock(mutex_);
+  return stats_;
+}
+
+auto SlabPool::GetStatsString() -> std::string {
+  std::vector<SlabPool*> pools;
+  {
+    std::scoped_lock lock(GetPoolRegistryMutex_());
+    pools = GetPoolRegistry_();
+  }
+  std::string out = std::to_string(pools.size()) + " slab pools:";
+  char buffer[256];
+  for (auto* pool : pools) {
+    auto stats = pool->GetStats();
+    snprintf(buffer, sizeof(buffer),
+             "\n   %s: live=%lld peak=%lld allocs=%llu frees=%llu"
+             " oversize=%llu slabs=%zu (%zu KB)",
+             pool->name(), static_cast<long long>(stats.live),  // NOLINT
+             static_cast<long long>(stats.peak_live),           // NOLINT
+             static_cast<unsigned long long>(stats.allocs),     // NOLINT
+             static_cast<unsigned long long>(stats.frees),      // NOLINT
+             static_cast<unsigned long long>(                   // NOLINT
+                 stats.oversize_allocs),
+             stats.slab_count, stats.slab_bytes / 1024);
+    out += buffer;
+  }
+  return out;
+}
+
+void SlabPool::LsPools() { Log(LogLevel::kInfo, GetStatsString()); }
+
+auto SlabPool::RunChurnBenchmark(int iterations) -> std::string {
+  BA_PRECONDITION(iterations > 0);
+
+  // A rough approximation of node/body/collision churn: a working set of
+  // a few thousand live objects of assorted sizes where a chunk of them
+  // gets replaced each iteration.
+  constexpr size_t kSizes[] = {48, 96, 176, 320, 704, 1200};
+  constexpr size_t kSizeCount = sizeof(kSizes) / sizeof(kSizes[0]);
+  constexpr size_t kWorkingSet = 4096;
+  constexpr size_t kChurnPerIteration = 512;
+
+  struct Block {
+    void* ptr{};
+    size_t size{};
+  };
+
+  // Scratch pool; deliberately not registered so it doesn't show up in
+  // stats.
+  auto pool = std::make_unique<SlabPool>("benchmark");
+
+  auto run = [&](auto&& alloc, auto&& free) -> microsecs_t {
+    std::vector<Block> blocks(kWorkingSet);
+    uint32_t seed = 12345;
+    auto next_rand = [&seed] {
+      seed = seed * 1664525u + 1013904223u;
+      return seed >> 8;
+    };
+    auto start = core::CorePlatform::GetCurrentMicrosecs();
+    for (auto&& block : blocks) {
+      block.size = kSizes[next_rand() % kSizeCount];
+      block.ptr = alloc(block.size);
+    }
+    for (int i = 0; i < iterations; ++i) {
+      for (size_t j = 0; j < kChurnPerIteration; ++j) {
+        auto& block{blocks[next_rand() % kWorkingSet]};
+        free(block.ptr, block.size);
+        block.size = kSizes[next_rand() % kSizeCount];
+        block.ptr = alloc(block.size);
+      }
+    }
+    for (auto&& block : blocks) {
+      free(block.ptr, block.size);
+    }
+    return core::CorePlatform::GetCurrentMicrosecs() - start;
+  };
+
+  auto heap_time =
+      run([](size_t size) { return ::operator new(size); },
+          [](void* ptr, size_t /*size*/) { ::operator delete(ptr); });
+  auto pool_time =
+      run([&pool](size_t size) { return pool->Alloc(size); },
+          [&pool](void* ptr, size_t size) { pool->Free(ptr, size); });
+
+  auto stats = pool->GetStats();
+  char buffer[256];
+  snprintf(buffer, sizeof(buffer),
+           "Slab pool churn benchmark (%d iterations, %llu allocs):"
+           " heap=%lldus pool=%lldus (%.2fx); pool slabs=%zu (%zu KB).",
+           iterations,
+           static_cast<unsigned long long>(stats.allocs),  // NOLINT
+           static_cast<long long>(heap_time),              // NOLINT
+           static_cast<long long>(pool_time),              // NOLINT
+           pool_time > 0 ? static_cast<double>(heap_time)
+                               / static_cast<double>(pool_time)
+                         : 0.0,
+           stats.slab_count, stats.slab_bytes / 1024);
+  return buffer;
+}
+
+}  // namespace ballistica
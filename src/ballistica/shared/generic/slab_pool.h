@@ -0,0 +1,122 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SHARED_GENERIC_SLAB_POOL_H_
+#define BALLISTICA_SHARED_GENERIC_SLAB_POOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ballistica {
+
+/// A simple size-classed slab allocator for small, frequently churned
+/// objects (scene nodes, bodies, collisions, etc).
+///
+/// Allocations are rounded up to a 16 byte size class and carved out of
+/// large slabs which are then recycled through per-class free lists. This
+/// keeps objects of similar types packed together in memory and avoids
+/// hitting the general-purpose heap (and fragmenting it) during heavy
+/// churn such as explosions. Slabs are never returned to the system; the
+/// pool simply holds onto its high-water mark. Requests larger than
+/// kMaxPooledSize fall through to the regular heap.
+///
+/// Pools should be created with Create() and are intentionally never
+/// destroyed, so objects released during static teardown never reference
+/// a dead pool.
+class SlabPool {
+ public:
+  static constexpr size_t kGranularity{16};
+  static constexpr size_t kMaxPooledSize{4096};
+  static constexpr size_t kTargetSlabSize{64 * 1024};
+  static constexpr size_t kMinItemsPerSlab{8};
+
+  struct Stats {
+    uint64_t allocs{};
+    uint64_t frees{};
+    uint64_t oversize_allocs{};
+    int64_t live{};
+    int64_t peak_live{};
+    size_t slab_count{};
+    size_t slab_bytes{};
+  };
+
+  /// Create a new named pool and register it for stats reporting. The
+  /// returned pool lives for the duration of the process.
+  static auto Create(const char* name) -> SlabPool*;
+
+  /// Pools may also be created directly for scratch use (benchmarks,
+  /// etc). Such pools are not registered for stats and release their slabs
+  /// when destroyed; nothing allocated from them may outlive them.
+  explicit SlabPool(const char* name);
+  ~SlabPool();
+
+  auto Alloc(size_t size) -> void*;
+  void Free(void* ptr, size_t size);
+
+  auto name() const -> const char* { return name_; }
+  auto GetStats() -> Stats;
+
+  /// Return a human readable summary of all registered pools.
+  static auto GetStatsString() -> std::string;
+
+  /// Log a summary of all registered pools.
+  static void LsPools();
+
+  /// Allocate and free blocks of a few different sizes in a churning
+  /// pattern using both a scratch SlabPool and the regular heap, returning
+  /// a summary of relative timings.
+  static auto RunChurnBenchmark(int iterations) -> std::string;
+
+ private:
+  struct FreeItem {
+    FreeItem* next;
+  };
+  struct SizeClass {
+    FreeItem* free_list{};
+    size_t slab_count{};
+  };
+  static auto ClassIndexForSize_(size_t size) -> size_t;
+  void AddSlab_(size_t class_index);
+
+  const char* name_;
+  std::mutex mutex_;
+  std::vector<SizeClass> classes_;
+  std::vector<void*> slabs_;
+  Stats stats_;
+};
+
+}  // namespace ballistica
+
+/// Give a class (and all of its subclasses) class-level allocation
+/// functions routing through the provided SlabPool accessor expression.
+/// Should be placed in a public section of the class declaration. Sized
+/// delete is used so that subclasses of differing sizes land back in
+/// their proper size class; this relies on the class having a virtual
+/// destructor (all ballistica::Objects do). Like Object's own, operator
+/// new is private in debug builds (with Object as a friend) so that
+/// allocations must go through Object::New() and friends.
+#if BA_DEBUG_BUILD
+#define BA_SLAB_POOL_ALLOCATED(POOL_EXPR)               \
+ private:                                               \
+  friend class Object;                                  \
+  static auto operator new(size_t size) -> void* {      \
+    return (POOL_EXPR)->Alloc(size);                    \
+  }                                                     \
+                                                        \
+ public:                                                \
+  static void operator delete(void* ptr, size_t size) { \
+    (POOL_EXPR)->Free(ptr, size);                       \
+  }
+#else
+#define BA_SLAB_POOL_ALLOCATED(POOL_EXPR)               \
+  static auto operator new(size_t size) -> void* {      \
+    return (POOL_EXPR)->Alloc(size);                    \
+  }                                                     \
+  static void operator delete(void* ptr, size_t size) { \
+    (POOL_EXPR)->Free(ptr, size);                       \
+  }
+#endif
+
+#endif  // BALLISTICA_SHARED_GENERIC_SLAB_POOL_H_
@@ -0,0 +1,141 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/shared/generic/worker_pool.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+#include "ballistica/core/core.h"
+#include "ballistica/shared/ballistica.h"
+
+namespace ballistica {
+
+using core::g_core;
+
+// Set while a thread is running chunks for a pool, so nested
+// ParallelFor() calls can run inline instead of deadlocking.
+static thread_local bool g_in_worker_job{};
+
+auto WorkerPool::Shared() -> WorkerPool* {
+  static WorkerPool* pool = [] {
+    int count = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+    count = std::clamp(count, 0, kMaxSharedThreads);
+    if (const char* envval = getenv("BA_WORKER_THREADS")) {
+      count = std::clamp(atoi(envval), 0, 64);
+    }
+    // Intentionally leaked; our threads live for the life of the process.
+    return new WorkerPool(count);
+  }();
+  return pool;
+}
+
+WorkerPool::WorkerPool(int thread_count) {
+  assert(thread_count >= 0);
+  threads_.reserve(thread_count);
+  for (int i = 0; i < thread_count; ++i) {
+    threads_.emplace_back(&WorkerPool::ThreadMain_, this, i + 1);
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::scoped_lock lock(mutex_);
+    shutting_down_ = true;
+  }
+  work_cv_.notify_all();
+  for (auto&& thread : threads_) {
+    thread.join();
+  }
+}
+
+void WorkerPool::ThreadMain_(int slot) {
+  if (g_core) {
+    g_core->RegisterThread("worker" + std::to_string(slot));
+  }
+  uint64_t seen_generation{};
+  while (true) {
+    {
+      std::unique_lock lock(mutex_);
+      work_cv_.wait(lock, [this, seen_generation] {
+        return shutting_down_ || generation_ != seen_generation;
+      });
+      if (shutting_down_) {
+        return;
+      }
+      seen_generation = generation_;
+    }
+    RunChunks_(slot);
+    {
+      std::scoped_lock lock(mutex_);
+      active_workers_--;
+    }
+    done_cv_.notify_all();
+  }
+}
+
+void WorkerPool::RunChunks_(int slot) {
+  g_in_worker_job = true;
+  while (true) {
+    size_t begin = next_index_.fetch_add(grain_size_);
+    if (begin >= count_) {
+      break;
+    }
+    size_t end = std::min(count_, begin + grain_size_);
+    try {
+      (*func_)(begin, end, slot);
+    } catch (...) {
+      std::scoped_lock lock(mutex_);
+      if (!exception_) {
+        exception_ = std::current_exception();
+      }
+    }
+  }
+  g_in_worker_job = false;
+}
+
+void WorkerPool::ParallelFor(size_t count, size_t grain_size,
+                             const RangeFunc& func) {
+  if (count == 0) {
+    return;
+  }
+  grain_size = std::max(size_t{1}, grain_size);
+
+  // Run inline if we've got nobody to help, there's not enough work to
+  // split, or we're being called from within a job.
+  if (threads_.empty() || count <= grain_size || g_in_worker_job) {
+    func(0, count, 0);
+    return;
+  }
+
+  std::scoped_lock run_lock(run_mutex_);
+  {
+    std::scoped_lock lock(mutex_);
+    func_ = &func;
+    count_ = count;
+    grain_size_ = grain_size;
+    next_index_ = 0;
+    exception_ = nullptr;
+    active_workers_ = static_cast<int>(threads_.size());
+    generation_++;
+  }
+  work_cv_.notify_all();
+
+  // Pitch in ourself.
+  RunChunks_(0);
+
+  // Wait for stragglers.
+  std::exception_ptr exception;
+  {
+    std::unique_lock lock(mutex_);
+    done_cv_.wait(lock, [this] { return active_workers_ == 0; });
+    func_ = nullptr;
+    exception = exception_;
+    exception_ = nullptr;
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+}  // namespace ballistica
@@ -0,0 +1,77 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SHARED_GENERIC_WORKER_POOL_H_
+#define BALLISTICA_SHARED_GENERIC_WORKER_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ballistica {
+
+/// A small fixed-size pool of threads for short, CPU-bound fork/join work
+/// (narrowphase collision tests, physics islands, etc).
+///
+/// Work is handed out with ParallelFor(), which blocks until all work is
+/// complete. The calling thread participates in the work, so a pool with
+/// zero threads simply runs everything inline. Only one ParallelFor() runs
+/// at a time; calls from other threads wait their turn, and calls made
+/// from within a running job are run inline.
+class WorkerPool {
+ public:
+  /// Function type run for a range of indices. The slot value is unique
+  /// among concurrently running calls within a single ParallelFor() and
+  /// is in the range [0, thread_count()] (the calling thread is slot 0).
+  /// This allows jobs to use per-slot scratch data without locking.
+  using RangeFunc = std::function<void(size_t begin, size_t end, int slot)>;
+
+  /// Return the process-wide shared pool, creating it if need be. Its
+  /// thread count is based on the hardware thread count (capped at
+  /// kMaxSharedThreads) and can be overridden with the
+  /// BA_WORKER_THREADS environment variable (0 disables threading).
+  static auto Shared() -> WorkerPool*;
+
+  static constexpr int kMaxSharedThreads{4};
+
+  explicit WorkerPool(int thread_count);
+  ~WorkerPool();
+
+  /// Number of worker threads (not including callers).
+  auto thread_count() const -> int {
+    return static_cast<int>(threads_.size());
+  }
+
+  /// Run func over [0, count) split into chunks of roughly grain_size
+  /// indices, spread across the pool and the calling thread. Exceptions
+  /// thrown by func are caught, and the first is rethrown to the caller
+  /// once all work has finished.
+  void ParallelFor(size_t count, size_t grain_size, const RangeFunc& func);
+
+ private:
+  void ThreadMain_(int slot);
+  void RunChunks_(int slot);
+
+  std::vector<std::thread> threads_;
+  std::mutex run_mutex_;
+  std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable done_cv_;
+  const RangeFunc* func_{};
+  size_t count_{};
+  size_t grain_size_{1};
+  std::atomic<size_t> next_index_{};
+  int active_workers_{};
+  uint64_t generation_{};
+  bool shutting_down_{};
+  std::exception_ptr exception_;
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_SHARED_GENERIC_WORKER_POOL_H_
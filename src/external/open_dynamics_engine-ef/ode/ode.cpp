@@ -1547,6 +1547,16 @@ void dWorldQuickStep (dWorldID w, dReal stepsize) {
   dxProcessIslands (w,stepsize,&dxQuickStepper);
 }
 
+void dWorldQuickStepIslands (dWorldID w, dReal stepsize,
+                             dIslandDispatchFunction *dispatch,
+                             void *dispatch_data)
+{
+  dUASSERT (w,"bad world argument");
+  dUASSERT (stepsize > 0,"stepsize must be > 0");
+  dUASSERT (dispatch,"bad dispatch argument");
+  dxProcessIslandsParallel (w,stepsize,&dxQuickStepper,dispatch,dispatch_data);
+}
+
 int dWorldGetQuickStepWarmStartingDataSize(dWorldID w) {
 	return 6 * w->nj;
 }
@@ -339,6 +339,18 @@ typedef struct dJointFeedback {
 } dJointFeedback;
 
 
+/* ballistica addition: island dispatching for dWorldQuickStepIslands(). The
+ * dispatcher must call job(job_data, i) exactly once for each i in
+ * [0, island_count) - in any order and on any threads - and return only
+ * once all calls have completed.
+ */
+
+typedef void dIslandJobFunction (void *job_data, int island_index);
+typedef void dIslandDispatchFunction (void *dispatch_data, int island_count,
+                                      dIslandJobFunction *job,
+                                      void *job_data);
+
+
 /* private functions that must be implemented by the collision library:
  * (1) indicate that a geom has moved, (2) get the next geom in a body list.
  * these functions are called whenever the position of geoms connected to a
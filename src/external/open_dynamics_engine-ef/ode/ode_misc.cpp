@@ -29,10 +29,16 @@
 
 static unsigned long seed = 0;
 
+unsigned long dRandSeeded (unsigned long *s)
+{
+  *s = (1664525L*(*s) + 1013904223L) & 0xffffffff;
+  return *s;
+}
+
+
 unsigned long dRand()
 {
-  seed = (1664525L*seed + 1013904223L) & 0xffffffff;
-  return seed;
+  return dRandSeeded (&seed);
 }
 
 
@@ -61,10 +67,16 @@ int dTestRand()
 }
 
 
-int dRandInt (int n)
+int dRandIntSeeded (unsigned long *s, int n)
 {
   double a = double(n) / 4294967296.0;
-  return (int) (double(dRand()) * a);
+  return (int) (double(dRandSeeded(s)) * a);
+}
+
+
+int dRandInt (int n)
+{
+  return dRandIntSeeded (&seed, n);
 }
 
 
@@ -50,6 +50,13 @@ void dRandSetSeed (unsigned long s);
  */
 int dRandInt (int n);
 
+/* ballistica addition: versions of dRand()/dRandInt() operating on a
+ * caller-owned seed instead of the global one, for use from code that may
+ * run on multiple threads at once.
+ */
+unsigned long dRandSeeded (unsigned long *seed);
+int dRandIntSeeded (unsigned long *seed, int n);
+
 /* return a random real number between 0..1 */
 dReal dRandReal(void);
 
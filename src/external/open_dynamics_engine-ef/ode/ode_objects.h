@@ -51,6 +51,14 @@ void dWorldImpulseToForce (dWorldID, dReal stepsize,
 /* World QuickStep functions */
 
 void dWorldQuickStep (dWorldID w, dReal stepsize);
+
+/* ballistica addition: QuickStep with independent islands stepped through a
+ * caller-provided dispatcher (see dIslandDispatchFunction). Results are
+ * identical to dWorldQuickStep().
+ */
+void dWorldQuickStepIslands (dWorldID w, dReal stepsize,
+                             dIslandDispatchFunction *dispatch,
+                             void *dispatch_data);
 void dWorldSetQuickStepNumIterations (dWorldID, int num);
 int dWorldGetQuickStepNumIterations (dWorldID);
 void dWorldSetQuickStepW (dWorldID, dReal param);
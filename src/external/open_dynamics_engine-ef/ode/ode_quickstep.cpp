@@ -39,33 +39,13 @@ typedef const dReal *dRealPtr;
 typedef dReal *dRealMutablePtr;
 #define dRealArray(name,n) dReal name[n];
 
-// ericf addition - a simple memory buffer
-class _Buffer{
-public:
-    _Buffer():_ptr(NULL),_allocated(false){
-    }
-    void allocate(unsigned long size){
-        if (_allocated && _ptr) free(_ptr);
-        //dIASSERT(size > 0);
-        _ptr = malloc(size);
-        dIASSERT(_ptr);
-        _allocated = true;
-    }
-    ~_Buffer(){
-        if (_allocated && _ptr) free(_ptr);
-        _ptr = NULL;
-    }
-    void* getPtr() const {return _ptr;}
-private:
-    void* _ptr;
-    bool _allocated;
-};
-
-
-// ...ericf update - we can shave a bit of time off by using our own bare-bones buffer class...
-#define TRIXY_ALLOCA(name,type,n) _Buffer name ## BUF; if (n > 6000){name ## BUF.allocate((n)); name = (type*)name ## BUF.getPtr();} else {name = (type*)ALLOCA((n)); dIASSERT(name);}
-
-#define dRealAllocaArray(name,n) dReal *name; TRIXY_ALLOCA(name,dReal,n*sizeof(dReal))
+// ballistica change: scratch memory comes from a per-thread arena (see
+// ode_util.h) instead of alloca() or malloc() so islands can be stepped on
+// worker threads with small stacks and large islands don't hit the heap
+// every step.
+// Everything is released when dxQuickStepper() returns.
+#define dRealAllocaArray(name,n) dReal *name = (dReal*) dxStepArenaAlloc ((n)*sizeof(dReal))
+#define dxStepArenaArray(type,n) ((type*) dxStepArenaAlloc ((n)*sizeof(type)))
 //#define dRealAllocaArray(name,n) dReal *name = (dReal*) ALLOCA ((n)*sizeof(dReal));
 
 
@@ -447,7 +427,7 @@ static void SOR_LCP (int m, int nb, dRealMutablePtr J, int *jb, dxBody * const *
 	for (i=0; i<m; i++) Ad[i] *= cfm[i];
 
 	// order to solve constraint rows in
-	IndexError *order = (IndexError*) alloca (m*sizeof(IndexError));
+	IndexError *order = dxStepArenaArray (IndexError,m);
 
 #ifndef REORDER_CONSTRAINTS
 	// make sure constraints with findex < 0 come first.
@@ -491,19 +471,20 @@ static void SOR_LCP (int m, int nb, dRealMutablePtr J, int *jb, dxBody * const *
 		qsort (order,m,sizeof(IndexError),&compare_index_error);
 #endif
 
-//ericf: we save and restore the random seed here so each island is not affected by the
-//existance of other islands
+// ballistica change: we shuffle using a local copy of the random seed here
+// so each island is not affected by the existance of other islands (this
+// also leaves the global seed untouched so islands can be solved on
+// multiple threads at once)
 #ifdef RANDOMLY_REORDER_CONSTRAINTS
-		unsigned long oldSeed = dRandGetSeed();
+		unsigned long localSeed = dRandGetSeed();
 		if ((iteration & 7) == 0) {
 			for (i=1; i<m; ++i) {
 				IndexError tmp = order[i];
-				int swapi = dRandInt(i+1);
+				int swapi = dRandIntSeeded(&localSeed,i+1);
 				order[i] = order[swapi];
 				order[swapi] = tmp;
 			}
 		}
-		dRandSetSeed(oldSeed);
 #endif
 
 		//@@@ potential optimization: swap lambda and last_lambda pointers rather
@@ -605,6 +586,9 @@ void dxQuickStepper (dxWorld *world, dxBody * const *body, int nb,
 	int i,j;
 	IFTIMING(dTimerStart("preprocessing");)
 
+	// all scratch memory we allocate below is released when this goes away.
+	dxStepArenaScope arenaScope;
+
 	dReal stepsize1 = dRecip(stepsize);
 
 	// number all bodies in the body list - set their tag values
@@ -614,7 +598,7 @@ void dxQuickStepper (dxWorld *world, dxBody * const *body, int nb,
 	// (the "dxJoint *const*" declaration says we're allowed to modify the joints
 	// but not the joint array, because the caller might need it unchanged).
 	//@@@ do we really need to do this? we'll be sorting constraint rows individually, not joints
-	dxJoint **joint = (dxJoint**) alloca (nj * sizeof(dxJoint*));
+	dxJoint **joint = dxStepArenaArray (dxJoint*,nj);
 	memcpy (joint,_joint,nj * sizeof(dxJoint*));
 	
 	// for all bodies, compute the inertia tensor and its inverse in the global
@@ -702,7 +686,7 @@ void dxQuickStepper (dxWorld *world, dxBody * const *body, int nb,
 	// entirely, so that the code that follows does not consider them.
 	//@@@ do we really need to save all the info1's
     //printf("SIZE IS %d coutn is %d\n",sizeof(dxJoint::Info1),nj);
-	dxJoint::Info1 *info = (dxJoint::Info1*) alloca (nj*sizeof(dxJoint::Info1));
+	dxJoint::Info1 *info = dxStepArenaArray (dxJoint::Info1,nj);
 	for (i=0, j=0; j<nj; j++) {	// i=dest, j=src
 		joint[j]->vtable->getInfo1 (joint[j],info+i);
 		dIASSERT (info[i].m >= 0 && info[i].m <= 6 && info[i].nub >= 0 && info[i].nub <= info[i].m);
@@ -715,7 +699,7 @@ void dxQuickStepper (dxWorld *world, dxBody * const *body, int nb,
 
 	// create the row offset array
 	int m = 0;
-	int *ofs = (int*) alloca (nj*sizeof(int));
+	int *ofs = dxStepArenaArray (int,nj);
 	for (i=0; i<nj; i++) {
 		ofs[i] = m;
 		m += info[i].m;
@@ -724,7 +708,7 @@ void dxQuickStepper (dxWorld *world, dxBody * const *body, int nb,
 
 	// if there are constraints, compute the constraint force
 	dRealAllocaArray (J,m*12);
-	int *jb = (int*) alloca (m*2*sizeof(int));
+	int *jb = dxStepArenaArray (int,m*2);
 	if (m > 0) {
 		// create a constraint equation right hand side vector `c', a constraint
 		// force mixing vector `cfm', and LCP low and high bound vectors, and an
@@ -733,7 +717,7 @@ void dxQuickStepper (dxWorld *world, dxBody * const *body, int nb,
 		dRealAllocaArray (cfm,m);
 		dRealAllocaArray (lo,m);
 		dRealAllocaArray (hi,m);
-		int *findex = (int*) alloca (m*sizeof(int));
+		int *findex = dxStepArenaArray (int,m);
 		dSetZero (c,m);
 		dSetValue (cfm,m,world->global_cfm);
 		dSetValue (lo,m,-dInfinity);
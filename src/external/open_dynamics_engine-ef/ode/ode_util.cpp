@@ -24,7 +24,10 @@
 #include "ode/ode_objects_private.h"
 #include "ode/ode_joint.h"
 #include "ode/ode_util.h"
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <vector>
 
 #define ALLOCA dALLOCA16
 
@@ -94,6 +97,9 @@ static inline dReal sinc (dReal x)
 // given a body b, apply its linear and angular rotation over the time
 // interval h, thereby adjusting its position and orientation.
 
+// set while stepping islands via dxProcessIslandsParallel().
+static thread_local bool defer_geom_moves = false;
+
 void dxStepBody (dxBody *b, dReal h)
 {
     int j;
@@ -167,8 +173,13 @@ void dxStepBody (dxBody *b, dReal h)
     dQtoR (b->q,b->R);
 
     // notify all attached geoms that this body has moved
-    for (dxGeom *geom = b->geom; geom; geom = dGeomGetBodyNext (geom))
-        dGeomMoved (geom);
+    // (unless we're stepping an island on a worker thread; in that case
+    // dxProcessIslandsParallel() does this once all islands are done since
+    // it touches shared space state)
+    if (!defer_geom_moves) {
+        for (dxGeom *geom = b->geom; geom; geom = dGeomGetBodyNext (geom))
+            dGeomMoved (geom);
+    }
 }
 
 //****************************************************************************
@@ -283,3 +294,203 @@ void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper)
   }
 # endif
 }
+
+//****************************************************************************
+// parallel island processing
+
+namespace {
+
+struct dxIslandRange {
+  int body_start;
+  int body_count;
+  int joint_start;
+  int joint_count;
+};
+
+struct dxIslandJob {
+  dxWorld *world;
+  dReal stepsize;
+  dstepper_fn_t stepper;
+  dxBody **body;
+  dxJoint **joint;
+  const dxIslandRange *islands;
+  const int *order;
+};
+
+void dxRunIslandJob (void *job_data, int index)
+{
+  const dxIslandJob *job = (const dxIslandJob*) job_data;
+  const dxIslandRange &island = job->islands[job->order[index]];
+  bool old_defer = defer_geom_moves;
+  defer_geom_moves = true;
+  job->stepper (job->world, job->body + island.body_start, island.body_count,
+                job->joint + island.joint_start, island.joint_count,
+                job->stepsize);
+  defer_geom_moves = old_defer;
+}
+
+}  // namespace
+
+void dxProcessIslandsParallel (dxWorld *world, dReal stepsize,
+                               dstepper_fn_t stepper,
+                               dIslandDispatchFunction *dispatch,
+                               void *dispatch_data)
+{
+  dxBody *b,*bb;
+  dxJoint *j;
+
+  // nothing to do if no bodies
+  if (world->nb <= 0) return;
+
+  // handle auto-disabling of bodies
+  dInternalHandleAutoDisabling (world,stepsize);
+
+  dxStepArenaScope arenaScope;
+
+  // gather all islands up front into flat body and joint lists. this uses
+  // the exact same traversal as dxProcessIslands() so we get the same
+  // islands with their contents in the same order. (stepping an island
+  // only touches its own bodies and joints, so doing this before stepping
+  // anything doesn't change anything).
+  dxBody **body = (dxBody**) dxStepArenaAlloc (world->nb * sizeof(dxBody*));
+  dxJoint **joint = (dxJoint**) dxStepArenaAlloc (world->nj * sizeof(dxJoint*));
+  dxIslandRange *islands =
+      (dxIslandRange*) dxStepArenaAlloc (world->nb * sizeof(dxIslandRange));
+  int bcount = 0;
+  int jcount = 0;
+  int icount = 0;
+
+  for (b=world->firstbody; b; b=(dxBody*)b->next) b->tag = 0;
+  for (j=world->firstjoint; j; j=(dxJoint*)j->next) j->tag = 0;
+
+  int stackalloc = (world->nj < world->nb) ? world->nj : world->nb;
+  dxBody **stack =
+      (dxBody**) dxStepArenaAlloc ((stackalloc + 1) * sizeof(dxBody*));
+
+  for (bb=world->firstbody; bb; bb=(dxBody*)bb->next) {
+    if (bb->tag || (bb->flags & dxBodyDisabled)) continue;
+    bb->tag = 1;
+
+    dxIslandRange &island = islands[icount++];
+    island.body_start = bcount;
+    island.joint_start = jcount;
+
+    int stacksize = 0;
+    body[bcount++] = bb;
+    b = bb;
+    while (true) {
+      for (dxJointNode *n=b->firstjoint; n; n=n->next) {
+        if (!n->joint->tag) {
+          n->joint->tag = 1;
+          joint[jcount++] = n->joint;
+          if (n->body && !n->body->tag) {
+            n->body->tag = 1;
+            stack[stacksize++] = n->body;
+          }
+        }
+      }
+      dIASSERT(stacksize <= world->nb);
+      dIASSERT(stacksize <= world->nj);
+      if (stacksize == 0) break;
+      b = stack[--stacksize];
+      body[bcount++] = b;
+    }
+    island.body_count = bcount - island.body_start;
+    island.joint_count = jcount - island.joint_start;
+  }
+
+  // hand out the biggest islands first so the smaller ones can fill in
+  // around them. this has no effect on results.
+  int *order = (int*) dxStepArenaAlloc (icount * sizeof(int));
+  for (int i=0; i<icount; i++) order[i] = i;
+  std::sort (order, order+icount, [islands](int a, int b) {
+    int sa = islands[a].body_count + islands[a].joint_count;
+    int sb = islands[b].body_count + islands[b].joint_count;
+    return (sa != sb) ? (sa > sb) : (a < b);
+  });
+
+  dxIslandJob job = {world, stepsize, stepper, body, joint, islands, order};
+  if (icount == 1) {
+    dxRunIslandJob (&job, 0);
+  }
+  else if (icount > 1) {
+    dispatch (dispatch_data, icount, &dxRunIslandJob, &job);
+  }
+
+  // now finish up in island order: notify geoms of movement (which we
+  // deferred since it touches shared space state), make sure tags are
+  // nonzero, and make sure all bodies are in the enabled state.
+  for (int i=0; i<bcount; i++) {
+    body[i]->tag = 1;
+    body[i]->flags &= ~dxBodyDisabled;
+    for (dxGeom *geom = body[i]->geom; geom; geom = dGeomGetBodyNext (geom))
+      dGeomMoved (geom);
+  }
+  for (int i=0; i<jcount; i++) joint[i]->tag = 1;
+}
+
+//****************************************************************************
+// step arena
+
+namespace {
+
+const size_t kStepArenaBlockSize = 256 * 1024;
+
+struct dxStepArenaBlock {
+  void *raw;
+  char *data;
+  size_t size;
+};
+
+struct dxStepArena {
+  std::vector<dxStepArenaBlock> blocks;
+  size_t block = 0;
+  size_t offset = 0;
+  ~dxStepArena() {
+    for (size_t i=0; i<blocks.size(); i++) free (blocks[i].raw);
+  }
+};
+
+thread_local dxStepArena step_arena;
+
+}  // namespace
+
+void *dxStepArenaAlloc (size_t size)
+{
+  dxStepArena &arena = step_arena;
+  size = (size == 0) ? EFFICIENT_ALIGNMENT : dEFFICIENT_SIZE(size);
+
+  // use the first block at or after our current one with room.
+  while (arena.block < arena.blocks.size()) {
+    dxStepArenaBlock &block = arena.blocks[arena.block];
+    if (arena.offset + size <= block.size) {
+      void *ptr = block.data + arena.offset;
+      arena.offset += size;
+      return ptr;
+    }
+    arena.block++;
+    arena.offset = 0;
+  }
+
+  // no luck; add a new one.
+  dxStepArenaBlock block;
+  block.size = std::max (kStepArenaBlockSize, size);
+  block.raw = malloc (block.size + EFFICIENT_ALIGNMENT);
+  dIASSERT (block.raw);
+  block.data = (char*) dEFFICIENT_SIZE((size_t)block.raw);
+  arena.blocks.push_back (block);
+  arena.block = arena.blocks.size() - 1;
+  arena.offset = size;
+  return block.data;
+}
+
+dxStepArenaScope::dxStepArenaScope()
+  : block (step_arena.block), offset (step_arena.offset)
+{
+}
+
+dxStepArenaScope::~dxStepArenaScope()
+{
+  step_arena.block = block;
+  step_arena.offset = offset;
+}
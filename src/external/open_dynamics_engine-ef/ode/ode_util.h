@@ -34,6 +34,29 @@ typedef void (*dstepper_fn_t) (dxWorld *world, dxBody * const *body, int nb,
 
 void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper);
 
+// ballistica addition: like dxProcessIslands() but gathers all islands up front
+// and hands them to a caller-provided dispatcher, which may step them
+// concurrently. results are identical to dxProcessIslands() regardless of
+// the order or threads islands are stepped on.
+void dxProcessIslandsParallel (dxWorld *world, dReal stepsize,
+                               dstepper_fn_t stepper,
+                               dIslandDispatchFunction *dispatch,
+                               void *dispatch_data);
+
+// ballistica addition: per-thread scratch memory for stepping. allocations are
+// 16 byte aligned and live until the innermost dxStepArenaScope on the
+// allocating thread is destroyed. memory is held onto between steps so
+// after warming up this never touches the heap.
+void *dxStepArenaAlloc (size_t size);
+
+struct dxStepArenaScope {
+  dxStepArenaScope();
+  ~dxStepArenaScope();
+private:
+  size_t block;
+  size_t offset;
+};
+
 
 
 /////////ERIC ADDED STUFF//////////////////////